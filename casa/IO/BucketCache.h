@@ -317,6 +317,22 @@ public:
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
+    // Get the statistics counters (since the last initStatistics).
+    // <group>
+    uInt nrOfAccess() const
+      { return naccess_p; }
+    uInt nrOfRead() const
+      { return nread_p; }
+    uInt nrOfInit() const
+      { return ninit_p; }
+    uInt nrOfWrite() const
+      { return nwrite_p; }
+    // </group>
+
+    // Get the bucket size.
+    uInt bucketSize() const
+      { return its_BucketSize; }
+
 private:
     // The file used.
     BucketFile* its_file;
@@ -32,6 +32,9 @@
 ///#include <casacore/casa/Containers/BlockIO.h>
 
 #include <casacore/casa/stdlib.h>                 // for rand
+#include <cmath>
+#include <cstring>
+#include <limits>
 #ifdef _OPENMP
 # include <omp.h>
 #endif
@@ -152,6 +155,122 @@ uInt64 SortKey::tryGenSort (Vector<uInt64>& indexVector, uInt64 nrrec, int opt)
 }
 
 
+Bool SortKey::isRadixKey() const
+{
+    switch (cmpObj_p->dataType()) {
+    case TpBool:
+    case TpChar:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        return False;
+    }
+}
+
+// Encode integer values by flipping the sign bit (if signed), so the
+// unsigned values compare in the same way.
+template<typename T, typename U>
+static void radixEncodeInt (uInt64* keys, const char* data, uInt incr,
+                            uInt64 nrrec)
+{
+    const U signBit = (std::numeric_limits<T>::is_signed  ?
+                       U(U(1) << (8*sizeof(U)-1)) : U(0));
+    for (uInt64 i=0; i<nrrec; ++i) {
+        T val;
+        memcpy (&val, data + i*incr, sizeof(T));
+        keys[i] = U(U(val) ^ signBit);
+    }
+}
+
+// Encode floating point values by inverting all bits of negative values
+// and the sign bit of positive values. -0 is the same as 0 and NaN is
+// sorted after infinity.
+template<typename T, typename U>
+static void radixEncodeFloat (uInt64* keys, const char* data, uInt incr,
+                              uInt64 nrrec)
+{
+    const U signBit = U(U(1) << (8*sizeof(U)-1));
+    for (uInt64 i=0; i<nrrec; ++i) {
+        T val;
+        memcpy (&val, data + i*incr, sizeof(T));
+        if (val == 0) {
+            val = 0;
+        } else if (std::isnan(val)) {
+            val = std::numeric_limits<T>::quiet_NaN();
+        }
+        U bits;
+        memcpy (&bits, &val, sizeof(T));
+        keys[i] = ((bits & signBit) == 0  ?  U(bits | signBit) : U(~bits));
+    }
+}
+
+uInt SortKey::radixEncode (uInt64* keys, uInt64 nrrec) const
+{
+    const char* data = static_cast<const char*>(data_p);
+    uInt nbytes = 0;
+    switch (cmpObj_p->dataType()) {
+    case TpBool:
+        radixEncodeInt<Bool,uChar> (keys, data, incr_p, nrrec);
+        nbytes = 1;
+        break;
+    case TpChar:
+        radixEncodeInt<Char,uChar> (keys, data, incr_p, nrrec);
+        nbytes = 1;
+        break;
+    case TpUChar:
+        radixEncodeInt<uChar,uChar> (keys, data, incr_p, nrrec);
+        nbytes = 1;
+        break;
+    case TpShort:
+        radixEncodeInt<Short,uShort> (keys, data, incr_p, nrrec);
+        nbytes = 2;
+        break;
+    case TpUShort:
+        radixEncodeInt<uShort,uShort> (keys, data, incr_p, nrrec);
+        nbytes = 2;
+        break;
+    case TpInt:
+        radixEncodeInt<Int,uInt> (keys, data, incr_p, nrrec);
+        nbytes = 4;
+        break;
+    case TpUInt:
+        radixEncodeInt<uInt,uInt> (keys, data, incr_p, nrrec);
+        nbytes = 4;
+        break;
+    case TpInt64:
+        radixEncodeInt<Int64,uInt64> (keys, data, incr_p, nrrec);
+        nbytes = 8;
+        break;
+    case TpFloat:
+        radixEncodeFloat<Float,uInt> (keys, data, incr_p, nrrec);
+        nbytes = 4;
+        break;
+    case TpDouble:
+        radixEncodeFloat<Double,uInt64> (keys, data, incr_p, nrrec);
+        nbytes = 8;
+        break;
+    default:
+        return 0;
+    }
+    // A descending key is sorted ascending on the inverted value.
+    if (order_p == Sort::Descending) {
+        uInt64 mask = (nbytes == 8  ?  ~uInt64(0) :
+                       (uInt64(1) << (8*nbytes)) - 1);
+        for (uInt64 i=0; i<nrrec; ++i) {
+            keys[i] ^= mask;
+        }
+    }
+    return nbytes;
+}
+
+
 
 
 Sort::Sort()
@@ -267,6 +386,14 @@ uInt64 Sort::sort (Vector<uInt64>& indexVector, uInt64 nrrec,
                    int options, Bool tryGenSort) const
   { return doSort (indexVector, nrrec, options, tryGenSort); }
 
+uInt Sort::partialSort (Vector<uInt>& indexVector, uInt nrrec,
+                        uInt nrsel) const
+  { return doPartialSort (indexVector, nrrec, nrsel); }
+
+uInt64 Sort::partialSort (Vector<uInt64>& indexVector, uInt64 nrrec,
+                          uInt64 nrsel) const
+  { return doPartialSort (indexVector, nrrec, nrsel); }
+
 uInt Sort::unique (Vector<uInt>& uniqueVector, uInt nrrec) const
   { return doUnique (uniqueVector, nrrec); }
 
@@ -82,6 +82,16 @@ public:
     int order() const
       { return order_p; }
 
+    // Tell if the key can be used in a radix sort. It is possible for
+    // the standard comparison objects of the fixed-width numeric types.
+    Bool isRadixKey() const;
+
+    // Encode the values of the key as unsigned integers which compare in
+    // the same way as the values (taking the sort order into account).
+    // It returns the number of significant bytes in the encoded values
+    // (0 if the key cannot be used in a radix sort).
+    uInt radixEncode (uInt64* keys, uInt64 nrrec) const;
+
 protected:
     // sort order; -1 = ascending, 1 = descending
     int               order_p;
@@ -138,6 +148,18 @@ protected:
 //  <DT> <src>Sort::HeapSort</src>
 //  <DD> Heapsort has O(n*log(n)) behaviour. Its speed is lower than
 //       that of QuickSort, so QuickSort is the default algorithm.
+//  <DT> <src>Sort::RadixSort</src>
+//  <DD> The LSD radix sort has O(n) behaviour and does not compare keys
+//       through the comparison objects. It can only be used if all keys
+//       are fixed-width numeric types (Bool, integer, Float or Double)
+//       using the standard comparison objects (as made when giving a data
+//       type to <src>sortKey</src>). It is well suited for sorting on a few
+//       integer keys like antenna numbers. Each key is encoded once as an
+//       unsigned integer whereafter the indices are distributed on each
+//       byte of the keys (least significant first) in parallel.
+//       Bytes having the same value for all records are skipped, so small
+//       integer values are sorted fast. If not all keys can be used,
+//       the default algorithm is used instead.
 // </DL>
 // The default is to use QuickSort for small arrays or if only a single
 // thread can be used. Otherwise ParSort is the default.
@@ -250,7 +272,8 @@ public:
                  InsSort=2,         // use insertion sort algorithm
                  QuickSort=4,       // use Quicksort algorithm
                  ParSort=8,         // use parallel merge sort algorithm
-                 NoDuplicates=16};  // skip data with equal sort keys
+                 NoDuplicates=16,   // skip data with equal sort keys
+                 RadixSort=32};     // use radix sort for numeric keys
 
     // Enumerate the sort order:
     enum Order {Ascending=-1,
@@ -328,6 +351,22 @@ public:
     uInt64 sort (Vector<uInt64>& indexVector, uInt64 nrrec,
                  int options = DefaultSort, Bool tryGenSort = True) const;
 
+    // Partially sort the data array of <src>nrrec</src> records, so that
+    // the resulting indices give the first <src>nrsel</src> records in the
+    // requested order (as in SQL's ORDER BY ... LIMIT).
+    // Only a heap of <src>nrsel</src> indices is maintained, which is much
+    // faster than a full sort if <src>nrsel</src> is small.
+    // Records with equal keys keep their original order.
+    // It returns the number of resulting records, which is the minimum of
+    // <src>nrrec</src> and <src>nrsel</src>. The indices array
+    // is resized to that number.
+    // <group>
+    uInt partialSort (Vector<uInt>& indexVector, uInt nrrec,
+                      uInt nrsel) const;
+    uInt64 partialSort (Vector<uInt64>& indexVector, uInt64 nrrec,
+                        uInt64 nrsel) const;
+    // </group>
+
     // Get all unique records in a sorted array. The array order is
     // given in the indexVector (as possibly returned by the sort function).
     // The default indexVector is 0..nrrec-1.
@@ -364,6 +403,9 @@ private:
     T doSort (Vector<T>& indexVector, T nrrec,
               int options = DefaultSort, Bool tryGenSort = True) const;
 
+    template<typename T>
+    T doPartialSort (Vector<T>& indexVector, T nrrec, T nrsel) const;
+
     template <typename T>
     T doUnique (Vector<T>& uniqueVector, T nrrec) const;
     template <typename T>
@@ -398,6 +440,11 @@ private:
     void merge (T* inx, T* tmp, T size, T* index,
                 T nparts) const;
 
+    // Do a (parallel) LSD radix sort if all keys are fixed-width numeric.
+    // It returns 0 if the radix sort cannot be used.
+    template<typename T>
+    T radixSort (int nthr, T nrrec, T* inx) const;
+
     // Do a quicksort, optionally skipping duplicates
     // (qkSort is the actual quicksort function).
     // <group>
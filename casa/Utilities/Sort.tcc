@@ -29,6 +29,8 @@
 //# Includes
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/SortError.h>
+#include <algorithm>
+#include <vector>
 #include <casacore/casa/Arrays/ArrayMath.h>
 
 #ifdef _OPENMP
@@ -44,8 +46,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (nrrec == 0) {
       return nrrec;
     }
-    //# Try if we can use the faster GenSort when we have one key only.
-    if (doTryGenSort  &&  nrkey_p == 1) {
+    //# Try if we can use the faster GenSort when we have one key only
+    //# (unless the radix sort has to be used for that key).
+    if (doTryGenSort  &&  nrkey_p == 1  &&
+        ! ((opt & ~NoDuplicates) == RadixSort  &&  keys_p[0]->isRadixKey())) {
       uInt n = keys_p[0]->tryGenSort (indexVector, nrrec, opt);
       if (n > 0) {
         return n;
@@ -99,6 +103,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         n = insSortNoDup (nrrec, inx);
       }
       break;
+    case RadixSort:
+      n = radixSort (nthr, nrrec, inx);
+      if (n == 0) {
+        // Not all keys can be used, so use the default sort.
+        n = (nrrec<1000 || nthr==1  ?
+             quickSort (nrrec, inx) : parSort (nthr, nrrec, inx));
+      }
+      if (nodup) {
+        n = insSortNoDup (nrrec, inx);
+      }
+      break;
     default:
       throw SortInvOpt();
     }
@@ -111,6 +126,29 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return n;
   }
 
+  template<typename T>
+  T Sort::doPartialSort (Vector<T>& indexVector, T nrrec, T nrsel) const
+  {
+    if (nrsel > nrrec) {
+      nrsel = nrrec;
+    }
+    indexVector.resize (nrrec);
+    indgen (indexVector);
+    if (nrsel == 0) {
+      indexVector.resize (0);
+      return 0;
+    }
+    Bool del;
+    T* inx = indexVector.getStorage (del);
+    // compare gives a value > 0 if the records are in order. Because it
+    // compares the indices for equal keys, it is a strict ordering.
+    std::partial_sort (inx, inx+nrsel, inx+nrrec,
+                       [this] (T i1, T i2) { return compare (i1, i2) > 0; });
+    indexVector.putStorage (inx, del);
+    indexVector.resize (nrsel, True);
+    return nrsel;
+  }
+
   template<typename T>
   T Sort::doUnique (Vector<T>& uniqueVector, T nrrec) const
   {
@@ -216,6 +254,84 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return nrrec;
   }  
 
+  template<typename T>
+  T Sort::radixSort (int nthr, T nrrec, T* inx) const
+  {
+    // Encode the keys as unsigned integers.
+    std::vector<std::vector<uInt64>> keys(nrkey_p);
+    std::vector<uInt> nbytes(nrkey_p);
+    for (size_t k=0; k<nrkey_p; ++k) {
+      if (! keys_p[k]->isRadixKey()) {
+        return 0;
+      }
+      keys[k].resize (nrrec);
+      nbytes[k] = keys_p[k]->radixEncode (keys[k].data(), nrrec);
+    }
+    // Like the other algorithms, equal keys are in reversed order if
+    // all keys are descending.
+    if (order_p == 1) {
+      std::reverse (inx, inx+nrrec);
+    }
+    // Each thread handles a contiguous part of the indices, so the
+    // counting sort of each byte is stable.
+    Block<T> tinx(nthr+1);
+    T step = nrrec/nthr;
+    for (int i=0; i<nthr; ++i) tinx[i] = i*step;
+    tinx[nthr] = nrrec;
+    Block<T> counts(nthr*256);
+    Block<T> tmp(nrrec);
+    T* from = inx;
+    T* to   = tmp.storage();
+    // Sort on the least significant byte of the least significant key first.
+    for (size_t k=nrkey_p; k>0; --k) {
+      const uInt64* key = keys[k-1].data();
+      for (uInt b=0; b<nbytes[k-1]; ++b) {
+        const uInt shift = 8*b;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<nthr; ++i) {
+          T* cnt = counts.storage() + i*256;
+          std::fill (cnt, cnt+256, T(0));
+          for (T j=tinx[i]; j<tinx[i+1]; ++j) {
+            cnt[(key[from[j]] >> shift) & 255]++;
+          }
+        }
+        // Determine the start of each byte value per thread.
+        // The pass can be skipped if all records have the same byte value.
+        T offset = 0;
+        Bool skip = False;
+        for (uInt d=0; d<256  &&  !skip; ++d) {
+          T nd = 0;
+          for (int i=0; i<nthr; ++i) {
+            T c = counts[i*256 + d];
+            counts[i*256 + d] = offset + nd;
+            nd += c;
+          }
+          skip = (nd == nrrec);
+          offset += nd;
+        }
+        if (skip) {
+          continue;
+        }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<nthr; ++i) {
+          T* cnt = counts.storage() + i*256;
+          for (T j=tinx[i]; j<tinx[i+1]; ++j) {
+            to[cnt[(key[from[j]] >> shift) & 255]++] = from[j];
+          }
+        }
+        std::swap (from, to);
+      }
+    }
+    if (from != inx) {
+      std::copy (from, from+nrrec, inx);
+    }
+    return nrrec;
+  }
+
   template<typename T>
   void Sort::merge (T* inx, T* tmp, T nrrec, T* index,
                     T nparts) const
@@ -27,6 +27,7 @@
 
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/stdlib.h>
 #include <casacore/casa/iostream.h>
@@ -282,6 +283,86 @@ void sort_test_unique()
     cout << endl;
 }
 
+// Test that a partial sort gives the first part of a full sort.
+void sort_test_partial()
+{
+    const uInt nrdata = 1000;
+    Int data[nrdata];
+    Double data2[nrdata];
+    for (uInt i=0; i<nrdata; i++) {
+        data[i]  = rand() % 10;
+        data2[i] = (rand() % 100) / 10.;
+    }
+    Sort sort;
+    sort.sortKey (data,  TpInt, 0, Sort::Ascending);
+    sort.sortKey (data2, TpDouble, 0, Sort::Descending);
+    Vector<uInt> fullvec;
+    AlwaysAssertExit (sort.sort (fullvec, nrdata, Sort::QuickSort) == nrdata);
+    uInt nrsel[] = {0, 1, 17, 500, nrdata, 2*nrdata};
+    for (uInt n : nrsel) {
+        Vector<uInt> inxvec;
+        uInt nr = sort.partialSort (inxvec, nrdata, n);
+        AlwaysAssertExit (nr == std::min(n, nrdata)  &&  inxvec.size() == nr);
+        for (uInt i=0; i<nr; i++) {
+            // Equal keys have to be in original order.
+            AlwaysAssertExit (inxvec[i] == fullvec[i]);
+        }
+    }
+}
+
+// Test that a radix sort gives the same result as a quicksort.
+void sort_test_radix()
+{
+    const uInt nrdata = 5000;
+    Int    data1[nrdata];
+    uShort data2[nrdata];
+    Double data3[nrdata];
+    Int64  data4[nrdata];
+    Float  data5[nrdata];
+    Bool   data6[nrdata];
+    String data7[nrdata];
+    for (uInt i=0; i<nrdata; i++) {
+        data1[i] = rand() % 7 - 3;
+        data2[i] = rand() % 300;
+        data3[i] = (rand() % 200 - 100) / 10.;
+        data4[i] = Int64(rand() % 5 - 2) << 40;
+        data5[i] = (rand() % 20 - 10) / 4.;
+        data6[i] = rand() % 2;
+        data7[i] = String::toString (rand() % 10);
+    }
+    data3[0] = -0.;
+    data3[1] = 0.;
+    Sort::Order orders[] = {Sort::Ascending, Sort::Descending};
+    for (Sort::Order order : orders) {
+        Sort sort;
+        sort.sortKey (data1, TpInt, 0, order);
+        sort.sortKey (data2, TpUShort, 0, Sort::Ascending);
+        sort.sortKey (data3, TpDouble, 0, order);
+        sort.sortKey (data4, TpInt64, 0, Sort::Descending);
+        sort.sortKey (data5, TpFloat, 0, order);
+        sort.sortKey (data6, TpBool, 0, Sort::Ascending);
+        for (int nodup = 0; nodup <= Sort::NoDuplicates;
+             nodup += Sort::NoDuplicates) {
+            Vector<uInt> qvec, rvec;
+            uInt nq = sort.sort (qvec, nrdata, Sort::QuickSort | nodup);
+            uInt nr = sort.sort (rvec, nrdata, Sort::RadixSort | nodup);
+            AlwaysAssertExit (nq == nr);
+            AlwaysAssertExit (allEQ (qvec, rvec));
+        }
+        // A single key and a key which cannot be used in a radix sort.
+        Sort sort1;
+        sort1.sortKey (data2, TpUShort, 0, order);
+        Vector<uInt> qvec, rvec;
+        sort1.sort (qvec, nrdata, Sort::QuickSort, False);
+        sort1.sort (rvec, nrdata, Sort::RadixSort);
+        AlwaysAssertExit (allEQ (qvec, rvec));
+        sort1.sortKey (data7, TpString, 0, order);
+        sort1.sort (qvec, nrdata, Sort::QuickSort);
+        sort1.sort (rvec, nrdata, Sort::RadixSort);
+        AlwaysAssertExit (allEQ (qvec, rvec));
+    }
+}
+
 int main()
 {
     sortit (Sort::InsSort);
@@ -308,6 +389,8 @@ int main()
     sortall (Sort::HeapSort | Sort::NoDuplicates, Sort::Descending);
 
     sort_test_unique();
+    sort_test_partial();
+    sort_test_radix();
 
     return 0;                              // exit with success status
 }
@@ -178,6 +178,10 @@ Bool sortall (Int* arr, uInt nr, uInt type)
     if (! sortarr (arr, nr, Sort::HeapSort)) {
 	success = False;
     }
+    cout << "RadixSort ";
+    if (! sortarr (arr, nr, Sort::RadixSort)) {
+	success = False;
+    }
     Timer tim;
     uInt i;
     if (type==0 || (type==2 && nr<=10000) || (type==5 && nr<=20000)
@@ -321,6 +325,11 @@ Bool sort2 (uInt nr)
     sort.sort (inx1, vec1.size(), Sort::ParSort);
     cout << "parsort2  ";
     timer.show();
+    timer.mark();
+    Vector<uInt> inx2;
+    sort.sort (inx2, vec1.size(), Sort::RadixSort);
+    cout << "radixsort2";
+    timer.show();
   }
   {
     Timer timer;
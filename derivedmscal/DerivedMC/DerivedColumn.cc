@@ -25,15 +25,36 @@
 
 //# Includes
 #include <casacore/derivedmscal/DerivedMC/DerivedColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 
 namespace casacore {
 
+  // Get the row numbers of all rows in a column.
+  static Vector<rownr_t> allRows (rownr_t nrow)
+  {
+    Vector<rownr_t> rownrs(nrow);
+    indgen (rownrs);
+    return rownrs;
+  }
+
   HourangleColumn::~HourangleColumn()
   {}
   void HourangleColumn::get (rownr_t rowNr, Double& data)
   {
     data = itsEngine->getHA (itsAntNr, rowNr);
   }
+  void HourangleColumn::getScalarColumnV (ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getHA (itsAntNr, allRows(vec.size()), vec);
+  }
+  void HourangleColumn::getScalarColumnCellsV (const RefRows& rownrs,
+                                       ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getHA (itsAntNr, rownrs.convert(), vec);
+  }
 
   ParAngleColumn::~ParAngleColumn()
   {}
@@ -41,6 +62,17 @@ namespace casacore {
   {
     data = itsEngine->getPA (itsAntNr, rowNr);
   }
+  void ParAngleColumn::getScalarColumnV (ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getPA (itsAntNr, allRows(vec.size()), vec);
+  }
+  void ParAngleColumn::getScalarColumnCellsV (const RefRows& rownrs,
+                                       ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getPA (itsAntNr, rownrs.convert(), vec);
+  }
 
   LASTColumn::~LASTColumn()
   {}
@@ -48,6 +80,17 @@ namespace casacore {
   {
     data = itsEngine->getLAST (itsAntNr, rowNr);
   }
+  void LASTColumn::getScalarColumnV (ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getLAST (itsAntNr, allRows(vec.size()), vec);
+  }
+  void LASTColumn::getScalarColumnCellsV (const RefRows& rownrs,
+                                       ArrayBase& data)
+  {
+    Vector<Double>& vec = static_cast<Vector<Double>&>(data);
+    itsEngine->getLAST (itsAntNr, rownrs.convert(), vec);
+  }
 
   HaDecColumn::~HaDecColumn()
   {}
@@ -63,6 +106,17 @@ namespace casacore {
   {
     itsEngine->getHaDec (itsAntNr, rowNr, data);
   }
+  void HaDecColumn::getArrayColumn (Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getHaDec (itsAntNr, allRows(mat.ncolumn()), mat);
+  }
+  void HaDecColumn::getArrayColumnCells (const RefRows& rownrs,
+                                     Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getHaDec (itsAntNr, rownrs.convert(), mat);
+  }
 
   AzElColumn::~AzElColumn()
   {}
@@ -78,6 +132,17 @@ namespace casacore {
   {
     itsEngine->getAzEl (itsAntNr, rowNr, data);
   }
+  void AzElColumn::getArrayColumn (Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getAzEl (itsAntNr, allRows(mat.ncolumn()), mat);
+  }
+  void AzElColumn::getArrayColumnCells (const RefRows& rownrs,
+                                     Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getAzEl (itsAntNr, rownrs.convert(), mat);
+  }
 
   ItrfColumn::~ItrfColumn()
   {}
@@ -93,6 +158,17 @@ namespace casacore {
   {
     itsEngine->getItrf (itsAntNr, rowNr, data);
   }
+  void ItrfColumn::getArrayColumn (Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getItrf (itsAntNr, allRows(mat.ncolumn()), mat);
+  }
+  void ItrfColumn::getArrayColumnCells (const RefRows& rownrs,
+                                     Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getItrf (itsAntNr, rownrs.convert(), mat);
+  }
 
   UVWJ2000Column::~UVWJ2000Column()
   {}
@@ -108,5 +184,16 @@ namespace casacore {
   {
     itsEngine->getNewUVW (False, rowNr, data);
   }
+  void UVWJ2000Column::getArrayColumn (Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getNewUVW (False, allRows(mat.ncolumn()), mat);
+  }
+  void UVWJ2000Column::getArrayColumnCells (const RefRows& rownrs,
+                                     Array<Double>& data)
+  {
+    Matrix<Double> mat(data);
+    itsEngine->getNewUVW (False, rownrs.convert(), mat);
+  }
 
 } //# end namespace
@@ -47,6 +47,9 @@ namespace casacore {
     {}
     virtual ~HourangleColumn();
     virtual void get (rownr_t rowNr, Double& data);
+    virtual void getScalarColumnV (ArrayBase& data);
+    virtual void getScalarColumnCellsV (const RefRows& rownrs,
+                                        ArrayBase& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# -1=array 0=antenna1 1=antenna2
@@ -64,6 +67,9 @@ namespace casacore {
     {}
     virtual ~LASTColumn();
     virtual void get (rownr_t rowNr, Double& data);
+    virtual void getScalarColumnV (ArrayBase& data);
+    virtual void getScalarColumnCellsV (const RefRows& rownrs,
+                                        ArrayBase& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# -1=array 0=antenna1 1=antenna2
@@ -81,6 +87,9 @@ namespace casacore {
     {}
     virtual ~ParAngleColumn();
     virtual void get (rownr_t rowNr, Double& data);
+    virtual void getScalarColumnV (ArrayBase& data);
+    virtual void getScalarColumnCellsV (const RefRows& rownrs,
+                                        ArrayBase& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# 0=antenna1 1=antenna2
@@ -100,6 +109,9 @@ namespace casacore {
     virtual IPosition shape (rownr_t rownr);
     virtual Bool isShapeDefined (rownr_t rownr);
     virtual void getArray (rownr_t rowNr, Array<Double>& data);
+    virtual void getArrayColumn (Array<Double>& data);
+    virtual void getArrayColumnCells (const RefRows& rownrs,
+                                      Array<Double>& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# 0=antenna1 1=antenna2
@@ -119,6 +131,9 @@ namespace casacore {
     virtual IPosition shape (rownr_t rownr);
     virtual Bool isShapeDefined (rownr_t rownr);
     virtual void getArray (rownr_t rowNr, Array<Double>& data);
+    virtual void getArrayColumn (Array<Double>& data);
+    virtual void getArrayColumnCells (const RefRows& rownrs,
+                                      Array<Double>& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# 0=antenna1 1=antenna2
@@ -138,6 +153,9 @@ namespace casacore {
     virtual IPosition shape (rownr_t rownr);
     virtual Bool isShapeDefined (rownr_t rownr);
     virtual void getArray (rownr_t rowNr, Array<Double>& data);
+    virtual void getArrayColumn (Array<Double>& data);
+    virtual void getArrayColumnCells (const RefRows& rownrs,
+                                      Array<Double>& data);
   private:
     MSCalEngine* itsEngine;
     Int          itsAntNr;    //# 0=antenna1 1=antenna2
@@ -156,6 +174,9 @@ namespace casacore {
     virtual IPosition shape (rownr_t rownr);
     virtual Bool isShapeDefined (rownr_t rownr);
     virtual void getArray (rownr_t rowNr, Array<Double>& data);
+    virtual void getArrayColumn (Array<Double>& data);
+    virtual void getArrayColumnCells (const RefRows& rownrs,
+                                      Array<Double>& data);
   private:
     MSCalEngine* itsEngine;
   };
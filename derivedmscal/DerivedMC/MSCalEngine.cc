@@ -39,6 +39,8 @@
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/tables/Tables/RefRows.h>
 
 
 namespace casacore {
@@ -116,31 +118,30 @@ void MSCalEngine::getNewUVW (Bool asApp, rownr_t rownr, Array<double>& data)
   if (ant1 == ant2) {
     data = 0.;
   } else {
-    vector<MBaseline>& antMB        = itsAntMB[itsLastCalInx];
-    vector<Vector<Double> >& antUvw = itsAntUvw[itsLastCalInx];
-    Block<Bool>& uvwFilled          = itsUvwFilled[itsLastCalInx];
     // Calculate UVW per antenna and subtract to get baseline.
-    // Only calculate for an antenna if not done yet.
-    Int ant = ant1;
-    for (int i=0; i<2; ++i) {
-      if (!uvwFilled[ant]) {
-        itsBLToJ2000.setModel (antMB[ant]);
-        MVBaseline bas = itsBLToJ2000().getValue();
-        MVuvw jvguvw(bas, itsLastDirJ2000.getValue());
-        if (asApp) {
-          antUvw[ant] = Muvw::Convert(Muvw(jvguvw, Muvw::J2000),
-                                      Muvw::Ref(Muvw::APP, itsFrame))
-            ().getValue().getVector();
-        } else {
-          antUvw[ant] = Muvw(jvguvw, Muvw::J2000).getValue().getVector();
-        }
-        uvwFilled[ant] = true;
-      }
-      ant = ant2;
-    }
     // The UVW of the baseline is the difference of the antennae UVW.
-    data = antUvw[ant2] - antUvw[ant1];
+    data = getAntUVW (asApp, ant2) - getAntUVW (asApp, ant1);
+  }
+}
+
+const Vector<Double>& MSCalEngine::getAntUVW (Bool asApp, Int ant)
+{
+  Vector<Double>& antUvw = itsAntUvw[itsLastCalInx][ant];
+  Bool& uvwFilled = itsUvwFilled[itsLastCalInx][ant];
+  if (!uvwFilled) {
+    itsBLToJ2000.setModel (itsAntMB[itsLastCalInx][ant]);
+    MVBaseline bas = itsBLToJ2000().getValue();
+    MVuvw jvguvw(bas, itsLastDirJ2000.getValue());
+    if (asApp) {
+      antUvw = Muvw::Convert(Muvw(jvguvw, Muvw::J2000),
+                             Muvw::Ref(Muvw::APP, itsFrame))
+        ().getValue().getVector();
+    } else {
+      antUvw = Muvw(jvguvw, Muvw::J2000).getValue().getVector();
+    }
+    uvwFilled = true;
   }
+  return antUvw;
 }
 
 double MSCalEngine::getDelay (Int antnr, rownr_t rownr)
@@ -170,6 +171,219 @@ double MSCalEngine::getDelay (Int antnr, rownr_t rownr)
   return (d1-d2) / C::c;
 }
 
+void MSCalEngine::getHA (Int antnr, const Vector<rownr_t>& rownrs,
+                         Vector<Double>& data)
+{
+  data.resize (rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs);
+    Double value = itsRADecToHADec().getValue().get()[0];
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data[groups.index[i]] = value;
+    }
+  }
+}
+
+void MSCalEngine::getHaDec (Int antnr, const Vector<rownr_t>& rownrs,
+                            Matrix<Double>& data)
+{
+  data.resize (2, rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs);
+    Vector<Double> value = itsRADecToHADec().getValue().get();
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data.column(groups.index[i]) = value;
+    }
+  }
+}
+
+void MSCalEngine::getPA (Int antnr, const Vector<rownr_t>& rownrs,
+                         Vector<Double>& data)
+{
+  data.resize (rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    Int mount = setGroup (groups, g, rownrs);
+    Double value = 0.;
+    if (mount == 1) {
+      value = itsRADecToAzEl().getValue().positionAngle
+        (itsPoleToAzEl().getValue());
+    }
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data[groups.index[i]] = value;
+    }
+  }
+}
+
+void MSCalEngine::getLAST (Int antnr, const Vector<rownr_t>& rownrs,
+                           Vector<Double>& data)
+{
+  data.resize (rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs);
+    Double value = itsUTCToLAST().getValue().get();
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data[groups.index[i]] = value;
+    }
+  }
+}
+
+void MSCalEngine::getAzEl (Int antnr, const Vector<rownr_t>& rownrs,
+                           Matrix<Double>& data)
+{
+  data.resize (2, rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs);
+    Vector<Double> value = itsRADecToAzEl().getValue().get();
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data.column(groups.index[i]) = value;
+    }
+  }
+}
+
+void MSCalEngine::getItrf (Int antnr, const Vector<rownr_t>& rownrs,
+                           Matrix<Double>& data)
+{
+  data.resize (2, rownrs.size());
+  RowGroups groups;
+  groupRows (antnr, rownrs, groups);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs);
+    Vector<Double> value = itsRADecToItrf().getValue().get();
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      data.column(groups.index[i]) = value;
+    }
+  }
+}
+
+void MSCalEngine::getNewUVW (Bool asApp, const Vector<rownr_t>& rownrs,
+                             Matrix<Double>& data)
+{
+  data.resize (3, rownrs.size());
+  RowGroups groups;
+  groupRows (-1, rownrs, groups);
+  RefRows rows(rownrs);
+  Vector<Int> ant1 = itsAntCol[0].getColumnCells (rows);
+  Vector<Int> ant2 = itsAntCol[1].getColumnCells (rows);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs, True);
+    // The antenna UVWs depend on field and time, so recalculate them
+    // for each group (the field can change without the time changing).
+    itsUvwFilled[itsLastCalInx] = False;
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      rownr_t inx = groups.index[i];
+      Vector<Double> uvw (data.column(inx));
+      if (ant1[inx] == ant2[inx]) {
+        uvw = 0.;
+      } else {
+        uvw = getAntUVW (asApp, ant2[inx]) - getAntUVW (asApp, ant1[inx]);
+      }
+    }
+  }
+}
+
+void MSCalEngine::getDelay (Int antnr, const Vector<rownr_t>& rownrs,
+                            Vector<Double>& data)
+{
+  data.resize (rownrs.size());
+  RowGroups groups;
+  groupRows (-1, rownrs, groups);
+  RefRows rows(rownrs);
+  Vector<Int> ant1 = itsAntCol[0].getColumnCells (rows);
+  Vector<Int> ant2 = itsAntCol[1].getColumnCells (rows);
+  for (rownr_t g=0; g<groups.ngroup; ++g) {
+    setGroup (groups, g, rownrs, True);
+    // Get the direction in ITRF xyz.
+    Vector<double> itrf = itsRADecToItrf().getValue().getValue();
+    const vector<MPosition>& antPos = itsAntPos[itsLastCalInx];
+    for (rownr_t i=groups.starts[g]; i<groups.end(g); ++i) {
+      rownr_t inx = groups.index[i];
+      AlwaysAssert (ant1[inx] < Int(antPos.size()), AipsError);
+      AlwaysAssert (ant2[inx] < Int(antPos.size()), AipsError);
+      // Delay (in meters) is inproduct (subtract array center position).
+      const Vector<double>& ap1 = antPos[ant1[inx]].getValue().getValue();
+      const Vector<double>& ap2 = antPos[ant2[inx]].getValue().getValue();
+      double d1 = (itrf[0] * (ap1[0] - itsArrayItrf[0]) +
+                   itrf[1] * (ap1[1] - itsArrayItrf[1]) +
+                   itrf[2] * (ap1[2] - itsArrayItrf[2]));
+      double d2 = (itrf[0] * (ap2[0] - itsArrayItrf[0]) +
+                   itrf[1] * (ap2[1] - itsArrayItrf[1]) +
+                   itrf[2] * (ap2[2] - itsArrayItrf[2]));
+      if (antnr == 0) {
+        data[inx] = d1 / C::c;
+      } else if (antnr == 1) {
+        data[inx] = d2 / C::c;
+      } else {
+        data[inx] = (d1-d2) / C::c;
+      }
+    }
+  }
+}
+
+void MSCalEngine::groupRows (Int antnr, const Vector<rownr_t>& rownrs,
+                             RowGroups& groups)
+{
+  // Initialize if not done yet.
+  if (itsLastCalInx < 0) {
+    init();
+  }
+  rownr_t nrow = rownrs.size();
+  groups.ngroup = 0;
+  if (nrow == 0) {
+    return;
+  }
+  // Read the keys of all rows at once.
+  RefRows rows(rownrs);
+  if (itsCalCol.isNull()) {
+    groups.calIds.resize (nrow);
+    groups.calIds = 0;
+  } else {
+    groups.calIds.reference (itsCalCol.getColumnCells (rows));
+  }
+  if (antnr < 0) {
+    groups.antIds.resize (nrow);
+    groups.antIds = -1;
+  } else {
+    groups.antIds.reference (itsAntCol[antnr].getColumnCells (rows));
+  }
+  if (itsReadFieldDir) {
+    groups.fieldIds.reference (itsFieldCol.getColumnCells (rows));
+  } else {
+    groups.fieldIds.resize (nrow);
+    groups.fieldIds = 0;
+  }
+  groups.times.reference (itsTimeCol.getColumnCells (rows));
+  // Sort on time first (after CAL_DESC_ID), so the epoch in the frame
+  // changes as little as possible.
+  Sort sort;
+  sort.sortKey (groups.calIds.data(), TpInt);
+  sort.sortKey (groups.times.data(), TpDouble);
+  sort.sortKey (groups.fieldIds.data(), TpInt);
+  if (antnr >= 0) {
+    sort.sortKey (groups.antIds.data(), TpInt);
+  }
+  sort.sort (groups.index, nrow);
+  groups.ngroup = sort.unique (groups.starts, groups.index);
+}
+
+Int MSCalEngine::setGroup (const RowGroups& groups, rownr_t group,
+                           const Vector<rownr_t>& rownrs, Bool fillAnt)
+{
+  rownr_t inx = groups.index[groups.starts[group]];
+  return setData (groups.calIds[inx], groups.antIds[inx],
+                  groups.fieldIds[inx], groups.times[inx],
+                  rownrs[inx], fillAnt);
+}
+
 void MSCalEngine::setDirection (const MDirection& dir)
 {
   // Direction is explicitly given, so do not read from FIELD table.
@@ -191,11 +405,28 @@ Int MSCalEngine::setData (Int antnr, rownr_t rownr, Bool fillAnt)
   if (itsLastCalInx < 0) {
     init();
   }
-  // Get the CAL_DESC_ID (if present).
-  Int calInx = 0;
+  // Get the CAL_DESC_ID (if present), antenna and field id from the table.
   Int calDescId = 0;
   if (! itsCalCol.isNull()) {
     calDescId = itsCalCol(rownr);
+  }
+  Int antId = -1;
+  if (antnr >= 0) {
+    antId = itsAntCol[antnr](rownr);
+  }
+  Int fieldId = 0;
+  if (itsReadFieldDir) {
+    fieldId = itsFieldCol(rownr);
+  }
+  return setData (calDescId, antId, fieldId, itsTimeCol(rownr),
+                  rownr, fillAnt);
+}
+
+Int MSCalEngine::setData (Int calDescId, Int antId, Int fieldId, Double time,
+                          rownr_t rownr, Bool fillAnt)
+{
+  Int calInx = 0;
+  if (! itsCalCol.isNull()) {
     // Update the CAL_DESC info if needed.
     if (calDescId >= Int(itsCalIdMap.size())) {
       fillCalDesc();
@@ -212,21 +443,19 @@ Int MSCalEngine::setData (Int antnr, rownr_t rownr, Bool fillAnt)
   // Get the array or antenna position and put into the measure frame.
   // Also get mount type (alt-az or other).
   Int mount = 0;
-  if (antnr < 0) {
+  if (antId < 0) {
     // Set the frame's array position if needed.
-    if (antnr != itsLastAntId) {
+    if (antId != itsLastAntId) {
       itsFrame.resetPosition (itsArrayPos);
-      itsLastAntId = antnr;
+      itsLastAntId = antId;
     }
     if (fillAnt  &&  itsAntPos[calInx].empty()) {
       fillAntPos (calDescId, calInx);
     }
   } else {
-    // Get the antenna id from the table.
     // Update the antenna positions if a higher antenna id is found.
     // In practice this will not happen, but it is possible that the ANTENNA
     // table was not fully filled yet.
-    Int antId = itsAntCol[antnr](rownr);
     if (antId != itsLastAntId) {
       if (itsAntPos[calInx].empty()) {
         fillAntPos (calDescId, calInx);
@@ -238,11 +467,7 @@ Int MSCalEngine::setData (Int antnr, rownr_t rownr, Bool fillAnt)
     mount = itsMount[calInx][antId];
   }
   // If needed, get the direction and put into the measure frame.
-  // Get field id from the table; update the field positions if needed.
-  Int fieldId = 0;
-  if (itsReadFieldDir) {
-    fieldId = itsFieldCol(rownr);
-  }
+  // Update the field positions if needed.
   if (fieldId != itsLastFieldId) {
     if (fieldId >= Int(itsFieldDir[calInx].size())) {
       fillFieldDir (calDescId, calInx);
@@ -266,7 +491,6 @@ Int MSCalEngine::setData (Int antnr, rownr_t rownr, Bool fillAnt)
     itsLastFieldId = fieldId;
   }
   // Set the epoch in the measure frame.
-  Double time = itsTimeCol(rownr);
   if (time != itsLastTime) {
     MEpoch epoch = itsTimeMeasCol(rownr);
     itsFrame.resetEpoch (epoch);
@@ -36,6 +36,7 @@
 #include <casacore/measures/Measures/MBaseline.h>
 #include <casacore/measures/Measures/MeasConvert.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
+#include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/vector.h>
 #include <casacore/casa/stdmap.h>
 
@@ -102,6 +103,15 @@ namespace casacore {
 // The engine can also be used for old CASA Calibration Tables. It understands
 // how they reference the MeasurementSets. Because these calibration tables
 // contain no ANTENNA2 columns, columns XX2 are the same as XX1.
+//
+// Besides getting the value for a single row, the values can be obtained
+// for a batch of rows. The rows are grouped on CAL_DESC_ID, TIME, FIELD_ID
+// and antenna (if needed), so the measure frame is set and the direction
+// conversion is done once per group instead of once per row. Because
+// a typical MS has many baselines per time stamp, this is much faster
+// than getting the values row by row. The DerivedMSCal virtual columns
+// and the MSCAL TaQL functions use the batch functions when the values
+// of multiple rows are asked for.
 // </synopsis>
 
 // <motivation>
@@ -159,7 +169,35 @@ public:
   // Get the delay for the given row.
   double getDelay (Int antnr, rownr_t rownr);
 
+  // Get the values for the given rows. The result is resized as needed.
+  // The array values are stored as the columns of a Matrix
+  // (2 values for HaDec, AzEl and Itrf; 3 values for UVW).
+  // <group>
+  void getHA     (Int antnr, const Vector<rownr_t>& rownrs, Vector<Double>&);
+  void getHaDec  (Int antnr, const Vector<rownr_t>& rownrs, Matrix<Double>&);
+  void getPA     (Int antnr, const Vector<rownr_t>& rownrs, Vector<Double>&);
+  void getLAST   (Int antnr, const Vector<rownr_t>& rownrs, Vector<Double>&);
+  void getAzEl   (Int antnr, const Vector<rownr_t>& rownrs, Matrix<Double>&);
+  void getItrf   (Int antnr, const Vector<rownr_t>& rownrs, Matrix<Double>&);
+  void getNewUVW (Bool asApp, const Vector<rownr_t>& rownrs, Matrix<Double>&);
+  void getDelay  (Int antnr, const Vector<rownr_t>& rownrs, Vector<Double>&);
+  // </group>
+
 private:
+  // The keys of the rows in a batch and the groups of equal keys.
+  struct RowGroups {
+    Vector<Int>     calIds;     //# CAL_DESC_ID (0 if not present)
+    Vector<Int>     antIds;     //# -1 if array position is used
+    Vector<Int>     fieldIds;
+    Vector<Double>  times;
+    Vector<rownr_t> index;      //# row indices in key order
+    Vector<rownr_t> starts;     //# start of each group in index
+    rownr_t         ngroup;
+    // Get the end of a group in index.
+    rownr_t end (rownr_t group) const
+      { return group+1 < ngroup  ?  starts[group+1] : index.size(); }
+  };
+
   // Copy constructor cannot be used.
   MSCalEngine (const MSCalEngine& that);
 
@@ -171,6 +209,23 @@ private:
   // It returns the mount of the antenna.
   Int setData (Int antnr, rownr_t rownr, Bool fillAnt=False);
 
+  // Set the data for the given CAL_DESC_ID, antenna (<0 is array position),
+  // field and time. The row number is used to get the epoch as a measure.
+  Int setData (Int calDescId, Int antId, Int fieldId, Double time,
+               rownr_t rownr, Bool fillAnt);
+
+  // Read the keys of the given rows and group the rows with equal keys.
+  // The antenna is only part of the key if antnr>=0.
+  void groupRows (Int antnr, const Vector<rownr_t>& rownrs, RowGroups&);
+
+  // Set the data for the given group. It returns the mount of the antenna.
+  Int setGroup (const RowGroups&, rownr_t group,
+                const Vector<rownr_t>& rownrs, Bool fillAnt=False);
+
+  // Calculate the UVW (in J2000 or APP) of the given antenna for the
+  // current data if not calculated yet.
+  const Vector<Double>& getAntUVW (Bool asApp, Int ant);
+
   // Initialize the column objects, etc.
   void init();
 
@@ -203,6 +203,7 @@ namespace casacore {
     case LAST:
       setNDim (0);
       setUnit ("rad");
+      setBatch (True);
       break;
     case HADEC:
     case AZEL:
@@ -210,6 +211,7 @@ namespace casacore {
       setShape (IPosition(1,2));
       itsTmpVector.resize (2);
       setUnit ("rad");
+      setBatch (True);
       break;
     case UVWWVL:
       setupWvls (table, operands(), 0);
@@ -225,6 +227,7 @@ namespace casacore {
       setUnit ("m");
       setShape (IPosition(1,3));
       itsTmpVector.resize (3);
+      setBatch (True);
       break;
     case NEWUVWWVL:
       setupWvls (table, operands(), 1);
@@ -239,6 +242,7 @@ namespace casacore {
     case DELAY:
       setNDim (0);
       setUnit ("s");
+      setBatch (True);
       break;
     case STOKES:
       setupStokes (table, operands());
@@ -905,6 +909,54 @@ namespace casacore {
     }
   }
 
+  void UDFMSCal::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Double* result)
+  {
+    Vector<Double> values (IPosition(1, rownrs.size()), result, SHARE);
+    switch (itsType) {
+    case HA:
+      itsEngine.getHA (itsArg, rownrs, values);
+      break;
+    case PA:
+      itsEngine.getPA (itsArg, rownrs, values);
+      break;
+    case LAST:
+      itsEngine.getLAST (itsArg, rownrs, values);
+      break;
+    case DELAY:
+      itsEngine.getDelay (itsArg, rownrs, values);
+      break;
+    default:
+      UDFBase::getDoubleBatch (rownrs, result);
+    }
+  }
+
+  void UDFMSCal::getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                      MArray<Double>* result)
+  {
+    Matrix<Double> values;
+    switch (itsType) {
+    case HADEC:
+      itsEngine.getHaDec (itsArg, rownrs, values);
+      break;
+    case AZEL:
+      itsEngine.getAzEl (itsArg, rownrs, values);
+      break;
+    case ITRF:
+      itsEngine.getItrf (itsArg, rownrs, values);
+      break;
+    case NEWUVW:
+      itsEngine.getNewUVW (itsArg, rownrs, values);
+      break;
+    default:
+      UDFBase::getArrayDoubleBatch (rownrs, result);
+      return;
+    }
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      result[i] = MArray<Double> (values.column(i).copy());
+    }
+  }
+
   MArray<DComplex> UDFMSCal::getArrayDComplex (const TableExprId& id)
   {
     switch (itsType) {
@@ -201,6 +201,14 @@ namespace casacore {
     virtual MArray<DComplex> getArrayDComplex (const TableExprId& id);
     virtual MArray<String>   getArrayString   (const TableExprId& id);
 
+    // Get the values for a block of rows.
+    // It is only used for the functions handled by the MSCalEngine,
+    // which calculates the values per unique time, field and antenna.
+    virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Double* result);
+    virtual void getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                      MArray<Double>* result);
+
     // Let a derived class recreate its column objects in case a selection
     // has to be applied.
     virtual void recreateColumnObjects (const Vector<rownr_t>& rownrs);
@@ -35,6 +35,8 @@
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/OS/Timer.h>
@@ -111,6 +113,43 @@ void check (uInt rownr,
   AlwaysAssertExit (uvwJ2000.isDefined(rownr));
 }
 
+// Get the values of a column at once and compare with the values per row.
+void checkColumn (ScalarColumn<Double>& col)
+{
+  rownr_t nrow = col.nrow();
+  Vector<Double> all = col.getColumn();
+  Vector<rownr_t> rownrs((nrow+1)/2);
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    rownrs[i] = nrow - 1 - 2*i;
+  }
+  Vector<Double> cells = col.getColumnCells (RefRows(rownrs));
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (nearAbs(all[i], col(i), 1e-10));
+  }
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (nearAbs(cells[i], col(rownrs[i]), 1e-10));
+  }
+}
+
+void checkColumn (ArrayColumn<Double>& col)
+{
+  rownr_t nrow = col.nrow();
+  Array<Double> all = col.getColumn();
+  Vector<rownr_t> rownrs((nrow+1)/2);
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    rownrs[i] = nrow - 1 - 2*i;
+  }
+  Array<Double> cells = col.getColumnCells (RefRows(rownrs));
+  Matrix<Double> allm(all);
+  Matrix<Double> cellm(cells);
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (allNearAbs(allm.column(i), col(i), 1e-8));
+  }
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (allNearAbs(cellm.column(i), col(rownrs[i]), 1e-8));
+  }
+}
+
 int main(int argc, char* argv[])
 {
   try {
@@ -199,7 +238,7 @@ int main(int argc, char* argv[])
     mdv.setObservatoryPosition (arrayPos);
     // Now loop through quite some rows and compare result of DerivedMSCal
     // with MSDerivedValues.
-    rownr_t nr = std::max(tab.nrow(), rownr_t(1000));
+    rownr_t nr = std::min(tab.nrow(), rownr_t(1000));
     Int lastFldId = -1;
     for (rownr_t i=0; i<nr; ++i) {
       Int fldId = fld(i);
@@ -218,6 +257,16 @@ int main(int argc, char* argv[])
         check (i, uvw, uvwJ2000);
       }
     }
+    // Check that getting the values of many rows at once (which does the
+    // conversions once per time/field/antenna) gives the same results.
+    checkColumn (ha);
+    checkColumn (ha1);
+    checkColumn (pa2);
+    checkColumn (last1);
+    checkColumn (azel);
+    checkColumn (azel2);
+    checkColumn (itrf);
+    checkColumn (uvwJ2000);
     // Now time getting the hourangle using DataMan and MSDerivedValues.
     double totha = 0;
     Timer timer;
@@ -225,6 +274,9 @@ int main(int argc, char* argv[])
       totha += ha(i);
     }
     timer.show ("DataMan  ha");
+    timer.mark();
+    totha = sum(ha.getColumn());
+    timer.show ("Column   ha");
     totha = 0;
     timer.mark();
     for (uInt i=0; i<tab.nrow(); ++i) {
@@ -243,6 +295,9 @@ int main(int argc, char* argv[])
       uvwJ2000(i);
     }
     timer.show ("DataMan uvw");
+    timer.mark();
+    uvwJ2000.getColumn();
+    timer.show ("Column  uvw");
     if (! uvw.isNull()) {
       timer.mark();
       for (uInt i=0; i<tab.nrow(); ++i) {
@@ -27,12 +27,15 @@
 #include <casacore/meas/MeasUDF/EpochEngine.h>
 #include <casacore/meas/MeasUDF/PositionEngine.h>
 #include <casacore/tables/TaQL/ExprUnitNode.h>
+#include <map>
 
 namespace casacore {
 
   DirectionEngine::DirectionEngine()
     : itsEpochEngine    (0),
-      itsPositionEngine (0)
+      itsPositionEngine (0),
+      itsFrameEpochSet  (False),
+      itsFramePosSet    (False)
   {}
 
   DirectionEngine::~DirectionEngine()
@@ -289,6 +292,105 @@ namespace casacore {
     itsConverter = MDirection::Convert (toType, ref);
   }
 
+  void DirectionEngine::setFrameEpoch (const MEpoch& epoch)
+  {
+    // Resetting the frame clears the values cached by the conversion
+    // (e.g. precession and nutation), so only do it if the epoch changes.
+    // In a MeasurementSet many consecutive rows have the same time.
+    const MVEpoch& mve = epoch.getValue();
+    if (itsFrameEpochSet  &&  epoch.getRef().offset() == 0
+        &&  epoch.getRef().getType() == itsFrameEpoch.getRef().getType()
+        &&  mve.getDay() == itsFrameEpoch.getValue().getDay()
+        &&  mve.getDayFraction() == itsFrameEpoch.getValue().getDayFraction()) {
+      return;
+    }
+    itsFrame.resetEpoch (epoch);
+    itsFrameEpoch    = epoch;
+    itsFrameEpochSet = (epoch.getRef().offset() == 0);
+  }
+
+  void DirectionEngine::setFramePosition (const MPosition& pos)
+  {
+    const Vector<Double>& xyz = pos.getValue().getValue();
+    if (itsFramePosSet  &&  pos.getRef().offset() == 0
+        &&  pos.getRef().getType() == itsFramePos.getRef().getType()) {
+      const Vector<Double>& last = itsFramePos.getValue().getValue();
+      if (xyz[0] == last[0]  &&  xyz[1] == last[1]  &&  xyz[2] == last[2]) {
+        return;
+      }
+    }
+    itsFrame.resetPosition (pos);
+    itsFramePos    = pos;
+    itsFramePosSet = (pos.getRef().offset() == 0);
+  }
+
+  void DirectionEngine::getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                             Bool riseSet, Bool asDirCos,
+                                             MArray<Double>* result)
+  {
+    // Group the rows on their directions, epochs and positions (e.g. all
+    // baselines of a time slot of a MeasurementSet), so the conversion
+    // is done only once per group. The other rows get a copy of the result.
+    std::map<std::vector<Double>, rownr_t> groups;
+    std::vector<Double> key;
+    Array<MDirection> dirs;
+    Array<MEpoch> eps;
+    Array<MPosition> pos;
+    TableExprId id;
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      id.setRownr (rownrs[i]);
+      getMeasures (id, dirs, eps, pos);
+      if (makeKey (dirs, eps, pos, key)) {
+        auto iter = groups.find (key);
+        if (iter != groups.end()) {
+          result[i] = MArray<Double> (result[iter->second].array().copy());
+          continue;
+        }
+        groups[key] = i;
+      }
+      result[i] = MArray<Double> (convert (dirs, eps, pos, riseSet, asDirCos));
+    }
+  }
+
+  Bool DirectionEngine::makeKey (const Array<MDirection>& dirs,
+                                 const Array<MEpoch>& eps,
+                                 const Array<MPosition>& pos,
+                                 std::vector<Double>& key) const
+  {
+    // The shapes are part of the key, because they define the result shape.
+    key.clear();
+    for (const IPosition& shape : {dirs.shape(), eps.shape(), pos.shape()}) {
+      key.push_back (shape.size());
+      key.insert (key.end(), shape.begin(), shape.end());
+    }
+    // A measure with an offset cannot be compared, so is not grouped.
+    for (const MDirection& dir : dirs) {
+      if (dir.getRef().offset() != 0) {
+        return False;
+      }
+      const Vector<Double>& v = dir.getValue().getValue();
+      key.push_back (dir.getRef().getType());
+      key.insert (key.end(), v.begin(), v.end());
+    }
+    for (const MEpoch& ep : eps) {
+      if (ep.getRef().offset() != 0) {
+        return False;
+      }
+      key.push_back (ep.getRef().getType());
+      key.push_back (ep.getValue().getDay());
+      key.push_back (ep.getValue().getDayFraction());
+    }
+    for (const MPosition& p : pos) {
+      if (p.getRef().offset() != 0) {
+        return False;
+      }
+      const Vector<Double>& v = p.getValue().getValue();
+      key.push_back (p.getRef().getType());
+      key.insert (key.end(), v.begin(), v.end());
+    }
+    return True;
+  }
+
   Array<MDirection> DirectionEngine::getDirections (const TableExprId& id)
   {
     if (itsConstants.size() > 0) {
@@ -302,21 +404,41 @@ namespace casacore {
     return directions;
   }
 
-  Array<Double> DirectionEngine::getArrayDouble (const TableExprId& id,
-                                                 Bool riseSet, Bool asDirCos)
+  void DirectionEngine::getMeasures (const TableExprId& id,
+                                     Array<MDirection>& dirs,
+                                     Array<MEpoch>& eps,
+                                     Array<MPosition>& pos)
   {
     DebugAssert (id.byRow(), AipsError);
-    Array<MDirection> res (getDirections(id));
+    dirs.reference (getDirections(id));
     // Get epochs and positions if given.
-    Array<MEpoch> eps(IPosition(1,1));
     if (itsEpochEngine) {
-      Array<MEpoch> arr = itsEpochEngine->getEpochs (id);
       eps.reference (itsEpochEngine->getEpochs (id));
+    } else {
+      eps.reference (Array<MEpoch>(IPosition(1,1)));
     }
-    Array<MPosition> pos(IPosition(1,1));
     if (itsPositionEngine) {
       pos.reference (itsPositionEngine->getPositions (id));
+    } else {
+      pos.reference (Array<MPosition>(IPosition(1,1)));
     }
+  }
+
+  Array<Double> DirectionEngine::getArrayDouble (const TableExprId& id,
+                                                 Bool riseSet, Bool asDirCos)
+  {
+    Array<MDirection> res;
+    Array<MEpoch> eps;
+    Array<MPosition> pos;
+    getMeasures (id, res, eps, pos);
+    return convert (res, eps, pos, riseSet, asDirCos);
+  }
+
+  Array<Double> DirectionEngine::convert (const Array<MDirection>& res,
+                                          const Array<MEpoch>& eps,
+                                          const Array<MPosition>& pos,
+                                          Bool riseSet, Bool asDirCos)
+  {
     // Convert the direction to the given type for all epochs and positions.
     Array<Double> out;
     if (res.size() > 0  &&  eps.size() > 0  &&  pos.size() > 0) {
@@ -334,13 +456,13 @@ namespace casacore {
            posIter != pos.cend(); ++posIter) {
         // Convert to desired position.
         if (itsPositionEngine) {
-          itsFrame.resetPosition (*posIter);
+          setFramePosition (*posIter);
         }
         for (Array<MEpoch>::const_contiter epsIter = eps.cbegin();
            epsIter != eps.cend(); ++epsIter) {
           // Convert to desired epoch.
           if (itsEpochEngine) {
-            itsFrame.resetEpoch (*epsIter);
+            setFrameEpoch (*epsIter);
           }
           uInt hIndex = 0;
           for (Array<MDirection>::const_contiter resIter = res.cbegin();
@@ -426,6 +548,7 @@ namespace casacore {
                                     double* rise, double* set)
   {
     itsFrame.set (MEpoch(Quantity(epoch, "d"), MEpoch::UTC));
+    itsFrameEpochSet = False;
     MDirection::Ref ref2(MDirection::HADEC, itsFrame);
     MDirection hd = MDirection::Convert(MDirection::HADEC, ref2) (dir);
     double dec = hd.getValue().get()[1];
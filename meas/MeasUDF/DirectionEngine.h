@@ -30,8 +30,12 @@
 #include <casacore/casa/aips.h>
 #include<casacore/meas/MeasUDF/MeasEngine.h>
 #include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
 #include <casacore/measures/Measures/MCDirection.h>
 #include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/tables/TaQL/MArray.h>
+#include <vector>
 
 namespace casacore {
 
@@ -149,6 +153,12 @@ namespace casacore {
     Array<Double> getArrayDouble (const TableExprId& id, Bool riseSet,
                                   Bool asDirCos);
 
+    // Get the values for the given rows.
+    // Rows with the same directions, epochs and positions (e.g. all
+    // baselines of a time slot) are converted only once.
+    void getArrayDoubleBatch (const Vector<rownr_t>& rownrs, Bool riseSet,
+                              Bool asDirCos, MArray<Double>* result);
+
     // Get the directions.
     Array<MDirection> getDirections (const TableExprId& id);
 
@@ -176,6 +186,30 @@ namespace casacore {
                                const TableExprId& id,
                                Array<MDirection>& directions);
 
+    // Get the directions, epochs and positions for a row.
+    // If no epoch or position engine is set, a single default is used.
+    void getMeasures (const TableExprId& id, Array<MDirection>& dirs,
+                      Array<MEpoch>& eps, Array<MPosition>& pos);
+
+    // Convert the directions for all epochs and positions.
+    Array<Double> convert (const Array<MDirection>& dirs,
+                           const Array<MEpoch>& eps,
+                           const Array<MPosition>& pos,
+                           Bool riseSet, Bool asDirCos);
+
+    // Make the key used to group rows with the same measures.
+    // It returns False if a measure has an offset, thus cannot be grouped.
+    Bool makeKey (const Array<MDirection>& dirs, const Array<MEpoch>& eps,
+                  const Array<MPosition>& pos,
+                  std::vector<Double>& key) const;
+
+    // Set the epoch or position in the frame if different from the
+    // current one.
+    // <group>
+    void setFrameEpoch (const MEpoch& epoch);
+    void setFramePosition (const MPosition& pos);
+    // </group>
+
     // Calucate the rise and set time of a source for a given position and
     // epoch. Argument <src>h</src> defines the possible edge of sun/moon.
     void calcRiseSet (const MDirection& dir,
@@ -196,6 +230,10 @@ namespace casacore {
     Vector<Double>                  itsH;           //# diff for sun or moon
     EpochEngine*                    itsEpochEngine;
     PositionEngine*                 itsPositionEngine;
+    MEpoch                          itsFrameEpoch;  //# epoch set in frame
+    MPosition                       itsFramePos;    //# position set in frame
+    Bool                            itsFrameEpochSet;
+    Bool                            itsFramePosSet;
   };
 
 } //end namespace
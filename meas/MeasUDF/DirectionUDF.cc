@@ -127,6 +127,7 @@ namespace casacore {
     setUnit (itsEngine.unit().getName());
     setConstant (itsEngine.isConstant());
     setAttributes (itsEngine.makeAttributes (itsRefType, itsType));
+    setBatch (! itsRiseSet);
   }
 
   Double DirectionUDF::getDouble (const TableExprId& id)
@@ -139,6 +140,23 @@ namespace casacore {
     return MArray<Double>(itsEngine.getArrayDouble (id, itsRiseSet,
                                                     itsType==DIRCOS));
   }
+  void DirectionUDF::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                     Double* result)
+  {
+    std::vector<MArray<Double>> values (rownrs.size());
+    getArrayDoubleBatch (rownrs, values.data());
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      result[i] = values[i].array().data()[0];
+    }
+  }
+
+  void DirectionUDF::getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                          MArray<Double>* result)
+  {
+    itsEngine.getArrayDoubleBatch (rownrs, itsRiseSet, itsType==DIRCOS,
+                                   result);
+  }
+
   MArray<MVTime> DirectionUDF::getArrayDate (const TableExprId& id)
   {
     Array<Double> res = itsEngine.getArrayDouble (id, itsRiseSet, False);
@@ -117,6 +117,12 @@ namespace casacore {
     virtual MArray<Double> getArrayDouble (const TableExprId& id);
     virtual MArray<MVTime> getArrayDate (const TableExprId& id);
 
+    // Get the values for a block of rows.
+    virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Double* result);
+    virtual void getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                      MArray<Double>* result);
+
   private:
     //# Data members.
     DirectionEngine   itsEngine;
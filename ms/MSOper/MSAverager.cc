@@ -0,0 +1,747 @@
+//# MSAverager.cc: Average a MeasurementSet in time and frequency
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSAverager.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/ms/MeasurementSets/MSIter.h>
+#include <casacore/ms/MeasurementSets/MSTileLayout.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Logging/LogIO.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // The main table columns having a channel axis.
+  const char* const chanColumnNames[] = {
+    "DATA", "FLOAT_DATA", "MODEL_DATA", "CORRECTED_DATA", "FLAG",
+    "WEIGHT_SPECTRUM", "SIGMA_SPECTRUM", "FLAG_CATEGORY"
+  };
+
+  // The main table columns calculated by the averager. The other columns
+  // are copied from the first row of each group.
+  const char* const averagedColumnNames[] = {
+    "TIME", "TIME_CENTROID", "INTERVAL", "EXPOSURE", "UVW", "FLAG_ROW",
+    "WEIGHT", "SIGMA", "DATA", "FLOAT_DATA", "MODEL_DATA", "CORRECTED_DATA",
+    "FLAG", "WEIGHT_SPECTRUM", "SIGMA_SPECTRUM", "FLAG_CATEGORY"
+  };
+
+  // Average the data of the given rows in bins of chanBin channels.
+  // The data are weighted by the weights of the unflagged data. If an output
+  // value has no weight, the unweighted mean of the unflagged data is used;
+  // if all data are flagged, the unweighted mean of all data.
+  template<typename T>
+  void averageKernel (const T* data, const Bool* flags, const Float* weights,
+                      const rownr_t* rows, size_t nrow,
+                      size_t ncorr, size_t nchan, uInt chanBin, T* result)
+  {
+    const size_t nout = (nchan + chanBin - 1) / chanBin;
+    for (size_t k=0; k<nout; ++k) {
+      const size_t chStart = k*chanBin;
+      const size_t chEnd   = std::min (nchan, chStart + chanBin);
+      for (size_t c=0; c<ncorr; ++c) {
+        T sumAll(0);
+        T sumUnflagged(0);
+        T sumWeighted(0);
+        Double sumWeight = 0;
+        size_t nUnflagged = 0;
+        for (size_t i=0; i<nrow; ++i) {
+          const size_t offset = rows[i]*nchan*ncorr + c;
+          for (size_t j=chStart; j<chEnd; ++j) {
+            const size_t inx = offset + j*ncorr;
+            sumAll += data[inx];
+            if (! flags[inx]) {
+              sumUnflagged += data[inx];
+              sumWeighted  += data[inx] * weights[inx];
+              sumWeight    += weights[inx];
+              nUnflagged++;
+            }
+          }
+        }
+        T& res = result[c + k*ncorr];
+        if (sumWeight > 0) {
+          res = sumWeighted / Float(sumWeight);
+        } else if (nUnflagged > 0) {
+          res = sumUnflagged / Float(nUnflagged);
+        } else {
+          res = sumAll / Float(nrow * (chEnd - chStart));
+        }
+      }
+    }
+  }
+
+  // Average the flags (all input flags set) and sum the weights of the
+  // unflagged data of the given rows in bins of chanBin channels.
+  void flagKernel (const Bool* flags, const Float* weights,
+                   const rownr_t* rows, size_t nrow,
+                   size_t ncorr, size_t nchan, uInt chanBin,
+                   Bool* resultFlags, Float* resultWeights)
+  {
+    const size_t nout = (nchan + chanBin - 1) / chanBin;
+    for (size_t k=0; k<nout; ++k) {
+      const size_t chStart = k*chanBin;
+      const size_t chEnd   = std::min (nchan, chStart + chanBin);
+      for (size_t c=0; c<ncorr; ++c) {
+        Bool allFlagged = True;
+        Double sumWeight = 0;
+        for (size_t i=0; i<nrow; ++i) {
+          const size_t offset = rows[i]*nchan*ncorr + c;
+          for (size_t j=chStart; j<chEnd; ++j) {
+            const size_t inx = offset + j*ncorr;
+            if (! flags[inx]) {
+              allFlagged = False;
+              sumWeight += weights[inx];
+            }
+          }
+        }
+        resultFlags[c + k*ncorr]   = allFlagged;
+        resultWeights[c + k*ncorr] = sumWeight;
+      }
+    }
+  }
+
+  // Average the FLAG_CATEGORY flags of the given rows in bins of chanBin
+  // channels. An output flag is set if all its input flags are set.
+  void categoryKernel (const Bool* flags, const rownr_t* rows, size_t nrow,
+                       size_t ncorr, size_t nchan, size_t ncat, uInt chanBin,
+                       Bool* result)
+  {
+    const size_t nout = (nchan + chanBin - 1) / chanBin;
+    for (size_t cat=0; cat<ncat; ++cat) {
+      for (size_t k=0; k<nout; ++k) {
+        const size_t chStart = k*chanBin;
+        const size_t chEnd   = std::min (nchan, chStart + chanBin);
+        for (size_t c=0; c<ncorr; ++c) {
+          Bool allFlagged = True;
+          for (size_t i=0; i<nrow  &&  allFlagged; ++i) {
+            const size_t offset = ((rows[i]*ncat + cat)*nchan)*ncorr + c;
+            for (size_t j=chStart; j<chEnd; ++j) {
+              if (! flags[offset + j*ncorr]) {
+                allFlagged = False;
+                break;
+              }
+            }
+          }
+          result[c + (k + cat*nout)*ncorr] = allFlagged;
+        }
+      }
+    }
+  }
+
+  // Check if all cells of an array column in the table are defined and
+  // have the same shape, so the column can be read as a whole.
+  Bool hasUniformContent (const ArrayColumnBase& col, rownr_t nrow)
+  {
+    if (nrow == 0  ||  ! col.isDefined(0)) {
+      return False;
+    }
+    const IPosition shape = col.shape(0);
+    for (rownr_t r=1; r<nrow; ++r) {
+      if (! (col.isDefined(r)  &&  col.shape(r).isEqual (shape))) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  // Check the shapes of the arrays given to the static functions.
+  void checkShapes (const IPosition& dataShape, const IPosition& flagShape,
+                    const IPosition& weightShape, uInt chanBin,
+                    const IPosition& resultShape)
+  {
+    if (chanBin == 0) {
+      throw AipsError ("MSAverager: the number of channels to average "
+                       "must be > 0");
+    }
+    if (! (dataShape.isEqual (flagShape)  &&
+           dataShape.isEqual (weightShape))) {
+      throw AipsError ("MSAverager: data, flags and weights must have "
+                       "the same shape");
+    }
+    if (! resultShape.isEqual (IPosition(2, dataShape[0],
+                                         (dataShape[1] + chanBin - 1) /
+                                         chanBin))) {
+      throw AipsError ("MSAverager: result has an incorrect shape");
+    }
+  }
+
+  template<typename T>
+  void averageDataCube (const Cube<T>& data, const Cube<Bool>& flags,
+                        const Cube<Float>& weights,
+                        const Vector<rownr_t>& rows,
+                        uInt chanBin, Matrix<T>& result)
+  {
+    checkShapes (data.shape(), flags.shape(), weights.shape(), chanBin,
+                 result.shape());
+    for (rownr_t row : rows) {
+      if (row >= data.nplane()) {
+        throw AipsError ("MSAverager: row number exceeds number of rows");
+      }
+    }
+    Bool deleteData, deleteFlags, deleteWeights, deleteRows, deleteResult;
+    const T* dataPtr = data.getStorage (deleteData);
+    const Bool* flagPtr = flags.getStorage (deleteFlags);
+    const Float* weightPtr = weights.getStorage (deleteWeights);
+    const rownr_t* rowPtr = rows.getStorage (deleteRows);
+    T* resultPtr = result.getStorage (deleteResult);
+    averageKernel (dataPtr, flagPtr, weightPtr, rowPtr, rows.size(),
+                   data.nrow(), data.ncolumn(), chanBin, resultPtr);
+    data.freeStorage (dataPtr, deleteData);
+    flags.freeStorage (flagPtr, deleteFlags);
+    weights.freeStorage (weightPtr, deleteWeights);
+    rows.freeStorage (rowPtr, deleteRows);
+    result.putStorage (resultPtr, deleteResult);
+  }
+
+  // Replace the description of an array column by one without a shape,
+  // so the averaged shape can be used.
+  template<typename T>
+  void replaceArrayDesc (TableDesc& td, const ColumnDesc& old)
+  {
+    ArrayColumnDesc<T> cd(old.name(), old.comment(), "StandardStMan",
+                          "StandardStMan", old.ndim());
+    cd.rwKeywordSet() = old.keywordSet();
+    td.removeColumn (old.name());
+    td.addColumn (cd);
+  }
+
+  void undefineShape (TableDesc& td, const String& name)
+  {
+    const ColumnDesc old(td[name]);
+    switch (old.dataType()) {
+    case TpBool:
+      replaceArrayDesc<Bool> (td, old);
+      break;
+    case TpFloat:
+      replaceArrayDesc<Float> (td, old);
+      break;
+    case TpComplex:
+      replaceArrayDesc<Complex> (td, old);
+      break;
+    default:
+      throw AipsError ("MSAverager: column " + name +
+                       " has an unsupported data type");
+    }
+  }
+
+} // end anonymous namespace
+
+
+MSAverager::MSAverager (const MeasurementSet& ms)
+: itsMS         (ms),
+  itsTimeBin    (0),
+  itsMaxTimeBin (0),
+  itsChanBin    (1)
+{}
+
+void MSAverager::setTimeBin (Double timeBin)
+{
+  itsTimeBin = timeBin;
+}
+
+void MSAverager::setChanBin (uInt chanBin)
+{
+  if (chanBin == 0) {
+    throw AipsError ("MSAverager: the number of channels to average "
+                     "must be > 0");
+  }
+  itsChanBin = chanBin;
+}
+
+void MSAverager::setMaxTimeBin (Double maxTimeBin)
+{
+  itsMaxTimeBin = maxTimeBin;
+}
+
+void MSAverager::averageData (const Cube<Complex>& data,
+                              const Cube<Bool>& flags,
+                              const Cube<Float>& weights,
+                              const Vector<rownr_t>& rows, uInt chanBin,
+                              Matrix<Complex>& result)
+{
+  averageDataCube (data, flags, weights, rows, chanBin, result);
+}
+
+void MSAverager::averageData (const Cube<Float>& data,
+                              const Cube<Bool>& flags,
+                              const Cube<Float>& weights,
+                              const Vector<rownr_t>& rows, uInt chanBin,
+                              Matrix<Float>& result)
+{
+  averageDataCube (data, flags, weights, rows, chanBin, result);
+}
+
+void MSAverager::averageFlags (const Cube<Bool>& flags,
+                               const Cube<Float>& weights,
+                               const Vector<rownr_t>& rows, uInt chanBin,
+                               Matrix<Bool>& resultFlags,
+                               Matrix<Float>& resultWeights)
+{
+  checkShapes (flags.shape(), flags.shape(), weights.shape(), chanBin,
+               resultFlags.shape());
+  checkShapes (flags.shape(), flags.shape(), weights.shape(), chanBin,
+               resultWeights.shape());
+  for (rownr_t row : rows) {
+    if (row >= flags.nplane()) {
+      throw AipsError ("MSAverager: row number exceeds number of rows");
+    }
+  }
+  Bool deleteFlags, deleteWeights, deleteRows, deleteResFlags, deleteResWeights;
+  const Bool* flagPtr = flags.getStorage (deleteFlags);
+  const Float* weightPtr = weights.getStorage (deleteWeights);
+  const rownr_t* rowPtr = rows.getStorage (deleteRows);
+  Bool* resFlagPtr = resultFlags.getStorage (deleteResFlags);
+  Float* resWeightPtr = resultWeights.getStorage (deleteResWeights);
+  flagKernel (flagPtr, weightPtr, rowPtr, rows.size(),
+              flags.nrow(), flags.ncolumn(), chanBin,
+              resFlagPtr, resWeightPtr);
+  flags.freeStorage (flagPtr, deleteFlags);
+  weights.freeStorage (weightPtr, deleteWeights);
+  rows.freeStorage (rowPtr, deleteRows);
+  resultFlags.putStorage (resFlagPtr, deleteResFlags);
+  resultWeights.putStorage (resWeightPtr, deleteResWeights);
+}
+
+MeasurementSet MSAverager::average (const String& outName) const
+{
+  LogIO log(LogOrigin("MSAverager", "average", WHERE));
+  MeasurementSet out = makeOutput (outName);
+  if (itsChanBin > 1) {
+    averageSpectralWindow (out);
+  }
+  // Each chunk of the iteration contains the rows of a time bin, so only
+  // those are held in memory. Without time averaging each time stamp is
+  // a chunk (a very small interval means no binning in MSIter).
+  Double interval = itsTimeBin;
+  Matrix<Int> nbins;
+  if (itsTimeBin <= 0) {
+    interval = DBL_MIN;
+  } else if (itsMaxTimeBin > itsTimeBin) {
+    nbins    = binsPerBaseline();
+    interval = nbins.empty() ? itsTimeBin : maxTimeFactor() * itsTimeBin;
+  }
+  if (itsMS.nrow() > 0) {
+    MSIter iter(itsMS, Block<Int>(), interval, True, False);
+    for (iter.origin(); iter.more(); ++iter) {
+      averageChunk (iter.table(), out, nbins);
+    }
+  }
+  out.flush();
+  log << LogIO::NORMAL << "Averaged " << itsMS.nrow() << " rows into "
+      << out.nrow() << " rows of " << outName << LogIO::POST;
+  return out;
+}
+
+MeasurementSet MSAverager::makeOutput (const String& outName) const
+{
+  TableDesc td = itsMS.actualTableDesc();
+  // Do not refer to the subtables of the input MS; they are copied.
+  TableRecord& keys = td.rwKeywordSet();
+  for (Int i=keys.nfields()-1; i>=0; --i) {
+    if (keys.type(i) == TpTable) {
+      keys.removeField (i);
+    }
+  }
+  const Vector<String> hcNames = td.hypercolumnNames();
+  for (const String& hcName : hcNames) {
+    td.removeHypercolumnDesc (hcName);
+  }
+  // The shape of the channel columns changes when averaging channels.
+  if (itsChanBin > 1) {
+    for (const char* name : chanColumnNames) {
+      if (td.isColumn(name)  &&  td[name].shape().size() > 0) {
+        undefineShape (td, name);
+      }
+    }
+  }
+  for (uInt i=0; i<td.ncolumn(); ++i) {
+    ColumnDesc& cd = td.rwColumnDesc(i);
+    cd.dataManagerType()  = "StandardStMan";
+    cd.dataManagerGroup() = "StandardStMan";
+  }
+  // The data columns are stored tiled, each in its own hypercolumn.
+  IPosition dataShape(2, 4, 64);
+  if (itsMS.nrow() > 0) {
+    dataShape = ArrayColumn<Bool>(itsMS, "FLAG").shape(0);
+    dataShape[1] = (dataShape[1] + itsChanBin - 1) / itsChanBin;
+  }
+  const IPosition tileShape = MSTileLayout::tileShape (dataShape);
+  std::vector<String> tiledColumns;
+  for (const char* name : chanColumnNames) {
+    if (td.isColumn(name)  &&  td[name].ndim() == 2) {
+      td.defineHypercolumn ("Tiled" + String(name), 3,
+                            Vector<String>(1, name));
+      tiledColumns.push_back (name);
+    }
+  }
+  SetupNewTable newtab(outName, td, Table::New);
+  for (const String& name : tiledColumns) {
+    TiledShapeStMan tsm("Tiled" + name, tileShape);
+    newtab.bindColumn (name, tsm);
+  }
+  {
+    MeasurementSet ms(newtab);
+    TableCopy::copyInfo (ms, itsMS);
+    TableCopy::copySubTables (ms, itsMS);
+  }
+  // Open it again, because the subtables are attached readonly by the copy.
+  return MeasurementSet(outName, Table::Update);
+}
+
+void MSAverager::averageSpectralWindow (MeasurementSet& out) const
+{
+  MSSpWindowColumns spwCols(out.spectralWindow());
+  for (rownr_t row=0; row<out.spectralWindow().nrow(); ++row) {
+    const Int nchan = spwCols.numChan()(row);
+    const Int nout  = (nchan + itsChanBin - 1) / itsChanBin;
+    const Vector<Double> freq  = spwCols.chanFreq()(row);
+    const Vector<Double> width = spwCols.chanWidth()(row);
+    const Vector<Double> bw    = spwCols.effectiveBW()(row);
+    const Vector<Double> res   = spwCols.resolution()(row);
+    Vector<Double> outFreq(nout, 0.);
+    Vector<Double> outWidth(nout, 0.);
+    Vector<Double> outBW(nout, 0.);
+    Vector<Double> outRes(nout, 0.);
+    Vector<Int> count(nout, 0);
+    for (Int j=0; j<nchan; ++j) {
+      const Int k = j / itsChanBin;
+      outFreq[k]  += freq[j];
+      outWidth[k] += width[j];
+      outBW[k]    += bw[j];
+      outRes[k]   += res[j];
+      count[k]++;
+    }
+    for (Int k=0; k<nout; ++k) {
+      outFreq[k] /= count[k];
+    }
+    spwCols.numChan().put (row, nout);
+    spwCols.chanFreq().put (row, outFreq);
+    spwCols.chanWidth().put (row, outWidth);
+    spwCols.effectiveBW().put (row, outBW);
+    spwCols.resolution().put (row, outRes);
+  }
+}
+
+Int MSAverager::maxTimeFactor() const
+{
+  return std::max (1, Int(itsMaxTimeBin / itsTimeBin + 0.5));
+}
+
+Matrix<Int> MSAverager::binsPerBaseline() const
+{
+  MSAntennaColumns antCols(itsMS.antenna());
+  const Int nant = itsMS.antenna().nrow();
+  const Int nmax = maxTimeFactor();
+  Matrix<Double> length(nant, nant, 0.);
+  Double maxLength = 0;
+  for (Int i=0; i<nant; ++i) {
+    const Vector<Double> pos1 = antCols.position()(i);
+    for (Int j=i+1; j<nant; ++j) {
+      const Vector<Double> pos2 = antCols.position()(j);
+      const Double len = sqrt(sum((pos2 - pos1) * (pos2 - pos1)));
+      length(i,j) = length(j,i) = len;
+      maxLength = std::max (maxLength, len);
+    }
+  }
+  // The longest baseline gets the shortest time bin. The number of bins
+  // is a divisor of the maximum, so each time bin of a baseline holds the
+  // same number of integrations.
+  Matrix<Int> nbins(nant, nant, nmax);
+  if (maxLength > 0) {
+    for (Int i=0; i<nant; ++i) {
+      for (Int j=0; j<nant; ++j) {
+        Int nb = std::min (nmax, std::max (1, Int(nmax * length(i,j) /
+                                                  maxLength + 0.5)));
+        while (nmax % nb != 0) {
+          --nb;
+        }
+        nbins(i,j) = nb;
+      }
+    }
+  }
+  return nbins;
+}
+
+void MSAverager::averageChunk (const Table& chunk, MeasurementSet& out,
+                               const Matrix<Int>& nbins) const
+{
+  const TableDesc& outDesc = out.tableDesc();
+  const rownr_t nrow = chunk.nrow();
+  const Vector<Double> time = ScalarColumn<Double>(chunk, "TIME").getColumn();
+  const Vector<Double> interval =
+    ScalarColumn<Double>(chunk, "INTERVAL").getColumn();
+  const Vector<Double> exposure =
+    ScalarColumn<Double>(chunk, "EXPOSURE").getColumn();
+  const Vector<Double> centroid =
+    ScalarColumn<Double>(chunk, "TIME_CENTROID").getColumn();
+  const Vector<Int> ant1  = ScalarColumn<Int>(chunk, "ANTENNA1").getColumn();
+  const Vector<Int> ant2  = ScalarColumn<Int>(chunk, "ANTENNA2").getColumn();
+  const Vector<Int> feed1 = ScalarColumn<Int>(chunk, "FEED1").getColumn();
+  const Vector<Int> feed2 = ScalarColumn<Int>(chunk, "FEED2").getColumn();
+  const Vector<Int> scan  = ScalarColumn<Int>(chunk, "SCAN_NUMBER").getColumn();
+  const Vector<Int> state = ScalarColumn<Int>(chunk, "STATE_ID").getColumn();
+  const Vector<Int> obs   =
+    ScalarColumn<Int>(chunk, "OBSERVATION_ID").getColumn();
+  const Vector<Int> proc  =
+    ScalarColumn<Int>(chunk, "PROCESSOR_ID").getColumn();
+  const Vector<Bool> flagRow =
+    ScalarColumn<Bool>(chunk, "FLAG_ROW").getColumn();
+  const Matrix<Double> uvw = ArrayColumn<Double>(chunk, "UVW").getColumn();
+  Cube<Bool> flags = ArrayColumn<Bool>(chunk, "FLAG").getColumn();
+  for (rownr_t r=0; r<nrow; ++r) {
+    if (flagRow[r]) {
+      flags.xyPlane(r) = True;
+    }
+  }
+  const size_t ncorr = flags.shape()[0];
+  const size_t nchan = flags.shape()[1];
+  const size_t nout  = (nchan + itsChanBin - 1) / itsChanBin;
+  // Use WEIGHT_SPECTRUM if it has values, otherwise WEIGHT per channel.
+  Cube<Float> weights;
+  if (chunk.tableDesc().isColumn ("WEIGHT_SPECTRUM")  &&
+      ArrayColumn<Float>(chunk, "WEIGHT_SPECTRUM").hasContent()) {
+    weights = ArrayColumn<Float>(chunk, "WEIGHT_SPECTRUM").getColumn();
+  } else {
+    const Matrix<Float> weight =
+      ArrayColumn<Float>(chunk, "WEIGHT").getColumn();
+    weights.resize (ncorr, nchan, nrow);
+    for (rownr_t r=0; r<nrow; ++r) {
+      for (size_t j=0; j<nchan; ++j) {
+        for (size_t c=0; c<ncorr; ++c) {
+          weights(c,j,r) = weight(c,r);
+        }
+      }
+    }
+  }
+  // Group the rows per output row. The bin index is used for baseline
+  // dependent averaging; otherwise all rows are in the same time bin.
+  Double startTime = 0;
+  if (! nbins.empty()) {
+    startTime = min(time - interval / 2.);
+  }
+  typedef std::tuple<Int,Int,Int,Int,Int,Int,Int,Int,Int> GroupKey;
+  std::map<GroupKey, std::vector<rownr_t>> groupMap;
+  for (rownr_t r=0; r<nrow; ++r) {
+    Int bin = 0;
+    if (! nbins.empty()) {
+      // An antenna not in the ANTENNA table has no baseline length, so
+      // it gets the most bins like binsPerBaseline does in that case.
+      const Int nmax = maxTimeFactor();
+      Int nb = nmax;
+      if (ant1[r] >= 0  &&  ant1[r] < Int(nbins.nrow())  &&
+          ant2[r] >= 0  &&  ant2[r] < Int(nbins.ncolumn())) {
+        nb = nbins(ant1[r], ant2[r]);
+      }
+      const Double binLength = nmax * itsTimeBin / nb;
+      bin = std::min (nb-1, Int((time[r] - startTime) / binLength));
+    }
+    groupMap[GroupKey(bin, ant1[r], ant2[r], feed1[r], feed2[r], scan[r],
+                      state[r], obs[r], proc[r])].push_back (r);
+  }
+  std::vector<std::vector<rownr_t>> groups;
+  groups.reserve (groupMap.size());
+  for (auto& group : groupMap) {
+    groups.push_back (std::move(group.second));
+  }
+  const size_t ng = groups.size();
+  // Get the data columns to average.
+  std::vector<String> complexNames;
+  std::vector<Cube<Complex>> complexIn;
+  std::vector<Cube<Complex>> complexOut;
+  for (const char* name : {"DATA", "MODEL_DATA", "CORRECTED_DATA"}) {
+    if (outDesc.isColumn(name)  &&
+        ArrayColumn<Complex>(chunk, name).hasContent()) {
+      complexNames.push_back (name);
+      complexIn.push_back (ArrayColumn<Complex>(chunk, name).getColumn());
+      complexOut.push_back (Cube<Complex>(ncorr, nout, ng));
+    }
+  }
+  Cube<Float> floatIn;
+  Cube<Float> floatOut;
+  const Bool hasFloat = (outDesc.isColumn("FLOAT_DATA")  &&
+                         ArrayColumn<Float>(chunk, "FLOAT_DATA").hasContent());
+  if (hasFloat) {
+    floatIn = ArrayColumn<Float>(chunk, "FLOAT_DATA").getColumn();
+    floatOut.resize (ncorr, nout, ng);
+  }
+  Array<Bool> categoryIn;
+  Array<Bool> categoryOut;
+  size_t ncat = 0;
+  if (outDesc.isColumn("FLAG_CATEGORY")) {
+    ArrayColumn<Bool> categoryCol(chunk, "FLAG_CATEGORY");
+    if (hasUniformContent (categoryCol, nrow)  &&
+        categoryCol.ndim(0) == 3  &&
+        categoryCol.shape(0).getFirst(2).isEqual (IPosition(2, ncorr,
+                                                            nchan))) {
+      categoryIn = categoryCol.getColumn();
+      ncat = categoryIn.shape()[2];
+      categoryOut.resize (IPosition(4, ncorr, nout, ncat, ng));
+    }
+  }
+  // Average each group (in parallel).
+  Vector<Double> outTime(ng);
+  Vector<Double> outInterval(ng);
+  Vector<Double> outExposure(ng);
+  Vector<Double> outCentroid(ng);
+  Vector<Bool>   outFlagRow(ng);
+  Matrix<Double> outUvw(3, ng);
+  Matrix<Float>  outWeight(ncorr, ng);
+  Matrix<Float>  outSigma(ncorr, ng);
+  Cube<Bool>     outFlags(ncorr, nout, ng);
+  Cube<Float>    outWeights(ncorr, nout, ng);
+  Cube<Float>    outSigmas(ncorr, nout, ng);
+  const size_t nplane = ncorr*nout;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (Int64 g=0; g<Int64(ng); ++g) {
+    const std::vector<rownr_t>& rows = groups[g];
+    flagKernel (flags.data(), weights.data(), rows.data(), rows.size(),
+                ncorr, nchan, itsChanBin,
+                outFlags.data() + g*nplane, outWeights.data() + g*nplane);
+    for (size_t i=0; i<complexIn.size(); ++i) {
+      averageKernel (complexIn[i].data(), flags.data(), weights.data(),
+                     rows.data(), rows.size(), ncorr, nchan, itsChanBin,
+                     complexOut[i].data() + g*nplane);
+    }
+    if (hasFloat) {
+      averageKernel (floatIn.data(), flags.data(), weights.data(),
+                     rows.data(), rows.size(), ncorr, nchan, itsChanBin,
+                     floatOut.data() + g*nplane);
+    }
+    if (ncat > 0) {
+      categoryKernel (categoryIn.data(), rows.data(), rows.size(),
+                      ncorr, nchan, ncat, itsChanBin,
+                      categoryOut.data() + g*nplane*ncat);
+    }
+    Double startTime = time[rows[0]] - interval[rows[0]] / 2;
+    Double endTime   = time[rows[0]] + interval[rows[0]] / 2;
+    Double sumExposure = 0;
+    Double sumCentroid = 0;
+    Double sumWeightedCentroid = 0;
+    Double uvwSum[3] = {0, 0, 0};
+    for (rownr_t r : rows) {
+      startTime = std::min (startTime, time[r] - interval[r] / 2);
+      endTime   = std::max (endTime,   time[r] + interval[r] / 2);
+      sumExposure += exposure[r];
+      sumCentroid += centroid[r];
+      sumWeightedCentroid += centroid[r] * exposure[r];
+      for (uInt k=0; k<3; ++k) {
+        uvwSum[k] += uvw(k,r);
+      }
+    }
+    outTime[g]     = (startTime + endTime) / 2;
+    outInterval[g] = endTime - startTime;
+    outExposure[g] = sumExposure;
+    outCentroid[g] = (sumExposure > 0  ?  sumWeightedCentroid / sumExposure
+                                       :  sumCentroid / rows.size());
+    for (uInt k=0; k<3; ++k) {
+      outUvw(k,g) = uvwSum[k] / rows.size();
+    }
+    Bool allFlagged = True;
+    for (size_t c=0; c<ncorr; ++c) {
+      Double sumWeight = 0;
+      for (size_t k=0; k<nout; ++k) {
+        sumWeight += outWeights(c,k,g);
+        allFlagged = allFlagged && outFlags(c,k,g);
+        outSigmas(c,k,g) = (outWeights(c,k,g) > 0  ?
+                            1 / std::sqrt(outWeights(c,k,g)) : 0);
+      }
+      outWeight(c,g) = sumWeight / nout;
+      outSigma(c,g)  = (outWeight(c,g) > 0  ?  1 / std::sqrt(outWeight(c,g))
+                                            :  0);
+    }
+    outFlagRow[g] = allFlagged;
+  }
+  // Write the averaged rows.
+  const rownr_t startRow = out.nrow();
+  out.addRow (ng);
+  const Slicer rowRange(IPosition(1, startRow), IPosition(1, ng));
+  ScalarColumn<Double>(out, "TIME").putColumnRange (rowRange, outTime);
+  ScalarColumn<Double>(out, "INTERVAL").putColumnRange (rowRange,
+                                                        outInterval);
+  ScalarColumn<Double>(out, "EXPOSURE").putColumnRange (rowRange,
+                                                        outExposure);
+  ScalarColumn<Double>(out, "TIME_CENTROID").putColumnRange (rowRange,
+                                                             outCentroid);
+  ScalarColumn<Bool>(out, "FLAG_ROW").putColumnRange (rowRange, outFlagRow);
+  ArrayColumn<Double>(out, "UVW").putColumnRange (rowRange, outUvw);
+  ArrayColumn<Float>(out, "WEIGHT").putColumnRange (rowRange, outWeight);
+  ArrayColumn<Float>(out, "SIGMA").putColumnRange (rowRange, outSigma);
+  ArrayColumn<Bool>(out, "FLAG").putColumnRange (rowRange, outFlags);
+  if (outDesc.isColumn ("WEIGHT_SPECTRUM")) {
+    ArrayColumn<Float>(out, "WEIGHT_SPECTRUM").putColumnRange (rowRange,
+                                                               outWeights);
+  }
+  if (outDesc.isColumn ("SIGMA_SPECTRUM")) {
+    ArrayColumn<Float>(out, "SIGMA_SPECTRUM").putColumnRange (rowRange,
+                                                              outSigmas);
+  }
+  for (size_t i=0; i<complexNames.size(); ++i) {
+    ArrayColumn<Complex>(out, complexNames[i]).putColumnRange (rowRange,
+                                                               complexOut[i]);
+  }
+  if (hasFloat) {
+    ArrayColumn<Float>(out, "FLOAT_DATA").putColumnRange (rowRange,
+                                                          floatOut);
+  }
+  if (ncat > 0) {
+    ArrayColumn<Bool>(out, "FLAG_CATEGORY").putColumnRange (rowRange,
+                                                            categoryOut);
+  }
+  // Copy the other columns from the first row of each group.
+  for (uInt i=0; i<outDesc.ncolumn(); ++i) {
+    const String& name = outDesc[i].name();
+    if (std::find (std::begin(averagedColumnNames),
+                   std::end(averagedColumnNames), name)
+          == std::end(averagedColumnNames)  &&
+        chunk.tableDesc().isColumn (name)) {
+      TableColumn outCol(out, name);
+      TableColumn inCol(chunk, name);
+      for (size_t g=0; g<ng; ++g) {
+        outCol.put (startRow + g, inCol, groups[g][0]);
+      }
+    }
+  }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,183 @@
+//# MSAverager.h: Average a MeasurementSet in time and frequency
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_MSAVERAGER_H
+#define MS_MSAVERAGER_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Average a MeasurementSet in time and frequency
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMSAverager.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> MeasurementSet
+//   <li> MSIter
+// </prerequisite>
+
+// <synopsis>
+// MSAverager writes a new MeasurementSet containing the data of an MS
+// (or a selection of it) averaged in time and/or frequency.
+// <br>The MS is traversed by an MSIter using the time bin as time interval,
+// so only the rows of a single time bin of a field and data description
+// are held in memory. In such a chunk the rows with the same baseline,
+// feeds, scan, state, observation and processor are averaged to a single
+// output row. The baselines are averaged in parallel if OpenMP is used.
+// <br>The averaging is done as follows:
+// <ul>
+//  <li> The data columns (DATA, FLOAT_DATA, MODEL_DATA and CORRECTED_DATA)
+//       are averaged using the WEIGHT_SPECTRUM (or WEIGHT if there is no
+//       WEIGHT_SPECTRUM) of the unflagged data. If all data of an output
+//       value are flagged, it is the unweighted mean of the flagged data.
+//  <li> An output value is flagged if all its input data are flagged.
+//       FLAG_ROW is set if all flags in the row are set.
+//  <li> WEIGHT_SPECTRUM is the sum of the weights of the unflagged data.
+//       WEIGHT is the mean of it over the channels. SIGMA and
+//       SIGMA_SPECTRUM are 1/sqrt of the weights (0 if the weight is 0).
+//  <li> TIME and INTERVAL are the centre and width of the time span covered
+//       by the input rows. EXPOSURE is the sum of the exposures and
+//       TIME_CENTROID the exposure weighted mean. UVW is the mean UVW.
+//  <li> A FLAG_CATEGORY flag is set if all its input flags are set.
+//       It is only written if all its input cells have the same shape.
+//  <li> The other columns are taken from the first input row.
+// </ul>
+// When averaging in frequency, the SPECTRAL_WINDOW subtable is adapted.
+// If the number of channels is not a multiple of the number of channels
+// to average, the last output channel averages the remaining channels.
+// <br>Optionally baseline dependent averaging can be done. Then the time
+// bin of a baseline is about inversely proportional to its length, ranging
+// from the given time bin for the longest baseline to the given maximum
+// time bin (rounded to a multiple of the time bin). The number of time
+// bins of a baseline is a divisor of that multiple, so all its time bins
+// have the same length. The time bins of the baselines are aligned to the
+// maximum time bin.
+// <br>The static functions <src>averageData</src> and
+// <src>averageFlags</src> contain the averaging algorithm. They are also
+// used by the virtual column engine MSChanAvgEngine, which averages in
+// frequency on the fly.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   MeasurementSet ms("in.ms");
+//   MSAverager averager(ms);
+//   averager.setTimeBin (10.);    // 10 seconds
+//   averager.setChanBin (4);      // 4 channels
+//   MeasurementSet avgms = averager.average ("out.ms");
+// </srcblock>
+// </example>
+
+// <motivation>
+// Averaging is a common operation that used to be implemented by each
+// application itself.
+// </motivation>
+
+class MSAverager
+{
+public:
+  // Construct for the given MS which can be a selection.
+  explicit MSAverager (const MeasurementSet& ms);
+
+  // Set the time bin (in seconds). A value <= 0 means no time averaging
+  // which is the default.
+  void setTimeBin (Double timeBin);
+
+  // Set the number of channels to average. Default is 1.
+  void setChanBin (uInt chanBin);
+
+  // Do baseline dependent time averaging with the given maximum time bin
+  // (in seconds) used for the shortest baselines. It is rounded to a
+  // multiple of the time bin. A value <= the time bin (the default)
+  // means no baseline dependent averaging.
+  void setMaxTimeBin (Double maxTimeBin);
+
+  // Write the averaged MS into a new MS with the given name and return it.
+  MeasurementSet average (const String& outName) const;
+
+  // Average the data in the given rows (the last axis of the cubes) and
+  // in each <src>chanBin</src> channels using the flags and weights.
+  // The result has to have the correct shape (ncorr, nchanOut).
+  // <group>
+  static void averageData (const Cube<Complex>& data,
+                           const Cube<Bool>& flags,
+                           const Cube<Float>& weights,
+                           const Vector<rownr_t>& rows, uInt chanBin,
+                           Matrix<Complex>& result);
+  static void averageData (const Cube<Float>& data,
+                           const Cube<Bool>& flags,
+                           const Cube<Float>& weights,
+                           const Vector<rownr_t>& rows, uInt chanBin,
+                           Matrix<Float>& result);
+  // </group>
+
+  // Average the flags and sum the weights of the unflagged data in the
+  // given rows and in each <src>chanBin</src> channels.
+  // The results have to have the correct shape (ncorr, nchanOut).
+  static void averageFlags (const Cube<Bool>& flags,
+                            const Cube<Float>& weights,
+                            const Vector<rownr_t>& rows, uInt chanBin,
+                            Matrix<Bool>& resultFlags,
+                            Matrix<Float>& resultWeights);
+
+private:
+  // Create the output MS with the subtables of the input MS.
+  MeasurementSet makeOutput (const String& outName) const;
+
+  // Average the rows of a chunk and append them to the output MS.
+  void averageChunk (const Table& chunk, MeasurementSet& out,
+                     const Matrix<Int>& nbins) const;
+
+  // Adapt the SPECTRAL_WINDOW subtable to the channel averaging.
+  void averageSpectralWindow (MeasurementSet& out) const;
+
+  // Get the maximum time bin as a multiple of the time bin.
+  Int maxTimeFactor() const;
+
+  // Get for each baseline the number of time bins in the maximum time bin
+  // (for baseline dependent averaging).
+  Matrix<Int> binsPerBaseline() const;
+
+  MeasurementSet itsMS;
+  Double         itsTimeBin;
+  Double         itsMaxTimeBin;
+  uInt           itsChanBin;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
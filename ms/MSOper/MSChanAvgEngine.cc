@@ -0,0 +1,286 @@
+//# MSChanAvgEngine.cc: Virtual column engine averaging MS data in frequency
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/ms/MSOper/MSChanAvgEngine.h>
+#include <casacore/ms/MSOper/MSAverager.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Utilities/DataType.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template<typename T>
+MSChanAvgColumn<T>::MSChanAvgColumn (MSChanAvgEngine* enginePtr,
+                                     const String& columnName)
+: itsEngine (enginePtr),
+  itsName   (columnName)
+{}
+
+template<typename T>
+MSChanAvgColumn<T>::~MSChanAvgColumn()
+{}
+
+template<typename T>
+void MSChanAvgColumn<T>::attach (const Table& table)
+{
+  itsSource.attach (table, itsEngine->sourceColumn (itsName));
+}
+
+template<typename T>
+IPosition MSChanAvgColumn<T>::shape (rownr_t rownr)
+{
+  IPosition shp = itsSource.shape (rownr);
+  if (shp.size() != 2) {
+    throw DataManError ("MSChanAvgEngine: source column of " + itsName +
+                        " does not contain matrices");
+  }
+  shp[1] = (shp[1] + itsEngine->chanBin() - 1) / itsEngine->chanBin();
+  return shp;
+}
+
+template<typename T>
+Bool MSChanAvgColumn<T>::isShapeDefined (rownr_t rownr)
+{
+  return itsSource.isDefined (rownr);
+}
+
+template<typename T>
+void MSChanAvgColumn<T>::getArray (rownr_t rownr, Array<T>& data)
+{
+  // The data array has the correct shape, so the result references it.
+  Matrix<T> result(data);
+  itsEngine->average (rownr, itsSource, result);
+}
+
+template class MSChanAvgColumn<Complex>;
+template class MSChanAvgColumn<Float>;
+template class MSChanAvgColumn<Bool>;
+
+
+
+MSChanAvgEngine::MSChanAvgEngine (uInt chanBin, const Record& sourceColumns)
+: itsChanBin       (chanBin),
+  itsSourceColumns (sourceColumns),
+  itsRows          (1, 0)
+{
+  if (chanBin == 0) {
+    throw DataManError ("MSChanAvgEngine: the number of channels to "
+                        "average must be > 0");
+  }
+}
+
+MSChanAvgEngine::MSChanAvgEngine (const String&, const Record& spec)
+: itsChanBin   (1),
+  itsRows      (1, 0)
+{
+  // The spec is empty when the table is read back; it is read by prepare.
+  if (spec.isDefined ("CHANBIN")) {
+    itsChanBin = spec.asInt ("CHANBIN");
+  }
+  if (spec.isDefined ("SOURCECOLUMNS")) {
+    itsSourceColumns = spec.subRecord ("SOURCECOLUMNS");
+  }
+}
+
+MSChanAvgEngine::~MSChanAvgEngine()
+{
+  for (MSChanAvgColumn<Complex>* col : itsComplexColumns) {
+    delete col;
+  }
+  for (MSChanAvgColumn<Float>* col : itsFloatColumns) {
+    delete col;
+  }
+  for (MSChanAvgColumn<Bool>* col : itsBoolColumns) {
+    delete col;
+  }
+}
+
+DataManager* MSChanAvgEngine::clone() const
+{
+  return new MSChanAvgEngine (itsChanBin, itsSourceColumns);
+}
+
+String MSChanAvgEngine::dataManagerType() const
+{
+  return className();
+}
+
+String MSChanAvgEngine::className()
+{
+  // The prefix tells the library to load if the class is not registered.
+  return "ms.MSChanAvgEngine";
+}
+
+Record MSChanAvgEngine::dataManagerSpec() const
+{
+  Record spec;
+  spec.define ("CHANBIN", Int(itsChanBin));
+  spec.defineRecord ("SOURCECOLUMNS", itsSourceColumns);
+  return spec;
+}
+
+DataManager* MSChanAvgEngine::makeObject (const String& dataManagerName,
+                                          const Record& spec)
+{
+  return new MSChanAvgEngine (dataManagerName, spec);
+}
+
+void MSChanAvgEngine::registerClass()
+{
+  DataManager::registerCtor (className(), makeObject);
+}
+
+String MSChanAvgEngine::sourceColumn (const String& columnName) const
+{
+  if (! itsSourceColumns.isDefined (columnName)) {
+    throw DataManError ("MSChanAvgEngine: no source column given for "
+                        "column " + columnName);
+  }
+  return itsSourceColumns.asString (columnName);
+}
+
+DataManagerColumn* MSChanAvgEngine::makeIndArrColumn (const String& name,
+                                                      int dataType,
+                                                      const String&)
+{
+  switch (dataType) {
+  case TpComplex:
+    itsComplexColumns.push_back (new MSChanAvgColumn<Complex>(this, name));
+    return itsComplexColumns.back();
+  case TpFloat:
+    itsFloatColumns.push_back (new MSChanAvgColumn<Float>(this, name));
+    return itsFloatColumns.back();
+  case TpBool:
+    itsBoolColumns.push_back (new MSChanAvgColumn<Bool>(this, name));
+    return itsBoolColumns.back();
+  default:
+    break;
+  }
+  throw DataManError ("MSChanAvgEngine: column " + name +
+                      " must have data type Complex, Float or Bool");
+}
+
+void MSChanAvgEngine::create64 (rownr_t)
+{
+  // Keep the specification in a table keyword.
+  table().rwKeywordSet().defineRecord (keywordName ("_MSChanAvg_Spec"),
+                                       dataManagerSpec());
+}
+
+void MSChanAvgEngine::prepare()
+{
+  const TableRecord& keySet = table().keywordSet();
+  String keyword = keywordName ("_MSChanAvg_Spec");
+  if (keySet.isDefined (keyword)) {
+    const Record spec = keySet.subRecord(keyword).toRecord();
+    itsChanBin = spec.asInt ("CHANBIN");
+    itsSourceColumns = spec.subRecord ("SOURCECOLUMNS");
+  }
+  const TableDesc& td = table().tableDesc();
+  itsFlagCol.attach (table(), "FLAG");
+  itsWeightCol.attach (table(), "WEIGHT");
+  if (td.isColumn ("FLAG_ROW")) {
+    itsFlagRowCol.attach (table(), "FLAG_ROW");
+  }
+  if (td.isColumn ("WEIGHT_SPECTRUM")) {
+    itsWeightSpectrumCol.attach (table(), "WEIGHT_SPECTRUM");
+  }
+  for (MSChanAvgColumn<Complex>* col : itsComplexColumns) {
+    col->attach (table());
+  }
+  for (MSChanAvgColumn<Float>* col : itsFloatColumns) {
+    col->attach (table());
+  }
+  for (MSChanAvgColumn<Bool>* col : itsBoolColumns) {
+    col->attach (table());
+  }
+}
+
+void MSChanAvgEngine::readFlagsWeights (rownr_t rownr)
+{
+  const Matrix<Bool> flags = itsFlagCol(rownr);
+  const uInt ncorr = flags.nrow();
+  const uInt nchan = flags.ncolumn();
+  itsFlags.resize (ncorr, nchan, 1);
+  itsWeights.resize (ncorr, nchan, 1);
+  if (! itsFlagRowCol.isNull()  &&  itsFlagRowCol(rownr)) {
+    itsFlags = True;
+  } else {
+    itsFlags.xyPlane(0) = flags;
+  }
+  if (! itsWeightSpectrumCol.isNull()  &&
+      itsWeightSpectrumCol.isDefined (rownr)) {
+    itsWeights.xyPlane(0) = itsWeightSpectrumCol(rownr);
+  } else {
+    const Vector<Float> weight = itsWeightCol(rownr);
+    for (uInt j=0; j<nchan; ++j) {
+      for (uInt c=0; c<ncorr; ++c) {
+        itsWeights(c,j,0) = weight[c];
+      }
+    }
+  }
+}
+
+void MSChanAvgEngine::average (rownr_t rownr,
+                               const ArrayColumn<Complex>& source,
+                               Matrix<Complex>& result)
+{
+  readFlagsWeights (rownr);
+  const Cube<Complex> data(source(rownr).reform (itsFlags.shape()));
+  MSAverager::averageData (data, itsFlags, itsWeights, itsRows, itsChanBin,
+                           result);
+}
+
+void MSChanAvgEngine::average (rownr_t rownr,
+                               const ArrayColumn<Float>& source,
+                               Matrix<Float>& result)
+{
+  readFlagsWeights (rownr);
+  if (source.columnDesc().name() == "WEIGHT_SPECTRUM") {
+    Matrix<Bool> flags(result.shape());
+    MSAverager::averageFlags (itsFlags, itsWeights, itsRows, itsChanBin,
+                              flags, result);
+  } else {
+    const Cube<Float> data(source(rownr).reform (itsFlags.shape()));
+    MSAverager::averageData (data, itsFlags, itsWeights, itsRows,
+                             itsChanBin, result);
+  }
+}
+
+void MSChanAvgEngine::average (rownr_t rownr,
+                               const ArrayColumn<Bool>&,
+                               Matrix<Bool>& result)
+{
+  readFlagsWeights (rownr);
+  Matrix<Float> weights(result.shape());
+  MSAverager::averageFlags (itsFlags, itsWeights, itsRows, itsChanBin,
+                            result, weights);
+}
+
+} //# NAMESPACE CASACORE - END
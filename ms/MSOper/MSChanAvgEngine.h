@@ -0,0 +1,242 @@
+//# MSChanAvgEngine.h: Virtual column engine averaging MS data in frequency
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_MSCHANAVGENGINE_H
+#define MS_MSCHANAVGENGINE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/VirtColEng.h>
+#include <casacore/tables/DataMan/VirtArrCol.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MSChanAvgEngine;
+
+
+// <summary>
+// Virtual column containing the frequency averaged data of another column
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tMSAverager.cc">
+// </reviewed>
+
+// <synopsis>
+// MSChanAvgColumn is the column object for a column bound to an
+// MSChanAvgEngine. Its cells are calculated by the engine from the
+// corresponding cells of the source column. It can be used for the types
+// Complex, Float and Bool.
+// </synopsis>
+
+template<typename T>
+class MSChanAvgColumn : public VirtualArrayColumn<T>
+{
+public:
+  MSChanAvgColumn (MSChanAvgEngine* enginePtr, const String& columnName);
+
+  virtual ~MSChanAvgColumn();
+
+  // Attach to the source column in the given table.
+  void attach (const Table& table);
+
+  // Get the shape of the averaged array in the given row.
+  virtual IPosition shape (rownr_t rownr);
+
+  // Is the shape (i.e. the source cell) defined?
+  virtual Bool isShapeDefined (rownr_t rownr);
+
+protected:
+  // Get the averaged array in the given row.
+  virtual void getArray (rownr_t rownr, Array<T>& data);
+
+private:
+  MSChanAvgEngine* itsEngine;
+  String           itsName;
+  ArrayColumn<T>   itsSource;
+};
+
+
+// <summary>
+// Virtual column engine averaging MS data in frequency
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMSAverager.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> MSAverager
+//   <li> VirtualColumnEngine
+// </prerequisite>
+
+// <synopsis>
+// MSChanAvgEngine makes it possible to have virtual columns in a
+// MeasurementSet containing the data of another column averaged in frequency.
+// The averaging is done on the fly when a cell is read, using the same
+// algorithm as MSAverager (see there). It uses the FLAG and WEIGHT_SPECTRUM
+// (or WEIGHT) columns of the MS.
+// <br>The specification record contains the number of channels to average
+// (field CHANBIN) and for each virtual column the name of its source column
+// (subrecord SOURCECOLUMNS). The data type of the source column defines
+// what is calculated:
+// <ul>
+//  <li> For a Bool column (i.e. FLAG) the averaged flags.
+//  <li> For the WEIGHT_SPECTRUM column the summed weights.
+//  <li> For other Complex or Float columns the averaged data.
+// </ul>
+// The specification is stored in the table, so the engine can be
+// reconstructed when the table is opened again. The engine is registered
+// with the name <src>ms.MSChanAvgEngine</src>, so the table system can find
+// it by loading the casa_ms library and calling its function
+// <src>register_ms</src> (see Register.h) if such a table is opened.
+// <br>The flags and weights are read for each access of a cell, so the
+// averaged values always reflect the current flags and weights.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms", Table::Update);
+//   TableDesc td;
+//   td.addColumn (ArrayColumnDesc<Complex>("DATA_AVG"));
+//   td.addColumn (ArrayColumnDesc<Bool>("FLAG_AVG"));
+//   Record sources;
+//   sources.define ("DATA_AVG", "DATA");
+//   sources.define ("FLAG_AVG", "FLAG");
+//   MSChanAvgEngine engine(4, sources);
+//   tab.addColumn (td, engine);
+// </srcblock>
+// </example>
+
+// <motivation>
+// Reading averaged data is useful for quick looks without having to
+// write an averaged MS.
+// </motivation>
+
+class MSChanAvgEngine : public VirtualColumnEngine
+{
+public:
+  // Create the engine averaging <src>chanBin</src> channels.
+  // The record gives the source column name for each virtual column.
+  MSChanAvgEngine (uInt chanBin, const Record& sourceColumns);
+
+  // Create from the specification record (as made by dataManagerSpec).
+  MSChanAvgEngine (const String& dataManagerName, const Record& spec);
+
+  ~MSChanAvgEngine();
+
+  // The object cannot be copied.
+  MSChanAvgEngine (const MSChanAvgEngine&) = delete;
+
+  // The object cannot be assigned to.
+  MSChanAvgEngine& operator= (const MSChanAvgEngine&) = delete;
+
+  // Clone the engine object.
+  virtual DataManager* clone() const;
+
+  // Return the type name of the engine (i.e. its class name).
+  virtual String dataManagerType() const;
+
+  // Return the name of the class.
+  static String className();
+
+  // Get the data manager specification.
+  virtual Record dataManagerSpec() const;
+
+  // Register the class name and the static makeObject "constructor".
+  // This will make the engine known to the table system.
+  static void registerClass();
+
+  // Define the "constructor" to construct this engine when a
+  // table is read back.
+  // This "constructor" has to be registered by the user of the engine.
+  // If the engine is commonly used, its registration can be added
+  // to the registerAllCtor function in DataManReg.cc.
+  // That function gets automatically invoked by the table system.
+  static DataManager* makeObject (const String& dataManagerName,
+                                  const Record& spec);
+
+  // Get the number of channels to average.
+  uInt chanBin() const
+    { return itsChanBin; }
+
+  // Get the name of the source column of a virtual column.
+  String sourceColumn (const String& columnName) const;
+
+  // Average the source data in the given row into the result.
+  // The result must have the averaged shape.
+  // <group>
+  void average (rownr_t rownr, const ArrayColumn<Complex>& source,
+                Matrix<Complex>& result);
+  void average (rownr_t rownr, const ArrayColumn<Float>& source,
+                Matrix<Float>& result);
+  void average (rownr_t rownr, const ArrayColumn<Bool>& source,
+                Matrix<Bool>& result);
+  // </group>
+
+private:
+  // Read the flags and weights of the given row.
+  void readFlagsWeights (rownr_t rownr);
+
+  // Create the column object for the array column in this engine.
+  virtual DataManagerColumn* makeIndArrColumn (const String& columnName,
+                                               int dataType,
+                                               const String& dataTypeId);
+
+  // Store the specification in the table keywords.
+  virtual void create64 (rownr_t initialNrrow);
+
+  // Read the specification and attach the columns to their sources.
+  virtual void prepare();
+
+  uInt                                   itsChanBin;
+  Record                                 itsSourceColumns;
+  std::vector<MSChanAvgColumn<Complex>*> itsComplexColumns;
+  std::vector<MSChanAvgColumn<Float>*>   itsFloatColumns;
+  std::vector<MSChanAvgColumn<Bool>*>    itsBoolColumns;
+  ArrayColumn<Bool>                      itsFlagCol;
+  ScalarColumn<Bool>                     itsFlagRowCol;
+  ArrayColumn<Float>                     itsWeightCol;
+  ArrayColumn<Float>                     itsWeightSpectrumCol;
+  Cube<Bool>                             itsFlags;
+  Cube<Float>                            itsWeights;
+  Vector<rownr_t>                        itsRows;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
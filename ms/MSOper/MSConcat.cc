@@ -28,6 +28,7 @@
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Containers/RecordField.h>
@@ -57,6 +58,7 @@
 #include <casacore/tables/Tables/TableVector.h>
 #include <casacore/tables/Tables/TabVecMath.h>
 #include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/iostream.h>
@@ -66,6 +68,194 @@
 
 namespace casacore {
 
+namespace {
+
+  // Get the number of rows to copy at once when appending the main table.
+  // It is about 4 MB of data. If the data column is stored in a tiled
+  // storage manager, it is a multiple of the number of rows in a tile,
+  // so whole tiles are read and written.
+  rownr_t concatBlockRows(const Table& tab, const String& colName)
+  {
+    const rownr_t targetBytes = 4*1024*1024;
+    rownr_t nrow = 1024;
+    if (tab.nrow() > 0 && tab.tableDesc().isColumn(colName)) {
+      TableColumn col(tab, colName);
+      if (col.isDefined(0)) {
+        rownr_t rowBytes = std::max(col.shape(0).product(), Int64(1)) *
+                           sizeof(Complex);
+        nrow = std::max(targetBytes / rowBytes, rownr_t(1));
+      }
+      try {
+        ROTiledStManAccessor accessor(tab, colName, True);
+        rownr_t tileRows = accessor.tileShape(0).last();
+        if (tileRows > 0) {
+          nrow = std::max(nrow / tileRows, rownr_t(1)) * tileRows;
+        }
+      } catch (const AipsError&) {
+        // Not stored in a tiled storage manager.
+      }
+    }
+    return nrow;
+  }
+
+  // Copy the given number of rows of an array column. The transform function
+  // is applied to the array of the rows read before they are written.
+  // If all cells are defined and have the same shape, all rows are copied at
+  // once. Otherwise the defined cells are copied one by one.
+  template<typename T, typename Func>
+  void copyArrayRows(ArrayColumn<T>& thisCol, const ArrayColumn<T>& otherCol,
+                     rownr_t otherRow, rownr_t thisRow, rownr_t nrow,
+                     Func transform)
+  {
+    Bool uniform = otherCol.isDefined(otherRow);
+    if (uniform) {
+      const IPosition shape = otherCol.shape(otherRow);
+      for (rownr_t i=1; i<nrow && uniform; ++i) {
+        uniform = otherCol.isDefined(otherRow+i) &&
+                  otherCol.shape(otherRow+i).isEqual(shape);
+      }
+    }
+    if (uniform) {
+      Array<T> arr = otherCol.getColumnRange
+        (Slicer(IPosition(1, otherRow), IPosition(1, nrow)));
+      transform(arr, 0);
+      thisCol.putColumnRange
+        (Slicer(IPosition(1, thisRow), IPosition(1, nrow)), arr);
+    } else {
+      for (rownr_t i=0; i<nrow; ++i) {
+        if (otherCol.isDefined(otherRow+i)) {
+          Array<T> arr = otherCol.getColumnRange
+            (Slicer(IPosition(1, otherRow+i), IPosition(1, 1)));
+          transform(arr, i);
+          thisCol.putColumnRange
+            (Slicer(IPosition(1, thisRow+i), IPosition(1, 1)), arr);
+        }
+      }
+    }
+  }
+
+  // Reverse the channel axis (the second axis) of each cell in an array
+  // holding the cells of multiple rows.
+  template<typename T>
+  void reverseChannels(Array<T>& arr)
+  {
+    DebugAssert(arr.contiguousStorage(), AipsError);
+    const Int64 ncorr = arr.shape()[0];
+    const Int64 nchan = arr.shape()[1];
+    const Int64 ncell = arr.size() / std::max(ncorr*nchan, Int64(1));
+    T* data = arr.data();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (Int64 c=0; c<ncell; ++c) {
+      T* cell = data + c*ncorr*nchan;
+      for (Int64 k=0; k<nchan/2; ++k) {
+        for (Int64 p=0; p<ncorr; ++p) {
+          std::swap(cell[k*ncorr + p], cell[(nchan-1-k)*ncorr + p]);
+        }
+      }
+    }
+  }
+
+  // Swap the correlations (the first axis) of the cells with a True swapped
+  // flag, where correlation p gets the value of correlation polSwap[p].
+  template<typename T>
+  void swapCorrelations(Array<T>& arr, const Bool* swapped,
+                        const vector<Int>& polSwap)
+  {
+    DebugAssert(arr.contiguousStorage(), AipsError);
+    const Int64 ncorr = arr.shape()[0];
+    const Int64 ncell = arr.shape().last();
+    const Int64 cellSize = arr.size() / std::max(ncell, Int64(1));
+    T* data = arr.data();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<T> tmp(ncorr);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for (Int64 c=0; c<ncell; ++c) {
+        if (swapped[c]) {
+          for (T* vals = data + c*cellSize; vals < data + (c+1)*cellSize;
+               vals += ncorr) {
+            for (Int64 p=0; p<ncorr; ++p) {
+              tmp[p] = vals[polSwap[p]];
+            }
+            for (Int64 p=0; p<ncorr; ++p) {
+              vals[p] = tmp[p];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Conjugate the values of the cells with a True swapped flag.
+  void conjugateCells(Array<Complex>& arr, const Bool* swapped)
+  {
+    DebugAssert(arr.contiguousStorage(), AipsError);
+    const Int64 ncell = arr.shape().last();
+    const Int64 cellSize = arr.size() / std::max(ncell, Int64(1));
+    Complex* data = arr.data();
+    for (Int64 c=0; c<ncell; ++c) {
+      if (swapped[c]) {
+        for (Complex* val = data + c*cellSize; val < data + (c+1)*cellSize;
+             ++val) {
+          *val = conj(*val);
+        }
+      }
+    }
+  }
+
+  // Negate the values of the cells with a True swapped flag.
+  void negateCells(Array<Double>& arr, const Bool* swapped)
+  {
+    DebugAssert(arr.contiguousStorage(), AipsError);
+    const Int64 ncell = arr.shape().last();
+    const Int64 cellSize = arr.size() / std::max(ncell, Int64(1));
+    Double* data = arr.data();
+    for (Int64 c=0; c<ncell; ++c) {
+      if (swapped[c]) {
+        for (Double* val = data + c*cellSize; val < data + (c+1)*cellSize;
+             ++val) {
+          *val = -*val;
+        }
+      }
+    }
+  }
+
+  // Make a dense id map from the map of the subtable rows.
+  Vector<Int> makeIdMap(const Block<uInt>& newIndices)
+  {
+    Vector<Int> idMap(newIndices.size());
+    for (uInt i=0; i<newIndices.size(); ++i) {
+      idMap[i] = newIndices[i];
+    }
+    return idMap;
+  }
+
+  // Make a dense id map from a map containing the changed ids only.
+  // The unchanged ids map to themselves.
+  Vector<Int> makeIdMap(const std::map<Int,Int>& changed, rownr_t nid)
+  {
+    Int nmap = nid;
+    for (const auto& x : changed) {
+      nmap = std::max(nmap, x.first + 1);
+    }
+    Vector<Int> idMap(nmap);
+    indgen(idMap);
+    for (const auto& x : changed) {
+      if (x.first >= 0) {
+        idMap[x.first] = x.second;
+      }
+    }
+    return idMap;
+  }
+
+} // end anonymous namespace
+
 MSConcat::MSConcat(MeasurementSet& ms):
   MSColumns(ms),
   itsMS(ms),
@@ -1003,6 +1193,9 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
     log << "Virtually appending " << otherMS.tableName() << " to " << itsMS.tableName() << endl << LogIO::POST;
   }
 
+  itsOtherIdMaps = Record();
+  itsThisIdMaps = Record();
+
   switch(handling){
   case 0: // normal concat
     break;
@@ -1109,6 +1302,7 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
 	<< LogIO::POST;
     doState = True; // i.e. itsMS Main table state id will have to be set to -1
 
+    itsThisIdMaps.define("STATE_ID", Vector<Int>(itsMS.state().nrow(), -1));
     RowNumbers delrows(itsMS.state().nrow());
     indgen(delrows);
     itsMS.state().removeRow(RowNumbers(delrows));
@@ -1270,6 +1464,35 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
     destMS = &tempMS;
   }
 
+  // Keep the id maps of the main table columns.
+  itsOtherIdMaps.define("ANTENNA1", makeIdMap(newAntIndices));
+  itsOtherIdMaps.define("ANTENNA2", makeIdMap(newAntIndices));
+  itsOtherIdMaps.define("DATA_DESC_ID", makeIdMap(newDDIndices));
+  itsOtherIdMaps.define("FIELD_ID", makeIdMap(newFldIndices));
+  if(doState && !otherStateNull){
+    if(itsStateNull){
+      itsOtherIdMaps.define("STATE_ID",
+                            Vector<Int>(otherMS.state().nrow(), -1));
+    }
+    else{
+      itsOtherIdMaps.define("STATE_ID", makeIdMap(newStateIndices));
+    }
+  }
+  if(doObsB_p){
+    itsOtherIdMaps.define("OBSERVATION_ID",
+                          makeIdMap(newObsIndexB_p, otherMS.observation().nrow()));
+  }
+  if(doProcB_p){
+    itsOtherIdMaps.define("PROCESSOR_ID",
+                          makeIdMap(newProcIndexB_p, otherMS.processor().nrow()));
+  }
+  if(doObsA_p){
+    itsThisIdMaps.define("OBSERVATION_ID", makeIdMap(newObsIndexA_p, 0));
+  }
+  if(doProcA_p){
+    itsThisIdMaps.define("PROCESSOR_ID", makeIdMap(newProcIndexA_p, 0));
+  }
+
   // STOP HERE if Main is not to be modified
   if(handling==1 || handling==3){
     return;
@@ -1382,30 +1605,33 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
 
   Vector<Int> obsIds=otherObsId.getColumn();
 
-  if(doObsA_p){ // the obs ids changed for the first table
+  if(doObsA_p && curRow>0){ // the obs ids changed for the first table
     Vector<Int> oldObsIds=thisObsId.getColumn();
     for(rownr_t r = 0; r < curRow; r++) {
       if(newObsIndexA_p.find(oldObsIds[r]) != newObsIndexA_p.end()){ // apply change
-	thisObsId.put(r, getMapValue (newObsIndexA_p, oldObsIds[r]));
+	oldObsIds[r] = getMapValue (newObsIndexA_p, oldObsIds[r]);
       }
     }
+    thisObsId.putColumnRange(Slicer(IPosition(1,0), IPosition(1,curRow)),
+			     oldObsIds(Slice(0,curRow)));
   }
 
   Vector<Int> procIds=otherProcId.getColumn();
 
-  if(doProcA_p){ // the proc ids changed for the first table
+  if(doProcA_p && curRow>0){ // the proc ids changed for the first table
     Vector<Int> oldProcIds=thisProcId.getColumn();
-    for(uInt r = 0; r < curRow; r++) {
+    for(rownr_t r = 0; r < curRow; r++) {
       if(newProcIndexA_p.find(oldProcIds[r]) != newProcIndexA_p.end()){ // apply change
-	thisProcId.put(r, getMapValue (newProcIndexA_p, oldProcIds[r]));
+	oldProcIds[r] = getMapValue (newProcIndexA_p, oldProcIds[r]);
       }
     }
+    thisProcId.putColumnRange(Slicer(IPosition(1,0), IPosition(1,curRow)),
+			      oldProcIds(Slice(0,curRow)));
   }
 
-  if(doState && otherStateNull){ // the state ids for the first table will have to be set to -1
-    for(rownr_t r = 0; r < curRow; r++) {
-      thisStateId.put(r, -1);
-    }
+  if(doState && otherStateNull && curRow>0){ // the state ids for the first table will have to be set to -1
+    thisStateId.putColumnRange(Slicer(IPosition(1,0), IPosition(1,curRow)),
+			       Vector<Int>(curRow, -1));
   }
 
   // SCAN NUMBER
@@ -1497,6 +1723,10 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
     && otherSigmaSp.isDefined(0);
 
   // MAIN
+  // The rows are copied in blocks. The ID columns of a block are remapped
+  // at once. The array columns are copied per run of rows with the same
+  // DATA_DESC_ID (thus the same shape, correlations and channel order) using
+  // a single get and put, after the run has been transformed in memory.
 
   Bool notYetFeedWarned = True;
   Bool doWeightScale = (itsWeightScale!=1. && itsWeightScale>0.);
@@ -1510,345 +1740,246 @@ IPosition MSConcat::isFixedShape(const TableDesc& td) {
   Int polId = -1;
   vector<Int> polSwap;
 
-  for (rownr_t r = 0; r < newRows; r++, curRow++) {
-    // Determine whether we need to swap rows in the visibility matrix
-    // if we change the order of the antennas.  This is done by
-    // creating a mapping that makes sure the receptor numbers remain
-    // correct when the antennas are swapped.
-    /////uInt d = otherDDId(r);
-    Int p = otherDDCols.polarizationId()(otherDDId(r));
-    if (p != polId) {
-      const Matrix<Int> &products = otherPolCols.corrProduct()(p);
-      polSwap.resize(products.shape()(1));
-      for (Int i = 0; i < products.shape()(1); i++) {
-        for (Int j = 0; j < products.shape()(1); j++) {
-          if (products(0, i) == products(1, j) &&
-              products(1, i) == products(0, j)) {
-            polSwap[i] = j;
-            break;
-          }
-        }
-      }
-      polId = p;
-    }
-
-    Int newA1 = newAntIndices[otherAnt1(r)];
-    Int newA2 = newAntIndices[otherAnt2(r)];
-    Bool doConjugateVis = False;
-    if(newA1>newA2){ // swap indices and multiply UVW by -1
-      //cout << "   corrected order r: " << r << " " << newA2 << " " << newA1 << endl;
-      thisAnt1.put(curRow, newA2);
-      thisAnt2.put(curRow, newA1);
-      Array<Double> newUvw;
-      newUvw.assign(otherUvw(r));
-      //cout << "   old UVW " << newUvw;
-      newUvw *= -1.;
-      //cout << ", new UVW " << newUvw << endl;
-      thisUvw.put(curRow, newUvw);
-      doConjugateVis = True;
-    }
-    else{
-      thisAnt1.put(curRow, newA1);
-      thisAnt2.put(curRow, newA2);
-      thisUvw.put(curRow, otherUvw, r);
-    }
-
-    thisDDId.put(curRow, newDDIndices[otherDDId(r)]);
-    thisFieldId.put(curRow, newFldIndices[otherFieldId(r)]);
-
-    Int oid = 0;
-    if(doObsB_p && newObsIndexB_p.find(obsIds[r]) != newObsIndexB_p.end()){
-      // the obs ids have been changed for the table to be appended
-      oid = getMapValue(newObsIndexB_p, obsIds[r]);
-    }
-    else { // this OBS id didn't change
-      oid = obsIds[r];
-    }
-    thisObsId.put(curRow, oid);
-
-    if(oid != obsIds[r]){ // obsid actually changed
-      if(scanOffsetForOid.find(oid) == scanOffsetForOid.end()){ // offset not set, use default
-	scanOffsetForOid[oid] = defaultScanOffset;
+  const rownr_t blockRows = concatBlockRows(otherMS, doFloatData ?
+                                            MS::columnName(MS::FLOAT_DATA) :
+                                            MS::columnName(MS::DATA));
+  for (rownr_t startRow = 0; startRow < newRows; startRow += blockRows) {
+    const rownr_t nrow = std::min(blockRows, newRows - startRow);
+    const Slicer otherRange(IPosition(1, startRow), IPosition(1, nrow));
+    const Slicer thisRange(IPosition(1, curRow), IPosition(1, nrow));
+    Vector<Int> ant1 = otherAnt1.getColumnRange(otherRange);
+    Vector<Int> ant2 = otherAnt2.getColumnRange(otherRange);
+    Vector<Int> feed1 = otherFeed1.getColumnRange(otherRange);
+    Vector<Int> feed2 = otherFeed2.getColumnRange(otherRange);
+    const Vector<Int> ddIds = otherDDId.getColumnRange(otherRange);
+    Vector<Int> newDDIds(nrow);
+    Vector<Int> fieldIds = otherFieldId.getColumnRange(otherRange);
+    Vector<Int> scans = otherScan.getColumnRange(otherRange);
+    Vector<Int> stateIds = otherStateId.getColumnRange(otherRange);
+    Vector<Int> newObsIds(nrow);
+    Vector<Int> newProcIds(nrow);
+    // Tells if the antennas are swapped, thus if the UVW has to be negated
+    // and the visibilities conjugated.
+    Vector<Bool> swapped(nrow);
+
+    for (rownr_t i = 0; i < nrow; i++) {
+      const rownr_t r = startRow + i;
+      if(notYetFeedWarned && (feed1[i]>0 || feed2[i]>0)){
+	log << LogIO::WARN << "MS to be appended contains antennas with multiple feeds. Feed ID reindexing is not implemented.\n"
+	    << LogIO::POST;
+	notYetFeedWarned = False;
       }
-      if(encountered.find(oid)==encountered.end() && scanOffsetForOid.at(oid)!=0){
-	log << LogIO::NORMAL << "Will offset scan numbers by " <<  scanOffsetForOid.at(oid)
-	    << " for observations with Obs ID " << oid
-	    << " in order to make scan numbers unique." << LogIO::POST;
-	encountered[oid] = 0;
-      }
-      thisScan.put(curRow, otherScan(r) + scanOffsetForOid.at(oid));
-    }
-    else{
-      thisScan.put(curRow, otherScan(r));
-    }
-
-    Int procid = 0;
-    if(doProcB_p && newProcIndexB_p.find(procIds[r]) != newProcIndexB_p.end()){
-      // the proc ids have been changed for the table to be appended
-      procid = getMapValue(newProcIndexB_p, procIds[r]);
-    }
-    else { // this PROC id didn't change
-      procid = procIds[r];
-    }
-    thisProcId.put(curRow, procid);
-
-
-    if(doState){
-      if(itsStateNull || otherStateNull){
-	thisStateId.put(curRow, -1);
+      Int newA1 = newAntIndices[ant1[i]];
+      Int newA2 = newAntIndices[ant2[i]];
+      swapped[i] = (newA1>newA2);
+      if(swapped[i]){ // swap indices
+	ant1[i] = newA2;
+	ant2[i] = newA1;
+	std::swap(feed1[i], feed2[i]);
       }
       else{
-	thisStateId.put(curRow, newStateIndices[otherStateId(r)]);
+	ant1[i] = newA1;
+	ant2[i] = newA2;
       }
-    }
-    else{
-      thisStateId.put(curRow, otherStateId, r);
-    }
 
-    if(itsChanReversed[otherDDId(r)]){
+      newDDIds[i] = newDDIndices[ddIds[i]];
+      fieldIds[i] = newFldIndices[fieldIds[i]];
 
-      Vector<Int> datShape;
-      Matrix<Complex> reversedData;
-      Matrix<Float> reversedFloatData;
-      Matrix<Complex> swappedData;
-      if(doFloatData){
-	datShape=otherFloatData.shape(r).asVector();
-	reversedFloatData.resize(datShape[0], datShape[1]);
-      }
-      else{
-	datShape=otherData.shape(r).asVector();
-	reversedData.resize(datShape[0], datShape[1]);
-      }
-      Matrix<Complex> reversedCorrData(datShape[0], datShape[1]);
-      Matrix<Complex> reversedModData(datShape[0], datShape[1]);
-      for (Int k1=0; k1 < datShape[0]; ++k1){
-	for(Int k2=0; k2 < datShape[1]; ++k2){
-	  if(doFloatData){
-	    reversedFloatData(k1,k2)=(Matrix<Float>(otherFloatData(r)))(k1,
-									datShape[1]-1-k2);
-	  }
-	  else{
-	    reversedData(k1,k2)=(Matrix<Complex>(otherData(r)))(k1,
-								datShape[1]-1-k2);
-	  }
-	  if(doModelData){
-	    reversedModData(k1,k2)=(Matrix<Complex>(otherModelData(r)))(k1,
-									datShape[1]-1-k2);
-	  }
-	  if(doCorrectedData){
-	    reversedCorrData(k1,k2)=(Matrix<Complex>(otherCorrectedData(r)))(k1,
-									     datShape[1]-1-k2);
-	  }
-	}
-      }
-      if(doFloatData){
-	thisFloatData.put(curRow, reversedFloatData);
-      }
-      else{
-	if(doConjugateVis){
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(reversedData)).row(polSwap[p]);
-	  }
-	  thisData.put(curRow, conj(swappedData));
-	}
-	else{
-	  thisData.put(curRow, reversedData);
-	}
+      Int oid = 0;
+      if(doObsB_p && newObsIndexB_p.find(obsIds[r]) != newObsIndexB_p.end()){
+	// the obs ids have been changed for the table to be appended
+	oid = getMapValue(newObsIndexB_p, obsIds[r]);
       }
-      if(doCorrectedData){
-	if(doConjugateVis){
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(reversedCorrData)).row(polSwap[p]);
-	  }
-	  thisCorrectedData.put(curRow, conj(swappedData));
-	}
-	else{
-	  thisCorrectedData.put(curRow, reversedCorrData);
-	}
+      else { // this OBS id didn't change
+	oid = obsIds[r];
       }
-      if(doModelData){
-	if(doConjugateVis){
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(reversedModData)).row(polSwap[p]);
-	  }
-	  thisModelData.put(curRow, conj(swappedData));
+      newObsIds[i] = oid;
+
+      if(oid != obsIds[r]){ // obsid actually changed
+	if(scanOffsetForOid.find(oid) == scanOffsetForOid.end()){ // offset not set, use default
+	  scanOffsetForOid[oid] = defaultScanOffset;
 	}
-	else{
-	  thisModelData.put(curRow, reversedModData);
+	if(encountered.find(oid)==encountered.end() && scanOffsetForOid.at(oid)!=0){
+	  log << LogIO::NORMAL << "Will offset scan numbers by " <<  scanOffsetForOid.at(oid)
+	      << " for observations with Obs ID " << oid
+	      << " in order to make scan numbers unique." << LogIO::POST;
+	  encountered[oid] = 0;
 	}
+	scans[i] += scanOffsetForOid.at(oid);
       }
-    }
-    else{ // no reversal
-      Vector<Int> datShape;
-      Matrix<Complex> swappedData;
-      if(doFloatData){
-	thisFloatData.put(curRow, otherFloatData, r);
+
+      if(doProcB_p && newProcIndexB_p.find(procIds[r]) != newProcIndexB_p.end()){
+	// the proc ids have been changed for the table to be appended
+	newProcIds[i] = getMapValue(newProcIndexB_p, procIds[r]);
       }
-      else{
-	if(doConjugateVis){ // conjugate because order of antennas was reversed
-	  datShape=otherData.shape(r).asVector();
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(otherData(r))).row(polSwap[p]);
-	  }
-	  thisData.put(curRow, conj(swappedData));
-	}
-	else{
-	  thisData.put(curRow, otherData, r);
-	}
+      else { // this PROC id didn't change
+	newProcIds[i] = procIds[r];
       }
-      if(doModelData){
-	if(doConjugateVis){
-	  datShape=otherModelData.shape(r).asVector();
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(otherModelData(r))).row(polSwap[p]);
-	  }
-	  thisModelData.put(curRow, conj(swappedData));
+
+      if(doState){
+	if(itsStateNull || otherStateNull){
+	  stateIds[i] = -1;
 	}
 	else{
-	  thisModelData.put(curRow, otherModelData, r);
-	}
-      }
-      if(doCorrectedData){
-	if(doConjugateVis){
-	  datShape=otherCorrectedData.shape(r).asVector();
-	  swappedData.resize(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedData.row(p) = (Matrix<Complex>(otherCorrectedData(r))).row(polSwap[p]);
+	  stateIds[i] = newStateIndices[stateIds[i]];
+	}
+      }
+    }
+
+    thisAnt1.putColumnRange(thisRange, ant1);
+    thisAnt2.putColumnRange(thisRange, ant2);
+    thisFeed1.putColumnRange(thisRange, feed1);
+    thisFeed2.putColumnRange(thisRange, feed2);
+    thisDDId.putColumnRange(thisRange, newDDIds);
+    thisFieldId.putColumnRange(thisRange, fieldIds);
+    thisObsId.putColumnRange(thisRange, newObsIds);
+    thisScan.putColumnRange(thisRange, scans);
+    thisProcId.putColumnRange(thisRange, newProcIds);
+    thisStateId.putColumnRange(thisRange, stateIds);
+    thisTime.putColumnRange(thisRange, otherTime.getColumnRange(otherRange));
+    thisInterval.putColumnRange(thisRange,
+				otherInterval.getColumnRange(otherRange));
+    thisExposure.putColumnRange(thisRange,
+				otherExposure.getColumnRange(otherRange));
+    thisTimeCen.putColumnRange(thisRange,
+			       otherTimeCen.getColumnRange(otherRange));
+    thisArrayId.putColumnRange(thisRange,
+			       otherArrayId.getColumnRange(otherRange));
+    thisFlagRow.putColumnRange(thisRange,
+			       otherFlagRow.getColumnRange(otherRange));
+
+    // Copy the array columns per run of rows with the same DATA_DESC_ID.
+    rownr_t runStart = 0;
+    while (runStart < nrow) {
+      rownr_t runEnd = runStart + 1;
+      while (runEnd < nrow && ddIds[runEnd] == ddIds[runStart]) {
+	runEnd++;
+      }
+      const rownr_t otherRow = startRow + runStart;
+      const rownr_t thisRow = curRow + runStart;
+      const rownr_t runRows = runEnd - runStart;
+      const Bool* runSwapped = swapped.data() + runStart;
+      const Bool anySwapped = anyTrue(swapped(Slice(runStart, runRows)));
+      const Bool reverse = itsChanReversed[ddIds[runStart]];
+
+      // Determine whether we need to swap rows in the visibility matrix
+      // if we change the order of the antennas.  This is done by
+      // creating a mapping that makes sure the receptor numbers remain
+      // correct when the antennas are swapped.
+      Int p = otherDDCols.polarizationId()(ddIds[runStart]);
+      if (p != polId) {
+	const Matrix<Int> &products = otherPolCols.corrProduct()(p);
+	polSwap.resize(products.shape()(1));
+	for (Int i = 0; i < products.shape()(1); i++) {
+	  polSwap[i] = i;
+	  for (Int j = 0; j < products.shape()(1); j++) {
+	    if (products(0, i) == products(1, j) &&
+		products(1, i) == products(0, j)) {
+	      polSwap[i] = j;
+	      break;
+	    }
 	  }
-	  thisCorrectedData.put(curRow, conj(swappedData));
-	}
-	else{
-	  thisCorrectedData.put(curRow, otherCorrectedData, r);
 	}
+	polId = p;
       }
-    } // end if itsChanReversed
 
-    if(doWeightScale){
-      if(doConjugateVis){
-	Vector<Int> datShape=otherWeight.shape(r).asVector();
-	Vector<Float> swappedWeight(datShape[0]);
-	for (Int p = 0; p < datShape[0]; p++) {
-	  swappedWeight(p) = (Vector<Float>(otherWeight(r)))(polSwap[p]);
-	}
-	thisWeight.put(curRow, swappedWeight*itsWeightScale);
-	if (copyWtSp) {
-	  datShape.assign(otherWeightSp.shape(r).asVector());
-	  Matrix<Float> swappedWeightSp(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedWeightSp.row(p) = (Matrix<Float>(otherWeightSp(r))).row(polSwap[p]);
-	  }
-	  thisWeightSp.put(curRow, swappedWeightSp*itsWeightScale);
-	}
-	datShape.assign(otherSigma.shape(r).asVector());
-	Vector<Float> swappedSigma(datShape[0]);
-	for (Int p = 0; p < datShape[0]; p++) {
-	  swappedSigma(p) = (Vector<Float>(otherSigma(r)))(polSwap[p]);
-	}
-	thisSigma.put(curRow, swappedSigma*sScale);
-	if (copySgSp) {
-	  datShape.assign(otherSigmaSp.shape(r).asVector());
-	  Matrix<Float> swappedSigmaSp(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedSigmaSp.row(p) = (Matrix<Float>(otherSigmaSp(r))).row(polSwap[p]);
-	  }
-	  thisSigmaSp.put(curRow, swappedSigmaSp*sScale);
-	}
-      }
-      else {
-	thisWeight.put(curRow, otherWeight(r)*itsWeightScale);
-	if (copyWtSp)
-	  thisWeightSp.put(curRow, otherWeightSp(r)*itsWeightScale);
-	thisSigma.put(curRow, otherSigma(r)*sScale);
-	if (copySgSp)
-	  thisSigmaSp.put(curRow, otherSigmaSp(r)*sScale);
-      }
-    }
-    else{
-      if (doConjugateVis){
-	Vector<Int> datShape=otherWeight.shape(r).asVector();
-	Vector<Float> swappedWeight(datShape[0]);
-	for (Int p = 0; p < datShape[0]; p++) {
-	  swappedWeight(p) = (Vector<Float>(otherWeight(r)))(polSwap[p]);
-	}
-	thisWeight.put(curRow, swappedWeight);
-	if (copyWtSp) {
-	  datShape.assign(otherWeightSp.shape(r).asVector());
-	  Matrix<Float> swappedWeightSp(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedWeightSp.row(p) = (Matrix<Float>(otherWeightSp(r))).row(polSwap[p]);
-	  }
-	  thisWeightSp.put(curRow, swappedWeightSp);
-	}
-	datShape.assign(otherSigma.shape(r).asVector());
-	Vector<Float> swappedSigma(datShape[0]);
-	for (Int p = 0; p < datShape[0]; p++) {
-	  swappedSigma(p) = (Vector<Float>(otherSigma(r)))(polSwap[p]);
+      // The data are channel reversed if needed. The visibilities are also
+      // conjugated and their correlations swapped for swapped antennas.
+      auto visTransform = [&](Array<Complex>& arr, rownr_t first) {
+	if (reverse) {
+	  reverseChannels(arr);
 	}
-	thisSigma.put(curRow, swappedSigma);
-	if (copySgSp) {
-	  datShape.assign(otherSigmaSp.shape(r).asVector());
-	  Matrix<Float> swappedSigmaSp(datShape[0], datShape[1]);
-	  for (Int p = 0; p < datShape[0]; p++) {
-	    swappedSigmaSp.row(p) = (Matrix<Float>(otherSigmaSp(r))).row(polSwap[p]);
-	  }
-	  thisSigmaSp.put(curRow, swappedSigmaSp);
+	if (anySwapped) {
+	  swapCorrelations(arr, runSwapped + first, polSwap);
+	  conjugateCells(arr, runSwapped + first);
 	}
+      };
+      if(doFloatData){
+	copyArrayRows(thisFloatData, otherFloatData, otherRow, thisRow, runRows,
+		      [&](Array<Float>& arr, rownr_t) {
+			if (reverse) {
+			  reverseChannels(arr);
+			}
+		      });
       }
       else{
-	thisWeight.put(curRow, otherWeight, r);
-	if (copyWtSp) thisWeightSp.put(curRow, otherWeightSp, r);
-	thisSigma.put(curRow, otherSigma, r);
-	if (copySgSp) thisSigmaSp.put(curRow, otherSigmaSp, r);
+	copyArrayRows(thisData, otherData, otherRow, thisRow, runRows,
+		      visTransform);
       }
-    }
-
-    if(notYetFeedWarned && (otherFeed1(r)>0 || otherFeed2(r)>0)){
-      log << LogIO::WARN << "MS to be appended contains antennas with multiple feeds. Feed ID reindexing is not implemented.\n"
-	  << LogIO::POST;
-      notYetFeedWarned = False;
-    }
-
-    if(doConjugateVis){
-      thisFeed1.put(curRow, otherFeed2, r);
-      thisFeed2.put(curRow, otherFeed1, r);
-    }
-    else{
-      thisFeed1.put(curRow, otherFeed1, r);
-      thisFeed2.put(curRow, otherFeed2, r);
-    }
-
-    thisTime.put(curRow, otherTime, r);
-    thisInterval.put(curRow, otherInterval, r);
-    thisExposure.put(curRow, otherExposure, r);
-    thisTimeCen.put(curRow, otherTimeCen, r);
-    thisArrayId.put(curRow, otherArrayId, r);
-    if(doConjugateVis){
-      Vector<Int> datShape=otherFlag.shape(r).asVector();
-      Matrix<Bool> swappedFlag(datShape[0], datShape[1]);
-      for (Int p = 0; p < datShape[0]; p++) {
-	swappedFlag.row(p) = (Matrix<Bool>(otherFlag(r))).row(polSwap[p]);
+      if(doModelData){
+	copyArrayRows(thisModelData, otherModelData, otherRow, thisRow,
+		      runRows, visTransform);
       }
-      thisFlag.put(curRow, swappedFlag);
+      if(doCorrectedData){
+	copyArrayRows(thisCorrectedData, otherCorrectedData, otherRow, thisRow,
+		      runRows, visTransform);
+      }
+
+      // The weights are scaled if needed. The columns per channel
+      // (spectra and flags) are channel reversed like the data.
+      auto weightTransform = [&](Array<Float>& arr, rownr_t first) {
+	if (anySwapped) {
+	  swapCorrelations(arr, runSwapped + first, polSwap);
+	}
+	if (doWeightScale) {
+	  arr *= itsWeightScale;
+	}
+      };
+      auto sigmaTransform = [&](Array<Float>& arr, rownr_t first) {
+	if (anySwapped) {
+	  swapCorrelations(arr, runSwapped + first, polSwap);
+	}
+	if (doWeightScale) {
+	  arr *= sScale;
+	}
+      };
+      auto flagTransform = [&](Array<Bool>& arr, rownr_t first) {
+	if (reverse) {
+	  reverseChannels(arr);
+	}
+	if (anySwapped) {
+	  swapCorrelations(arr, runSwapped + first, polSwap);
+	}
+      };
+      copyArrayRows(thisWeight, otherWeight, otherRow, thisRow, runRows,
+		    weightTransform);
+      if (copyWtSp) {
+	copyArrayRows(thisWeightSp, otherWeightSp, otherRow, thisRow, runRows,
+		      [&](Array<Float>& arr, rownr_t first) {
+			if (reverse) {
+			  reverseChannels(arr);
+			}
+			weightTransform(arr, first);
+		      });
+      }
+      copyArrayRows(thisSigma, otherSigma, otherRow, thisRow, runRows,
+		    sigmaTransform);
+      if (copySgSp) {
+	copyArrayRows(thisSigmaSp, otherSigmaSp, otherRow, thisRow, runRows,
+		      [&](Array<Float>& arr, rownr_t first) {
+			if (reverse) {
+			  reverseChannels(arr);
+			}
+			sigmaTransform(arr, first);
+		      });
+      }
+      copyArrayRows(thisFlag, otherFlag, otherRow, thisRow, runRows,
+		    flagTransform);
       if (copyFlagCat) {
-	datShape.assign(otherFlagCat.shape(r).asVector());
-	Cube<Bool> swappedFlagCat(datShape[0], datShape[1], datShape[2]);
-	for (Int p = 0; p < datShape[0]; p++) {
-	  swappedFlagCat.yzPlane(p) = (Cube<Bool>(otherFlagCat(r))).yzPlane(polSwap[p]);
-	}
-	thisFlagCat.put(curRow, swappedFlagCat);
+	copyArrayRows(thisFlagCat, otherFlagCat, otherRow, thisRow, runRows,
+		      flagTransform);
       }
-    }
-    else{
-      thisFlag.put(curRow, otherFlag, r);
-      if (copyFlagCat) thisFlagCat.put(curRow, otherFlagCat, r);
-    }
-    thisFlagRow.put(curRow, otherFlagRow, r);
 
+      // UVW is negated for swapped antennas.
+      copyArrayRows(thisUvw, otherUvw, otherRow, thisRow, runRows,
+		    [&](Array<Double>& arr, rownr_t first) {
+		      if (anySwapped) {
+			negateCells(arr, runSwapped + first);
+		      }
+		    });
+      runStart = runEnd;
+    }
+    curRow += nrow;
   } // end for
 
   if(doModelData){ //update the MODEL_DATA keywords
@@ -1877,6 +2008,11 @@ void MSConcat::setRespectForFieldName(const Bool respectFieldName){
   itsRespectForFieldName = respectFieldName;
 }
 
+Bool MSConcat::channelsReversed() const
+{
+  return anyTrue(itsChanReversed);
+}
+
 void MSConcat::checkShape(const IPosition& otherShape) const
 {
   const uInt nAxes = std::min(itsFixedShape.nelements(), otherShape.nelements());
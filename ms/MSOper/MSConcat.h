@@ -30,6 +30,7 @@
 #include <casacore/ms/MeasurementSets/MSColumns.h>
 #include <casacore/ms/MeasurementSets/MeasurementSet.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Containers/Record.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -60,6 +61,17 @@ template <class T> class Block;
 // </etymology>
 //
 // <synopsis>
+// MSConcat appends another MeasurementSet to the MeasurementSet it is
+// constructed with. The subtables are merged and the ids in the main table
+// are remapped accordingly.
+// <br>The main table rows are appended in blocks (a multiple of the tile
+// size if the data are stored in a tiled storage manager). The ids in a
+// block are remapped at once and the array columns are copied with a single
+// get and put per run of rows with the same DATA_DESC_ID.
+// <br>The maps of the ids of the MS appended last can be obtained with
+// functions <src>otherIdMaps</src> and <src>thisIdMaps</src>. They are
+// used by class MSVirtualConcat to remap the ids on the fly instead of
+// rewriting the main table.
 // </synopsis>
 //
 // <example>
@@ -92,6 +104,27 @@ public:
   void setRespectForFieldName(const Bool respectFieldName); //# If True, fields of same direction are not merged
                                                             //# if their name is different
 
+  // Get the maps of the ids in the main table of the MS appended last
+  // by <src>concatenate</src>. The record contains a field for each id
+  // column to remap (e.g. ANTENNA1, FIELD_ID) holding a Vector<Int> which
+  // gives the new id for each old id. Negative ids and ids outside the
+  // vector are not remapped.
+  const Record& otherIdMaps() const
+    { return itsOtherIdMaps; }
+
+  // Get the maps of the ids in the main table of the MS that have changed
+  // due to the last <src>concatenate</src> (the OBSERVATION_ID and
+  // PROCESSOR_ID if redundant rows were removed, STATE_ID if the STATE
+  // table was emptied). The record is empty if no ids changed.
+  const Record& thisIdMaps() const
+    { return itsThisIdMaps; }
+
+  // Tell if the channels of a spectral window of the MS appended last by
+  // <src>concatenate</src> matched the channels of an existing spectral
+  // window in reversed order. The data in the main table are only reversed
+  // if the main table is concatenated.
+  Bool channelsReversed() const;
+
 private:
   MSConcat();
   static IPosition isFixedShape(const TableDesc& td);
@@ -152,6 +185,8 @@ private:
   std::map <Int, Int> newProcIndexA_p;
   std::map <Int, Int> newProcIndexB_p;
   std::map <Int, Int> solSystObjects_p;
+  Record itsOtherIdMaps;
+  Record itsThisIdMaps;
 
   Bool doSource_p;
   Bool doSource2_p;
@@ -0,0 +1,206 @@
+//# MSIdMapEngine.cc: Virtual column engine remapping the ids of a forwarded MS
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/ms/MSOper/MSIdMapEngine.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/BaseColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Utilities/DataType.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+MSIdMapEngine::MSIdMapEngine (const String& dataManagerName,
+                              const Record& spec)
+: ForwardColumnEngine (dataManagerName, spec)
+{
+  setSuffix ("_IdMap");
+  if (spec.isDefined("IDMAPS")) {
+    idMaps_p = spec.subRecord ("IDMAPS");
+  }
+}
+
+MSIdMapEngine::MSIdMapEngine (const Table& referencedTable,
+                              const Record& idMaps,
+                              const String& dataManagerName)
+: ForwardColumnEngine (referencedTable, dataManagerName),
+  idMaps_p            (idMaps)
+{
+  setSuffix ("_IdMap");
+}
+
+MSIdMapEngine::~MSIdMapEngine()
+{}
+
+DataManager* MSIdMapEngine::clone() const
+{
+  return new MSIdMapEngine (refTable(), idMaps_p, dataManagerName());
+}
+
+Vector<Int> MSIdMapEngine::idMap (const String& columnName) const
+{
+  if (idMaps_p.isDefined (columnName)) {
+    return idMaps_p.asArrayInt (columnName);
+  }
+  return Vector<Int>();
+}
+
+DataManagerColumn* MSIdMapEngine::makeScalarColumn (const String& name,
+                                                    int dataType,
+                                                    const String& dataTypeId)
+{
+  ForwardColumn* colp;
+  if (dataType == TpInt) {
+    colp = new MSIdMapColumn (this, name, dataType, dataTypeId, refTable());
+  } else {
+    colp = new ForwardColumn (this, name, dataType, dataTypeId, refTable());
+  }
+  addForwardColumn (colp);
+  return colp;
+}
+
+DataManagerColumn* MSIdMapEngine::makeIndArrColumn (const String& name,
+                                                    int dataType,
+                                                    const String& dataTypeId)
+{
+  ForwardColumn* colp = new ForwardColumn (this, name, dataType,
+                                           dataTypeId, refTable());
+  addForwardColumn (colp);
+  return colp;
+}
+
+void MSIdMapEngine::create64 (rownr_t)
+{
+  baseCreate();
+  // Keep the maps in a table keyword.
+  table().rwKeywordSet().defineRecord (keywordName ("_MSIdMap_Maps"),
+                                       idMaps_p);
+}
+
+void MSIdMapEngine::prepare()
+{
+  // The maps have to be known before the columns are prepared.
+  const TableRecord& keySet = table().keywordSet();
+  String keyword = keywordName ("_MSIdMap_Maps");
+  if (keySet.isDefined (keyword)) {
+    idMaps_p = keySet.subRecord (keyword).toRecord();
+  }
+  basePrepare();
+}
+
+DataManager* MSIdMapEngine::makeObject (const String& dataManagerName,
+                                        const Record& spec)
+{
+  return new MSIdMapEngine (dataManagerName, spec);
+}
+void MSIdMapEngine::registerClass()
+{
+  DataManager::registerCtor (className(), makeObject);
+}
+String MSIdMapEngine::dataManagerType() const
+{
+  return className();
+}
+String MSIdMapEngine::className()
+{
+  // The prefix tells the library to load if the class is not registered.
+  return "ms.MSIdMapEngine";
+}
+
+Record MSIdMapEngine::dataManagerSpec() const
+{
+  Record spec = ForwardColumnEngine::dataManagerSpec();
+  spec.defineRecord ("IDMAPS", idMaps_p);
+  return spec;
+}
+
+
+
+MSIdMapColumn::MSIdMapColumn (MSIdMapEngine* enginePtr,
+                              const String& name,
+                              int dataType,
+                              const String& dataTypeId,
+                              const Table& refTable)
+: ForwardColumn (enginePtr, name, dataType, dataTypeId, refTable),
+  enginePtr_p   (enginePtr)
+{}
+
+MSIdMapColumn::~MSIdMapColumn()
+{}
+
+void MSIdMapColumn::prepare (const Table& thisTable)
+{
+  idMap_p.reference (enginePtr_p->idMap (columnName()));
+  // A mapped column cannot be written.
+  basePrepare (thisTable, idMap_p.empty());
+}
+
+void MSIdMapColumn::mapIds (Int* ids, size_t nr) const
+{
+  const Int nmap = idMap_p.size();
+  const Int* map = idMap_p.data();
+  for (size_t i=0; i<nr; ++i) {
+    if (ids[i] >= 0  &&  ids[i] < nmap) {
+      ids[i] = map[ids[i]];
+    }
+  }
+}
+
+void MSIdMapColumn::getInt (rownr_t rownr, Int* dataPtr)
+{
+  colPtr()->get (rownr, dataPtr);
+  mapIds (dataPtr, 1);
+}
+
+void MSIdMapColumn::getScalarColumnV (ArrayBase& dataPtr)
+{
+  colPtr()->getScalarColumn (dataPtr);
+  if (! idMap_p.empty()) {
+    Array<Int>& arr = static_cast<Array<Int>&>(dataPtr);
+    Bool deleteIt;
+    Int* ids = arr.getStorage (deleteIt);
+    mapIds (ids, arr.size());
+    arr.putStorage (ids, deleteIt);
+  }
+}
+
+void MSIdMapColumn::getScalarColumnCellsV (const RefRows& rownrs,
+                                           ArrayBase& dataPtr)
+{
+  colPtr()->getScalarColumnCells (rownrs, dataPtr);
+  if (! idMap_p.empty()) {
+    Array<Int>& arr = static_cast<Array<Int>&>(dataPtr);
+    Bool deleteIt;
+    Int* ids = arr.getStorage (deleteIt);
+    mapIds (ids, arr.size());
+    arr.putStorage (ids, deleteIt);
+  }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,240 @@
+//# MSIdMapEngine.h: Virtual column engine remapping the ids of a forwarded MS
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_MSIDMAPENGINE_H
+#define MS_MSIDMAPENGINE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/ForwardCol.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Record.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MSIdMapEngine;
+
+
+// <summary>
+// Forwarding column remapping the ids in the column
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tMSVirtualConcat.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> MSIdMapEngine
+//   <li> ForwardColumn
+// </prerequisite>
+
+// <synopsis>
+// MSIdMapColumn is the column object for an Int column bound to
+// an MSIdMapEngine. If the engine holds an id map for the column, each
+// value read from the referenced column is replaced by its mapped value.
+// Such a column is readonly. Otherwise the column is a plain forwarding
+// column.
+// </synopsis>
+
+class MSIdMapColumn : public ForwardColumn
+{
+public:
+    // Construct it for the given column.
+    MSIdMapColumn (MSIdMapEngine* enginePtr,
+                   const String& columnName,
+                   int dataType,
+                   const String& dataTypeId,
+                   const Table& referencedTable);
+
+    ~MSIdMapColumn();
+
+    // Copy constructor is not needed and therefore forbidden.
+    MSIdMapColumn (const MSIdMapColumn&) = delete;
+
+    // Assignment is not needed and therefore forbidden.
+    MSIdMapColumn& operator= (const MSIdMapColumn&) = delete;
+
+    // Initialize the object. It gets the id map from the engine.
+    // A mapped column is opened readonly.
+    virtual void prepare (const Table& thisTable);
+
+private:
+    // Map the ids in the given array.
+    void mapIds (Int* ids, size_t nr) const;
+
+    // Get the mapped scalar value in the given row.
+    virtual void getInt (rownr_t rownr, Int* dataPtr);
+
+    // Get the mapped scalars in the entire column or in some cells.
+    // <group>
+    void getScalarColumnV (ArrayBase& dataPtr);
+    virtual void getScalarColumnCellsV (const RefRows& rownrs,
+                                        ArrayBase& dataPtr);
+    // </group>
+
+
+    MSIdMapEngine* enginePtr_p;    //# pointer to parent engine
+    Vector<Int>    idMap_p;        //# empty if the column is not mapped
+};
+
+
+
+
+// <summary>
+// Virtual column engine forwarding an MS and remapping its ids
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMSVirtualConcat.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> ForwardColumnEngine
+//   <li> MSConcat
+// </prerequisite>
+
+// <etymology>
+// MSIdMapEngine maps the ids in the main table of an MS.
+// </etymology>
+
+// <synopsis>
+// MSIdMapEngine is a ForwardColumnEngine, thus forwards all columns bound
+// to it to the same columns in the referenced table. In addition it holds
+// an id map for some Int columns (e.g. ANTENNA1, FIELD_ID) which gives the
+// new value for each value in the referenced column. The values are mapped
+// when read, so the referenced table is not changed and no data are copied.
+// Negative values and values exceeding the map are not mapped.
+// <br>It is used by class MSVirtualConcat to map the ids of the main table
+// of an MS to the rows of subtables merged by class MSConcat. The maps are
+// given as a record containing a Vector<Int> for each column to map. They
+// are stored in a keyword of the table, so the mapping is done as well when
+// the table is opened again.
+// <br>The engine is registered with the name <src>ms.MSIdMapEngine</src>,
+// so the table system can find it by loading the casa_ms library and
+// calling its function <src>register_ms</src> (see Register.h) if a table
+// using the engine is opened.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   // Forward the main table of an MS, renumbering antennas 0 and 1.
+//   MeasurementSet ms("my.ms");
+//   Record maps;
+//   maps.define ("ANTENNA1", Vector<Int>({1,0}));
+//   maps.define ("ANTENNA2", Vector<Int>({1,0}));
+//   MSIdMapEngine engine (ms, maps);
+//   SetupNewTable newtab ("mapped.ms", ms.actualTableDesc(), Table::New);
+//   newtab.bindAll (engine);
+//   Table tab (newtab, ms.nrow());
+// </srcblock>
+// </example>
+
+// <motivation>
+// Virtually concatenating many MSs needs remapping of the subtable ids
+// without rewriting the main tables.
+// </motivation>
+
+class MSIdMapEngine : public ForwardColumnEngine
+{
+public:
+    // The constructor used to reconstruct the engine when a table
+    // is read back.
+    MSIdMapEngine (const String& dataManagerName, const Record& spec);
+
+    // Create the engine forwarding to the given table and mapping the ids
+    // in the columns given in the record.
+    MSIdMapEngine (const Table& referencedTable, const Record& idMaps,
+                   const String& dataManagerName = String());
+
+    ~MSIdMapEngine();
+
+    // Copy constructor is not needed and therefore forbidden.
+    MSIdMapEngine (const MSIdMapEngine&) = delete;
+
+    // Assignment is not needed and therefore forbidden.
+    MSIdMapEngine& operator= (const MSIdMapEngine&) = delete;
+
+    // Clone the engine object.
+    DataManager* clone() const;
+
+    // Return the type name of the engine
+    // (i.e. its class name MSIdMapEngine).
+    String dataManagerType() const;
+
+    // Record a record containing data manager specifications.
+    virtual Record dataManagerSpec() const;
+
+    // Get the id map of the given column.
+    // An empty vector is returned if the column is not mapped.
+    Vector<Int> idMap (const String& columnName) const;
+
+    // Return the name of the class.
+    static String className();
+
+    // Register the class name and the static makeObject "constructor".
+    // This will make the engine known to the table system.
+    static void registerClass();
+
+    // Define the "constructor" to construct this engine when a
+    // table is read back.
+    // This "constructor" has to be registered by the user of the engine.
+    // This function gets automatically invoked by the table system.
+    static DataManager* makeObject (const String& dataManagerName,
+                                    const Record& spec);
+
+private:
+    // Create the column object for the scalar column in this engine.
+    // An Int column is an MSIdMapColumn; other columns are forwarded.
+    DataManagerColumn* makeScalarColumn (const String& columnName,
+                                         int dataType,
+                                         const String& dataTypeId);
+
+    // Create the column object for the indirect array column in this
+    // engine. It is a plain forwarding column.
+    DataManagerColumn* makeIndArrColumn (const String& columnName,
+                                         int dataType,
+                                         const String& dataTypeId);
+
+    // Initialize the object for a new table. It stores the id maps
+    // in a table keyword.
+    void create64 (rownr_t initialNrrow);
+
+    // Initialize the engine. It reads the id maps from the table keyword.
+    void prepare();
+
+
+    //# The id maps per column.
+    Record idMaps_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -38,6 +38,7 @@
 #include <casacore/scimath/StatsFramework/ClassicalStatistics.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/casa/Containers/ValueHolder.h>
 
@@ -91,6 +92,7 @@ MSMetaData::MSMetaData(const MeasurementSet *const &ms, const Float maxCacheSize
         File(ms->tableName()).exists() ? 0 : 1, ms
       ),
        _spwInfoStored(False), _forceSubScanPropsToCache(False),
+       _persistScanProps(False),
        _sourceTimes() {}
 
 MSMetaData::~MSMetaData() {}
@@ -4086,9 +4088,14 @@ void MSMetaData::_getScanAndSubScanProperties(
     }
     std::shared_ptr<std::map<SubScanKey, SubScanProperties> > myssprops;
     std::shared_ptr<std::map<ScanKey, ScanProperties> > myscanprops;
-    _computeScanAndSubScanProperties(
-        myscanprops, myssprops, showProgress
-    );
+    if (! _readPersistedScanProperties(myscanprops, myssprops)) {
+        _computeScanAndSubScanProperties(
+            myscanprops, myssprops, showProgress
+        );
+        if (_persistScanProps) {
+            _writePersistedScanProperties(*myscanprops, *myssprops);
+        }
+    }
     scanProps = myscanprops;
     subScanProps = myssprops;
 
@@ -4143,6 +4150,331 @@ void MSMetaData::_getScanAndSubScanProperties(
     }
 }
 
+namespace {
+
+// The persisted scan and subscan properties are kept in a keyword of the
+// MS main table. The version has to be incremented if the layout changes.
+const String persistKeyword = "METADATA_CACHE";
+const Int persistVersion = 1;
+
+template <class T>
+Vector<T> _toVector(const std::set<T>& s) {
+    return Vector<T>(std::vector<T>(s.begin(), s.end()));
+}
+
+template <class T>
+std::set<T> _toSet(const Vector<T>& v) {
+    return std::set<T>(v.begin(), v.end());
+}
+
+template <class T>
+Vector<T> _getVector(const RecordInterface& rec, const String& name) {
+    Vector<T> v;
+    rec.get(name, v);
+    return v;
+}
+
+void _putQuantityMap(
+    RecordInterface& rec, const String& name,
+    const std::map<uInt, Quantity>& m
+) {
+    Vector<uInt> keys(m.size());
+    Vector<Double> values(m.size());
+    Vector<String> units(m.size());
+    uInt i = 0;
+    for (const auto& kv : m) {
+        keys[i] = kv.first;
+        values[i] = kv.second.getValue();
+        units[i] = kv.second.getUnit();
+        ++i;
+    }
+    rec.define(name + "_KEYS", keys);
+    rec.define(name, values);
+    rec.define(name + "_UNITS", units);
+}
+
+std::map<uInt, Quantity> _getQuantityMap(
+    const RecordInterface& rec, const String& name
+) {
+    Vector<uInt> keys = _getVector<uInt>(rec, name + "_KEYS");
+    Vector<Double> values = _getVector<Double>(rec, name);
+    Vector<String> units = _getVector<String>(rec, name + "_UNITS");
+    std::map<uInt, Quantity> m;
+    for (uInt i=0; i<keys.size(); ++i) {
+        m[keys[i]] = Quantity(values[i], units[i]);
+    }
+    return m;
+}
+
+void _putNRowsMap(
+    RecordInterface& rec, const String& name,
+    const std::map<uInt, rownr_t>& m
+) {
+    Vector<uInt> keys(m.size());
+    Vector<Int64> values(m.size());
+    uInt i = 0;
+    for (const auto& kv : m) {
+        keys[i] = kv.first;
+        values[i] = kv.second;
+        ++i;
+    }
+    rec.define(name + "_KEYS", keys);
+    rec.define(name, values);
+}
+
+std::map<uInt, rownr_t> _getNRowsMap(
+    const RecordInterface& rec, const String& name
+) {
+    Vector<uInt> keys = _getVector<uInt>(rec, name + "_KEYS");
+    Vector<Int64> values = _getVector<Int64>(rec, name);
+    std::map<uInt, rownr_t> m;
+    for (uInt i=0; i<keys.size(); ++i) {
+        m[keys[i]] = values[i];
+    }
+    return m;
+}
+
+void _putFirstExposureTimeMap(
+    RecordInterface& rec, const MSMetaData::FirstExposureTimeMap& m
+) {
+    Vector<Int> ddIDs(m.size());
+    Vector<Double> times(m.size()), exposures(m.size());
+    Vector<String> units(m.size());
+    uInt i = 0;
+    for (const auto& kv : m) {
+        ddIDs[i] = kv.first;
+        times[i] = kv.second.first;
+        exposures[i] = kv.second.second.getValue();
+        units[i] = kv.second.second.getUnit();
+        ++i;
+    }
+    rec.define("FIRST_EXPOSURE_DDIDS", ddIDs);
+    rec.define("FIRST_EXPOSURE_TIMES", times);
+    rec.define("FIRST_EXPOSURES", exposures);
+    rec.define("FIRST_EXPOSURE_UNITS", units);
+}
+
+MSMetaData::FirstExposureTimeMap _getFirstExposureTimeMap(
+    const RecordInterface& rec
+) {
+    Vector<Int> ddIDs = _getVector<Int>(rec, "FIRST_EXPOSURE_DDIDS");
+    Vector<Double> times = _getVector<Double>(rec, "FIRST_EXPOSURE_TIMES");
+    Vector<Double> exposures = _getVector<Double>(rec, "FIRST_EXPOSURES");
+    Vector<String> units = _getVector<String>(rec, "FIRST_EXPOSURE_UNITS");
+    MSMetaData::FirstExposureTimeMap m;
+    for (uInt i=0; i<ddIDs.size(); ++i) {
+        m[ddIDs[i]] = std::make_pair(times[i], Quantity(exposures[i], units[i]));
+    }
+    return m;
+}
+
+}
+
+void MSMetaData::removePersistedScanProperties(MeasurementSet& ms) {
+    if (ms.keywordSet().isDefined(persistKeyword)) {
+        ms.rwKeywordSet().removeField(persistKeyword);
+    }
+}
+
+Bool MSMetaData::_readPersistedScanProperties(
+    std::shared_ptr<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
+    std::shared_ptr<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps
+) const {
+    if (! _ms->isRootTable()) {
+        return False;
+    }
+    // Lock the MS to be sure the change counter is up-to-date.
+    Table tab(*_ms);
+    TableLocker locker(tab, FileLocker::Read);
+    const TableRecord& keys = tab.keywordSet();
+    if (! keys.isDefined(persistKeyword)
+        || keys.dataType(persistKeyword) != TpRecord
+    ) {
+        return False;
+    }
+    const TableRecord& rec = keys.subRecord(persistKeyword);
+    if (
+        ! rec.isDefined("VERSION") || rec.asInt("VERSION") != persistVersion
+        || rownr_t(rec.asInt64("NROW")) != tab.nrow()
+        || rec.asuInt("DATA_CHANGE_COUNTER") != tab.getDataChangeCounter()
+    ) {
+        return False;
+    }
+    // The spectral windows are derived using the DATA_DESCRIPTION table.
+    Vector<uInt> ddIDToSpw(getDataDescIDToSpwMap());
+    Vector<uInt> persistedDDIDToSpw = _getVector<uInt>(rec, "DDID_TO_SPW");
+    if (
+        ddIDToSpw.size() != persistedDDIDToSpw.size()
+        || ! allEQ(ddIDToSpw, persistedDDIDToSpw)
+    ) {
+        return False;
+    }
+    scanProps = std::make_shared<std::map<ScanKey, ScanProperties>>();
+    subScanProps = std::make_shared<std::map<SubScanKey, SubScanProperties>>();
+    const TableRecord& scans = rec.subRecord("SCANS");
+    for (uInt i=0; i<scans.nfields(); ++i) {
+        const TableRecord& srec = scans.subRecord(i);
+        Vector<Int> k = _getVector<Int>(srec, "KEY");
+        ScanKey key;
+        key.obsID = k[0];
+        key.arrayID = k[1];
+        key.scan = k[2];
+        ScanProperties& props = (*scanProps)[key];
+        props.firstExposureTime = _getFirstExposureTimeMap(srec);
+        props.meanInterval = _getQuantityMap(srec, "MEAN_INTERVAL");
+        props.spwNRows = _getNRowsMap(srec, "SPW_NROWS");
+        Vector<Double> range = _getVector<Double>(srec, "TIME_RANGE");
+        props.timeRange = std::make_pair(range[0], range[1]);
+        Vector<uInt> spws = _getVector<uInt>(srec, "TIMES_KEYS");
+        Vector<uInt> ntimes = _getVector<uInt>(srec, "TIMES_NELEM");
+        Vector<Double> times = _getVector<Double>(srec, "TIMES");
+        uInt start = 0;
+        for (uInt j=0; j<spws.size(); ++j) {
+            props.times[spws[j]].insert(
+                times.data() + start, times.data() + start + ntimes[j]
+            );
+            start += ntimes[j];
+        }
+    }
+    const TableRecord& subScans = rec.subRecord("SUBSCANS");
+    for (uInt i=0; i<subScans.nfields(); ++i) {
+        const TableRecord& srec = subScans.subRecord(i);
+        Vector<Int> k = _getVector<Int>(srec, "KEY");
+        SubScanKey key;
+        key.obsID = k[0];
+        key.arrayID = k[1];
+        key.scan = k[2];
+        key.fieldID = k[3];
+        SubScanProperties& props = (*subScanProps)[key];
+        props.acRows = srec.asInt64("AC_NROWS");
+        props.xcRows = srec.asInt64("XC_NROWS");
+        props.antennas = _toSet(_getVector<Int>(srec, "ANTENNAS"));
+        props.beginTime = srec.asDouble("BEGIN_TIME");
+        props.ddIDs = _toSet(_getVector<uInt>(srec, "DDIDS"));
+        props.endTime = srec.asDouble("END_TIME");
+        props.meanInterval = _getQuantityMap(srec, "MEAN_INTERVAL");
+        props.firstExposureTime = _getFirstExposureTimeMap(srec);
+        props.meanExposureTime = Quantity(
+            srec.asDouble("MEAN_EXPOSURE"), srec.asString("MEAN_EXPOSURE_UNIT")
+        );
+        props.spws = _toSet(_getVector<uInt>(srec, "SPWS"));
+        props.spwNRows = _getNRowsMap(srec, "SPW_NROWS");
+        props.stateIDs = _toSet(_getVector<Int>(srec, "STATE_IDS"));
+        Vector<Double> times = _getVector<Double>(srec, "TIMESTAMPS");
+        Vector<Int64> nrows = _getVector<Int64>(srec, "TIMESTAMP_NROWS");
+        Vector<uInt> nddIDs = _getVector<uInt>(srec, "TIMESTAMP_NDDIDS");
+        Vector<Int> ddIDs = _getVector<Int>(srec, "TIMESTAMP_DDIDS");
+        uInt start = 0;
+        for (uInt j=0; j<times.size(); ++j) {
+            TimeStampProperties& tprops = props.timeProps[times[j]];
+            tprops.nrows = nrows[j];
+            tprops.ddIDs.insert(
+                ddIDs.data() + start, ddIDs.data() + start + nddIDs[j]
+            );
+            start += nddIDs[j];
+        }
+    }
+    return True;
+}
+
+void MSMetaData::_writePersistedScanProperties(
+    const std::map<ScanKey, MSMetaData::ScanProperties>& scanProps,
+    const std::map<SubScanKey, MSMetaData::SubScanProperties>& subScanProps
+) const {
+    if (! (_ms->isRootTable() && _ms->isWritable())) {
+        return;
+    }
+    TableRecord scans;
+    uInt n = 0;
+    for (const auto& kv : scanProps) {
+        const ScanKey& key = kv.first;
+        const ScanProperties& props = kv.second;
+        TableRecord srec;
+        Vector<Int> k(3);
+        k[0] = key.obsID;
+        k[1] = key.arrayID;
+        k[2] = key.scan;
+        srec.define("KEY", k);
+        _putFirstExposureTimeMap(srec, props.firstExposureTime);
+        _putQuantityMap(srec, "MEAN_INTERVAL", props.meanInterval);
+        _putNRowsMap(srec, "SPW_NROWS", props.spwNRows);
+        Vector<Double> range(2);
+        range[0] = props.timeRange.first;
+        range[1] = props.timeRange.second;
+        srec.define("TIME_RANGE", range);
+        Vector<uInt> spws(props.times.size()), ntimes(props.times.size());
+        std::vector<Double> times;
+        uInt j = 0;
+        for (const auto& spwTimes : props.times) {
+            spws[j] = spwTimes.first;
+            ntimes[j] = spwTimes.second.size();
+            times.insert(times.end(), spwTimes.second.begin(), spwTimes.second.end());
+            ++j;
+        }
+        srec.define("TIMES_KEYS", spws);
+        srec.define("TIMES_NELEM", ntimes);
+        srec.define("TIMES", Vector<Double>(times));
+        scans.defineRecord(String::toString(n++), srec);
+    }
+    TableRecord subScans;
+    n = 0;
+    for (const auto& kv : subScanProps) {
+        const SubScanKey& key = kv.first;
+        const SubScanProperties& props = kv.second;
+        TableRecord srec;
+        Vector<Int> k(4);
+        k[0] = key.obsID;
+        k[1] = key.arrayID;
+        k[2] = key.scan;
+        k[3] = key.fieldID;
+        srec.define("KEY", k);
+        srec.define("AC_NROWS", Int64(props.acRows));
+        srec.define("XC_NROWS", Int64(props.xcRows));
+        srec.define("ANTENNAS", _toVector(props.antennas));
+        srec.define("BEGIN_TIME", props.beginTime);
+        srec.define("DDIDS", _toVector(props.ddIDs));
+        srec.define("END_TIME", props.endTime);
+        _putQuantityMap(srec, "MEAN_INTERVAL", props.meanInterval);
+        _putFirstExposureTimeMap(srec, props.firstExposureTime);
+        srec.define("MEAN_EXPOSURE", props.meanExposureTime.getValue());
+        srec.define("MEAN_EXPOSURE_UNIT", props.meanExposureTime.getUnit());
+        srec.define("SPWS", _toVector(props.spws));
+        _putNRowsMap(srec, "SPW_NROWS", props.spwNRows);
+        srec.define("STATE_IDS", _toVector(props.stateIDs));
+        Vector<Double> times(props.timeProps.size());
+        Vector<Int64> nrows(props.timeProps.size());
+        Vector<uInt> nddIDs(props.timeProps.size());
+        std::vector<Int> ddIDs;
+        uInt j = 0;
+        for (const auto& tp : props.timeProps) {
+            times[j] = tp.first;
+            nrows[j] = tp.second.nrows;
+            nddIDs[j] = tp.second.ddIDs.size();
+            ddIDs.insert(ddIDs.end(), tp.second.ddIDs.begin(), tp.second.ddIDs.end());
+            ++j;
+        }
+        srec.define("TIMESTAMPS", times);
+        srec.define("TIMESTAMP_NROWS", nrows);
+        srec.define("TIMESTAMP_NDDIDS", nddIDs);
+        srec.define("TIMESTAMP_DDIDS", Vector<Int>(ddIDs));
+        subScans.defineRecord(String::toString(n++), srec);
+    }
+    Table tab(*_ms);
+    TableLocker locker(tab, FileLocker::Write);
+    // Flush first, so the change counter accounts for all data the
+    // properties were computed from.
+    tab.flush();
+    TableRecord rec;
+    rec.define("VERSION", persistVersion);
+    rec.define("NROW", Int64(tab.nrow()));
+    rec.define("DATA_CHANGE_COUNTER", tab.getDataChangeCounter());
+    rec.define("DDID_TO_SPW", Vector<uInt>(getDataDescIDToSpwMap()));
+    rec.defineRecord("SCANS", scans);
+    rec.defineRecord("SUBSCANS", subScans);
+    tab.rwKeywordSet().defineRecord(persistKeyword, rec);
+    tab.flush();
+}
+
 std::map<Double, Double> MSMetaData::_getTimeToTotalBWMap(
     const Vector<Double>& times, const Vector<Int>& ddIDs
 ) {
@@ -515,6 +515,20 @@ public:
     // is often a good idea to cache it if it will be accessed many times.
     void setForceSubScanPropsToCache(Bool b) { _forceSubScanPropsToCache = b; }
 
+    // If True, the scan and subscan properties are written into the
+    // <src>METADATA_CACHE</src> keyword of the MS main table after they
+    // have been computed. Later MSMetaData objects on the same MS read them
+    // from the keyword instead of iterating over the main table, as long as
+    // the number of rows and the data change counter of the main table
+    // (see <linkto class=Table>Table::getDataChangeCounter</linkto>) are the
+    // same as when they were written. The properties are only written if
+    // the MS is a writable root table. The default is False, but persisted
+    // properties are always used if valid.
+    void setPersistScanProperties(Bool b) { _persistScanProps = b; }
+
+    // Remove the persisted scan and subscan properties from the MS.
+    static void removePersistedScanProperties(MeasurementSet& ms);
+
     // get a data structure, consumable by users, representing a summary of the dataset
     Record getSummary() const;
 
@@ -814,6 +828,7 @@ private:
     const vector<const Table*> _taqlTempTable;
 
     mutable Bool _spwInfoStored, _forceSubScanPropsToCache;
+    Bool _persistScanProps;
     vector<std::map<Int, Quantity> > _firstExposureTimeMap;
     mutable vector<Int> _numCorrs, _source_sourceIDs, _field_sourceIDs;
 
@@ -1115,6 +1130,20 @@ private:
         Bool showProgress
     ) const;
 
+    // Read the scan and subscan properties persisted in the MS. False is
+    // returned if they are not persisted or out of date.
+    Bool _readPersistedScanProperties(
+        std::shared_ptr<std::map<ScanKey, ScanProperties> >& scanProps,
+        std::shared_ptr<std::map<SubScanKey, SubScanProperties> >& subScanProps
+    ) const;
+
+    // Persist the scan and subscan properties in the MS if it is a
+    // writable root table.
+    void _writePersistedScanProperties(
+        const std::map<ScanKey, ScanProperties>& scanProps,
+        const std::map<SubScanKey, SubScanProperties>& subScanProps
+    ) const;
+
     std::set<SubScanKey> _getSubScanKeys() const;
 
     // get subscans related to the given scan
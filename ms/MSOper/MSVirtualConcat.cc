@@ -0,0 +1,213 @@
+//# MSVirtualConcat.cc: Concatenate MeasurementSets without copying the data
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSVirtualConcat.h>
+#include <casacore/ms/MSOper/MSConcat.h>
+#include <casacore/ms/MSOper/MSIdMapEngine.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Logging/LogIO.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <iomanip>
+#include <sstream>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // Tell if the antenna map keeps the order of the antennas, so
+  // ANTENNA1 cannot exceed ANTENNA2 after mapping.
+  Bool keepsAntennaOrder(const Record& idMaps)
+  {
+    if (idMaps.isDefined("ANTENNA1")) {
+      const Vector<Int> antMap = idMaps.asArrayInt("ANTENNA1");
+      for (uInt i=1; i<antMap.size(); ++i) {
+        if (antMap[i] < antMap[i-1]) {
+          return False;
+        }
+      }
+    }
+    return True;
+  }
+
+} // end anonymous namespace
+
+
+MSVirtualConcat::MSVirtualConcat()
+: itsFreqTol             (1.0, "Hz"),
+  itsDirTol              (1.0, "mas"),
+  itsRespectForFieldName (False)
+{}
+
+void MSVirtualConcat::setTolerance (const Quantum<Double>& freqTol,
+                                    const Quantum<Double>& dirTol)
+{
+  itsFreqTol = freqTol;
+  itsDirTol  = dirTol;
+}
+
+void MSVirtualConcat::setRespectForFieldName (Bool respectFieldName)
+{
+  itsRespectForFieldName = respectFieldName;
+}
+
+MeasurementSet MSVirtualConcat::concatenate (const Block<String>& msNames,
+                                             const String& outName) const
+{
+  LogIO log(LogOrigin("MSVirtualConcat", "concatenate", WHERE));
+  if (msNames.empty()) {
+    throw AipsError ("MSVirtualConcat: no MeasurementSets given");
+  }
+  MSIdMapEngine::registerClass();
+  const String absName = Path(outName).absoluteName();
+  // The tables are made in a work directory first. The parts are moved
+  // into the new MS when the ConcatTable is written; the rest is removed.
+  const String workDir = File::newUniqueName (Path(absName).dirName(),
+                                              "MSVirtualConcat_tmp")
+                                                         .absoluteName();
+  Directory(workDir).create();
+  const uInt nms = msNames.size();
+  Block<MeasurementSet> mss(nms);
+  for (uInt i=0; i<nms; ++i) {
+    mss[i] = MeasurementSet(msNames[i]);
+  }
+  try {
+    // Merge the subtables into the subtables of an MS without rows.
+    const String holderName = workDir + "/SUBTABLES";
+    {
+      Table holder = TableCopy::makeEmptyTable (holderName, Record(), mss[0],
+                                                Table::New,
+                                                Table::AipsrcEndian,
+                                                True, True);
+      TableCopy::copyInfo (holder, mss[0]);
+      TableCopy::copySubTables (holder, mss[0]);
+    }
+    MeasurementSet holderMS(holderName, Table::Update);
+    Block<Record> idMaps(nms);
+    {
+      MSConcat mscat(holderMS);
+      Quantum<Double> freqTol(itsFreqTol);
+      Quantum<Double> dirTol(itsDirTol);
+      mscat.setTolerance (freqTol, dirTol);
+      mscat.setRespectForFieldName (itsRespectForFieldName);
+      for (uInt i=1; i<nms; ++i) {
+        mscat.concatenate (mss[i], 1);     // do not concatenate MAIN
+        // The data of a spectral window matched in reversed channel order
+        // have to be reversed, which cannot be done virtually.
+        if (mscat.channelsReversed()) {
+          throw AipsError ("MSVirtualConcat: the channels of a spectral "
+                           "window in " + msNames[i] + " are in reversed "
+                           "order; use MSConcat to concatenate it");
+        }
+        // Ids of the MSs merged before might have changed.
+        for (uInt j=0; j<i; ++j) {
+          composeIdMaps (idMaps[j], mscat.thisIdMaps());
+        }
+        idMaps[i] = mscat.otherIdMaps();
+        if (! keepsAntennaOrder (idMaps[i])) {
+          log << LogIO::WARN << "The antennas of " << msNames[i]
+              << " are in another order; ANTENNA1 can exceed ANTENNA2"
+              << " because the antennas are not swapped" << LogIO::POST;
+        }
+      }
+    }
+    Block<Table> parts(nms);
+    for (uInt i=0; i<nms; ++i) {
+      std::ostringstream partName;
+      partName << workDir << "/PART_" << std::setfill('0') << std::setw(4)
+               << i;
+      parts[i] = makePart (mss[i], idMaps[i], partName.str());
+    }
+    // The first part holds the merged subtables.
+    TableCopy::copySubTables (parts[0], holderMS);
+    Table concTab(parts, Block<String>(), "SUBMSS");
+    concTab.rename (absName, Table::New);
+    concTab.flush();
+  } catch (const std::exception&) {
+    Directory(workDir).removeRecursive();
+    throw;
+  }
+  Directory(workDir).removeRecursive();
+  log << LogIO::NORMAL << "Virtually concatenated " << nms
+      << " MeasurementSets into " << absName << LogIO::POST;
+  // Open it again, because the parts have been moved.
+  return MeasurementSet(absName);
+}
+
+MeasurementSet MSVirtualConcat::open (const String& name,
+                                      Table::TableOption option)
+{
+  MSIdMapEngine::registerClass();
+  return MeasurementSet(name, option);
+}
+
+void MSVirtualConcat::composeIdMaps (Record& idMaps,
+                                     const Record& changedIds)
+{
+  for (uInt i=0; i<changedIds.nfields(); ++i) {
+    const String& name = changedIds.name(i);
+    const Vector<Int> changed = changedIds.asArrayInt(i);
+    if (idMaps.isDefined (name)) {
+      Vector<Int> idMap = idMaps.asArrayInt (name);
+      for (Int& id : idMap) {
+        if (id >= 0  &&  id < Int(changed.size())) {
+          id = changed[id];
+        }
+      }
+      idMaps.define (name, idMap);
+    } else {
+      idMaps.define (name, changed);
+    }
+  }
+}
+
+Table MSVirtualConcat::makePart (const MeasurementSet& ms,
+                                 const Record& idMaps,
+                                 const String& name)
+{
+  TableDesc td = ms.actualTableDesc();
+  // Do not refer to the subtables of the MS.
+  TableRecord& keys = td.rwKeywordSet();
+  for (Int i=keys.nfields()-1; i>=0; --i) {
+    if (keys.type(i) == TpTable) {
+      keys.removeField (i);
+    }
+  }
+  SetupNewTable newtab (name, td, Table::New);
+  MSIdMapEngine engine (ms, idMaps);
+  newtab.bindAll (engine);
+  Table part (newtab, ms.nrow());
+  TableCopy::copyInfo (part, ms);
+  return part;
+}
+
+} //# NAMESPACE CASACORE - END
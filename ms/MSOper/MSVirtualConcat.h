@@ -0,0 +1,142 @@
+//# MSVirtualConcat.h: Concatenate MeasurementSets without copying the data
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_MSVIRTUALCONCAT_H
+#define MS_MSVIRTUALCONCAT_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Quanta/Quantum.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Concatenate MeasurementSets without copying their main tables
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tMSVirtualConcat.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> MSConcat
+//   <li> MSIdMapEngine
+//   <li> ConcatTable
+// </prerequisite>
+
+// <synopsis>
+// MSVirtualConcat makes a MeasurementSet which is the concatenation of
+// a number of MeasurementSets (e.g. the subbands of an observation).
+// Unlike MSConcat it does not copy the main tables, so it is fast and
+// takes hardly any disk space.
+// <br>The subtables are merged by MSConcat into the subtables of the new
+// MS. They are usually small, so they are physically copied. For each
+// input MS a table is made forwarding its main table columns by means of
+// an MSIdMapEngine, which maps the ids in the main table (e.g. ANTENNA1,
+// DATA_DESC_ID) on the fly to the rows of the merged subtables.
+// The new MS is the virtual concatenation (a ConcatTable) of these tables,
+// which are stored in its subdirectory SUBMSS.
+// <br>The mapped id columns are readonly, but the other columns can be
+// written if the input MS is writable; the data are written into the
+// input MS.
+// <br>A few things done by MSConcat are not done here, because they
+// require the data to be changed:
+// <ul>
+//  <li> The antennas in a row are not swapped if the merged ANTENNA1
+//       exceeds ANTENNA2 (in which case MSConcat conjugates the data).
+//       A warning is given if that can happen.
+//  <li> The scan numbers are not offset to make them unique.
+//  <li> The channels cannot be reversed, so an exception is thrown if
+//       a spectral window of an input MS matches an existing one with
+//       the opposite frequency order.
+// </ul>
+// The new MS can be opened again as any MS, because the table system
+// loads the casa_ms library to register MSIdMapEngine if needed.
+// Function <src>open</src> registers it explicitly, which is needed if
+// the casa_ms library is linked statically.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Block<String> names(2);
+//   names[0] = "sb0.ms";
+//   names[1] = "sb1.ms";
+//   MSVirtualConcat vconcat;
+//   MeasurementSet ms = vconcat.concatenate (names, "all.ms");
+//   // Later on.
+//   MeasurementSet ms2 ("all.ms");
+// </srcblock>
+// </example>
+
+// <motivation>
+// Many observations consist of hundreds of MSs which are often processed
+// as one. Physically concatenating them takes a lot of time and disk space.
+// </motivation>
+
+class MSVirtualConcat
+{
+public:
+  MSVirtualConcat();
+
+  // Set the tolerances used to match the FIELD and SPECTRAL_WINDOW rows.
+  // See MSConcat for the defaults.
+  void setTolerance (const Quantum<Double>& freqTol,
+                     const Quantum<Double>& dirTol);
+
+  // If True, fields with the same direction but a different name are
+  // not merged.
+  void setRespectForFieldName (Bool respectFieldName);
+
+  // Make the virtually concatenated MS with the given name from the MSs
+  // with the given names. The new MS is returned.
+  MeasurementSet concatenate (const Block<String>& msNames,
+                              const String& outName) const;
+
+  // Open a virtually concatenated MS. It registers MSIdMapEngine first.
+  static MeasurementSet open (const String& name,
+                              Table::TableOption option = Table::Old);
+
+private:
+  // Apply the changed ids of the MS made so far to the id maps of
+  // a previous input MS.
+  static void composeIdMaps (Record& idMaps, const Record& changedIds);
+
+  // Make the table forwarding to the given MS and mapping its ids.
+  // The subtables of the MS are not referenced.
+  static Table makePart (const MeasurementSet& ms, const Record& idMaps,
+                         const String& name);
+
+  Quantum<Double> itsFreqTol;
+  Quantum<Double> itsDirTol;
+  Bool            itsRespectForFieldName;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,44 @@
+//# Register.h: Register the virtual column engines of the ms module
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_REGISTER_H
+#define MS_REGISTER_H
+
+#include <casacore/casa/aips.h>
+
+// <group name=MSRegister>
+// This function registers the virtual column engines of the ms module
+// (MSChanAvgEngine and MSIdMapEngine). Their names are prefixed with
+// <src>ms.</src>, so the table system calls this function after loading
+// the dynamic library casa_ms.so/dylib when a table using such an engine
+// is opened.
+
+extern "C" {
+  void register_ms();
+}
+
+// </group>
+
+#endif
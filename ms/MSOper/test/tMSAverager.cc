@@ -0,0 +1,357 @@
+//# tMSAverager.cc: Test program for classes MSAverager and MSChanAvgEngine
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSAverager.h>
+#include <casacore/ms/MSOper/MSChanAvgEngine.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+const Int nant  = 4;
+const Int ncorr = 2;
+const Int nchan = 6;
+const Int ntime = 4;
+
+// Make an MS with 4 antennas on a line, 4 time slots of 10 seconds and
+// 6 channels. The real part of the data is 10*time+channel, the imaginary
+// part 4*ant1+ant2. The weight of time slot t is 1+t.
+// Channel 0 of the first correlation of baseline 0-1 is flagged in slot 1.
+void makeMS (const String& name)
+{
+  TableDesc td = MeasurementSet::requiredTableDesc();
+  MeasurementSet::addColumnToDesc (td, MS::DATA, 2);
+  SetupNewTable newtab(name, td, Table::New);
+  MeasurementSet ms(newtab);
+  ms.createDefaultSubtables (Table::New);
+  MSColumns cols(ms);
+  ms.antenna().addRow (nant);
+  ms.feed().addRow (nant);
+  for (Int i=0; i<nant; ++i) {
+    Vector<Double> pos(3);
+    pos[0] = 3828763. + i*100;
+    pos[1] = 442449. + i*20;
+    pos[2] = 5064923. - i*10;
+    cols.antenna().position().put (i, pos);
+    cols.antenna().mount().put (i, "ALT-AZ");
+    cols.antenna().name().put (i, "A" + String::toString(i));
+    cols.antenna().station().put (i, "S" + String::toString(i));
+    cols.antenna().dishDiameter().put (i, 25.);
+    cols.feed().antennaId().put (i, i);
+    cols.feed().spectralWindowId().put (i, -1);
+    cols.feed().numReceptors().put (i, 1);
+    cols.feed().beamOffset().put (i, Matrix<Double>(2,1,0.));
+    cols.feed().polarizationType().put (i, Vector<String>(1,"X"));
+    cols.feed().polResponse().put (i, Matrix<Complex>(1,1,Complex(0)));
+    cols.feed().position().put (i, Vector<Double>(3,0.));
+    cols.feed().receptorAngle().put (i, Vector<Double>(1,0.));
+  }
+  ms.field().addRow();
+  Matrix<Double> dir(2,1);
+  dir(0,0) = 1.;
+  dir(1,0) = 0.9;
+  cols.field().phaseDir().put (0, dir);
+  cols.field().delayDir().put (0, dir);
+  cols.field().referenceDir().put (0, dir);
+  cols.field().name().put (0, "F");
+  cols.field().numPoly().put (0, 0);
+  // No telescope name, so MSIter does not need the Observatories table.
+  ms.observation().addRow();
+  ms.spectralWindow().addRow();
+  Vector<Double> freqs(nchan);
+  indgen (freqs, 1.4e9, 1e6);
+  cols.spectralWindow().numChan().put (0, nchan);
+  cols.spectralWindow().chanFreq().put (0, freqs);
+  cols.spectralWindow().chanWidth().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().effectiveBW().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().resolution().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().refFrequency().put (0, 1.4e9);
+  cols.spectralWindow().totalBandwidth().put (0, nchan*1e6);
+  cols.spectralWindow().measFreqRef().put (0, MFrequency::TOPO);
+  ms.polarization().addRow();
+  cols.polarization().numCorr().put (0, ncorr);
+  Vector<Int> corrType(ncorr);
+  corrType[0] = 9;
+  corrType[1] = 12;
+  cols.polarization().corrType().put (0, corrType);
+  cols.polarization().corrProduct().put (0, Matrix<Int>(2,ncorr,0));
+  ms.dataDescription().addRow();
+  cols.dataDescription().spectralWindowId().put (0, 0);
+  cols.dataDescription().polarizationId().put (0, 0);
+  rownr_t row = 0;
+  for (Int t=0; t<ntime; ++t) {
+    for (Int a1=0; a1<nant; ++a1) {
+      for (Int a2=a1; a2<nant; ++a2) {
+        ms.addRow();
+        cols.time().put (row, 4.8e9 + 10*t);
+        cols.timeCentroid().put (row, 4.8e9 + 10*t);
+        cols.interval().put (row, 10.);
+        cols.exposure().put (row, 10.);
+        cols.scanNumber().put (row, 1);
+        cols.antenna1().put (row, a1);
+        cols.antenna2().put (row, a2);
+        cols.uvw().put (row, Vector<Double>(3, t));
+        Matrix<Complex> data(ncorr, nchan);
+        for (Int j=0; j<nchan; ++j) {
+          for (Int c=0; c<ncorr; ++c) {
+            data(c,j) = Complex(10*t + j, 4*a1 + a2);
+          }
+        }
+        cols.data().put (row, data);
+        Matrix<Bool> flags(ncorr, nchan, False);
+        if (t == 1  &&  a1 == 0  &&  a2 == 1) {
+          flags(0,0) = True;
+        }
+        cols.flag().put (row, flags);
+        // A single flag category set for the first 4 channels and for all
+        // channels in even time slots.
+        Cube<Bool> category(ncorr, nchan, 1, False);
+        for (Int j=0; j<nchan; ++j) {
+          for (Int c=0; c<ncorr; ++c) {
+            category(c,j,0) = (j < 4  ||  t%2 == 0);
+          }
+        }
+        cols.flagCategory().put (row, category);
+        cols.flagRow().put (row, False);
+        cols.weight().put (row, Vector<Float>(ncorr, 1.+t));
+        cols.sigma().put (row, Vector<Float>(ncorr, 1.));
+        row++;
+      }
+    }
+  }
+}
+
+// Find the row of the given baseline and time.
+rownr_t findRow (const MeasurementSet& ms, Int a1, Int a2, Double time)
+{
+  MSMainColumns cols(ms);
+  for (rownr_t row=0; row<ms.nrow(); ++row) {
+    if (cols.antenna1()(row) == a1  &&  cols.antenna2()(row) == a2  &&
+        near (cols.time()(row), time)) {
+      return row;
+    }
+  }
+  throw AipsError ("row not found");
+}
+
+void testKernel()
+{
+  // Two rows, three channels, one correlation averaged in bins of 2.
+  Cube<Complex> data(1, 3, 2);
+  Cube<Bool> flags(1, 3, 2, False);
+  Cube<Float> weights(1, 3, 2, 1.);
+  indgen (data);
+  flags(0,2,0) = True;
+  flags(0,2,1) = True;
+  weights(0,0,1) = 3.;
+  Vector<rownr_t> rows(2);
+  rows[0] = 0;
+  rows[1] = 1;
+  Matrix<Complex> result(1, 2);
+  MSAverager::averageData (data, flags, weights, rows, 2, result);
+  // (0 + 1 + 3*3 + 4) / 6
+  AlwaysAssertExit (near (result(0,0), Complex(14./6.)));
+  // All flagged, so unweighted mean of 2 and 5.
+  AlwaysAssertExit (near (result(0,1), Complex(3.5)));
+  Matrix<Bool> resFlags(1, 2);
+  Matrix<Float> resWeights(1, 2);
+  MSAverager::averageFlags (flags, weights, rows, 2, resFlags, resWeights);
+  AlwaysAssertExit (!resFlags(0,0)  &&  resFlags(0,1));
+  AlwaysAssertExit (near (resWeights(0,0), 6.f)  &&  resWeights(0,1) == 0);
+  // Only the first row.
+  MSAverager::averageData (data, flags, weights, rows(Slice(0,1)), 2,
+                           result);
+  AlwaysAssertExit (near (result(0,0), Complex(0.5)));
+  // A result with a wrong shape is an error.
+  Matrix<Complex> wrong(1, 3);
+  Bool failed = False;
+  try {
+    MSAverager::averageData (data, flags, weights, rows, 2, wrong);
+  } catch (const AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testAverage (const MeasurementSet& ms)
+{
+  MSAverager averager(ms);
+  averager.setTimeBin (20.);
+  averager.setChanBin (4);
+  MeasurementSet out = averager.average ("tMSAverager_tmp.avg");
+  AlwaysAssertExit (out.nrow() == ms.nrow() / 2);
+  MSColumns cols(out);
+  AlwaysAssertExit (cols.spectralWindow().numChan()(0) == 2);
+  Vector<Double> freqs = cols.spectralWindow().chanFreq()(0);
+  AlwaysAssertExit (near (freqs[0], 1.4015e9)  &&  near (freqs[1], 1.4045e9));
+  Vector<Double> widths = cols.spectralWindow().chanWidth()(0);
+  AlwaysAssertExit (near (widths[0], 4e6)  &&  near (widths[1], 2e6));
+  // Check baseline 0-1 in the first time bin.
+  rownr_t row = findRow (out, 0, 1, 4.8e9 + 5);
+  AlwaysAssertExit (near (cols.interval()(row), 20.));
+  AlwaysAssertExit (near (cols.exposure()(row), 20.));
+  AlwaysAssertExit (allNear (cols.uvw()(row), Vector<Double>(3, 0.5), 1e-10));
+  Matrix<Complex> data = cols.data()(row);
+  AlwaysAssertExit (data.shape() == IPosition(2, ncorr, 2));
+  AlwaysAssertExit (near (data(0,0), Complex(7.8, 1)));
+  AlwaysAssertExit (near (data(1,0), Complex(98./12., 1)));
+  AlwaysAssertExit (near (data(0,1), Complex(67./6., 1)));
+  Matrix<Bool> flags = cols.flag()(row);
+  AlwaysAssertExit (! anyTrue (flags));
+  AlwaysAssertExit (! cols.flagRow()(row));
+  // A category flag is only set if set in both time slots.
+  Cube<Bool> category = cols.flagCategory()(row);
+  AlwaysAssertExit (category.shape() == IPosition(3, ncorr, 2, 1));
+  AlwaysAssertExit (allTrue (category.xzPlane(0))  &&
+                    ! anyTrue (category.xzPlane(1)));
+  Vector<Float> weight = cols.weight()(row);
+  AlwaysAssertExit (near (weight[0], 8.f)  &&  near (weight[1], 9.f));
+  Vector<Float> sigma = cols.sigma()(row);
+  AlwaysAssertExit (near (sigma[0], Float(1/sqrt(8.))));
+  // The id columns are copied.
+  AlwaysAssertExit (cols.scanNumber()(row) == 1);
+  AlwaysAssertExit (cols.dataDescId()(row) == 0);
+}
+
+void testNoAverage (const MeasurementSet& ms)
+{
+  // Without averaging the data is the same.
+  MSAverager averager(ms);
+  MeasurementSet out = averager.average ("tMSAverager_tmp.noavg");
+  AlwaysAssertExit (out.nrow() == ms.nrow());
+  MSMainColumns incols(ms);
+  MSMainColumns outcols(out);
+  AlwaysAssertExit (allEQ (incols.data().getColumn(),
+                           outcols.data().getColumn()));
+  AlwaysAssertExit (allEQ (incols.flag().getColumn(),
+                           outcols.flag().getColumn()));
+  AlwaysAssertExit (allEQ (incols.time().getColumn(),
+                           outcols.time().getColumn()));
+  // The weight of a flagged channel is not counted.
+  rownr_t row = findRow (out, 0, 1, 4.8e9 + 10);
+  AlwaysAssertExit (! allNear (outcols.weight()(row),
+                               Vector<Float>(ncorr, 2.), 1e-6));
+  row = findRow (out, 0, 2, 4.8e9 + 10);
+  AlwaysAssertExit (allNear (outcols.weight()(row),
+                             Vector<Float>(ncorr, 2.), 1e-6));
+}
+
+void testBDA (const MeasurementSet& ms)
+{
+  MSAverager averager(ms);
+  averager.setTimeBin (10.);
+  averager.setMaxTimeBin (40.);
+  MeasurementSet out = averager.average ("tMSAverager_tmp.bda");
+  // The autocorrelations and short baselines are averaged to 1 row,
+  // the medium baselines to 2 rows (the number of bins must divide 4),
+  // the longest one is not averaged.
+  AlwaysAssertExit (out.nrow() == 4 + 3 + 2*2 + 4);
+  MSMainColumns cols(out);
+  Vector<Int> ant1 = cols.antenna1().getColumn();
+  Vector<Int> ant2 = cols.antenna2().getColumn();
+  AlwaysAssertExit (ntrue(ant1 == 0  &&  ant2 == 3) == 4);
+  AlwaysAssertExit (ntrue(ant1 == 0  &&  ant2 == 2) == 2);
+  AlwaysAssertExit (ntrue(ant1 == 1  &&  ant2 == 2) == 1);
+  rownr_t row = findRow (out, 1, 2, 4.8e9 + 15);
+  AlwaysAssertExit (near (cols.interval()(row), 40.));
+  // Each time bin of a medium baseline averages 2 integrations.
+  row = findRow (out, 0, 2, 4.8e9 + 5);
+  AlwaysAssertExit (near (cols.interval()(row), 20.));
+  row = findRow (out, 0, 2, 4.8e9 + 25);
+  AlwaysAssertExit (near (cols.interval()(row), 20.));
+}
+
+void testEngine (const MeasurementSet& ms)
+{
+  MSChanAvgEngine::registerClass();
+  ms.deepCopy ("tMSAverager_tmp.virt", Table::New);
+  {
+    Table tab("tMSAverager_tmp.virt", Table::Update);
+    TableDesc td;
+    td.addColumn (ArrayColumnDesc<Complex>("DATA_AVG"));
+    td.addColumn (ArrayColumnDesc<Bool>("FLAG_AVG"));
+    Record sources;
+    sources.define ("DATA_AVG", "DATA");
+    sources.define ("FLAG_AVG", "FLAG");
+    MSChanAvgEngine engine(4, sources);
+    tab.addColumn (td, engine);
+  }
+  // Compare with the channel averaged MS.
+  MSAverager averager(ms);
+  averager.setChanBin (4);
+  MeasurementSet out = averager.average ("tMSAverager_tmp.chanavg");
+  AlwaysAssertExit (out.nrow() == ms.nrow());
+  MSMainColumns outcols(out);
+  Table tab("tMSAverager_tmp.virt");
+  ArrayColumn<Complex> dataAvg(tab, "DATA_AVG");
+  ArrayColumn<Bool> flagAvg(tab, "FLAG_AVG");
+  AlwaysAssertExit (dataAvg.shape(0) == IPosition(2, ncorr, 2));
+  AlwaysAssertExit (allNear (dataAvg.getColumn(), outcols.data().getColumn(),
+                             1e-6));
+  AlwaysAssertExit (allEQ (flagAvg.getColumn(), outcols.flag().getColumn()));
+  AlwaysAssertExit (allNear (dataAvg(0), outcols.data()(0), 1e-6));
+  // The engine name tells the library to load for it.
+  Record dminfo = tab.dataManagerInfo();
+  Bool found = False;
+  for (uInt i=0; i<dminfo.nfields(); ++i) {
+    found = found  ||
+      dminfo.subRecord(i).asString("TYPE") == "ms.MSChanAvgEngine";
+  }
+  AlwaysAssertExit (found);
+  // Changed flags are used when reading the same row again.
+  {
+    Table tabUpd("tMSAverager_tmp.virt", Table::Update);
+    ArrayColumn<Bool> flagCol(tabUpd, "FLAG");
+    ArrayColumn<Bool> flagAvgUpd(tabUpd, "FLAG_AVG");
+    AlwaysAssertExit (! anyTrue (flagAvgUpd(2)));
+    flagCol.put (2, Matrix<Bool>(ncorr, nchan, True));
+    AlwaysAssertExit (allTrue (flagAvgUpd(2)));
+  }
+}
+
+int main()
+{
+  try {
+    testKernel();
+    makeMS ("tMSAverager_tmp.ms");
+    MeasurementSet ms("tMSAverager_tmp.ms");
+    testAverage (ms);
+    testNoAverage (ms);
+    testBDA (ms);
+    testEngine (ms);
+  } catch (const AipsError& x) {
+    cout << "Exception caught: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,285 @@
+//# tMSConcat.cc: Test program for class MSConcat
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSConcat.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the copy of the main table done by MSConcat.
+// The appended MS can have its antennas in reversed order (so rows get
+// swapped antennas, thus conjugated data and swapped correlations) and
+// its channels in reversed frequency order. Its FLAG_CATEGORY column can
+// contain undefined cells and cells with another shape.
+// </summary>
+
+const Int nant  = 5;
+const Int ncorr = 4;
+const Int nchan = 8;
+const Int ncat  = 2;
+
+// Tell if the FLAG_CATEGORY cell of a row in an irregular MS is undefined
+// or has an extra category.
+Bool undefinedCat (rownr_t row)
+  { return row%7 == 3; }
+Bool extraCat (rownr_t row)
+  { return row%7 == 5; }
+
+void makeMS (const String& name, Double timeOffset, Bool reverseAnt,
+             Bool reverseChan, Bool irregular)
+{
+  TableDesc td = MeasurementSet::requiredTableDesc();
+  MeasurementSet::addColumnToDesc (td, MS::DATA, 2);
+  MeasurementSet::addColumnToDesc (td, MS::WEIGHT_SPECTRUM, 2);
+  SetupNewTable newtab(name, td, Table::New);
+  MeasurementSet ms(newtab);
+  ms.createDefaultSubtables (Table::New);
+  MSColumns cols(ms);
+  ms.antenna().addRow (nant);
+  ms.feed().addRow (nant);
+  for (Int j=0; j<nant; ++j) {
+    // Antenna i is stored in row j.
+    Int i = (reverseAnt  ?  nant-1-j : j);
+    Vector<Double> pos(3);
+    pos[0] = 3828763. + i*100;
+    pos[1] = 442449. + i*20;
+    pos[2] = 5064923. - i*10;
+    cols.antenna().position().put (j, pos);
+    cols.antenna().mount().put (j, "ALT-AZ");
+    cols.antenna().name().put (j, "A" + String::toString(i));
+    cols.antenna().station().put (j, "S" + String::toString(i));
+    cols.antenna().dishDiameter().put (j, 25.);
+    cols.feed().antennaId().put (j, j);
+    cols.feed().spectralWindowId().put (j, -1);
+    cols.feed().numReceptors().put (j, 2);
+    cols.feed().beamOffset().put (j, Matrix<Double>(2,2,0.));
+    cols.feed().polarizationType().put (j, Vector<String>(2,"X"));
+    cols.feed().polResponse().put (j, Matrix<Complex>(2,2,Complex(0)));
+    cols.feed().position().put (j, Vector<Double>(3,0.));
+    cols.feed().receptorAngle().put (j, Vector<Double>(2,0.));
+  }
+  ms.field().addRow();
+  Matrix<Double> dir(2,1);
+  dir(0,0) = 1.;
+  dir(1,0) = 0.9;
+  cols.field().phaseDir().put (0, dir);
+  cols.field().delayDir().put (0, dir);
+  cols.field().referenceDir().put (0, dir);
+  cols.field().name().put (0, "F0");
+  cols.field().numPoly().put (0, 0);
+  ms.observation().addRow();
+  cols.observation().telescopeName().put (0, "T");
+  Vector<Double> timeRange(2);
+  timeRange[0] = 4.8e9;
+  timeRange[1] = 4.9e9;
+  cols.observation().timeRange().put (0, timeRange);
+  ms.spectralWindow().addRow();
+  Vector<Double> freqs(nchan);
+  indgen (freqs, 1.4e9, 1e6);
+  if (reverseChan) {
+    freqs = reverseArray (freqs, 0);
+  }
+  cols.spectralWindow().numChan().put (0, nchan);
+  cols.spectralWindow().chanFreq().put (0, freqs);
+  cols.spectralWindow().chanWidth().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().effectiveBW().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().resolution().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().refFrequency().put (0, 1.4e9);
+  cols.spectralWindow().totalBandwidth().put (0, nchan*1e6);
+  cols.spectralWindow().measFreqRef().put (0, MFrequency::TOPO);
+  ms.polarization().addRow();
+  Vector<Int> corrType(ncorr);
+  indgen (corrType, 9);
+  Matrix<Int> corrProduct(2, ncorr);
+  for (Int c=0; c<ncorr; ++c) {
+    corrProduct(0,c) = c/2;
+    corrProduct(1,c) = c%2;
+  }
+  cols.polarization().numCorr().put (0, ncorr);
+  cols.polarization().corrType().put (0, corrType);
+  cols.polarization().corrProduct().put (0, corrProduct);
+  ms.dataDescription().addRow();
+  cols.dataDescription().spectralWindowId().put (0, 0);
+  cols.dataDescription().polarizationId().put (0, 0);
+  rownr_t row = 0;
+  for (Int t=0; t<30; ++t) {
+    for (Int a1=0; a1<nant; ++a1) {
+      for (Int a2=a1; a2<nant; ++a2) {
+        ms.addRow();
+        cols.time().put (row, 4.8e9 + timeOffset + t*10.);
+        cols.timeCentroid().put (row, 4.8e9 + timeOffset + t*10.);
+        cols.interval().put (row, 10.);
+        cols.exposure().put (row, 10.);
+        cols.scanNumber().put (row, 1 + t/10);
+        cols.antenna1().put (row, a1);
+        cols.antenna2().put (row, a2);
+        Vector<Double> uvw(3);
+        uvw[0] = a1*10 + a2;
+        uvw[1] = t;
+        uvw[2] = row;
+        cols.uvw().put (row, uvw);
+        Matrix<Complex> data(ncorr, nchan);
+        Matrix<Bool> flag(ncorr, nchan);
+        Matrix<Float> wtsp(ncorr, nchan);
+        for (Int c=0; c<ncorr; ++c) {
+          for (Int k=0; k<nchan; ++k) {
+            data(c,k) = Complex(row*100 + c*10 + k, c+1);
+            flag(c,k) = (row + 2*c + k) % 3 == 0;
+            wtsp(c,k) = row*100 + c*10 + k;
+          }
+        }
+        cols.data().put (row, data);
+        cols.flag().put (row, flag);
+        cols.weightSpectrum().put (row, wtsp);
+        Vector<Float> weight(ncorr);
+        indgen (weight, Float(row));
+        cols.weight().put (row, weight);
+        cols.sigma().put (row, weight + Float(10));
+        if (!irregular  ||  !undefinedCat(row)) {
+          Cube<Bool> flagCat(ncorr, nchan,
+                             (irregular && extraCat(row) ? ncat+1 : ncat));
+          for (Int c=0; c<ncorr; ++c) {
+            for (Int k=0; k<nchan; ++k) {
+              for (uInt n=0; n<flagCat.nplane(); ++n) {
+                flagCat(c,k,n) = (row + c + 3*k + n) % 4 == 0;
+              }
+            }
+          }
+          cols.flagCategory().put (row, flagCat);
+        }
+        row++;
+      }
+    }
+  }
+}
+
+// Concatenate and check the rows appended.
+void check (Bool reverseAnt, Bool reverseChan, Bool irregular)
+{
+  makeMS ("tMSConcat_tmp.ms1", 0., False, False, False);
+  makeMS ("tMSConcat_tmp.ms2", 1000., reverseAnt, reverseChan, irregular);
+  MeasurementSet ms1("tMSConcat_tmp.ms1", Table::Update);
+  MeasurementSet ms2("tMSConcat_tmp.ms2");
+  rownr_t nrow1 = ms1.nrow();
+  {
+    MSConcat concat(ms1);
+    concat.concatenate (ms2);
+  }
+  AlwaysAssertExit (ms1.nrow() == nrow1 + ms2.nrow());
+  AlwaysAssertExit (ms1.spectralWindow().nrow() == 1);
+  AlwaysAssertExit (ms1.antenna().nrow() == uInt(nant));
+  MSColumns cols1(ms1);
+  MSColumns cols2(ms2);
+  // The correlation with swapped receptors.
+  const Int polSwap[] = {0, 2, 1, 3};
+  uInt nswapped = 0;
+  for (rownr_t r=0; r<ms2.nrow(); ++r) {
+    rownr_t d = nrow1 + r;
+    Int a1 = cols2.antenna1()(r);
+    Int a2 = cols2.antenna2()(r);
+    if (reverseAnt) {
+      a1 = nant-1 - a1;
+      a2 = nant-1 - a2;
+    }
+    Bool swapped = a1 > a2;
+    if (swapped) {
+      nswapped++;
+    }
+    AlwaysAssertExit (cols1.antenna1()(d) == std::min(a1, a2));
+    AlwaysAssertExit (cols1.antenna2()(d) == std::max(a1, a2));
+    AlwaysAssertExit (cols1.time()(d) == cols2.time()(r));
+    Vector<Double> uvw = cols2.uvw()(r);
+    if (swapped) {
+      uvw *= -1.;
+    }
+    AlwaysAssertExit (allEQ (cols1.uvw()(d), uvw));
+    Matrix<Complex> data2 = cols2.data()(r);
+    Matrix<Complex> data1 = cols1.data()(d);
+    Matrix<Bool> flag2 = cols2.flag()(r);
+    Matrix<Bool> flag1 = cols1.flag()(d);
+    Matrix<Float> wtsp2 = cols2.weightSpectrum()(r);
+    Matrix<Float> wtsp1 = cols1.weightSpectrum()(d);
+    Vector<Float> weight2 = cols2.weight()(r);
+    Vector<Float> weight1 = cols1.weight()(d);
+    Vector<Float> sigma2 = cols2.sigma()(r);
+    Vector<Float> sigma1 = cols1.sigma()(d);
+    AlwaysAssertExit (cols2.flagCategory().isDefined(r) ==
+                      cols1.flagCategory().isDefined(d));
+    Cube<Bool> flagCat1, flagCat2;
+    if (cols2.flagCategory().isDefined(r)) {
+      flagCat2 = cols2.flagCategory()(r);
+      flagCat1 = cols1.flagCategory()(d);
+      AlwaysAssertExit (flagCat1.shape() == flagCat2.shape());
+    }
+    for (Int c=0; c<ncorr; ++c) {
+      Int c2 = (swapped  ?  polSwap[c] : c);
+      AlwaysAssertExit (weight1[c] == weight2[c2]);
+      AlwaysAssertExit (sigma1[c] == sigma2[c2]);
+      for (Int k=0; k<nchan; ++k) {
+        Int k2 = (reverseChan  ?  nchan-1-k : k);
+        Complex val = data2(c2,k2);
+        AlwaysAssertExit (data1(c,k) == (swapped ? conj(val) : val));
+        AlwaysAssertExit (flag1(c,k) == flag2(c2,k2));
+        AlwaysAssertExit (wtsp1(c,k) == wtsp2(c2,k2));
+        for (uInt n=0; n<flagCat1.nplane(); ++n) {
+          AlwaysAssertExit (flagCat1(c,k,n) == flagCat2(c2,k2,n));
+        }
+      }
+    }
+  }
+  AlwaysAssertExit ((nswapped > 0) == reverseAnt);
+  // The first MS is unchanged.
+  makeMS ("tMSConcat_tmp.ms3", 0., False, False, False);
+  MeasurementSet orig("tMSConcat_tmp.ms3");
+  MSColumns cols3(orig);
+  for (rownr_t r=0; r<nrow1; ++r) {
+    AlwaysAssertExit (allEQ (cols1.data()(r), cols3.data()(r)));
+    AlwaysAssertExit (allEQ (cols1.flagCategory()(r),
+                             cols3.flagCategory()(r)));
+  }
+}
+
+int main()
+{
+  try {
+    check (False, False, False);
+    check (True, False, False);
+    check (False, True, False);
+    check (True, True, True);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,172 @@
+//# tMSMetaDataCache.cc: Test persisting the scan properties of MSMetaData
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Quanta/QLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/ms/MSOper/MSMetaData.h>
+#include <casacore/ms/MSOper/MSKeys.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/ms/MeasurementSets/MSDataDescColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+
+#include <casacore/casa/namespace.h>
+
+#include <iostream>
+
+using namespace std;
+
+// Create an MS with 3 scans, each having 2 fields (subscans).
+void createMS(const String& name, Int nAnt, Int nTime) {
+    SetupNewTable newtab(name, MS::requiredTableDesc(), Table::New);
+    MeasurementSet ms(newtab);
+    ms.createDefaultSubtables(Table::New);
+    ms.dataDescription().addRow(2);
+    MSDataDescColumns ddcols(ms.dataDescription());
+    ddcols.spectralWindowId().put(0, 0);
+    ddcols.spectralWindowId().put(1, 1);
+    MSMainColumns cols(ms);
+    rownr_t row = 0;
+    for (Int t=0; t<nTime; ++t) {
+        for (Int ddid=0; ddid<2; ++ddid) {
+            for (Int a1=0; a1<nAnt; ++a1) {
+                for (Int a2=a1; a2<nAnt; ++a2) {
+                    ms.addRow();
+                    cols.time().put(row, 1e9 + 10*t);
+                    cols.interval().put(row, 10);
+                    cols.exposure().put(row, 9);
+                    cols.antenna1().put(row, a1);
+                    cols.antenna2().put(row, a2);
+                    cols.dataDescId().put(row, ddid);
+                    cols.scanNumber().put(row, 1 + t/4);
+                    cols.fieldId().put(row, (t/2)%2);
+                    cols.stateId().put(row, -1);
+                    ++row;
+                }
+            }
+        }
+    }
+}
+
+void compare(
+    const std::map<SubScanKey, MSMetaData::SubScanProperties>& p1,
+    const std::map<SubScanKey, MSMetaData::SubScanProperties>& p2
+) {
+    AlwaysAssertExit(p1.size() == p2.size());
+    auto iter2 = p2.begin();
+    for (const auto& kv : p1) {
+        AlwaysAssertExit(toString(kv.first) == toString(iter2->first));
+        const MSMetaData::SubScanProperties& s1 = kv.second;
+        const MSMetaData::SubScanProperties& s2 = iter2->second;
+        AlwaysAssertExit(s1.acRows == s2.acRows && s1.xcRows == s2.xcRows);
+        AlwaysAssertExit(s1.antennas == s2.antennas);
+        AlwaysAssertExit(s1.beginTime == s2.beginTime);
+        AlwaysAssertExit(s1.endTime == s2.endTime);
+        AlwaysAssertExit(s1.ddIDs == s2.ddIDs && s1.spws == s2.spws);
+        AlwaysAssertExit(s1.spwNRows == s2.spwNRows);
+        AlwaysAssertExit(s1.stateIDs == s2.stateIDs);
+        AlwaysAssertExit(s1.meanExposureTime == s2.meanExposureTime);
+        AlwaysAssertExit(s1.meanInterval.size() == s2.meanInterval.size());
+        for (const auto& mi : s1.meanInterval) {
+            AlwaysAssertExit(mi.second == s2.meanInterval.at(mi.first));
+        }
+        AlwaysAssertExit(s1.timeProps.size() == s2.timeProps.size());
+        for (const auto& tp : s1.timeProps) {
+            const MSMetaData::TimeStampProperties& t2 = s2.timeProps.at(tp.first);
+            AlwaysAssertExit(tp.second.nrows == t2.nrows);
+            AlwaysAssertExit(tp.second.ddIDs == t2.ddIDs);
+        }
+        ++iter2;
+    }
+}
+
+int main() {
+    try {
+        const String name("tMSMetaDataCache_tmp.ms");
+        createMS(name, 4, 12);
+        std::map<SubScanKey, MSMetaData::SubScanProperties> props;
+        {
+            // Compute the properties and persist them.
+            MeasurementSet ms(name, Table::Update);
+            MSMetaData md(&ms, 0);
+            md.setPersistScanProperties(True);
+            props = *md.getSubScanProperties();
+            AlwaysAssertExit(props.size() == 6);
+            AlwaysAssertExit(ms.keywordSet().isDefined("METADATA_CACHE"));
+            // An unchanged MS uses the persisted properties.
+            MSMetaData md2(&ms, 0);
+            compare(props, *md2.getSubScanProperties());
+            AlwaysAssertExit(md2.getScanNumbers(0, 0).size() == 3);
+        }
+        {
+            // Tamper the persisted properties to check they are used.
+            // Changing keywords does not invalidate them.
+            {
+                MeasurementSet ms(name, Table::Update);
+                TableRecord& rec = ms.rwKeywordSet().rwSubRecord("METADATA_CACHE");
+                rec.rwSubRecord("SUBSCANS").rwSubRecord(0).define("BEGIN_TIME", 1.);
+            }
+            MeasurementSet ms(name);
+            MSMetaData md(&ms, 0);
+            AlwaysAssertExit(md.getSubScanProperties()->begin()->second.beginTime == 1.);
+        }
+        {
+            // Changing the data invalidates the persisted properties.
+            {
+                MeasurementSet ms(name, Table::Update);
+                MSMainColumns cols(ms);
+                cols.exposure().put(0, 9);
+            }
+            MeasurementSet ms(name);
+            MSMetaData md(&ms, 0);
+            compare(props, *md.getSubScanProperties());
+        }
+        {
+            // Adding rows invalidates them as well.
+            {
+                MeasurementSet ms(name, Table::Update);
+                MSMainColumns cols(ms);
+                rownr_t row = ms.nrow();
+                ms.addRow();
+                cols.time().put(row, 2e9);
+                cols.interval().put(row, 10);
+                cols.exposure().put(row, 9);
+                cols.scanNumber().put(row, 4);
+                cols.stateId().put(row, -1);
+            }
+            MeasurementSet ms(name, Table::Update);
+            MSMetaData md(&ms, 0);
+            AlwaysAssertExit(md.getSubScanProperties()->size() == 7);
+            MSMetaData::removePersistedScanProperties(ms);
+            AlwaysAssertExit(! ms.keywordSet().isDefined("METADATA_CACHE"));
+        }
+    }
+    catch (const AipsError& x) {
+        cerr << "Exception : " << x.getMesg() << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
@@ -0,0 +1,232 @@
+//# tMSVirtualConcat.cc: Test program for class MSVirtualConcat
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSVirtualConcat.h>
+#include <casacore/ms/MSOper/MSConcat.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// Make an MS with 4 antennas and 1 field, spectral window and time slot.
+// The MSs differ in frequency and/or field direction. The channels can be
+// in reversed frequency order.
+void makeMS (const String& name, Double freq, Double dec, Int rowOffset,
+             Bool reverseChan=False)
+{
+  TableDesc td = MeasurementSet::requiredTableDesc();
+  MeasurementSet::addColumnToDesc (td, MS::DATA, 2);
+  SetupNewTable newtab(name, td, Table::New);
+  MeasurementSet ms(newtab);
+  ms.createDefaultSubtables (Table::New);
+  MSColumns cols(ms);
+  const Int nant = 4;
+  const Int nchan = 4;
+  ms.antenna().addRow (nant);
+  ms.feed().addRow (nant);
+  for (Int i=0; i<nant; ++i) {
+    Vector<Double> pos(3);
+    pos[0] = 3828763. + i*100;
+    pos[1] = 442449. + i*20;
+    pos[2] = 5064923. - i*10;
+    cols.antenna().position().put (i, pos);
+    cols.antenna().mount().put (i, "ALT-AZ");
+    cols.antenna().name().put (i, "A" + String::toString(i));
+    cols.antenna().station().put (i, "S" + String::toString(i));
+    cols.antenna().dishDiameter().put (i, 25.);
+    cols.feed().antennaId().put (i, i);
+    cols.feed().spectralWindowId().put (i, -1);
+    cols.feed().numReceptors().put (i, 1);
+    cols.feed().beamOffset().put (i, Matrix<Double>(2,1,0.));
+    cols.feed().polarizationType().put (i, Vector<String>(1,"X"));
+    cols.feed().polResponse().put (i, Matrix<Complex>(1,1,Complex(0)));
+    cols.feed().position().put (i, Vector<Double>(3,0.));
+    cols.feed().receptorAngle().put (i, Vector<Double>(1,0.));
+  }
+  ms.field().addRow();
+  Matrix<Double> dir(2,1);
+  dir(0,0) = 1.;
+  dir(1,0) = dec;
+  cols.field().phaseDir().put (0, dir);
+  cols.field().delayDir().put (0, dir);
+  cols.field().referenceDir().put (0, dir);
+  cols.field().name().put (0, "F" + String::toString(dec));
+  cols.field().numPoly().put (0, 0);
+  ms.observation().addRow();
+  cols.observation().telescopeName().put (0, "T");
+  Vector<Double> timeRange(2);
+  timeRange[0] = 4.8e9;
+  timeRange[1] = 4.9e9;
+  cols.observation().timeRange().put (0, timeRange);
+  ms.spectralWindow().addRow();
+  Vector<Double> freqs(nchan);
+  indgen (freqs, freq, 1e6);
+  if (reverseChan) {
+    freqs = reverseArray (freqs, 0);
+  }
+  cols.spectralWindow().numChan().put (0, nchan);
+  cols.spectralWindow().chanFreq().put (0, freqs);
+  cols.spectralWindow().chanWidth().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().effectiveBW().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().resolution().put (0, Vector<Double>(nchan, 1e6));
+  cols.spectralWindow().refFrequency().put (0, freq);
+  cols.spectralWindow().totalBandwidth().put (0, nchan*1e6);
+  cols.spectralWindow().measFreqRef().put (0, MFrequency::TOPO);
+  ms.polarization().addRow();
+  cols.polarization().numCorr().put (0, 1);
+  cols.polarization().corrType().put (0, Vector<Int>(1, 9));
+  cols.polarization().corrProduct().put (0, Matrix<Int>(2,1,0));
+  ms.dataDescription().addRow();
+  cols.dataDescription().spectralWindowId().put (0, 0);
+  cols.dataDescription().polarizationId().put (0, 0);
+  rownr_t row = 0;
+  for (Int a1=0; a1<nant; ++a1) {
+    for (Int a2=a1; a2<nant; ++a2) {
+      ms.addRow();
+      cols.time().put (row, 4.8e9);
+      cols.timeCentroid().put (row, 4.8e9);
+      cols.interval().put (row, 10.);
+      cols.exposure().put (row, 10.);
+      cols.scanNumber().put (row, 1);
+      cols.antenna1().put (row, a1);
+      cols.antenna2().put (row, a2);
+      cols.uvw().put (row, Vector<Double>(3, a2-a1));
+      cols.data().put (row, Matrix<Complex>(1, nchan,
+                                            Complex(rowOffset+row, 0)));
+      cols.flag().put (row, Matrix<Bool>(1, nchan, False));
+      cols.weight().put (row, Vector<Float>(1, 1.));
+      cols.sigma().put (row, Vector<Float>(1, 1.));
+      row++;
+    }
+  }
+}
+
+// Check the virtually concatenated MS against the physical one.
+void checkMS (const MeasurementSet& vms, const MeasurementSet& pms)
+{
+  AlwaysAssertExit (vms.nrow() == pms.nrow());
+  AlwaysAssertExit (vms.spectralWindow().nrow() ==
+                    pms.spectralWindow().nrow());
+  AlwaysAssertExit (vms.field().nrow() == pms.field().nrow());
+  AlwaysAssertExit (vms.antenna().nrow() == pms.antenna().nrow());
+  MSMainColumns vcols(vms);
+  MSMainColumns pcols(pms);
+  AlwaysAssertExit (allEQ (vcols.antenna1().getColumn(),
+                           pcols.antenna1().getColumn()));
+  AlwaysAssertExit (allEQ (vcols.antenna2().getColumn(),
+                           pcols.antenna2().getColumn()));
+  AlwaysAssertExit (allEQ (vcols.dataDescId().getColumn(),
+                           pcols.dataDescId().getColumn()));
+  AlwaysAssertExit (allEQ (vcols.fieldId().getColumn(),
+                           pcols.fieldId().getColumn()));
+  AlwaysAssertExit (allEQ (vcols.observationId().getColumn(),
+                           pcols.observationId().getColumn()));
+  AlwaysAssertExit (allEQ (vcols.data().getColumn(),
+                           pcols.data().getColumn()));
+  // Check the cell by cell access and the access of some cells.
+  for (rownr_t i=0; i<vms.nrow(); ++i) {
+    AlwaysAssertExit (vcols.dataDescId()(i) == pcols.dataDescId()(i));
+    AlwaysAssertExit (vcols.fieldId()(i) == pcols.fieldId()(i));
+  }
+  RefRows rows(3, vms.nrow()-1, 4);
+  AlwaysAssertExit (allEQ (vcols.fieldId().getColumnCells(rows),
+                           pcols.fieldId().getColumnCells(rows)));
+}
+
+int main()
+{
+  try {
+    // The second MS has a new frequency and field, the third one has the
+    // frequency of the first and field of the second MS.
+    makeMS ("tMSVirtualConcat_tmp.ms0", 1.4e9, 0.9, 0);
+    makeMS ("tMSVirtualConcat_tmp.ms1", 1.5e9, 0.8, 100);
+    makeMS ("tMSVirtualConcat_tmp.ms2", 1.4e9, 0.8, 200);
+    Block<String> names(3);
+    for (uInt i=0; i<names.size(); ++i) {
+      names[i] = "tMSVirtualConcat_tmp.ms" + String::toString(i);
+    }
+    // Concatenate physically.
+    {
+      Table(names[0]).deepCopy ("tMSVirtualConcat_tmp.phys", Table::New);
+      MeasurementSet pms("tMSVirtualConcat_tmp.phys", Table::Update);
+      MSConcat mscat(pms);
+      for (uInt i=1; i<names.size(); ++i) {
+        mscat.concatenate (MeasurementSet(names[i]));
+      }
+    }
+    MeasurementSet pms("tMSVirtualConcat_tmp.phys");
+    AlwaysAssertExit (pms.spectralWindow().nrow() == 2);
+    AlwaysAssertExit (pms.field().nrow() == 2);
+    // Concatenate virtually and compare.
+    {
+      MSVirtualConcat vconcat;
+      MeasurementSet vms = vconcat.concatenate (names,
+                                                "tMSVirtualConcat_tmp.virt");
+      AlwaysAssertExit (vms.tableInfo().type() == TableInfo::type
+                        (TableInfo::MEASUREMENTSET));
+      checkMS (vms, pms);
+    }
+    // Open it again.
+    MeasurementSet vms = MSVirtualConcat::open ("tMSVirtualConcat_tmp.virt");
+    AlwaysAssertExit (vms.getPartNames().size() == 3);
+    checkMS (vms, pms);
+    // A mapped column cannot be written.
+    AlwaysAssertExit (! vms.isColumnWritable ("FIELD_ID"));
+    // The engine name tells the library to load for it.
+    Record dminfo = Table(vms.getPartNames()[1]).dataManagerInfo();
+    Bool found = False;
+    for (uInt i=0; i<dminfo.nfields(); ++i) {
+      found = found  ||
+        dminfo.subRecord(i).asString("TYPE") == "ms.MSIdMapEngine";
+    }
+    AlwaysAssertExit (found);
+    // An MS with the channels in reversed order cannot be concatenated
+    // virtually.
+    makeMS ("tMSVirtualConcat_tmp.ms3", 1.4e9, 0.9, 300, True);
+    Block<String> revNames(2);
+    revNames[0] = names[0];
+    revNames[1] = "tMSVirtualConcat_tmp.ms3";
+    Bool caught = False;
+    try {
+      MSVirtualConcat().concatenate (revNames, "tMSVirtualConcat_tmp.rev");
+    } catch (const AipsError& x) {
+      caught = True;
+    }
+    AlwaysAssertExit (caught);
+    AlwaysAssertExit (! File("tMSVirtualConcat_tmp.rev").exists());
+  } catch (const AipsError& x) {
+    cout << "Exception caught: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
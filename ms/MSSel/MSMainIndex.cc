@@ -0,0 +1,289 @@
+//# MSMainIndex.cc: index of the key columns of a MeasurementSet main table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSSel/MSMainIndex.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // The name of the subtable containing the index and its version.
+  const String indexName = "ROW_INDEX";
+  const Int indexVersion = 1;
+
+  // A strided range of rows.
+  struct RowRun
+  {
+    rownr_t start;
+    rownr_t incr;
+    rownr_t nrow;
+  };
+
+  // Add a row to the runs of a key value. The row extends the last run
+  // if it continues its stride.
+  void addRowToRuns (std::map<Int64,std::vector<RowRun>>& runs,
+                     Int64 value, rownr_t row)
+  {
+    std::vector<RowRun>& valueRuns = runs[value];
+    if (! valueRuns.empty()) {
+      RowRun& last = valueRuns.back();
+      if (last.nrow == 1) {
+        last.incr = row - last.start;
+        last.nrow = 2;
+        return;
+      }
+      if (row == last.start + last.nrow * last.incr) {
+        last.nrow++;
+        return;
+      }
+    }
+    valueRuns.push_back (RowRun{row, 1, 1});
+  }
+
+}
+
+//-------------------------------------------------------------------------
+
+MSMainIndex::MSMainIndex(const MeasurementSet& ms)
+{
+  if (! hasIndex(ms)) {
+    throw AipsError ("MSMainIndex: MS " + ms.tableName() +
+                     " has no up-to-date " + indexName + " subtable");
+  }
+  Table tab = ms.keywordSet().asTable (indexName);
+  Vector<Int> keys = ScalarColumn<Int>(tab, "KEY").getColumn();
+  Vector<Int64> values = ScalarColumn<Int64>(tab, "VALUE").getColumn();
+  Vector<Int64> start = ScalarColumn<Int64>(tab, "START").getColumn();
+  Vector<Int64> incr = ScalarColumn<Int64>(tab, "INCREMENT").getColumn();
+  Vector<Int64> nrow = ScalarColumn<Int64>(tab, "NROW").getColumn();
+  // The index is ordered by key and value.
+  std::vector<Int64> keyValues[NKEY], keyOffsets[NKEY];
+  std::vector<Int64> keyStart[NKEY], keyIncr[NKEY], keyNrow[NKEY];
+  for (rownr_t i=0; i<keys.size(); ++i) {
+    Int key = keys[i];
+    AlwaysAssert (key >= 0  &&  key < NKEY, AipsError);
+    if (keyValues[key].empty()  ||  keyValues[key].back() != values[i]) {
+      keyValues[key].push_back (values[i]);
+      keyOffsets[key].push_back (keyStart[key].size());
+    }
+    keyStart[key].push_back (start[i]);
+    keyIncr[key].push_back (incr[i]);
+    keyNrow[key].push_back (nrow[i]);
+  }
+  for (Int key=0; key<NKEY; ++key) {
+    keyOffsets[key].push_back (keyStart[key].size());
+    values_p[key]  = Vector<Int64>(keyValues[key]);
+    offsets_p[key] = Vector<Int64>(keyOffsets[key]);
+    start_p[key]   = Vector<Int64>(keyStart[key]);
+    incr_p[key]    = Vector<Int64>(keyIncr[key]);
+    nrow_p[key]    = Vector<Int64>(keyNrow[key]);
+  }
+}
+
+//-------------------------------------------------------------------------
+
+Bool MSMainIndex::hasIndex(const MeasurementSet& ms)
+{
+  if (! ms.keywordSet().isDefined (indexName)  ||
+      ms.keywordSet().dataType (indexName) != TpTable) {
+    return False;
+  }
+  // Lock the MS to be sure the change counter is up-to-date.
+  Table mainTab(ms);
+  TableLocker locker(mainTab, FileLocker::Read);
+  Table tab = ms.keywordSet().asTable (indexName);
+  const TableRecord& keys = tab.keywordSet();
+  return (keys.isDefined ("VERSION")  &&
+          keys.asInt ("VERSION") == indexVersion  &&
+          rownr_t(keys.asInt64 ("MAIN_NROW")) == mainTab.nrow()  &&
+          keys.asuInt ("DATA_CHANGE_COUNTER") ==
+            mainTab.getDataChangeCounter());
+}
+
+//-------------------------------------------------------------------------
+
+void MSMainIndex::makeIndex(MeasurementSet& ms)
+{
+  TableLocker locker(ms, FileLocker::Write);
+  // Flush first, so the change counter accounts for all data.
+  ms.flush();
+  removeIndex (ms);
+  // Collect the runs of each key value, reading the columns in chunks.
+  std::map<Int64,std::vector<RowRun>> runs[NKEY];
+  ScalarColumn<Int> scanCol(ms, MS::columnName(MS::SCAN_NUMBER));
+  ScalarColumn<Int> fieldCol(ms, MS::columnName(MS::FIELD_ID));
+  ScalarColumn<Int> ddidCol(ms, MS::columnName(MS::DATA_DESC_ID));
+  ScalarColumn<Int> ant1Col(ms, MS::columnName(MS::ANTENNA1));
+  ScalarColumn<Int> ant2Col(ms, MS::columnName(MS::ANTENNA2));
+  const rownr_t chunkSize = 1048576;
+  rownr_t nrow = ms.nrow();
+  for (rownr_t row=0; row<nrow; row+=chunkSize) {
+    rownr_t n = std::min (chunkSize, nrow-row);
+    Slicer slicer (IPosition(1, row), IPosition(1, n));
+    Vector<Int> scans  = scanCol.getColumnRange (slicer);
+    Vector<Int> fields = fieldCol.getColumnRange (slicer);
+    Vector<Int> ddids  = ddidCol.getColumnRange (slicer);
+    Vector<Int> ant1   = ant1Col.getColumnRange (slicer);
+    Vector<Int> ant2   = ant2Col.getColumnRange (slicer);
+    for (rownr_t i=0; i<n; ++i) {
+      addRowToRuns (runs[SCAN], scans[i], row+i);
+      addRowToRuns (runs[FIELD], fields[i], row+i);
+      addRowToRuns (runs[DATA_DESC], ddids[i], row+i);
+      addRowToRuns (runs[BASELINE], Int64(ant1[i]) * 4294967296 + ant2[i],
+                    row+i);
+    }
+  }
+  // Write the runs ordered by key and value into the subtable.
+  rownr_t nruns = 0;
+  for (Int key=0; key<NKEY; ++key) {
+    for (const auto& valueRuns : runs[key]) {
+      nruns += valueRuns.second.size();
+    }
+  }
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>   ("KEY", "MSMainIndex key"));
+  td.addColumn (ScalarColumnDesc<Int64> ("VALUE", "key value"));
+  td.addColumn (ScalarColumnDesc<Int64> ("START", "first row of run"));
+  td.addColumn (ScalarColumnDesc<Int64> ("INCREMENT", "row stride of run"));
+  td.addColumn (ScalarColumnDesc<Int64> ("NROW", "number of rows in run"));
+  SetupNewTable newtab (ms.tableName() + '/' + indexName, td, Table::New);
+  Table tab (newtab, nruns);
+  Vector<Int> keys(nruns);
+  Vector<Int64> values(nruns), start(nruns), incr(nruns), nrows(nruns);
+  rownr_t i = 0;
+  for (Int key=0; key<NKEY; ++key) {
+    for (const auto& valueRuns : runs[key]) {
+      for (const RowRun& run : valueRuns.second) {
+        keys[i]   = key;
+        values[i] = valueRuns.first;
+        start[i]  = run.start;
+        incr[i]   = run.incr;
+        nrows[i]  = run.nrow;
+        ++i;
+      }
+    }
+  }
+  ScalarColumn<Int>(tab, "KEY").putColumn (keys);
+  ScalarColumn<Int64>(tab, "VALUE").putColumn (values);
+  ScalarColumn<Int64>(tab, "START").putColumn (start);
+  ScalarColumn<Int64>(tab, "INCREMENT").putColumn (incr);
+  ScalarColumn<Int64>(tab, "NROW").putColumn (nrows);
+  tab.rwKeywordSet().define ("VERSION", indexVersion);
+  tab.rwKeywordSet().define ("MAIN_NROW", Int64(nrow));
+  tab.rwKeywordSet().define ("DATA_CHANGE_COUNTER", ms.getDataChangeCounter());
+  tab.flush();
+  ms.rwKeywordSet().defineTable (indexName, tab);
+  ms.flush();
+}
+
+//-------------------------------------------------------------------------
+
+void MSMainIndex::removeIndex(MeasurementSet& ms)
+{
+  if (ms.keywordSet().isDefined (indexName)) {
+    if (ms.keywordSet().dataType (indexName) == TpTable) {
+      Table tab = ms.keywordSet().asTable (indexName);
+      tab.markForDelete();
+    }
+    ms.rwKeywordSet().removeField (indexName);
+  }
+}
+
+//-------------------------------------------------------------------------
+
+Vector<String> MSMainIndex::columnNames(Key key)
+{
+  switch (key) {
+  case SCAN:
+    return Vector<String>(1, MS::columnName(MS::SCAN_NUMBER));
+  case FIELD:
+    return Vector<String>(1, MS::columnName(MS::FIELD_ID));
+  case DATA_DESC:
+    return Vector<String>(1, MS::columnName(MS::DATA_DESC_ID));
+  case BASELINE:
+    {
+      Vector<String> names(2);
+      names[0] = MS::columnName(MS::ANTENNA1);
+      names[1] = MS::columnName(MS::ANTENNA2);
+      return names;
+    }
+  default:
+    throw AipsError ("MSMainIndex::columnNames: invalid key");
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void MSMainIndex::addRows(std::vector<rownr_t>& rows, Key key, uInt i) const
+{
+  for (Int64 r=offsets_p[key][i]; r<offsets_p[key][i+1]; ++r) {
+    rownr_t row = start_p[key][r];
+    for (Int64 j=0; j<nrow_p[key][r]; ++j) {
+      rows.push_back (row);
+      row += incr_p[key][r];
+    }
+  }
+}
+
+Vector<rownr_t> MSMainIndex::rows(Key key, Int64 value) const
+{
+  std::vector<rownr_t> rows;
+  const Vector<Int64>& vals = values_p[key];
+  const Int64* iter = std::lower_bound (vals.data(), vals.data() + vals.size(),
+                                        value);
+  if (iter != vals.data() + vals.size()  &&  *iter == value) {
+    addRows (rows, key, iter - vals.data());
+    std::sort (rows.begin(), rows.end());
+  }
+  return Vector<rownr_t>(rows);
+}
+
+Vector<rownr_t> MSMainIndex::selectRows(Key key,
+                                        const TableExprNode& node) const
+{
+  std::vector<rownr_t> rows;
+  for (uInt i=0; i<values_p[key].size(); ++i) {
+    // All rows of a value give the same result, so use the first one.
+    Bool selected;
+    node.get (TableExprId(start_p[key][offsets_p[key][i]]), selected);
+    if (selected) {
+      addRows (rows, key, i);
+    }
+  }
+  std::sort (rows.begin(), rows.end());
+  return Vector<rownr_t>(rows);
+}
+
+} //# NAMESPACE CASACORE - END
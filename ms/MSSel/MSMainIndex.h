@@ -0,0 +1,150 @@
+//# MSMainIndex: index of the key columns of a MeasurementSet main table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef MS_MSMAININDEX_H
+#define MS_MSMAININDEX_H
+
+//# includes
+#include <casacore/casa/aips.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Class to handle lookup or indexing into the rows of a MS main table
+// </summary>
+
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="tMSMainIndex" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> MeasurementSet
+//   <li> MSSelection
+// </prerequisite>
+//
+// <etymology>
+// From "MeasurementSet", "main table" and "index".
+// </etymology>
+//
+// <synopsis>
+// This class keeps for the SCAN_NUMBER, FIELD_ID and DATA_DESC_ID
+// columns and the baselines (ANTENNA1,ANTENNA2) of the main table the
+// rows containing each value. The rows are kept as strided row ranges
+// (start, increment, number of rows), so the rows of a scan or field in
+// a time ordered MS, and the rows of a baseline in a regularly
+// shaped MS, take a few ranges only.
+// <br>The index is built once by <src>makeIndex</src> and persisted in
+// the ROW_INDEX subtable of the MS. It is only used if the number of rows
+// and the data change counter of the main table (see
+// <linkto class=Table>Table::getDataChangeCounter</linkto>) are the same
+// as when the index was made.
+// <p>
+// <src>selectRows</src> finds the rows for which a selection expression
+// on one of the keys is true. The expression is evaluated only for the
+// first row of each distinct value, thus it can only depend on the columns
+// of the key. The expressions made by MSSelection for an antenna, field,
+// spectral window or scan selection meet this criterion, so
+// <linkto class=MSSelection>MSSelection::getSelectedMS</linkto> uses the
+// index (if present) to find the selected rows without reading the
+// key columns.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   MeasurementSet ms("my.ms", Table::Update);
+//   MSMainIndex::makeIndex(ms);
+//   // Find the rows of scan 3 without reading SCAN_NUMBER.
+//   MSMainIndex index(ms);
+//   Vector<rownr_t> rows = index.selectRows(MSMainIndex::SCAN,
+//                                           ms.col("SCAN_NUMBER") == 3);
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Selecting a small part of a large MS should not require reading the
+// key columns of all rows.
+// </motivation>
+//
+// <thrown>
+//    <li> AipsError if the MS has no up-to-date index
+// </thrown>
+//
+
+class MSMainIndex
+{
+public:
+  // The keys for which the rows are indexed.
+  enum Key {SCAN, FIELD, DATA_DESC, BASELINE, NKEY};
+
+  // Read the index of the MS.
+  // An exception is thrown if the MS has no up-to-date index.
+  explicit MSMainIndex(const MeasurementSet& ms);
+
+  // Tell if the MS has an up-to-date index.
+  static Bool hasIndex(const MeasurementSet& ms);
+
+  // Build the index of the MS and persist it in its ROW_INDEX subtable.
+  // An existing index is replaced.
+  static void makeIndex(MeasurementSet& ms);
+
+  // Remove the index from the MS.
+  static void removeIndex(MeasurementSet& ms);
+
+  // Get the name of the column(s) forming the key.
+  static Vector<String> columnNames(Key key);
+
+  // Get the distinct values of a key in ascending order.
+  // The value of a baseline is <src>ANTENNA1 * 2^32 + ANTENNA2</src>.
+  const Vector<Int64>& values(Key key) const
+    { return values_p[key]; }
+
+  // Get the rows (in ascending order) having the given key value.
+  Vector<rownr_t> rows(Key key, Int64 value) const;
+
+  // Get the rows (in ascending order) for which the expression is True.
+  // The expression can only depend on the columns of the key.
+  Vector<rownr_t> selectRows(Key key, const TableExprNode& node) const;
+
+private:
+  // Add the rows of the runs of the i-th value of the key to the vector.
+  void addRows(std::vector<rownr_t>& rows, Key key, uInt i) const;
+
+  // Per key the distinct values and the offsets of their runs.
+  Vector<Int64> values_p[NKEY];
+  Vector<Int64> offsets_p[NKEY];
+  // Per key the runs as start row, increment and number of rows.
+  Vector<Int64> start_p[NKEY];
+  Vector<Int64> incr_p[NKEY];
+  Vector<Int64> nrow_p[NKEY];
+};
+
+} //# NAMESPACE CASACORE - END
+
+#endif
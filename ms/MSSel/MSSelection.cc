@@ -25,6 +25,7 @@
 //----------------------------------------------------------------------------
 
 #include <casacore/ms/MSSel/MSSelection.h>
+#include <casacore/ms/MSSel/MSMainIndex.h>
 #include <casacore/ms/MSSel/MSAntennaGram.h>
 #include <casacore/ms/MSSel/MSCorrGram.h>
 #include <casacore/ms/MSSel/MSFieldGram.h>
@@ -50,6 +51,8 @@
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <iterator>
 #include <casacore/ms/MSSel/MSSelectionError.h>
 #include <casacore/ms/MSSel/MSSSpwErrorHandler.h>
 #include <casacore/ms/MSSel/MSSelectionTools.h>
@@ -723,6 +726,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 	      default:  break;
 	      } // Switch
 	    
+	    if (!node.isNull()) exprTEN_p[exprOrder_p[i]] = node;
 	    condition = condition && node;
 	  }//For
 	//
@@ -891,11 +895,65 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       throw(MSSelectionError("MSSelection::getSelectedMS() called without setting the parent MS.\n"
   			     "Hint: Need to use MSSelection::resetMS() perhaps?"));
     //    return baseGetSelectedMS_p(selectedMS, *ms_p, fullTEN_p, outMSName);
+    Vector<rownr_t> rows;
+    if (getIndexedRows(rows))
+      return getSelectedTable(selectedMS, *ms_p, rows, outMSName);
     return getSelectedTable(selectedMS, *ms_p, fullTEN_p, outMSName);
   }
   
   //----------------------------------------------------------------------------
   
+  Bool MSSelection::getIndexedRows(Vector<rownr_t>& rows)
+  {
+    // The TEN of a TaQL expression can contain anything, so it is not
+    // evaluated for a subset of the rows.
+    if (fullTEN_p.isNull() || taqlExpr_p != "" ||
+	!ms_p->isRootTable() || !MSMainIndex::hasIndex(*ms_p))
+      return False;
+    // The TENs of these expressions only use the columns of the key.
+    static const std::pair<Int, MSMainIndex::Key> indexedExprs[] = {
+      {SCAN_EXPR,    MSMainIndex::SCAN},
+      {FIELD_EXPR,   MSMainIndex::FIELD},
+      {SPW_EXPR,     MSMainIndex::DATA_DESC},
+      {ANTENNA_EXPR, MSMainIndex::BASELINE}
+    };
+    std::shared_ptr<MSMainIndex> index;
+    uInt nIndexed = 0;
+    for (const auto& expr : indexedExprs)
+      {
+	std::map<Int, TableExprNode>::const_iterator iter = exprTEN_p.find(expr.first);
+	if (iter == exprTEN_p.end()) continue;
+	if (!index) index = std::make_shared<MSMainIndex>(*ms_p);
+	Vector<rownr_t> keyRows = index->selectRows(expr.second, iter->second);
+	if (nIndexed == 0)
+	  rows.reference(keyRows);
+	else
+	  {
+	    std::vector<rownr_t> both;
+	    std::set_intersection(rows.begin(), rows.end(),
+				  keyRows.begin(), keyRows.end(),
+				  std::back_inserter(both));
+	    rows.reference(Vector<rownr_t>(both));
+	  }
+	++nIndexed;
+      }
+    if (nIndexed == 0) return False;
+    // Evaluate the full TEN for the selected rows if it contains
+    // other expressions.
+    if (nIndexed < exprTEN_p.size() || timeExpr_p != "")
+      {
+	Array<Bool> mask = fullTEN_p.getColumnBool(RowNumbers(rows));
+	std::vector<rownr_t> selRows;
+	Array<Bool>::const_iterator maskIter = mask.begin();
+	for (rownr_t i=0; i<rows.size(); ++i, ++maskIter)
+	  if (*maskIter) selRows.push_back(rows[i]);
+	rows.reference(Vector<rownr_t>(selRows));
+      }
+    return True;
+  }
+  
+  //----------------------------------------------------------------------------
+  
   Bool MSSelection::exprIsNull(const MSExprType type)
   {
     Bool exprIsNull=False;
@@ -472,11 +472,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // mssSetData() MSSelectionTools.h which also returns the in-row
     // (corr/chan) slices that can be supplied to the VisIter object
     // for on-the-fly in-row selection.
+    //
+    // If the MS has an up-to-date row index (see class MSMainIndex),
+    // the rows selected by the antenna, field, spw and scan expressions
+    // are found using the index. The other expressions are only
+    // evaluated for those rows.
     Bool getSelectedMS(MeasurementSet& selectedMS,
 		       const String& outMSName="");
     
     void resetMS(const MeasurementSet& ms) {resetTEN(); ms_p=&ms;};
-    void resetTEN() {fullTEN_p=TableExprNode();};
+    void resetTEN() {fullTEN_p=TableExprNode(); exprTEN_p.clear();};
     
     
     // The MSSelection object is designed to be re-usable object.  The
@@ -599,11 +604,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     
     // Check if record field exists and is not unset
     Bool definedAndSet(const Record& inpRec, const String& fieldName);
+
+    // Get the selected rows using the row index of the MS.
+    // It returns False if the MS has no up-to-date index or if the
+    // selection cannot use it.
+    Bool getIndexedRows(Vector<rownr_t>& rows);
     
     // Convert an MS select string to TaQL
     //   const String msToTaQL(const String& msSelect) {};
     
     TableExprNode fullTEN_p;
+    // The TENs of the individual expressions
+    std::map<Int, TableExprNode> exprTEN_p;
     const MeasurementSet *ms_p;
     // Selection expressions
     String antennaExpr_p;
@@ -382,4 +382,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return newRefTab;
   }
 
+  Bool getSelectedTable(Table& selectedTab,
+			const Table& baseTab,
+			const Vector<rownr_t>& rows,
+			const String& outName)
+  {
+    selectedTab = Table((baseTab)(rows));
+    if (selectedTab.nrow() == 0) 
+      throw(MSSelectionNullSelection("MSSelectionNullSelection : The selected table has zero rows."));
+    if (outName!="") selectedTab.rename(outName,Table::New);
+    selectedTab.flush();
+    return True;
+  }
+
 }
@@ -121,6 +121,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   Bool getSelectedTable(Table& selectedTab,     const Table& baseTab,
 			TableExprNode& fullTEN,	const String& outName);
 
+  // Same as above, but select the given rows.
+  Bool getSelectedTable(Table& selectedTab,     const Table& baseTab,
+			const Vector<rownr_t>& rows, const String& outName);
+
   Record mssSelectedIndices(MSSelection& mss, const MeasurementSet *ms);
 
   String stripWhite(const String& str, Bool onlyends=True);
@@ -0,0 +1,150 @@
+//# tMSMainIndex.cc: Test program for class MSMainIndex
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/ms/MSSel/MSMainIndex.h>
+#include <casacore/ms/MSSel/MSSelection.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSMainColumns.h>
+#include <casacore/ms/MeasurementSets/MSFieldColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+
+using namespace casacore;
+
+// Make an MS with 3 scans of 2 fields each, 2 data descriptions and
+// all baselines of 4 antennas.
+void makeMS()
+{
+  TableDesc simpleDesc = MS::requiredTableDesc();
+  SetupNewTable newTab("tMSMainIndex_tmp.ms", simpleDesc, Table::New);
+  MeasurementSet ms(newTab);
+  ms.createDefaultSubtables(Table::New);
+  ms.field().addRow(2);
+  MSFieldColumns fieldcol(ms.field());
+  fieldcol.name().put (0, "F0");
+  fieldcol.name().put (1, "F1");
+  MSMainColumns cols(ms);
+  rownr_t row = 0;
+  for (Int t=0; t<12; ++t) {
+    for (Int ddid=0; ddid<2; ++ddid) {
+      for (Int a1=0; a1<4; ++a1) {
+        for (Int a2=a1; a2<4; ++a2) {
+          ms.addRow();
+          cols.time().put (row, 1e9 + 10*t);
+          cols.antenna1().put (row, a1);
+          cols.antenna2().put (row, a2);
+          cols.dataDescId().put (row, ddid);
+          cols.scanNumber().put (row, 1 + t/4);
+          cols.fieldId().put (row, (t/2)%2);
+          ++row;
+        }
+      }
+    }
+  }
+}
+
+// Get the rows for which the expression is true by evaluating it for
+// all rows.
+Vector<rownr_t> allRows (const MeasurementSet& ms, const TableExprNode& node)
+{
+  return ms(node).rowNumbers(ms);
+}
+
+void checkIndex (const MeasurementSet& ms)
+{
+  AlwaysAssertExit (MSMainIndex::hasIndex(ms));
+  MSMainIndex index(ms);
+  AlwaysAssertExit (index.values(MSMainIndex::SCAN).size() == 3);
+  AlwaysAssertExit (index.values(MSMainIndex::FIELD).size() == 2);
+  AlwaysAssertExit (index.values(MSMainIndex::DATA_DESC).size() == 2);
+  AlwaysAssertExit (index.values(MSMainIndex::BASELINE).size() == 10);
+  for (Int scan=1; scan<=3; ++scan) {
+    AlwaysAssertExit (allEQ (index.rows(MSMainIndex::SCAN, scan),
+                             allRows(ms, ms.col("SCAN_NUMBER") == scan)));
+  }
+  AlwaysAssertExit (index.rows(MSMainIndex::SCAN, 4).empty());
+  AlwaysAssertExit (allEQ (index.rows(MSMainIndex::BASELINE, 4294967296 + 3),
+                           allRows(ms, ms.col("ANTENNA1") == 1 &&
+                                       ms.col("ANTENNA2") == 3)));
+  TableExprNode fieldNode (ms.col("FIELD_ID") == 1);
+  AlwaysAssertExit (allEQ (index.selectRows(MSMainIndex::FIELD, fieldNode),
+                           allRows(ms, fieldNode)));
+  TableExprNode ddNode (ms.col("DATA_DESC_ID") != 5);
+  AlwaysAssertExit (allEQ (index.selectRows(MSMainIndex::DATA_DESC, ddNode),
+                           allRows(ms, ddNode)));
+  TableExprNode blNode (ms.col("ANTENNA1") == ms.col("ANTENNA2") ||
+                        ms.col("ANTENNA2") == 2);
+  AlwaysAssertExit (allEQ (index.selectRows(MSMainIndex::BASELINE, blNode),
+                           allRows(ms, blNode)));
+}
+
+void checkSelection (MeasurementSet& ms)
+{
+  // The selection has to be the same with and without using the index.
+  MSSelection mss;
+  mss.resetMS (ms);
+  mss.setScanExpr ("2,3");
+  mss.setFieldExpr ("0");
+  MeasurementSet sel1;
+  mss.getSelectedMS (sel1);
+  MSMainIndex::removeIndex (ms);
+  AlwaysAssertExit (! MSMainIndex::hasIndex(ms));
+  mss.resetMS (ms);
+  MeasurementSet sel2;
+  mss.getSelectedMS (sel2);
+  AlwaysAssertExit (sel1.nrow() > 0);
+  AlwaysAssertExit (allEQ (sel1.rowNumbers(ms), sel2.rowNumbers(ms)));
+}
+
+int main()
+{
+  try {
+    makeMS();
+    MeasurementSet ms("tMSMainIndex_tmp.ms", Table::Update);
+    AlwaysAssertExit (! MSMainIndex::hasIndex(ms));
+    MSMainIndex::makeIndex (ms);
+    checkIndex (ms);
+    // Changing keywords keeps the index valid, changing data does not.
+    ms.rwKeywordSet().define ("TESTKEY", 1);
+    ms.flush();
+    AlwaysAssertExit (MSMainIndex::hasIndex(ms));
+    MSMainColumns(ms).fieldId().put (0, 0);
+    ms.flush();
+    AlwaysAssertExit (! MSMainIndex::hasIndex(ms));
+    MSMainIndex::makeIndex (ms);
+    checkIndex (ms);
+    checkSelection (ms);
+  } catch (std::exception& x) {
+    cout << "ERROR: " << x.what() << endl;
+    return 1;
+  } 
+  return 0;
+}
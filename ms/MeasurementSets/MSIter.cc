@@ -40,6 +40,9 @@
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/Stokes.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Logging/LogIO.h>
 #include <casacore/casa/iostream.h>
 
@@ -248,6 +251,82 @@ Bool MSIter::isSubSet (const Vector<rownr_t>& r1, const Vector<rownr_t>& r2) {
   return ok;
 }
 
+Bool MSIter::isInOrder(Table& tab, const Block<String>& columns,
+                       Bool storeResult)
+{
+  rownr_t nrow = tab.nrow();
+  Vector<String> colNames(columns.begin(), columns.end());
+  // See if the order has been checked before. The keywords of a reference
+  // table are the keywords of its root table, so they cannot be used for
+  // a reference table (which can be in a different order).
+  const String keyName("MSITER_SORT_CHECK");
+  if (tab.isRootTable()) {
+    // Lock the table to be sure the change counter is up-to-date.
+    TableLocker locker(tab, FileLocker::Read);
+    const TableRecord& keys = tab.keywordSet();
+    if (keys.isDefined(keyName)  &&  keys.dataType(keyName) == TpRecord) {
+      const TableRecord& order = keys.subRecord(keyName);
+      Vector<String> sortedOn = order.asArrayString("COLUMNS");
+      if (rownr_t(order.asInt64("NROW")) == nrow  &&
+          order.asuInt("DATA_CHANGE_COUNTER") == tab.getDataChangeCounter()  &&
+          sortedOn.size() >= colNames.size()  &&
+          allEQ (sortedOn(Slice(0, colNames.size())), colNames)) {
+        return True;
+      }
+    }
+  }
+  for (const String& name : colNames) {
+    const ColumnDesc& cd = tab.tableDesc().columnDesc(name);
+    if (!cd.isScalar()  ||
+        (cd.dataType() != TpInt  &&  cd.dataType() != TpDouble)) {
+      return False;
+    }
+  }
+  // Read the columns in blocks and check if each row is in order
+  // with respect to its previous row.
+  const rownr_t blockSize = 65536;
+  size_t ncol = colNames.size();
+  std::vector<Vector<Double>> vals(ncol);
+  std::vector<Double> last(ncol);
+  for (rownr_t st=0; st<nrow; st+=blockSize) {
+    rownr_t n = std::min(blockSize, nrow-st);
+    Slicer slicer(IPosition(1,st), IPosition(1,n));
+    for (size_t k=0; k<ncol; ++k) {
+      if (tab.tableDesc().columnDesc(colNames[k]).dataType() == TpInt) {
+        vals[k].resize(n);
+        convertArray(vals[k],
+                     ScalarColumn<Int>(tab, colNames[k]).getColumnRange(slicer));
+      } else {
+        vals[k].reference(ScalarColumn<Double>(tab, colNames[k]).getColumnRange(slicer));
+      }
+    }
+    for (rownr_t j=0; j<n; ++j) {
+      if (st+j > 0) {
+        for (size_t k=0; k<ncol; ++k) {
+          if (vals[k][j] > last[k]) break;
+          if (vals[k][j] < last[k]) return False;
+        }
+      }
+      for (size_t k=0; k<ncol; ++k) {
+        last[k] = vals[k][j];
+      }
+    }
+  }
+  // Keep the result if requested, so the next MSIter does not need to
+  // check again as long as the data do not change.
+  if (storeResult  &&  tab.isRootTable()  &&  tab.isWritable()) {
+    TableLocker locker(tab, FileLocker::Write);
+    // Flush first, so the change counter accounts for the data checked.
+    tab.flush();
+    TableRecord order;
+    order.define("COLUMNS", colNames);
+    order.define("NROW", Int64(nrow));
+    order.define("DATA_CHANGE_COUNTER", tab.getDataChangeCounter());
+    tab.rwKeywordSet().defineRecord(keyName, order);
+  }
+  return True;
+}
+
 void MSIter::construct(const Block<Int>& sortColumns,
 		       Bool addDefaultSortColumns)
 {
@@ -387,9 +466,16 @@ void MSIter::construct(const Block<Int>& sortColumns,
     }
 
     if (!useIn && !useSorted) {
-      // we have to resort the input; enclose in >>> <<< to avoid pollution of test .out file
-      if (aips_debug) cout << ">>>"<<endl<<"MSIter::construct - resorting table"<<endl<<"<<<"<<endl;
-      sorted = bms_p[i].sort(columns, Sort::Ascending, Sort::QuickSort);
+      if (isInOrder(bms_p[i], columns, storeSorted_p)) {
+        // the input is already in the requested order, so there is no
+        // need to sort it or to store a sorted table
+        useIn=True;
+        store=False;
+      } else {
+        // we have to resort the input; enclose in >>> <<< to avoid pollution of test .out file
+        if (aips_debug) cout << ">>>"<<endl<<"MSIter::construct - resorting table"<<endl<<"<<<"<<endl;
+        sorted = bms_p[i].sort(columns, Sort::Ascending, Sort::QuickSort);
+      }
     }
 
     // Only store if globally requested _and_ locally decided
@@ -429,6 +515,10 @@ MSIter::MSIter(const MSIter& other)
 
 MSIter::~MSIter()
 {
+  // The background thread might still be reading.
+  if (prefetch_p.valid()) {
+    prefetch_p.wait();
+  }
   for (size_t i=0; i<nMS_p; i++) delete tabIter_p[i];
 }
 
@@ -437,6 +527,8 @@ MSIter::operator=(const MSIter& other)
 {
   if (this == &other) return *this;
   This = (MSIter*)this;
+  finishPrefetch();
+  other.finishPrefetch();
   bms_p = other.bms_p;
   for (size_t i =0 ; i < nMS_p; ++i) delete tabIter_p[i];
   nMS_p = other.nMS_p;
@@ -477,6 +569,10 @@ MSIter::operator=(const MSIter& other)
   colArray_p = other.colArray_p;
   colDataDesc_p = other.colDataDesc_p;
   colField_p = other.colField_p;
+  firstDataDescId_p = other.firstDataDescId_p;
+  firstFieldId_p = other.firstFieldId_p;
+  firstTime_p = other.firstTime_p;
+  firstEpoch_p = other.firstEpoch_p;
   phaseCenter_p = other.phaseCenter_p;
   receptorAnglesFeed0_p = other.receptorAnglesFeed0_p;
   receptorAngles_p = other.receptorAngles_p;
@@ -493,6 +589,15 @@ MSIter::operator=(const MSIter& other)
   telescopePosition_p = other.telescopePosition_p;
   timeComp_p = std::make_shared<MSInterval>(interval_p);
   prevFirstTimeStamp_p=other.prevFirstTimeStamp_p;
+  prefetchColumns_p.reference (other.prefetchColumns_p.copy());
+  lookIter_p.reset();
+  if (other.lookIter_p) {
+    lookIter_p = std::make_shared<TableIterator>(*other.lookIter_p);
+    lookIter_p->copyState (*other.lookIter_p);
+  }
+  lookMS_p = other.lookMS_p;
+  chunkData_p = other.chunkData_p;
+  nextChunkData_p = other.nextChunkData_p;
   return *this;
 }
 
@@ -522,12 +627,24 @@ void MSIter::setInterval(Double timeInterval)
 
 void MSIter::origin()
 {
+  // A pending prefetch has to finish before the tables are accessed.
+  finishPrefetch();
+  nextChunkData_p.reset();
   curMS_p=0;
   checkFeed_p=True;
   if (!tabIterAtStart_p[curMS_p]) tabIter_p[curMS_p]->reset();
   setState();
   newMS_p=newArrayId_p=newSpectralWindowId_p=newFieldId_p=newPolarizationId_p=
     newDataDescId_p=more_p=True;
+  if (! prefetchColumns_p.empty()) {
+    chunkData_p = readChunk (bms_p[curMS_p],
+                             curTable_p.rowNumbers(bms_p[curMS_p]),
+                             prefetchColumns_p);
+    lookIter_p = std::make_shared<TableIterator>(*tabIter_p[curMS_p]);
+    lookIter_p->copyState (*tabIter_p[curMS_p]);
+    lookMS_p = curMS_p;
+    startPrefetch();
+  }
 }
 
 MSIter & MSIter::operator++(int)
@@ -547,6 +664,7 @@ MSIter & MSIter::operator++()
 
 void MSIter::advance()
 {
+  finishPrefetch();
   newMS_p=newArrayId_p=newSpectralWindowId_p=newPolarizationId_p=
     newDataDescId_p=newFieldId_p=False;
   tabIter_p[curMS_p]->next();
@@ -559,6 +677,128 @@ void MSIter::advance()
     }
   }
   if (more_p) setState();
+  if (more_p  &&  ! prefetchColumns_p.empty()) {
+    chunkData_p = nextChunkData_p;
+    nextChunkData_p.reset();
+    if (! chunkData_p) {
+      chunkData_p = readChunk (bms_p[curMS_p],
+                               curTable_p.rowNumbers(bms_p[curMS_p]),
+                               prefetchColumns_p);
+    }
+    if (lookIter_p) {
+      startPrefetch();
+    }
+  }
+}
+
+void MSIter::setPrefetchColumns (const Vector<String>& columnNames)
+{
+  finishPrefetch();
+  prefetchColumns_p.reference (columnNames.copy());
+  lookIter_p.reset();
+  chunkData_p.reset();
+  nextChunkData_p.reset();
+}
+
+const Record& MSIter::chunkData() const
+{
+  if (! chunkData_p) {
+    throw AipsError ("MSIter::chunkData: no columns are prefetched; "
+                     "call setPrefetchColumns and origin first");
+  }
+  return *chunkData_p;
+}
+
+void MSIter::startPrefetch()
+{
+  // Find the next chunk, which can be in the next MS.
+  lookIter_p->next();
+  while (lookIter_p->pastEnd()) {
+    if (++lookMS_p >= nMS_p) {
+      lookIter_p.reset();
+      return;
+    }
+    lookIter_p = std::make_shared<TableIterator>(*tabIter_p[lookMS_p]);
+    lookIter_p->reset();
+  }
+  Table ms (bms_p[lookMS_p]);
+  Vector<rownr_t> rownrs (lookIter_p->table().rowNumbers(ms));
+  Vector<String> names (prefetchColumns_p.copy());
+  prefetch_p = std::async (std::launch::async,
+                           [ms, rownrs, names]()
+                           { return readChunk (ms, rownrs, names); });
+}
+
+void MSIter::finishPrefetch() const
+{
+  if (prefetch_p.valid()) {
+    nextChunkData_p = prefetch_p.get();
+  }
+}
+
+// Read the cells of a scalar or array column.
+template<typename T>
+static void readChunkCells (Record& rec, const Table& ms, const String& name,
+                            Bool isScalar, const RefRows& rows)
+{
+  if (isScalar) {
+    rec.define (name, ScalarColumn<T>(ms, name).getColumnCells (rows));
+  } else {
+    rec.define (name, ArrayColumn<T>(ms, name).getColumnCells (rows));
+  }
+}
+
+std::shared_ptr<Record> MSIter::readChunk (const Table& ms,
+                                           const Vector<rownr_t>& rownrs,
+                                           const Vector<String>& columnNames)
+{
+  std::shared_ptr<Record> rec = std::make_shared<Record>();
+  // Collapse the row numbers to intervals, so contiguous rows are read
+  // in bulk.
+  RefRows rows (rownrs, False, True);
+  for (const String& name : columnNames) {
+    const ColumnDesc& cd = ms.tableDesc().columnDesc (name);
+    Bool isScalar = cd.isScalar();
+    switch (cd.dataType()) {
+    case TpBool:
+      readChunkCells<Bool> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpUChar:
+      readChunkCells<uChar> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpShort:
+      readChunkCells<Short> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpInt:
+      readChunkCells<Int> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpUInt:
+      readChunkCells<uInt> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpInt64:
+      readChunkCells<Int64> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpFloat:
+      readChunkCells<Float> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpDouble:
+      readChunkCells<Double> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpComplex:
+      readChunkCells<Complex> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpDComplex:
+      readChunkCells<DComplex> (*rec, ms, name, isScalar, rows);
+      break;
+    case TpString:
+      readChunkCells<String> (*rec, ms, name, isScalar, rows);
+      break;
+    default:
+      throw AipsError ("MSIter: column " + name +
+                       " has a data type that cannot be prefetched");
+    }
+  }
+  return rec;
 }
 
 void MSIter::setState()
@@ -568,6 +808,14 @@ void MSIter::setState()
     checkFeed_p=True;
   curTable_p=tabIter_p[curMS_p]->table();
   colArray_p.attach(curTable_p,MS::columnName(MS::ARRAY_ID));
+  colDataDesc_p.attach(curTable_p,MS::columnName(MS::DATA_DESC_ID));
+  colField_p.attach(curTable_p,MS::columnName(MS::FIELD_ID));
+  // Read the values needed by the lazily evaluated metadata functions
+  // now, because the main table cannot be read while prefetching.
+  firstDataDescId_p = colDataDesc_p(0);
+  firstFieldId_p = colField_p(0);
+  firstTime_p = ScalarColumn<Double>(curTable_p,
+                                     MS::columnName(MS::TIME))(0);
   // msc_p is already defined here (it is set in setMSInfo)
   if(newMS_p)
     msc_p->antenna().mount().getColumn(antennaMounts_p,True);
@@ -695,7 +943,7 @@ const MFrequency& MSIter::frequency0() const
       Vector<MFrequency>(msc_p->spectralWindow().
 			 chanFreqMeas()(curSpectralWindowIdFirst_p))(0);
     // get the reference frame out off the freq measure and set epoch measure.
-    This->frequency0_p.getRefPtr()->getFrame().set(msc_p->timeMeas()(0));
+    This->frequency0_p.getRefPtr()->getFrame().set(firstEpoch_p);
   return frequency0_p;
 }
 
@@ -736,6 +984,7 @@ void MSIter::setMSInfo()
     // get the reference frame out of the freq measure and set the
     // position measure.
     frequency0_p.getRefPtr()->getFrame().set(telescopePosition_p);
+    firstEpoch_p = msc_p->timeMeas()(0);
 
     // force updates
     lastSpectralWindowId_p=-1;
@@ -901,9 +1150,7 @@ void MSIter::setFeedInfo() const
 
 void MSIter::cacheCurrentDDInfo() const
 {
-  colDataDesc_p.attach(curTable_p,MS::columnName(MS::DATA_DESC_ID));
-
-  curDataDescIdFirst_p = colDataDesc_p(0);
+  curDataDescIdFirst_p = firstDataDescId_p;
   curSpectralWindowIdFirst_p = msc_p->dataDescription().spectralWindowId()
     (curDataDescIdFirst_p);
   curPolarizationIdFirst_p = msc_p->dataDescription().polarizationId()
@@ -926,8 +1173,7 @@ void MSIter::cacheExtraDDInfo() const
 
 void MSIter::setFieldInfo() const
 {
-  colField_p.attach(curTable_p,MS::columnName(MS::FIELD_ID));
-  curFieldIdFirst_p=colField_p(0);
+  curFieldIdFirst_p=firstFieldId_p;
 }
 
 const String& MSIter::fieldName() const {
@@ -963,7 +1209,7 @@ const String& MSIter::sourceName()  const {
 }
 const MDirection& MSIter::phaseCenter() const {
   if(msc_p){
-    Double firstTimeStamp=ScalarColumn<Double>(curTable_p, MS::columnName(MS::TIME)).get(0);
+    Double firstTimeStamp=firstTime_p;
     if(newFieldId_p || (firstTimeStamp != prevFirstTimeStamp_p)){
       if(curFieldIdFirst_p == -1)
         setFieldInfo();
@@ -33,11 +33,15 @@
 #include <casacore/measures/Measures/MFrequency.h>
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/measures/Measures/MPosition.h>
+#include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Utilities/Compare.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Containers/Record.h>
 #include <casacore/scimath/Mathematics/SquareMatrix.h>
 #include <casacore/scimath/Mathematics/RigidVector.h>
+#include <future>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -90,6 +94,9 @@ private:
 // examples below.  MSIter implements iteration by time interval for the use of
 // e.g., calibration tasks that want to calculate solutions over some interval
 // of time.  You can iterate over multiple MeasurementSets with this class.
+// If a MeasurementSet is already in the order of the sort columns (e.g.
+// written in TIME order by the correlator), it is iterated directly
+// without making a sorted reference table.
 // </synopsis>
 //
 // <example>
@@ -144,6 +151,24 @@ private:
 // </srcblock>
 // </example>
 //
+// <example>
+// Reading the data of the chunks can be overlapped with processing them
+// by telling which columns have to be prefetched. While a chunk is being
+// processed, the given columns of the next chunk are read in a background
+// thread.
+// <srcblock>
+// MSIter msIter(ms, sort, timeInterval);
+// Vector<String> cols(3);
+// cols[0] = "DATA"; cols[1] = "FLAG"; cols[2] = "UVW";
+// msIter.setPrefetchColumns (cols);
+// for (msIter.origin(); msIter.more(); msIter++) {
+//    const Record& data = msIter.chunkData();
+//    Cube<Complex> vis (data.asArrayComplex ("DATA"));
+//    process (vis);
+// }
+// </srcblock>
+// </example>
+//
 // <motivation>
 // This class was originally part of the VisibilityIterator class, but that
 // class was getting too large and complicated. By splitting out the toplevel
@@ -248,6 +273,32 @@ public:
   // Report Name of slowest column that changes at end of current iteration
   const String& keyChange() const;
 
+  // Set the columns of which the values of the next chunk have to be read
+  // in a background thread while the current chunk is processed.
+  // The columns of a chunk are read in bulk using the row numbers of the
+  // chunk in the MS. Array columns must have the same shape in a chunk.
+  // An empty vector switches off prefetching.
+  // You should call origin() thereafter.
+  // <br>Note that tables are not thread-safe, so the main table of the MS
+  // cannot be read while prefetching. Therefore the functions giving access
+  // to the main table (table(), ms(), msColumns() and the column functions
+  // like colFieldIds()) wait until the next chunk has been read, which
+  // undoes the overlap. The values of the columns should be obtained using
+  // chunkData(). The metadata functions of MSIter (like fieldId() and
+  // phaseCenter()) do not wait, because the main table values they need
+  // are read when the iterator is positioned at a chunk.
+  void setPrefetchColumns (const Vector<String>& columnNames);
+
+  // Get the columns being prefetched.
+  const Vector<String>& prefetchColumns() const
+    { return prefetchColumns_p; }
+
+  // Get the values of the prefetched columns in the current chunk.
+  // The record contains a field per column. It contains a Vector for a
+  // scalar column and an Array with an extra last axis for an array column.
+  // An exception is thrown if prefetching is not done.
+  const Record& chunkData() const;
+
   // Return the current Table iteration
   Table table() const;
 
@@ -400,6 +451,16 @@ public:
   const String& fieldName() const;
   const String& sourceName() const;
 
+  // Determine if the rows of the table are already in ascending order of
+  // the given columns, so the table can be iterated without sorting it.
+  // Only Int and Double columns are checked; False is returned for other
+  // types. If <src>storeResult</src> is True and the table is a writable
+  // root table, a positive result is kept in its keyword MSITER_SORT_CHECK
+  // together with the data change counter of the table, so it is not
+  // checked again as long as the data in the table do not change.
+  static Bool isInOrder(Table& tab, const Block<String>& columns,
+                        Bool storeResult=False);
+
 protected:
   // handle the construction details
   void construct(const Block<Int>& sortColumns, Bool addDefaultSortColumns);
@@ -421,6 +482,14 @@ protected:
   // caching (mutable) variables for performance reasons.
   void cacheExtraDDInfo() const;
   void setFieldInfo() const;
+  // Start reading the prefetch columns of the chunk after the current one.
+  void startPrefetch();
+  // Wait until the prefetched values of the next chunk are read.
+  void finishPrefetch() const;
+  // Read the values of the given columns in the given rows.
+  static std::shared_ptr<Record> readChunk (const Table& ms,
+                                            const Vector<rownr_t>& rownrs,
+                                            const Vector<String>& columnNames);
 
 // Determine if the numbers in r1 are a sorted subset of those in r2
   Bool isSubSet(const Vector<rownr_t>& r1, const Vector<rownr_t>& r2);
@@ -466,11 +535,18 @@ protected:
   // time selection
   Double interval_p;
 
-  // This column is mutable since it is only attached when it is
-  // neccesary to read the DD Ids. That might happen when calling
-  // a const accesor like dataDescriptionId().
-  mutable ScalarColumn<Int> colDataDesc_p, colField_p;
+  // The columns of the current chunk. They are attached when the
+  // iterator is positioned at a chunk.
+  ScalarColumn<Int> colDataDesc_p, colField_p;
   ScalarColumn<Int> colArray_p;
+  // The values of the first row of the current chunk, which are read
+  // when the iterator is positioned at a chunk, so the lazily evaluated
+  // metadata functions do not need to read the main table (which cannot
+  // be done while prefetching).
+  Int firstDataDescId_p, firstFieldId_p;
+  Double firstTime_p;
+  // The epoch of the first row of the current MS.
+  MEpoch firstEpoch_p;
 
   mutable MDirection phaseCenter_p;
   mutable Double prevFirstTimeStamp_p;
@@ -502,12 +578,22 @@ protected:
 
   std::shared_ptr<MSInterval> timeComp_p; // Points to the time comparator.
                                           // 0 if not using a time interval.
+
+  // Prefetching of the columns of the next chunk. The look-ahead iterator
+  // is one chunk ahead of the iterator of the current chunk.
+  Vector<String> prefetchColumns_p;
+  std::shared_ptr<TableIterator> lookIter_p;
+  size_t lookMS_p;
+  std::shared_ptr<Record> chunkData_p;
+  mutable std::shared_ptr<Record> nextChunkData_p;
+  mutable std::future<std::shared_ptr<Record>> prefetch_p;
 };
 
 inline Bool MSIter::more() const { return more_p;}
-inline Table MSIter::table() const {return curTable_p;}
-inline const MS& MSIter::ms() const {return bms_p[curMS_p];}
-inline const MSColumns& MSIter::msColumns() const { return *msc_p;}
+inline Table MSIter::table() const {finishPrefetch(); return curTable_p;}
+inline const MS& MSIter::ms() const {finishPrefetch(); return bms_p[curMS_p];}
+inline const MSColumns& MSIter::msColumns() const
+{ finishPrefetch(); return *msc_p;}
 inline Bool MSIter::newMS() const { return newMS_p;}
 inline Bool MSIter::newArray() const {return newArrayId_p;}
 inline Bool MSIter::newField() const { return newFieldId_p;}
@@ -516,12 +602,12 @@ inline Bool MSIter::newSpectralWindow() const
 inline size_t MSIter::msId() const { return curMS_p;}
 inline size_t MSIter::numMS() const { return nMS_p;}
 inline const ScalarColumn<Int>& MSIter::colArrayIds() const
-{ return colArray_p;}
+{ finishPrefetch(); return colArray_p;}
 inline const ScalarColumn<Int>& MSIter::colFieldIds() const
-{ return colField_p;}
+{ finishPrefetch(); return colField_p;}
 inline const ScalarColumn<Int>& MSIter::colDataDescriptionIds() const
 {if(curDataDescIdFirst_p==-1) {cacheCurrentDDInfo(); cacheExtraDDInfo();}
-  return colDataDesc_p;}
+  finishPrefetch(); return colDataDesc_p;}
 inline Int MSIter::arrayId() const {return curArrayIdFirst_p;}
 inline Int MSIter::fieldId() const {if(curFieldIdFirst_p==-1) setFieldInfo(); return curFieldIdFirst_p;}
 inline Int MSIter::spectralWindowId() const
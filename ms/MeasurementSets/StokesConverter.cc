@@ -40,7 +40,72 @@ extern "C" {
     static float floatsqrt(float val) {return sqrt(val);}
 }
 
-StokesConverter::StokesConverter() {}
+namespace {
+
+// Arrays with fewer samples (cells of nCorr values) are converted serially.
+const Int64 minParallelSamples = 32768;
+
+// Apply the linear conversion to nSample samples of NIN correlations.
+// The complex products are written out on the real and imaginary parts,
+// because std::complex multiplication checks for NaNs, which prevents the
+// compiler from vectorizing.
+template<Int NIN>
+void convertLinear(const Complex* in, Complex* out, Int64 nSample,
+                   Int nOut, const Float* convRe, const Float* convIm)
+{
+  const Float* inf = reinterpret_cast<const Float*>(in);
+  Float* outf = reinterpret_cast<Float*>(out);
+#ifdef _OPENMP
+#pragma omp parallel for if (nSample > minParallelSamples)
+#endif
+  for (Int64 s=0; s<nSample; s++) {
+    const Float* ip = inf + 2*NIN*s;
+    Float* op = outf + 2*nOut*s;
+    for (Int i=0; i<nOut; i++) {
+      const Float* cr = convRe + i*NIN;
+      const Float* ci = convIm + i*NIN;
+      Float re=0, im=0;
+      for (Int k=0; k<NIN; k++) {
+        re += cr[k]*ip[2*k] - ci[k]*ip[2*k+1];
+        im += cr[k]*ip[2*k+1] + ci[k]*ip[2*k];
+      }
+      op[2*i]=re;
+      op[2*i+1]=im;
+    }
+  }
+}
+
+// Same for any number of input correlations.
+void convertLinear(const Complex* in, Complex* out, Int64 nSample,
+                   Int nIn, Int nOut, const Float* convRe, const Float* convIm)
+{
+  const Float* inf = reinterpret_cast<const Float*>(in);
+  Float* outf = reinterpret_cast<Float*>(out);
+#ifdef _OPENMP
+#pragma omp parallel for if (nSample > minParallelSamples)
+#endif
+  for (Int64 s=0; s<nSample; s++) {
+    const Float* ip = inf + 2*nIn*s;
+    Float* op = outf + 2*nOut*s;
+    for (Int i=0; i<nOut; i++) {
+      const Float* cr = convRe + i*nIn;
+      const Float* ci = convIm + i*nIn;
+      Float re=0, im=0;
+      for (Int k=0; k<nIn; k++) {
+        re += cr[k]*ip[2*k] - ci[k]*ip[2*k+1];
+        im += cr[k]*ip[2*k+1] + ci[k]*ip[2*k];
+      }
+      op[2*i]=re;
+      op[2*i+1]=im;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+StokesConverter::StokesConverter()
+: linear_p(False)
+{}
 
 StokesConverter::~StokesConverter() {}
 
@@ -51,6 +116,7 @@ StokesConverter::StokesConverter(const Vector<Int>& out, const Vector<Int>& in,
 }
 
 StokesConverter::StokesConverter(const StokesConverter& other)
+: linear_p(False)
 {
   operator=(other);
 }
@@ -175,6 +241,21 @@ void StokesConverter::setConversion(const Vector<Int>& out,
       }
     }
   }
+  // The fast kernel can be used if all outputs are linear combinations.
+  linear_p=True;
+  for (Int i=0; i<nOut; i++) {
+    if (out(i)<=0 || out(i)>Stokes::YL) linear_p=False;
+  }
+  convRe_p.resize(nOut*nIn);
+  convIm_p.resize(nOut*nIn);
+  if (linear_p) {
+    for (Int i=0; i<nOut; i++) {
+      for (Int j=0; j<nIn; j++) {
+	convRe_p(i*nIn+j)=real(conv_p(i,j));
+	convIm_p(i*nIn+j)=imag(conv_p(i,j));
+      }
+    }
+  }
 }
 
 void StokesConverter::initConvMatrix()
@@ -288,6 +369,30 @@ void StokesConverter::convert(Array<Complex>& out, const Array<Complex>& in) con
   out.resize(outShape);
   Int nCorrIn=in.shape()(0);
   DebugAssert(nCorrIn==Int(in_p.nelements()),AipsError);
+  if (linear_p) {
+    Int nOut=out_p.nelements();
+    Int64 nSample=in.nelements()/nCorrIn;
+    Bool deleteIn, deleteOut;
+    const Complex* inPtr=in.getStorage(deleteIn);
+    Complex* outPtr=out.getStorage(deleteOut);
+    switch (nCorrIn) {
+    case 2:
+      convertLinear<2>(inPtr,outPtr,nSample,nOut,
+		       convRe_p.data(),convIm_p.data());
+      break;
+    case 4:
+      convertLinear<4>(inPtr,outPtr,nSample,nOut,
+		       convRe_p.data(),convIm_p.data());
+      break;
+    default:
+      convertLinear(inPtr,outPtr,nSample,nCorrIn,nOut,
+		    convRe_p.data(),convIm_p.data());
+      break;
+    }
+    in.freeStorage(inPtr,deleteIn);
+    out.putStorage(outPtr,deleteOut);
+    return;
+  }
   Matrix<Complex> inMat=in.reform(IPosition(2,nCorrIn,in.nelements()/nCorrIn));
 
   Matrix<Complex> outMat=out.reform(IPosition(2,outShape(0),
@@ -369,21 +474,30 @@ void StokesConverter::convert(Array<Bool>& out, const Array<Bool>& in) const
   out.resize(outShape);
   Int nCorrIn=in.shape()(0);
   DebugAssert(nCorrIn==Int(in_p.nelements()),AipsError);
-  Matrix<Bool> inMat=in.reform(IPosition(2,nCorrIn,in.nelements()/nCorrIn));
-  
-  Matrix<Bool> outMat=out.reform(IPosition(2,outShape(0),
-					   out.nelements()/outShape(0)));
-  for (uInt i=0; i<out_p.nelements(); i++) {
-    for (uInt j=0; j<inMat.ncolumn(); j++) {
-      outMat(i,j)=False;
+  Int nOut=out_p.nelements();
+  Int64 nSample=in.nelements()/nCorrIn;
+  Bool deleteIn, deleteOut;
+  const Bool* inPtr=in.getStorage(deleteIn);
+  Bool* outPtr=out.getStorage(deleteOut);
+  const Bool* flagConv=flagConv_p.data();
+#ifdef _OPENMP
+#pragma omp parallel for if (nSample > minParallelSamples)
+#endif
+  for (Int64 j=0; j<nSample; j++) {
+    const Bool* ip=inPtr+j*nCorrIn;
+    Bool* op=outPtr+j*nOut;
+    for (Int i=0; i<nOut; i++) {
+      op[i]=False;
       for (Int k=0; k<nCorrIn; k++) {
-	if (flagConv_p(i,k)&&inMat(k,j)) {
-	  outMat(i,j)=True;
+	if (flagConv[i+k*nOut] && ip[k]) {
+	  op[i]=True;
 	  break;
 	}
       }
     }
   }
+  in.freeStorage(inPtr,deleteIn);
+  out.putStorage(outPtr,deleteOut);
 }
 
 void StokesConverter::convert(Array<Float>& out, const Array<Float>& in,
@@ -393,26 +507,34 @@ void StokesConverter::convert(Array<Float>& out, const Array<Float>& in,
   out.resize(outShape);
   Int nCorrIn=in.shape()(0);
   DebugAssert(nCorrIn==Int(in_p.nelements()),AipsError);
-  Matrix<Float> inMat=in.reform(IPosition(2,nCorrIn,in.nelements()/nCorrIn));
-  
-  Matrix<Float> outMat=out.reform(IPosition(2,outShape(0),
-					   out.nelements()/outShape(0)));
+  Int nOut=out_p.nelements();
+  Int64 nSample=in.nelements()/nCorrIn;
+  Bool deleteIn, deleteOut;
+  const Float* inPtr=in.getStorage(deleteIn);
+  Float* outPtr=out.getStorage(deleteOut);
+  const Float* wtConv=wtConv_p.data();
   // change calculation based on sigma:
   // for weights we use Wout=1/sum(square(factor(k))*1/Win(k))
   // for sigmas  we use Sout=sqrt(sum(square(factor(k)*Sin(k))))
-  for (uInt i=0; i<out_p.nelements(); i++) {
-    for (uInt j=0; j<inMat.ncolumn(); j++) {
-      outMat(i,j)=0;
+#ifdef _OPENMP
+#pragma omp parallel for if (nSample > minParallelSamples)
+#endif
+  for (Int64 j=0; j<nSample; j++) {
+    const Float* ip=inPtr+j*nCorrIn;
+    Float* op=outPtr+j*nOut;
+    for (Int i=0; i<nOut; i++) {
+      Float sum=0;
       for (Int k=0; k<nCorrIn; k++) {
-	if (inMat(k,j)!=0) outMat(i,j)+= 
-			     (sigma ? square(wtConv_p(i,k)*inMat(k,j)) :
-			      square(wtConv_p(i,k))/inMat(k,j));
-	else { outMat(i,j)=0; break;}  // flag output if one of inputs is zero
+	Float wt=wtConv[i+k*nOut];
+	if (ip[k]!=0) sum+= (sigma ? square(wt*ip[k]) : square(wt)/ip[k]);
+	else { sum=0; break;}  // flag output if one of inputs is zero
       }
-      if (outMat(i,j)!=0) outMat(i,j)=
-			    (sigma ? sqrt(outMat(i,j)) : 1/outMat(i,j));
+      if (sum!=0) sum=(sigma ? sqrt(sum) : 1/sum);
+      op[i]=sum;
     }
   }
+  in.freeStorage(inPtr,deleteIn);
+  out.putStorage(outPtr,deleteOut);
 }
 
 void StokesConverter::invert(Array<Bool>& out, const Array<Bool>& in) const
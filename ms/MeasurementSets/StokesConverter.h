@@ -138,6 +138,11 @@ public:
   // convert data, first dimension of input must match
   // that of the input conversion vector used to set up the conversion.
   // Output is resized as needed.
+  // If all output polarizations are linear combinations of the input
+  // (i.e. no polarized intensity or angle is asked for), a vectorizable
+  // kernel is used which is specialized for 2 and 4 input correlations.
+  // Large arrays (e.g. a pol x chan x row cube) are converted in parallel
+  // if OpenMP is used.
   void convert(Array<Complex>& out, const Array<Complex>& in) const;
 
   // convert flags, first dimension of input must match
@@ -150,6 +155,7 @@ public:
   // that of the input conversion vector used to set up the conversion.
   // Output is resized as needed.
   // Set sigma to True when converting sigma's using this routine.
+  // As for the data, large arrays are converted in parallel.
   void convert(Array<Float>& out, const Array<Float>& in,
 	       Bool sigma=False) const;
 
@@ -175,6 +181,9 @@ private:
   Matrix<Bool> flagConv_p;
   Matrix<Float> wtConv_p;
   Matrix<Complex> polConv_p;
+  //# real and imaginary parts of conv_p (row-major) for the linear kernel
+  Bool linear_p;
+  Vector<Float> convRe_p, convIm_p;
 };
 
 
@@ -37,6 +37,7 @@
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <iostream>
 #include <sstream>
@@ -952,6 +953,112 @@ void iterMSCachedFieldInfo ()
   }
 }
 
+// Test that the prefetched columns contain the data of the chunks,
+// also when iterating over multiple MSs.
+void iterMSPrefetch (double binwidth)
+{
+  MeasurementSet ms("tMSIter_tmp.ms");
+  Block<MeasurementSet> mss(2, ms);
+  Block<int> sort(2);
+  sort[0] = MS::ANTENNA1;
+  sort[1] = MS::ANTENNA2;
+  MSIter msIter(mss, sort, binwidth, False, False);
+  Vector<String> cols(3);
+  cols[0] = "DATA";
+  cols[1] = "TIME";
+  cols[2] = "ANTENNA2";
+  msIter.setPrefetchColumns (cols);
+  std::vector<Record> chunks;
+  std::vector<Int> fieldIds;
+  std::vector<Int> spwIds;
+  std::vector<MDirection> phaseCenters;
+  for (msIter.origin(); msIter.more(); msIter++) {
+    chunks.push_back (msIter.chunkData());
+    // The metadata functions do not wait for the prefetch.
+    fieldIds.push_back (msIter.fieldId());
+    spwIds.push_back (msIter.spectralWindowId());
+    phaseCenters.push_back (msIter.phaseCenter());
+    // Accessing the main table waits for the prefetch.
+    if (chunks.size() % 2 == 0) {
+      AlwaysAssertExit (allEQ (chunks.back().asArrayDouble("TIME"),
+                               ScalarColumn<Double>(msIter.table(), "TIME").getColumn()));
+    }
+  }
+  // Check the data using an iteration without prefetching.
+  msIter.setPrefetchColumns (Vector<String>());
+  size_t nchunk = 0;
+  for (msIter.origin(); msIter.more(); msIter++) {
+    AlwaysAssertExit (nchunk < chunks.size());
+    const Record& rec = chunks[nchunk];
+    AlwaysAssertExit (allEQ (rec.asArrayComplex("DATA"),
+                             ArrayColumn<Complex>(msIter.table(), "DATA").getColumn()));
+    AlwaysAssertExit (allEQ (rec.asArrayDouble("TIME"),
+                             ScalarColumn<Double>(msIter.table(), "TIME").getColumn()));
+    AlwaysAssertExit (allEQ (rec.asArrayInt("ANTENNA2"),
+                             ScalarColumn<Int>(msIter.table(), "ANTENNA2").getColumn()));
+    AlwaysAssertExit (fieldIds[nchunk] == msIter.fieldId());
+    AlwaysAssertExit (spwIds[nchunk] == msIter.spectralWindowId());
+    AlwaysAssertExit (allNear (phaseCenters[nchunk].getValue().get(),
+                               msIter.phaseCenter().getValue().get(), 1e-12));
+    ++nchunk;
+  }
+  AlwaysAssertExit (nchunk == chunks.size());
+  bool caught = false;
+  try {
+    msIter.chunkData();
+  } catch (const AipsError&) {
+    caught = true;
+  }
+  AlwaysAssertExit (caught);
+}
+
+// Test that an MS already in the iteration order is not sorted.
+void iterMSInOrder()
+{
+  MeasurementSet ms("tMSIter_tmp.ms", Table::Update);
+  Block<int> sort(1, MS::TIME);
+  rownr_t nrow = 0;
+  {
+    MSIter msIter(ms, sort, 0., True, False);
+    for (msIter.origin(); msIter.more(); msIter++) {
+      Vector<rownr_t> rows = msIter.table().rowNumbers(ms);
+      AlwaysAssertExit (rows[0] == nrow);
+      AlwaysAssertExit (rows[rows.size()-1] == nrow + rows.size() - 1);
+      nrow += rows.size();
+    }
+  }
+  AlwaysAssertExit (nrow == ms.nrow());
+  // The result of the check is only kept if asked for.
+  AlwaysAssertExit (! ms.keywordSet().isDefined("MSITER_SORT_CHECK"));
+  // The order is not right if sorted on ANTENNA1.
+  Block<String> cols(2);
+  cols[0] = "ANTENNA1";
+  cols[1] = "TIME";
+  AlwaysAssertExit (! MSIter::isInOrder (ms, cols, True));
+  AlwaysAssertExit (! ms.keywordSet().isDefined("MSITER_SORT_CHECK"));
+  cols[0] = "ARRAY_ID";
+  AlwaysAssertExit (MSIter::isInOrder (ms, cols, True));
+  AlwaysAssertExit (ms.keywordSet().isDefined("MSITER_SORT_CHECK"));
+  // A permuted reference table with the same number of rows shares the
+  // keywords of the MS, but is not in order.
+  Vector<rownr_t> rownrs(ms.nrow());
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    rownrs[i] = rownrs.size() - 1 - i;
+  }
+  Table permuted = ms(rownrs);
+  AlwaysAssertExit (permuted.nrow() == ms.nrow());
+  AlwaysAssertExit (! MSIter::isInOrder (permuted, cols));
+  // Changing the data invalidates the kept result.
+  ScalarColumn<Double> timeCol(ms, "TIME");
+  Double time0 = timeCol(0);
+  timeCol.put (0, timeCol(ms.nrow()-1) + 1);
+  ms.flush();
+  AlwaysAssertExit (! MSIter::isInOrder (ms, cols));
+  timeCol.put (0, time0);
+  ms.flush();
+  AlwaysAssertExit (MSIter::isInOrder (ms, cols));
+}
+
 int main (int argc, char* argv[])
 {
   try {
@@ -991,6 +1098,8 @@ int main (int argc, char* argv[])
     iterMSCachedDDFeedInfo();
     cout << "########" << endl;
     iterMSCachedFieldInfo();
+    iterMSPrefetch(binwidth);
+    iterMSInOrder();
   } catch (std::exception& x) {
     cerr << "Unexpected exception: " << x.what() << endl;
     return 1;
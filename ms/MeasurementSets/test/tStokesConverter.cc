@@ -24,6 +24,10 @@
 //#                        Charlottesville, VA 22903-2475 USA
 
 #include <casacore/casa/Arrays/MaskArrLogi.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/ms/MeasurementSets/StokesConverter.h>
@@ -117,6 +121,64 @@ int main()
 	}
       }
     }
+    {
+      // Convert a large cube (using the parallel linear kernel) and compare
+      // with the general path, which is used if Ptotal is also asked for.
+      Vector<Int> in(4),out(4),outp(5);
+      for (Int j=0; j<4; j++) {
+	in(j)=Stokes::XX+j;
+	out(j)=Stokes::I+j;
+	outp(j)=Stokes::I+j;
+      }
+      outp(4)=Stokes::Ptotal;
+      Cube<Complex> datain(4,16,4096);
+      for (uInt i=0; i<datain.nelements(); i++) {
+	datain.data()[i]=Complex(i%97, -Float(i%31));
+      }
+      StokesConverter lin(out,in), gen(outp,in);
+      Array<Complex> dataout, dataoutp;
+      lin.convert(dataout,datain);
+      gen.convert(dataoutp,datain);
+      Cube<Complex> outCube(dataout), outpCube(dataoutp);
+      if (dataout.shape()!=IPosition(3,4,16,4096) ||
+	  !allNearAbs(outCube, outpCube(Slice(0,4),Slice(),Slice()), 1.e-4)) {
+	err++;
+	cerr << "large cube conversion differs" << endl;
+      }
+      // Two correlations to I.
+      Vector<Int> in2(2), out2(1,Stokes::I);
+      in2(0)=Stokes::XX;
+      in2(1)=Stokes::YY;
+      StokesConverter sc2(out2,in2);
+      Matrix<Complex> d2(2,50000);
+      Matrix<Float> w2(2,50000);
+      for (uInt j=0; j<d2.ncolumn(); j++) {
+	d2(0,j)=Complex(j%7,1);
+	d2(1,j)=Complex(j%5,3);
+	w2(0,j)=1+j%3;
+	w2(1,j)=2;
+      }
+      w2(1,10)=0;
+      Array<Complex> o2;
+      Array<Float> ow2, os2;
+      sc2.convert(o2,d2);
+      sc2.convert(ow2,w2);
+      sc2.convert(os2,w2,True);
+      Matrix<Complex> o2m(o2);
+      Matrix<Float> ow2m(ow2), os2m(os2);
+      for (uInt j=0; j<d2.ncolumn(); j++) {
+	// I=XX+YY (no rescaling)
+	Float expWt=(j==10 ? 0 : 1/(1/w2(0,j)+1/w2(1,j)));
+	Float expSig=(j==10 ? 0 : sqrt(w2(0,j)*w2(0,j)+w2(1,j)*w2(1,j)));
+	if (!nearAbs(o2m(0,j),d2(0,j)+d2(1,j),1.e-6) ||
+	    !nearAbs(ow2m(0,j),expWt,1.e-5) ||
+	    !nearAbs(os2m(0,j),expSig,1.e-5)) {
+	  err++;
+	  cerr << "2-correlation conversion wrong at " << j << endl;
+	  break;
+	}
+      }
+    }
   } catch (std::exception& x) {
     cout << "Exception: "<< x.what() <<endl;
   } 
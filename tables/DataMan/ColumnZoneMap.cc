@@ -0,0 +1,232 @@
+//# ColumnZoneMap.cc: Minimum and maximum value per zone of rows in a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <limits>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+ColumnZoneMap::ColumnZoneMap (uInt zoneSize)
+: itsZoneSize (zoneSize),
+  itsNrow     (0)
+{
+  if (itsZoneSize == 0) {
+    itsZoneSize = 1024;
+  }
+}
+
+void ColumnZoneMap::resetZone (rownr_t zone)
+{
+  itsMin[zone] = std::numeric_limits<Double>::max();
+  itsMax[zone] = -std::numeric_limits<Double>::max();
+}
+
+rownr_t ColumnZoneMap::lastRow (rownr_t zone) const
+{
+  return std::min (firstRow(zone) + itsZoneSize, nrow()) - 1;
+}
+
+void ColumnZoneMap::clear()
+{
+  itsNrow = 0;
+  itsMin.clear();
+  itsMax.clear();
+  itsNrWritten.clear();
+  itsRecalc.clear();
+}
+
+void ColumnZoneMap::addRows (rownr_t nrow, Bool written)
+{
+  rownr_t oldNrow = itsNrow;
+  itsNrow += nrow;
+  rownr_t oldNzone = itsMin.size();
+  rownr_t newNzone = (itsNrow + itsZoneSize - 1) / itsZoneSize;
+  itsMin.resize (newNzone);
+  itsMax.resize (newNzone);
+  itsNrWritten.resize (newNzone, 0);
+  itsRecalc.resize (newNzone, false);
+  for (rownr_t i=oldNzone; i<newNzone; ++i) {
+    resetZone (i);
+  }
+  // The zones containing rows with unknown values have to be recalculated.
+  // Otherwise the new rows are not written yet, thus not counted.
+  if (written) {
+    for (rownr_t i=oldNrow/itsZoneSize; i<newNzone; ++i) {
+      itsRecalc[i] = true;
+    }
+  }
+}
+
+void ColumnZoneMap::removeRow (rownr_t rownr)
+{
+  AlwaysAssert (rownr < nrow(), AipsError);
+  itsNrow--;
+  rownr_t nzone = (itsNrow + itsZoneSize - 1) / itsZoneSize;
+  itsMin.resize (nzone);
+  itsMax.resize (nzone);
+  itsNrWritten.resize (nzone);
+  itsRecalc.resize (nzone);
+  // The rows after the removed row are shifted into other zones, so the
+  // zones from the removed row on have to be recalculated.
+  for (rownr_t i=rownr/itsZoneSize; i<nzone; ++i) {
+    itsRecalc[i] = true;
+  }
+}
+
+void ColumnZoneMap::invalidate()
+{
+  std::fill (itsRecalc.begin(), itsRecalc.end(), true);
+}
+
+void ColumnZoneMap::setZone (rownr_t zone, Double minVal, Double maxVal)
+{
+  itsMin[zone] = minVal;
+  itsMax[zone] = maxVal;
+  itsRecalc[zone] = false;
+  itsNrWritten[zone] = lastRow(zone) - firstRow(zone) + 1;
+}
+
+Bool ColumnZoneMap::isValid() const
+{
+  for (rownr_t i=0; i<nzone(); ++i) {
+    if (! isValid(i)) {
+      return False;
+    }
+  }
+  return True;
+}
+
+std::vector<std::pair<rownr_t,rownr_t>> ColumnZoneMap::selectRows
+(const Vector<Double>& startValues, const Vector<Double>& endValues) const
+{
+  std::vector<std::pair<rownr_t,rownr_t>> intervals;
+  for (rownr_t zone=0; zone<nzone(); ++zone) {
+    Bool match = !isValid(zone);
+    // The ranges are ordered, so stop if a range starts after the maximum.
+    for (size_t i=0; i<startValues.size()  &&  !match; ++i) {
+      if (startValues[i] > itsMax[zone]) {
+        break;
+      }
+      match = endValues[i] >= itsMin[zone];
+    }
+    if (match) {
+      if (!intervals.empty()  &&  intervals.back().second+1 == firstRow(zone)) {
+        intervals.back().second = lastRow(zone);
+      } else {
+        intervals.push_back (std::make_pair (firstRow(zone), lastRow(zone)));
+      }
+    }
+  }
+  return intervals;
+}
+
+std::vector<std::pair<rownr_t,rownr_t>> ColumnZoneMap::intersect
+(const std::vector<std::pair<rownr_t,rownr_t>>& left,
+ const std::vector<std::pair<rownr_t,rownr_t>>& right)
+{
+  std::vector<std::pair<rownr_t,rownr_t>> result;
+  size_t i=0;
+  size_t j=0;
+  while (i < left.size()  &&  j < right.size()) {
+    rownr_t st  = std::max (left[i].first, right[j].first);
+    rownr_t end = std::min (left[i].second, right[j].second);
+    if (st <= end) {
+      result.push_back (std::make_pair (st, end));
+    }
+    // Advance the interval ending first.
+    if (left[i].second < right[j].second) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+  return result;
+}
+
+void ColumnZoneMap::put (AipsIO& ios) const
+{
+  ios.putstart ("ColumnZoneMap", 1);
+  ios << itsZoneSize;
+  ios << uInt64(nrow());
+  ios << uInt64(nzone());
+  for (rownr_t i=0; i<nzone(); ++i) {
+    Bool valid = isValid(i);
+    ios << valid;
+    if (valid) {
+      ios << itsMin[i] << itsMax[i];
+    }
+  }
+  ios.putend();
+}
+
+void ColumnZoneMap::get (AipsIO& ios, rownr_t nrow)
+{
+  ios.getstart ("ColumnZoneMap");
+  uInt64 nrowMap, nzoneMap;
+  ios >> itsZoneSize;
+  ios >> nrowMap;
+  ios >> nzoneMap;
+  // All rows have been written, so only the invalid zones need to be
+  // recalculated.
+  clear();
+  addRows (nrowMap, True);
+  Bool valid;
+  Double minVal, maxVal;
+  for (uInt64 i=0; i<nzoneMap; ++i) {
+    ios >> valid;
+    if (valid) {
+      ios >> minVal >> maxVal;
+      setZone (i, minVal, maxVal);
+    }
+  }
+  ios.getend();
+  // Clear the map if it does not match the column.
+  if (nrowMap != nrow) {
+    clear();
+    addRows (nrow, True);
+  }
+}
+
+void ColumnZoneMap::show (ostream& os) const
+{
+  os << "ColumnZoneMap with " << nzone() << " zones of " << itsZoneSize
+     << " rows" << endl;
+  for (rownr_t i=0; i<nzone(); ++i) {
+    os << "  zone " << i << " rows " << firstRow(i) << '-' << lastRow(i);
+    if (isValid(i)) {
+      os << "  min=" << itsMin[i] << " max=" << itsMax[i] << endl;
+    } else {
+      os << "  invalid" << endl;
+    }
+  }
+}
+
+} //# NAMESPACE CASACORE - END
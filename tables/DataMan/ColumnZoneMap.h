@@ -0,0 +1,200 @@
+//# ColumnZoneMap.h: Minimum and maximum value per zone of rows in a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_COLUMNZONEMAP_H
+#define TABLES_COLUMNZONEMAP_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/iosfwd.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class AipsIO;
+
+
+// <summary>
+// Minimum and maximum value per zone of rows in a scalar numeric column.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tColumnZoneMap.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=DataManagerColumn>DataManagerColumn</linkto>
+// </prerequisite>
+
+// <etymology>
+// A zone map (also known as min/max index or block range index) keeps
+// a summary of the values in each zone of consecutive rows.
+// </etymology>
+
+// <synopsis>
+// ColumnZoneMap divides the rows of a column into zones of a fixed number
+// of rows. For each zone it keeps the minimum and maximum value (as Double)
+// of the values put in that zone.
+// A storage manager can maintain such a map for its scalar numeric columns
+// by calling <src>put</src> for each value written. It is best if the zone
+// size matches the number of rows in a data bucket, so each zone that does
+// not need to be read corresponds to a bucket that is not read.
+// <br>A zone is only valid if each of its rows is known to be covered by
+// its minimum and maximum. Rows that have been added, but not been written
+// yet, make a zone invalid. To keep the memory use per zone, only the
+// number of rows written in order from the start of the zone is counted.
+// Thus if the rows of a zone are written in another order, the zone stays
+// invalid. Removing a row shifts the rows after it, which
+// makes all zones from that row on invalid. The storage manager has to
+// recalculate invalid zones using <src>setZone</src> before the zone map
+// can be used.
+// <br>The zone map is used by the table selection to skip zones that
+// cannot contain rows matching the ranges of the values derived from
+// a selection expression (see <linkto class=TableExprRange>
+// TableExprRange</linkto>).
+// <br>Note that a NaN value does not extend the minimum or maximum. This is
+// fine, because a NaN value never matches a range.
+// </synopsis>
+
+// <motivation>
+// Selections on a column in (roughly) increasing order like TIME or
+// SCAN_NUMBER in a MeasurementSet only need to read a small fraction of
+// the data.
+// </motivation>
+
+class ColumnZoneMap
+{
+public:
+  // Create an empty zone map with the given number of rows per zone.
+  explicit ColumnZoneMap (uInt zoneSize=0);
+
+  // Get the number of rows per zone.
+  uInt zoneSize() const
+    { return itsZoneSize; }
+
+  // Get the number of rows and zones.
+  // <group>
+  rownr_t nrow() const
+    { return itsNrow; }
+  rownr_t nzone() const
+    { return itsMin.size(); }
+  // </group>
+
+  // Add rows. If <src>written=False</src> the values in the new rows are
+  // not set yet, otherwise the rows contain unknown values, so the zones
+  // containing them have to be recalculated.
+  void addRows (rownr_t nrow, Bool written=False);
+
+  // A row has been removed.
+  void removeRow (rownr_t rownr);
+
+  // Clear the map, thus make all zones invalid.
+  void invalidate();
+
+  // Add a value written in the given row.
+  void put (rownr_t rownr, Double value)
+  {
+    rownr_t zone = rownr / itsZoneSize;
+    if (value < itsMin[zone]) itsMin[zone] = value;
+    if (value > itsMax[zone]) itsMax[zone] = value;
+    if (rownr == firstRow(zone) + itsNrWritten[zone]) {
+      itsNrWritten[zone]++;
+    }
+  }
+
+  // Set the minimum and maximum of a zone, which makes it valid.
+  void setZone (rownr_t zone, Double minVal, Double maxVal);
+
+  // Get the row range of a zone.
+  // <group>
+  rownr_t firstRow (rownr_t zone) const
+    { return zone * itsZoneSize; }
+  rownr_t lastRow (rownr_t zone) const;
+  // </group>
+
+  // Tell if a zone is valid.
+  Bool isValid (rownr_t zone) const
+    { return !itsRecalc[zone]  &&
+        firstRow(zone) + itsNrWritten[zone] > lastRow(zone); }
+
+  // Tell if all zones are valid.
+  Bool isValid() const;
+
+  // Get the minimum and maximum value of a zone.
+  // <group>
+  Double minimum (rownr_t zone) const
+    { return itsMin[zone]; }
+  Double maximum (rownr_t zone) const
+    { return itsMax[zone]; }
+  // </group>
+
+  // Get the row intervals that might contain values within the given
+  // ranges (as made by TableExprRange).
+  // An invalid zone is always selected.
+  // Adjacent intervals are combined, so the intervals are ascending and
+  // disjoint. Each interval is given as first and last row.
+  std::vector<std::pair<rownr_t,rownr_t>>
+  selectRows (const Vector<Double>& startValues,
+              const Vector<Double>& endValues) const;
+
+  // Intersect two vectors of row intervals as made by selectRows.
+  static std::vector<std::pair<rownr_t,rownr_t>> intersect
+  (const std::vector<std::pair<rownr_t,rownr_t>>& left,
+   const std::vector<std::pair<rownr_t,rownr_t>>& right);
+
+  // Write the zone map. Only valid zones are written.
+  void put (AipsIO&) const;
+
+  // Read the zone map for a column with the given number of rows.
+  // If the number of rows mismatches, the zone map is cleared.
+  void get (AipsIO&, rownr_t nrow);
+
+  // Show the zone map.
+  void show (ostream&) const;
+
+private:
+  // Reset the minimum and maximum of a zone.
+  void resetZone (rownr_t zone);
+
+  // Remove all zones.
+  void clear();
+
+  uInt                itsZoneSize;
+  rownr_t             itsNrow;
+  std::vector<Double> itsMin;
+  std::vector<Double> itsMax;
+  std::vector<uInt>   itsNrWritten; //# nr of rows written in order per zone
+  std::vector<bool>   itsRecalc;    //# zone has to be recalculated
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -64,5 +64,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                         "empty RODataManAccessor object");
   }
 
+  Record RODataManAccessor::getCacheStatistics() const
+  {
+    if (itsDataManager) {
+      return itsDataManager->getCacheStatistics();
+    }
+    throw DataManError ("getCacheStatistics cannot be used on a default "
+                        "empty RODataManAccessor object");
+  }
+
 } //# NAMESPACE CASACORE - END
 
@@ -111,6 +111,9 @@ public:
     void showCacheStatistics (ostream& os) const
       { itsDataManager->showCacheStatistics (os); }
 
+    // Get IO statistics as a record (see DataManager::getCacheStatistics).
+    Record getCacheStatistics() const;
+
 protected:
     // Get the data manager for the given data manager or column name.
     DataManager* baseDataManager() const
@@ -155,6 +155,27 @@ void DataManager::setMaximumCacheSize (uInt)
 void DataManager::showCacheStatistics (ostream&) const
 {}
 
+Record DataManager::getCacheStatistics() const
+{
+  return Record();
+}
+
+void DataManager::addCacheStatistics (Record& stats, Int64 naccess,
+                                      Int64 nread, Int64 nwrite,
+                                      Int64 nbytesRead)
+{
+  const char* names[] = {"naccess", "nread", "nwrite", "nbytesread"};
+  Int64 values[] = {naccess, nread, nwrite, nbytesRead};
+  for (uInt i=0; i<4; ++i) {
+    Int fld = stats.fieldNumber (names[i]);
+    if (fld < 0) {
+      stats.define (names[i], values[i]);
+    } else {
+      stats.define (fld, stats.asInt64(fld) + values[i]);
+    }
+  }
+}
+
 void DataManager::setTsmOption (const TSMOption& tsmOption)
 {
   AlwaysAssert (!multiFile_p, AipsError);
@@ -350,6 +350,17 @@ public:
     // Show the data manager's IO statistics. By default it does nothing.
     virtual void showCacheStatistics (std::ostream&) const;
 
+    // Get the data manager's IO statistics as a record containing the
+    // Int64 fields naccess, nread, nwrite and nbytesread, accumulated
+    // over all its caches. By default an empty record is returned.
+    virtual Record getCacheStatistics() const;
+
+    // Add the given cache counters to the fields in the statistics record.
+    // The fields are created if not existing yet.
+    static void addCacheStatistics (Record& stats, Int64 naccess,
+                                    Int64 nread, Int64 nwrite,
+                                    Int64 nbytesRead);
+
     // Create a column in the data manager on behalf of a table column.
     // It calls makeXColumn and checks the data type.
     // <group>
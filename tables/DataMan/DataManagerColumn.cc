@@ -88,6 +88,16 @@ Bool DataManagerColumn::canChangeShape() const
     return False;
 }
 
+const ColumnZoneMap* DataManagerColumn::zoneMap()
+{
+    return 0;
+}
+
+Bool DataManagerColumn::findMinMax (rownr_t&, rownr_t&)
+{
+    return False;
+}
+
 
 String DataManagerColumn::dataTypeId() const
     { return String(); }
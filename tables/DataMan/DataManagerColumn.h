@@ -41,6 +41,7 @@ class IPosition;
 class Slicer;
 class RefRows;
 class ArrayBase;
+class ColumnZoneMap;
 
 
 // <summary>
@@ -227,6 +228,20 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Get the zone map (minimum and maximum per zone of rows) of a scalar
+    // numeric column. It is used by the table selection to skip rows which
+    // cannot match (see class ColumnZoneMap).
+    // A data manager supporting zone maps has to make all zones valid.
+    // The default implementation returns a null pointer, thus no zone map.
+    virtual const ColumnZoneMap* zoneMap();
+
+    // Find the rows containing the minimum and maximum value of a scalar
+    // numeric column using the metadata kept by the data manager, thus
+    // without reading all values. It is used to answer the TaQL aggregate
+    // functions gmin and gmax for an entire table.
+    // The default implementation returns False, thus not possible.
+    virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr);
+
     // Get access to the ColumnCache object.
     // <group>
     ColumnCache& columnCache()
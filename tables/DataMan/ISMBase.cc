@@ -203,6 +203,17 @@ void ISMBase::showCacheStatistics (ostream& os) const
     }
 }
 
+Record ISMBase::getCacheStatistics() const
+{
+    Record stats;
+    if (cache_p != 0) {
+	addCacheStatistics (stats, cache_p->nrOfAccess(), cache_p->nrOfRead(),
+			    cache_p->nrOfWrite(),
+			    Int64(cache_p->nrOfRead()) * cache_p->bucketSize());
+    }
+    return stats;
+}
+
 void ISMBase::showIndexStatistics (ostream& os)
 {
     if (index_p != 0) {
@@ -35,6 +35,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -126,6 +127,72 @@ void ISMColumn::addRow (rownr_t, rownr_t)
     //# Nothing to do.
 }
 
+Bool ISMColumn::findMinMax (rownr_t& minRownr, rownr_t& maxRownr)
+{
+    rownr_t nrrow = stmanPtr_p->nrow();
+    if (nrrow == 0  ||  shape_p.nelements() > 0) {
+        return False;
+    }
+    switch (dataType()) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+        break;
+    default:
+        return False;
+    }
+    Double minVal = std::numeric_limits<Double>::max();
+    Double maxVal = -std::numeric_limits<Double>::max();
+    minRownr = maxRownr = 0;
+    // Step through the intervals of equal values.
+    rownr_t rownr = 0;
+    while (rownr < nrrow) {
+        getValue (rownr, lastValue_p, True);
+        Double value = 0;
+        switch (dataType()) {
+        case TpUChar:
+            value = *static_cast<uChar*>(lastValue_p);
+            break;
+        case TpShort:
+            value = *static_cast<Short*>(lastValue_p);
+            break;
+        case TpUShort:
+            value = *static_cast<uShort*>(lastValue_p);
+            break;
+        case TpInt:
+            value = *static_cast<Int*>(lastValue_p);
+            break;
+        case TpUInt:
+            value = *static_cast<uInt*>(lastValue_p);
+            break;
+        case TpInt64:
+            value = *static_cast<Int64*>(lastValue_p);
+            break;
+        case TpFloat:
+            value = *static_cast<Float*>(lastValue_p);
+            break;
+        default:
+            value = *static_cast<Double*>(lastValue_p);
+            break;
+        }
+        if (value < minVal) {
+            minVal   = value;
+            minRownr = rownr;
+        }
+        if (value > maxVal) {
+            maxVal   = value;
+            maxRownr = rownr;
+        }
+        rownr = endRow_p + 1;
+    }
+    return True;
+}
+
 void ISMColumn::remove (rownr_t bucketRownr, ISMBucket* bucket, rownr_t bucketNrrow,
 			rownr_t newNrrow)
 {
@@ -213,6 +213,11 @@ public:
     // the new rows when needed.
     virtual void addRow (rownr_t newNrrow, rownr_t oldNrrow);
 
+    // Find the rows containing the minimum and maximum value of a scalar
+    // numeric column. Only the first row of each interval of equal values
+    // is read, so it is fast for slowly varying columns such as TIME.
+    virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr);
+
     // Remove the given row in the bucket from the column.
     void remove (rownr_t bucketRownr, ISMBucket* bucket, rownr_t bucketNrrow,
 		 rownr_t newNrrow);
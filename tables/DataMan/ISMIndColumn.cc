@@ -198,6 +198,9 @@ IPosition ISMIndColumn::shape (rownr_t rownr)
 Bool ISMIndColumn::canChangeShape() const
     { return (shapeIsFixed_p  ?  False : True); }
 
+Bool ISMIndColumn::findMinMax (rownr_t&, rownr_t&)
+    { return False; }
+
 
 StIndArray* ISMIndColumn::putArrayPtr (rownr_t rownr, const IPosition& shape,
 				       Bool copyData)
@@ -133,6 +133,9 @@ public:
     // This storage manager can handle changing array shapes.
     virtual Bool canChangeShape() const;
 
+    // The minimum and maximum cannot be found for array columns.
+    virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr);
+
     // Get an array value in the given row.
     // The buffer pointed to by dataPtr has to have the correct length
     // (which is guaranteed by the ArrayColumn get function).
@@ -30,6 +30,7 @@
 #include <casacore/tables/DataMan/SSMIndStringColumn.h>
 #include <casacore/tables/DataMan/SSMIndex.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
 #include <casacore/tables/DataMan/StArrayFile.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/BlockIO.h>
@@ -44,6 +45,7 @@
 #include <casacore/casa/IO/LECanonicalIO.h>
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
+#include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/DataMan/DataManError.h>
@@ -72,7 +74,9 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMapChanged    (False),
+  itsUseZoneMaps       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -104,7 +108,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMapChanged    (False),
+  itsUseZoneMaps       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -136,7 +142,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMapChanged    (False),
+  itsUseZoneMaps       (False)
 { 
   // Get nr of rows per bucket if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -155,6 +163,9 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("ZoneMaps")) {
+    itsUseZoneMaps = spec.asBool ("ZoneMaps");
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -177,7 +188,9 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMapChanged    (False),
+  itsUseZoneMaps       (that.itsUseZoneMaps)
 {}
 
 SSMBase::~SSMBase()
@@ -224,6 +237,10 @@ Record SSMBase::getProperties() const
   const_cast<SSMBase*>(this)->getCache();
   Record rec;
   rec.define ("MaxCacheSize", Int(itsCacheSize));
+  // Only define it if used, so the properties of other tables do not change.
+  if (itsUseZoneMaps) {
+    rec.define ("ZoneMaps", True);
+  }
   return rec;
 }
 
@@ -232,6 +249,26 @@ void SSMBase::setProperties (const Record& rec)
   if (rec.isDefined("MaxCacheSize")) {
     setCacheSize (rec.asInt("MaxCacheSize"), False);
   }
+  if (rec.isDefined("ZoneMaps")) {
+    setUseZoneMaps (rec.asBool("ZoneMaps"));
+  }
+}
+
+void SSMBase::setUseZoneMaps (Bool use)
+{
+  if (use != itsUseZoneMaps) {
+    itsUseZoneMaps = use;
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->enableZoneMap (use);
+    }
+    // Write or remove the zone map file at the next flush.
+    itsZoneMapChanged = True;
+  }
+}
+
+uInt SSMBase::dataChangeCounter() const
+{
+  return table().getDataManChangeCounter (sequenceNr());
 }
 
 void SSMBase::clearCache()
@@ -273,6 +310,17 @@ void SSMBase::showCacheStatistics (ostream& anOs) const
   }
 }
 
+Record SSMBase::getCacheStatistics() const
+{
+  Record stats;
+  if (itsCache != 0) {
+    addCacheStatistics (stats, itsCache->nrOfAccess(), itsCache->nrOfRead(),
+                        itsCache->nrOfWrite(),
+                        Int64(itsCache->nrOfRead()) * itsCache->bucketSize());
+  }
+  return stats;
+}
+
 void SSMBase::showIndexStatistics (ostream & anOs) const
 {
   uInt aNrIdx=itsPtrIndex.nelements();
@@ -293,6 +341,8 @@ DataManagerColumn* SSMBase::makeScalarColumn (const String&,
     itsPtrColumn.resize (itsPtrColumn.nelements() + 32);
   }
   SSMColumn* aColumn = new SSMColumn (this, aDataType, ncolumn());
+  // Keep a zone map for numeric columns, so selections can skip buckets.
+  aColumn->enableZoneMap (itsUseZoneMaps);
   itsPtrColumn[ncolumn()] = aColumn;
   return aColumn;
 }
@@ -383,6 +433,13 @@ uInt SSMBase::getRowsPerBucket(uInt aColumn) const
   return itsPtrIndex[itsColIndexMap[aColumn]]->getRowsPerBucket();
 }
 
+uInt SSMBase::getZoneSize (uInt aColumn)
+{
+  // Make sure the index is available.
+  getCache();
+  return getRowsPerBucket (aColumn);
+}
+
 uInt SSMBase::getNewBucket()
 {
   char* aBucketPtr = new char[itsBucketSize];
@@ -965,7 +1022,14 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
       itsFile->fsync();
     }
     changed = True;
+  }
+  // The change counter of this data manager in the table's lock file
+  // is incremented after this flush if the data have changed.
+  // The zone maps are only valid for that counter value.
+  if (isDataChanged  ||  itsZoneMapChanged) {
+    writeZoneMaps (dataChangeCounter() + (isDataChanged ? 1 : 0));
     isDataChanged = False;
+    itsZoneMapChanged = False;
   }
   if (itsIosFile) {
     itsIosFile->flush(doFsync);
@@ -1002,6 +1066,7 @@ rownr_t SSMBase::resync64 (rownr_t aNrRows)
   for (uInt i=0; i<aNrCol; i++) {
     itsPtrColumn[i]->resync (itsNrRows);
   }
+  readZoneMaps();
   return itsNrRows;
 }
 
@@ -1031,6 +1096,12 @@ rownr_t SSMBase::open64 (rownr_t aRowNr, AipsIO& ios)
   for (uInt i=0; i<aNrCol; i++) {
     itsPtrColumn[i]->getFile(itsNrRows);
   }
+  // Zone maps are used if their file exists.
+  if (! multiFile()  &&  File(fileName() + 'z').exists()) {
+    setUseZoneMaps (True);
+    itsZoneMapChanged = False;
+  }
+  readZoneMaps();
   return itsNrRows;
 }
 
@@ -1066,6 +1137,90 @@ void SSMBase::deleteManager()
     delete itsFile;
     itsFile = 0;
   }
+  File zoneFile (fileName() + 'z');
+  if (zoneFile.exists()) {
+    DOos::remove (zoneFile.path().absoluteName(), False, False);
+  }
+}
+
+void SSMBase::writeZoneMaps (uInt changeCounter)
+{
+  if (multiFile()) {
+    return;
+  }
+  File zoneFile (fileName() + 'z');
+  if (! itsUseZoneMaps) {
+    if (zoneFile.exists()) {
+      DOos::remove (zoneFile.path().absoluteName(), False, False);
+    }
+    return;
+  }
+  // Count the columns with a zone map.
+  uInt nzm = 0;
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->getZoneMap()) {
+      nzm++;
+    }
+  }
+  if (nzm == 0) {
+    return;
+  }
+  // The zone maps are stored per column name, because column numbers
+  // change when columns are removed.
+  AipsIO ios (zoneFile.path().absoluteName(), ByteIO::New);
+  ios.putstart ("SSMZoneMap", 2);
+  ios << changeCounter << uInt64(itsNrRows) << nzm;
+  for (uInt i=0; i<ncolumn(); i++) {
+    const ColumnZoneMap* zm = itsPtrColumn[i]->getZoneMap();
+    if (zm) {
+      ios << itsPtrColumn[i]->columnName();
+      zm->put (ios);
+    }
+  }
+  ios.putend();
+}
+
+void SSMBase::readZoneMaps()
+{
+  if (multiFile()  ||  ! itsUseZoneMaps) {
+    return;
+  }
+  File zoneFile (fileName() + 'z');
+  if (! zoneFile.exists()) {
+    return;
+  }
+  try {
+    AipsIO ios (zoneFile.path().absoluteName());
+    uInt version = ios.getstart ("SSMZoneMap");
+    uInt changeCounter = 0;
+    if (version >= 2) {
+      ios >> changeCounter;
+    }
+    // Do not use the zone maps if the data have been changed after they
+    // were written (e.g. by an older casacore version not knowing about
+    // zone maps). The zones are recalculated when needed.
+    if (version < 2  ||  changeCounter != dataChangeCounter()) {
+      return;
+    }
+    uInt64 nrow;
+    uInt nzm;
+    String name;
+    ios >> nrow >> nzm;
+    for (uInt j=0; j<nzm; j++) {
+      ios >> name;
+      std::unique_ptr<ColumnZoneMap> zm (new ColumnZoneMap);
+      zm->get (ios, itsNrRows);
+      for (uInt i=0; i<ncolumn(); i++) {
+        if (itsPtrColumn[i]->columnName() == name) {
+          itsPtrColumn[i]->setZoneMap (zm.release());
+          break;
+        }
+      }
+    }
+    ios.getend();
+  } catch (const std::exception&) {
+    // Ignore a damaged file; the zone maps are recalculated when needed.
+  }
 }
 
 void SSMBase::init()
@@ -132,6 +132,16 @@ class SSMStringHandler;
 // always an index availanle in case the system crashes.
 // If possible 2 halfs of a single bucket are used alternately, otherwise 
 // separate buckets are used.
+// <p>
+// Optionally (see <src>setUseZoneMaps</src>) a
+// <linkto class=ColumnZoneMap>ColumnZoneMap</linkto> is kept for each
+// scalar numeric column, so selections can skip buckets. The zone maps are
+// stored in a separate file (with suffix z), so the data file format is
+// not changed. Its existence tells that zone maps are used. The file
+// contains the change counter of the data manager as kept in the table's
+// lock file. The zone maps are only used if it matches the current counter,
+// so the file is ignored after the data have been changed by software not
+// knowing about zone maps.
 // </synopsis>
 
 // <motivation>
@@ -187,15 +197,26 @@ public:
   virtual Record dataManagerSpec() const;
 
   // Get data manager properties that can be modified.
-  // It is only ActualCacheSize (the actual cache size in buckets).
+  // It is MaxCacheSize (the maximum cache size in buckets) and, if zone
+  // maps are used, ZoneMaps.
   // It is a subset of the data manager specification.
   virtual Record getProperties() const;
 
   // Modify data manager properties.
-  // Only MaxCacheSize can be used. It is similar to function setCacheSize
-  // with <src>canExceedNrBuckets=False</src>.
+  // MaxCacheSize is similar to function setCacheSize with
+  // <src>canExceedNrBuckets=False</src>. ZoneMaps is similar to function
+  // setUseZoneMaps.
   virtual void setProperties (const Record& spec);
 
+  // Tell if zone maps have to be kept for the scalar numeric columns.
+  // By default they are not kept. If kept, they are written into a file
+  // at the next flush. That file is removed if switched off.
+  void setUseZoneMaps (Bool use);
+
+  // Are zone maps kept?
+  Bool useZoneMaps() const
+    { return itsUseZoneMaps; }
+
   // Get the version of the class.
   uInt getVersion() const;
   
@@ -217,6 +238,9 @@ public:
   // Show the statistics of all caches used.
   virtual void showCacheStatistics (ostream& anOs) const;
 
+  // Get the statistics of the cache as a record.
+  virtual Record getCacheStatistics() const;
+
   // Show statistics of all indices used.
   void showIndexStatistics (ostream & anOs) const;
 
@@ -281,6 +305,14 @@ public:
   // Get rows per bucket for the given column.
   uInt getRowsPerBucket (uInt aColumn) const;
 
+  // Get the zone size to use for the zone map of the given column.
+  // It is the number of rows per bucket.
+  uInt getZoneSize (uInt aColumn);
+
+  // Tell that a zone map has been recalculated, so it has to be written.
+  void setZoneMapChanged()
+    { itsZoneMapChanged = True; }
+
   // Return a pointer to the (one and only) StringHandler object.
   SSMStringHandler* getStringHandler();
 
@@ -389,6 +421,17 @@ private:
   // Write the header and the indices.
   void writeIndex();
 
+  // Write the zone maps of the columns into the file with suffix z.
+  // The change counter tells for which data they are valid.
+  // Nothing is written if a MultiFile is used.
+  void writeZoneMaps (uInt changeCounter);
+
+  // Read the zone maps (if the file exists and is up-to-date).
+  void readZoneMaps();
+
+  // Get the change counter of this data manager from the table.
+  uInt dataChangeCounter() const;
+
 
   //# Declare member variables.
   // Name of data manager.
@@ -458,6 +501,12 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // Has a zone map been recalculated since the last flush?
+  Bool itsZoneMapChanged;
+
+  // Are zone maps kept?
+  Bool itsUseZoneMaps;
 };
 
 
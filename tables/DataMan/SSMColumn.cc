@@ -26,6 +26,8 @@
 #include <casacore/tables/DataMan/SSMColumn.h>
 #include <casacore/tables/DataMan/SSMBase.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
+#include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -35,6 +37,8 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <algorithm>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -48,7 +52,8 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsUseZoneMap  (False)
 {
   init();
 }
@@ -83,14 +88,19 @@ IPosition SSMColumn::shape (rownr_t)
 
 void SSMColumn::doCreate(rownr_t)
 {
+  itsZoneMap.reset();
 }
 
 void SSMColumn::getFile(rownr_t)
 {
 }
 
-void SSMColumn::addRow (rownr_t aNewNrRows, rownr_t, Bool doInit)
+void SSMColumn::addRow (rownr_t aNewNrRows, rownr_t anOldNrRows, Bool doInit)
 {
+  if (itsUseZoneMap) {
+    makeZoneMap();
+    itsZoneMap->addRows (aNewNrRows - anOldNrRows);
+  }
   if (doInit  &&  dataType() == TpString) {
     rownr_t aRowNr=0;
     rownr_t aNrRows=aNewNrRows;
@@ -112,6 +122,9 @@ void SSMColumn::addRow (rownr_t aNewNrRows, rownr_t, Bool doInit)
 
 void SSMColumn::deleteRow(rownr_t aRowNr)
 {
+  if (itsZoneMap) {
+    itsZoneMap->removeRow (aRowNr);
+  }
   char*   aValue;
   rownr_t aSRow;
   rownr_t anERow;
@@ -341,6 +354,9 @@ void SSMColumn::putBool (rownr_t aRowNr, const Bool* aValue)
 void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uChar*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -349,6 +365,9 @@ void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Short*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -357,6 +376,9 @@ void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uShort*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -365,6 +387,9 @@ void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -373,6 +398,9 @@ void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uInt*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -381,6 +409,9 @@ void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int64*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -389,6 +420,9 @@ void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<float*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -397,6 +431,9 @@ void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 void SSMColumn::putdouble (rownr_t aRowNr, const double* aValue)
 {
   putValue(aRowNr,aValue);
+  if (itsZoneMap) {
+    itsZoneMap->put (aRowNr, *aValue);
+  }
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<double*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -561,6 +598,10 @@ void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
 
   // Be sure cache will be emptied
   columnCache().invalidate();
+  // The zone map has to be recalculated.
+  if (itsZoneMap) {
+    itsZoneMap->invalidate();
+  }
 }
 
 void SSMColumn::removeColumn()
@@ -626,6 +667,200 @@ void SSMColumn::resync (rownr_t)
 {
     // Invalidate the last value read.
     columnCache().invalidate();
+    // The zone map is read again by SSMBase::resync64.
+    itsZoneMap.reset();
+}
+
+void SSMColumn::enableZoneMap (Bool enable)
+{
+  switch (dataType()) {
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpInt64:
+  case TpFloat:
+  case TpDouble:
+    itsUseZoneMap = enable;
+    break;
+  default:
+    itsUseZoneMap = False;
+    break;
+  }
+  if (! itsUseZoneMap) {
+    itsZoneMap.reset();
+  }
+}
+
+void SSMColumn::setZoneMap (ColumnZoneMap* zoneMap)
+{
+  if (itsUseZoneMap) {
+    itsZoneMap.reset (zoneMap);
+  } else {
+    delete zoneMap;
+  }
+}
+
+void SSMColumn::makeZoneMap()
+{
+  if (! itsZoneMap) {
+    // Use the bucket size as the zone size, so skipping a zone means
+    // skipping a bucket (as long as no rows are removed).
+    itsZoneMap.reset (new ColumnZoneMap (itsSSMPtr->getZoneSize(itsColNr)));
+    itsZoneMap->addRows (itsSSMPtr->getNRow(), True);
+  }
+}
+
+const ColumnZoneMap* SSMColumn::zoneMap()
+{
+  if (! itsUseZoneMap) {
+    return 0;
+  }
+  makeZoneMap();
+  for (rownr_t zone=0; zone<itsZoneMap->nzone(); ++zone) {
+    if (! itsZoneMap->isValid(zone)) {
+      calcZone (zone);
+      itsSSMPtr->setZoneMapChanged();
+    }
+  }
+  return itsZoneMap.get();
+}
+
+Bool SSMColumn::findMinMax (rownr_t& minRownr, rownr_t& maxRownr)
+{
+  const ColumnZoneMap* zm = zoneMap();
+  if (!zm  ||  zm->nrow() == 0) {
+    return False;
+  }
+  // The zone limits are bounds, because they are not narrowed when
+  // a value is overwritten. So the zones have to be read until a zone
+  // cannot contain a better value.
+  std::vector<rownr_t> zones(zm->nzone());
+  for (rownr_t i=0; i<zones.size(); ++i) {
+    zones[i] = i;
+  }
+  std::stable_sort (zones.begin(), zones.end(),
+             [zm](rownr_t z1, rownr_t z2)
+             { return zm->minimum(z1) < zm->minimum(z2); });
+  Double minVal = std::numeric_limits<Double>::max();
+  minRownr = 0;
+  for (rownr_t zone : zones) {
+    if (zm->minimum(zone) >= minVal) break;
+    Double zoneMin, zoneMax;
+    rownr_t zoneMinRow, zoneMaxRow;
+    scanZone (zone, zoneMin, zoneMax, zoneMinRow, zoneMaxRow);
+    if (zoneMin < minVal) {
+      minVal   = zoneMin;
+      minRownr = zoneMinRow;
+    }
+  }
+  std::stable_sort (zones.begin(), zones.end(),
+             [zm](rownr_t z1, rownr_t z2)
+             { return zm->maximum(z1) > zm->maximum(z2); });
+  Double maxVal = -std::numeric_limits<Double>::max();
+  maxRownr = 0;
+  for (rownr_t zone : zones) {
+    if (zm->maximum(zone) <= maxVal) break;
+    Double zoneMin, zoneMax;
+    rownr_t zoneMinRow, zoneMaxRow;
+    scanZone (zone, zoneMin, zoneMax, zoneMinRow, zoneMaxRow);
+    if (zoneMax > maxVal) {
+      maxVal   = zoneMax;
+      maxRownr = zoneMaxRow;
+    }
+  }
+  return True;
+}
+
+template<typename T>
+void ssmColumnMinMax (const void* buf, rownr_t n, rownr_t firstRow,
+                      Double& minVal, Double& maxVal,
+                      rownr_t& minRownr, rownr_t& maxRownr)
+{
+  const T* values = static_cast<const T*>(buf);
+  for (rownr_t i=0; i<n; ++i) {
+    Double value = values[i];
+    if (value < minVal) {
+      minVal = value;
+      minRownr = firstRow + i;
+    }
+    if (value > maxVal) {
+      maxVal = value;
+      maxRownr = firstRow + i;
+    }
+  }
+}
+
+void SSMColumn::calcZone (rownr_t zone)
+{
+  Double minVal;
+  Double maxVal;
+  rownr_t minRownr;
+  rownr_t maxRownr;
+  scanZone (zone, minVal, maxVal, minRownr, maxRownr);
+  itsZoneMap->setZone (zone, minVal, maxVal);
+}
+
+void SSMColumn::scanZone (rownr_t zone, Double& minVal, Double& maxVal,
+                          rownr_t& minRownr, rownr_t& maxRownr)
+{
+  minVal = std::numeric_limits<Double>::max();
+  maxVal = -std::numeric_limits<Double>::max();
+  minRownr = maxRownr = itsZoneMap->firstRow (zone);
+  // Use a separate buffer to leave the column cache untouched.
+  std::vector<char> buf;
+  rownr_t aRowNr = itsZoneMap->firstRow (zone);
+  rownr_t aLastRow = itsZoneMap->lastRow (zone);
+  while (aRowNr <= aLastRow) {
+    rownr_t aStartRow;
+    rownr_t anEndRow;
+    char* aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
+                                    columnName());
+    rownr_t aNr = std::min(anEndRow, aLastRow) - aRowNr + 1;
+    buf.resize (aNr * itsLocalSize);
+    itsReadFunc (buf.data(),
+                 aValue + (aRowNr-aStartRow) * itsExternalSizeBytes,
+                 aNr * itsNrCopy);
+    switch (dataType()) {
+    case TpUChar:
+      ssmColumnMinMax<uChar> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpShort:
+      ssmColumnMinMax<Short> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpUShort:
+      ssmColumnMinMax<uShort> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpInt:
+      ssmColumnMinMax<Int> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpUInt:
+      ssmColumnMinMax<uInt> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpInt64:
+      ssmColumnMinMax<Int64> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpFloat:
+      ssmColumnMinMax<Float> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    case TpDouble:
+      ssmColumnMinMax<Double> (buf.data(), aNr, aRowNr, minVal, maxVal,
+                              minRownr, maxRownr);
+      break;
+    default:
+      throw DataManInternalError ("SSMColumn::scanZone: non-numeric column "
+                                  + columnName());
+    }
+    aRowNr += aNr;
+  }
 }
 
 } //# NAMESPACE CASACORE - END
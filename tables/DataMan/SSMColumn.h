@@ -34,10 +34,12 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward declarations
+class ColumnZoneMap;
 
 
 // <summary>
@@ -201,6 +203,29 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Tell if a zone map has to be maintained for this column.
+  // It is only done for scalar numeric columns.
+  void enableZoneMap (Bool enable);
+
+  // Get the zone map after recalculating its invalid zones.
+  // A null pointer is returned if no zone map is maintained.
+  virtual const ColumnZoneMap* zoneMap();
+
+  // Get the zone map as currently maintained (for writing it).
+  // A null pointer is returned if the zone map has not been created.
+  const ColumnZoneMap* getZoneMap() const
+    { return itsZoneMap.get(); }
+
+  // Set the zone map (as read from the file).
+  void setZoneMap (ColumnZoneMap* zoneMap);
+
+  // Find the rows containing the minimum and maximum value.
+  // The zones are searched in order of their minimum (maximum) and
+  // the search stops at the first zone that cannot contain a smaller
+  // (larger) value. Usually only one zone has to be read for each.
+  // False is returned if no zone map is maintained.
+  virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr);
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, rownr_t rowNr, rownr_t startRow, rownr_t endRow);
@@ -257,8 +282,24 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is a zone map maintained?
+  Bool              itsUseZoneMap;
+  // The zone map (created when needed).
+  std::unique_ptr<ColumnZoneMap> itsZoneMap;
   
 private:
+  // Create the zone map if not done yet.
+  // All zones of existing rows are invalid.
+  void makeZoneMap();
+
+  // Recalculate the minimum and maximum of a zone by reading its values.
+  void calcZone (rownr_t zone);
+
+  // Read the values of a zone to get its minimum and maximum and the
+  // rows containing them.
+  void scanZone (rownr_t zone, Double& minVal, Double& maxVal,
+                 rownr_t& minRownr, rownr_t& maxRownr);
+
   // Initialize part of the object.
   // It determines the nr of elements, the function to use to convert
   // from local to file format, etc..
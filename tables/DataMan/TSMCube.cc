@@ -166,6 +166,16 @@ void TSMCube::showCacheStatistics (ostream& os) const
     }
 }
 
+void TSMCube::addCacheStatistics (Record& stats) const
+{
+    if (cache_p != 0) {
+        DataManager::addCacheStatistics
+          (stats, cache_p->nrOfAccess(), cache_p->nrOfRead(),
+           cache_p->nrOfWrite(),
+           Int64(cache_p->nrOfRead()) * cache_p->bucketSize());
+    }
+}
+
 uInt TSMCube::coordinateSize (const String& coordinateName) const
 {
     if (! values_p.isDefined (coordinateName)) {
@@ -154,6 +154,11 @@ public:
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Add the cache statistics to the given record
+    // (see <src>DataManager::getCacheStatistics</src>).
+    // Nothing is added if no cache is used.
+    virtual void addCacheStatistics (Record& stats) const;
+
     // Put the data of the object into the AipsIO stream.
     void putObject (AipsIO& ios);
 
@@ -0,0 +1,617 @@
+//# TileShapeAdvisor.cc: Advise a tile shape from the access pattern of a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/DataMan/TileShapeAdvisor.h>
+#include <casacore/tables/DataMan/DataManInfo.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <cstdlib>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // Simulation of a tile cache using LRU replacement.
+  // It counts the number of tiles read and written.
+  class TileCache
+  {
+  public:
+    explicit TileCache (uInt64 ntiles)
+      : itsSize (ntiles)
+    {}
+
+    // Access a tile and return the number of tile I/Os needed.
+    uInt access (uInt64 tile, Bool write)
+    {
+      auto iter = itsMap.find (tile);
+      if (iter != itsMap.end()) {
+        // Make it the most recently used tile.
+        itsTiles.splice (itsTiles.begin(), itsTiles, iter->second);
+        iter->second->second = iter->second->second || write;
+        return 0;
+      }
+      uInt nio = 1;
+      if (itsTiles.size() >= itsSize) {
+        // Remove the least recently used tile; write it if changed.
+        if (itsTiles.back().second) {
+          nio++;
+        }
+        itsMap.erase (itsTiles.back().first);
+        itsTiles.pop_back();
+      }
+      itsTiles.emplace_front (tile, write);
+      itsMap[tile] = itsTiles.begin();
+      return nio;
+    }
+
+    // Get the number of changed tiles to be written at the end.
+    uInt64 ndirty() const
+    {
+      uInt64 n = 0;
+      for (const auto& tile : itsTiles) {
+        if (tile.second) {
+          n++;
+        }
+      }
+      return n;
+    }
+
+  private:
+    typedef std::list<std::pair<uInt64,Bool>> TileList;
+    uInt64 itsSize;
+    TileList itsTiles;
+    std::unordered_map<uInt64,TileList::iterator> itsMap;
+  };
+
+  // Parse a shape written by showContainer like [1,2,3].
+  Bool parseShape (const std::string& str, IPosition& shape)
+  {
+    if (str.size() < 2  ||  str[0] != '['  ||  str[str.size()-1] != ']') {
+      return False;
+    }
+    std::vector<Int64> vals;
+    std::istringstream iss(str.substr (1, str.size()-2));
+    std::string val;
+    while (std::getline (iss, val, ',')) {
+      vals.push_back (std::strtoll (val.c_str(), 0, 10));
+    }
+    shape.resize (vals.size());
+    for (uInt i=0; i<vals.size(); ++i) {
+      shape[i] = vals[i];
+    }
+    return True;
+  }
+
+  // Parse the blc, trc and inc written by TableTrace like [0,0][3,0][1,1].
+  Bool parseSlice (const std::string& str, IPosition& blc,
+                   IPosition& trc, IPosition& inc)
+  {
+    std::string::size_type p1 = str.find ("][");
+    if (p1 == std::string::npos) {
+      return False;
+    }
+    std::string::size_type p2 = str.find ("][", p1+1);
+    if (p2 == std::string::npos) {
+      return False;
+    }
+    return (parseShape (str.substr(0, p1+1), blc)  &&
+            parseShape (str.substr(p1+1, p2-p1), trc)  &&
+            parseShape (str.substr(p2+1), inc));
+  }
+
+} //# end anonymous namespace
+
+
+TileShapeAdvisor::TileShapeAdvisor (const IPosition& cellShape, rownr_t nrow,
+                                    uInt valueSize)
+{
+  init (cellShape, nrow, valueSize);
+}
+
+TileShapeAdvisor::TileShapeAdvisor (const Table& table,
+                                    const String& columnName)
+{
+  const ColumnDesc& cdesc = table.tableDesc().columnDesc (columnName);
+  if (! cdesc.isArray()  ||  cdesc.dataType() == TpString) {
+    throw TableError ("TileShapeAdvisor: column " + columnName +
+                      " is not a numeric array column");
+  }
+  IPosition cellShape = cdesc.shape();
+  if (cellShape.empty()) {
+    TableColumn col(table, columnName);
+    if (table.nrow() == 0  ||  ! col.isDefined (0)) {
+      throw TableError ("TileShapeAdvisor: shape of column " + columnName +
+                        " is unknown");
+    }
+    cellShape = col.shape (0);
+  }
+  init (cellShape, table.nrow(), ValType::getTypeSize (cdesc.dataType()));
+}
+
+void TileShapeAdvisor::init (const IPosition& cellShape, rownr_t nrow,
+                             uInt valueSize)
+{
+  if (cellShape.empty()  ||  cellShape.product() <= 0  ||  nrow == 0
+  ||  valueSize == 0) {
+    throw AipsError ("TileShapeAdvisor: cell shape, number of rows and "
+                     "value size must be > 0");
+  }
+  itsCubeShape = cellShape;
+  itsCubeShape.append (IPosition(1, nrow));
+  itsValueSize    = valueSize;
+  itsMinTileBytes = 32768;
+  itsMaxTileBytes = 4194304;
+  itsMaxCacheSize = 64*1024*1024;
+  itsSeekCost     = 65536;
+  itsCacheSize    = 0;
+  itsCost         = 0;
+}
+
+void TileShapeAdvisor::setTileSizeRange (uInt64 minBytes, uInt64 maxBytes)
+{
+  if (minBytes > maxBytes) {
+    throw AipsError ("TileShapeAdvisor: minimum tile size exceeds maximum");
+  }
+  itsMinTileBytes = minBytes;
+  itsMaxTileBytes = maxBytes;
+}
+
+void TileShapeAdvisor::setMaxCacheSize (uInt64 nbytes)
+{
+  itsMaxCacheSize = nbytes;
+}
+
+void TileShapeAdvisor::setSeekCost (uInt64 nbytes)
+{
+  itsSeekCost = nbytes;
+}
+
+void TileShapeAdvisor::addAccess (const IPosition& blc, const IPosition& trc,
+                                  const IPosition& inc, Bool write)
+{
+  const uInt ndim = itsCubeShape.size();
+  IPosition stride(inc);
+  if (stride.empty()) {
+    stride.resize (ndim);
+    stride = 1;
+  }
+  if (blc.size() != ndim  ||  trc.size() != ndim  ||  stride.size() != ndim) {
+    throw AipsError ("TileShapeAdvisor::addAccess: blc, trc or inc has "
+                     "wrong dimensionality");
+  }
+  for (uInt i=0; i<ndim; ++i) {
+    if (blc[i] < 0  ||  blc[i] > trc[i]  ||  trc[i] >= itsCubeShape[i]
+    ||  stride[i] <= 0) {
+      throw AipsError ("TileShapeAdvisor::addAccess: invalid blc, trc or inc");
+    }
+  }
+  Access access;
+  access.blc   = blc;
+  access.trc   = trc;
+  access.inc   = stride;
+  access.write = write;
+  itsAccesses.push_back (access);
+}
+
+void TileShapeAdvisor::addRowAccess (rownr_t startRow, rownr_t endRow,
+                                     rownr_t incrRow,
+                                     const IPosition& blc,
+                                     const IPosition& trc,
+                                     const IPosition& inc, Bool write)
+{
+  const uInt ncell = itsCubeShape.size() - 1;
+  const rownr_t nrow = itsCubeShape[ncell];
+  // Ignore rows not in the table (e.g., added later).
+  if (startRow >= nrow) {
+    return;
+  }
+  IPosition cblc(itsCubeShape.size(), 0);
+  IPosition ctrc(itsCubeShape - 1);
+  IPosition cinc(itsCubeShape.size(), 1);
+  // Use the cell slice if it is valid (TableTrace shows the Slicer as given).
+  if (blc.size() == ncell  &&  trc.size() == ncell  &&  inc.size() == ncell) {
+    for (uInt i=0; i<ncell; ++i) {
+      cblc[i] = std::max (blc[i], ssize_t(0));
+      if (trc[i] >= 0  &&  trc[i] < itsCubeShape[i]) {
+        ctrc[i] = trc[i];
+      }
+      if (cblc[i] > ctrc[i]) {
+        return;
+      }
+      cinc[i] = std::max (inc[i], ssize_t(1));
+    }
+  }
+  cblc[ncell] = startRow;
+  ctrc[ncell] = std::min (std::max(startRow, endRow), nrow-1);
+  cinc[ncell] = std::max (incrRow, rownr_t(1));
+  addAccess (cblc, ctrc, cinc, write);
+}
+
+void TileShapeAdvisor::addPattern (AccessPattern pattern, uInt rowsPerTime)
+{
+  const uInt ncell = itsCubeShape.size() - 1;
+  const rownr_t nrow = itsCubeShape[ncell];
+  if (rowsPerTime == 0  ||  rowsPerTime > nrow) {
+    rowsPerTime = nrow;
+  }
+  const IPosition noSlice;
+  switch (pattern) {
+  case PerTime:
+    for (rownr_t row=0; row<nrow; row+=rowsPerTime) {
+      addRowAccess (row, row+rowsPerTime-1, 1, noSlice, noSlice, noSlice,
+                    False);
+    }
+    break;
+  case PerBaseline:
+    for (uInt bl=0; bl<rowsPerTime; ++bl) {
+      addRowAccess (bl, nrow-1, rowsPerTime, noSlice, noSlice, noSlice,
+                    False);
+    }
+    break;
+  case PerChannel:
+    {
+      IPosition blc(ncell, 0);
+      IPosition trc(itsCubeShape.getFirst (ncell) - 1);
+      IPosition inc(ncell, 1);
+      for (Int64 chan=0; chan<itsCubeShape[ncell-1]; ++chan) {
+        blc[ncell-1] = chan;
+        trc[ncell-1] = chan;
+        addRowAccess (0, nrow-1, 1, blc, trc, inc, False);
+      }
+    }
+    break;
+  }
+}
+
+uInt TileShapeAdvisor::readTrace (const String& traceFileName,
+                                  const String& columnName,
+                                  const String& tableName, Bool useWrites)
+{
+  std::ifstream ifs(traceFileName.c_str());
+  if (! ifs) {
+    throw AipsError ("TileShapeAdvisor: trace file " + traceFileName +
+                     " cannot be opened");
+  }
+  // TableTrace shows the absolute table name when a table is opened.
+  // The table ids can be reused after a table is closed.
+  const Bool useAllTables = tableName.empty();
+  const String absName = (useAllTables ? tableName :
+                          Path(tableName).absoluteName());
+  std::set<Int> tableIds;
+  uInt nacc = itsAccesses.size();
+  std::string line;
+  while (std::getline (ifs, line)) {
+    if (line.empty()  ||  line[0] == '#') {
+      continue;
+    }
+    // A line looks like: time oper t=tabid name rows [shape] [blc/trc/inc]
+    std::istringstream iss(line);
+    std::string time, oper, tabid, rows, shape, slice;
+    String name;
+    iss >> time >> oper >> tabid >> name;
+    if (!iss  ||  oper.size() != 1  ||  tabid.compare (0, 2, "t=") != 0) {
+      continue;
+    }
+    Int id = std::atoi (tabid.c_str() + 2);
+    char op = oper[0];
+    if (op == 'n'  ||  op == 'o') {
+      if (!useAllTables  &&  name == absName) {
+        tableIds.insert (id);
+      }
+      continue;
+    } else if (op == 'c') {
+      if (!useAllTables  &&  name == absName) {
+        tableIds.erase (id);
+      }
+      continue;
+    }
+    if (name != columnName  ||  !(op == 'r'  ||  (op == 'w'  &&  useWrites))
+    ||  !(useAllTables  ||  tableIds.count (id) > 0)) {
+      continue;
+    }
+    iss >> rows >> shape >> slice;
+    IPosition blc, trc, inc;
+    if (! parseSlice (slice, blc, trc, inc)) {
+      blc.resize (0);
+    }
+    if (rows == "*") {
+      addRowAccess (0, itsCubeShape[itsCubeShape.size()-1] - 1, 1,
+                    blc, trc, inc, op == 'w');
+      continue;
+    }
+    // The rows are given like 1,4:8,10:20:2
+    std::istringstream rowss(rows);
+    std::string item;
+    while (std::getline (rowss, item, ',')) {
+      rownr_t vals[3];
+      uInt nval = 0;
+      std::istringstream itemss(item);
+      std::string val;
+      while (nval < 3  &&  std::getline (itemss, val, ':')) {
+        vals[nval++] = std::strtoull (val.c_str(), 0, 10);
+      }
+      if (nval > 0) {
+        addRowAccess (vals[0], (nval > 1 ? vals[1] : vals[0]),
+                      (nval > 2 ? vals[2] : 1),
+                      blc, trc, inc, op == 'w');
+      }
+    }
+  }
+  return itsAccesses.size() - nacc;
+}
+
+uInt64 TileShapeAdvisor::cacheTiles (const IPosition& tileShape,
+                                     uInt64 cacheSize) const
+{
+  uInt64 tileBytes = tileShape.product() * itsValueSize;
+  return std::max (cacheSize / tileBytes, uInt64(1));
+}
+
+Double TileShapeAdvisor::simulate (const IPosition& tileShape,
+                                   uInt64 ntiles, Double maxCost) const
+{
+  const Double tileCost = tileShape.product() * itsValueSize + itsSeekCost;
+  const uInt ndim = itsCubeShape.size();
+  // Get the tile number stride of each axis.
+  std::vector<uInt64> tileStride(ndim);
+  uInt64 stride = 1;
+  for (uInt i=0; i<ndim; ++i) {
+    tileStride[i] = stride;
+    stride *= (itsCubeShape[i] + tileShape[i] - 1) / tileShape[i];
+  }
+  TileCache cache(ntiles);
+  uInt64 nio = 0;
+  std::vector<std::vector<uInt64>> tiles(ndim);
+  std::vector<size_t> pos(ndim);
+  for (const Access& acc : itsAccesses) {
+    // Determine the tiles touched on each axis.
+    for (uInt i=0; i<ndim; ++i) {
+      std::vector<uInt64>& axTiles = tiles[i];
+      axTiles.clear();
+      const Int64 len = tileShape[i];
+      if (acc.inc[i] <= len) {
+        for (Int64 j=acc.blc[i]/len; j<=acc.trc[i]/len; ++j) {
+          axTiles.push_back (j * tileStride[i]);
+        }
+      } else {
+        for (Int64 j=acc.blc[i]; j<=acc.trc[i]; j+=acc.inc[i]) {
+          axTiles.push_back (j / len * tileStride[i]);
+        }
+      }
+      pos[i] = 0;
+    }
+    // Access the tiles in the same order as TSMCube (first axis fastest).
+    while (True) {
+      uInt64 tile = 0;
+      for (uInt i=0; i<ndim; ++i) {
+        tile += tiles[i][pos[i]];
+      }
+      uInt n = cache.access (tile, acc.write);
+      if (n > 0) {
+        nio += n;
+        // Stop if already more expensive than the limit.
+        if (maxCost >= 0  &&  nio * tileCost > maxCost) {
+          return nio * tileCost;
+        }
+      }
+      uInt i=0;
+      for (; i<ndim; ++i) {
+        if (++pos[i] < tiles[i].size()) {
+          break;
+        }
+        pos[i] = 0;
+      }
+      if (i == ndim) {
+        break;
+      }
+    }
+  }
+  nio += cache.ndirty();
+  return nio * tileCost;
+}
+
+Double TileShapeAdvisor::predictCost (const IPosition& tileShape,
+                                      uInt64 cacheSize) const
+{
+  if (tileShape.size() != itsCubeShape.size()  ||  tileShape.product() <= 0) {
+    throw AipsError ("TileShapeAdvisor::predictCost: tile shape " +
+                     tileShape.toString() + " has wrong dimensionality");
+  }
+  if (cacheSize == 0) {
+    cacheSize = itsMaxCacheSize;
+  }
+  return simulate (tileShape, cacheTiles (tileShape, cacheSize));
+}
+
+std::vector<IPosition> TileShapeAdvisor::candidates() const
+{
+  const uInt ndim = itsCubeShape.size();
+  // Tile lengths per axis are powers of two and the axis length.
+  std::vector<std::vector<Int64>> lengths(ndim);
+  for (uInt i=0; i<ndim; ++i) {
+    for (Int64 len=1; len<itsCubeShape[i]; len*=2) {
+      lengths[i].push_back (len);
+    }
+    lengths[i].push_back (itsCubeShape[i]);
+  }
+  std::vector<IPosition> result;
+  IPosition tileShape(ndim);
+  std::vector<size_t> pos(ndim, 0);
+  while (True) {
+    for (uInt i=0; i<ndim; ++i) {
+      tileShape[i] = lengths[i][pos[i]];
+    }
+    uInt64 nbytes = tileShape.product() * itsValueSize;
+    if (nbytes <= itsMaxTileBytes  &&
+        (nbytes >= itsMinTileBytes  ||  tileShape == itsCubeShape)) {
+      result.push_back (tileShape);
+    }
+    uInt i=0;
+    for (; i<ndim; ++i) {
+      if (++pos[i] < lengths[i].size()) {
+        break;
+      }
+      pos[i] = 0;
+    }
+    if (i == ndim) {
+      break;
+    }
+  }
+  return result;
+}
+
+IPosition TileShapeAdvisor::advise()
+{
+  if (itsAccesses.empty()) {
+    throw AipsError ("TileShapeAdvisor::advise: no accesses defined");
+  }
+  std::vector<IPosition> cands = candidates();
+  if (cands.empty()) {
+    throw AipsError ("TileShapeAdvisor::advise: no tile shape fits in the "
+                     "tile size range");
+  }
+  // Simulate the largest tiles first, because they are fast to simulate
+  // and usually give a low bound to stop simulating worse candidates.
+  std::stable_sort (cands.begin(), cands.end(),
+                    [](const IPosition& left, const IPosition& right)
+                    { return left.product() > right.product(); });
+  // Simulate the candidates in parallel.
+  std::vector<Double> costs(cands.size());
+  const Int64 ncand = cands.size();
+  Double bestCost = -1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (Int64 i=0; i<ncand; ++i) {
+    Double bound;
+#ifdef _OPENMP
+#pragma omp critical(TileShapeAdvisor_bestCost)
+#endif
+    bound = bestCost;
+    costs[i] = simulate (cands[i], cacheTiles (cands[i], itsMaxCacheSize),
+                         bound);
+#ifdef _OPENMP
+#pragma omp critical(TileShapeAdvisor_bestCost)
+#endif
+    {
+      if (bestCost < 0  ||  costs[i] < bestCost) {
+        bestCost = costs[i];
+      }
+    }
+  }
+  // Take the cheapest one; for equal costs the smallest tile.
+  size_t best = 0;
+  for (size_t i=1; i<cands.size(); ++i) {
+    if (costs[i] < costs[best]  ||
+        (costs[i] == costs[best]  &&
+         cands[i].product() < cands[best].product())) {
+      best = i;
+    }
+  }
+  itsTileShape = cands[best];
+  itsCost      = costs[best];
+  // Find the smallest cache giving about the same cost.
+  const uInt64 maxTiles = cacheTiles (itsTileShape, itsMaxCacheSize);
+  uInt64 ntiles = 1;
+  while (ntiles < maxTiles  &&
+         simulate (itsTileShape, ntiles, 1.05*itsCost) > 1.05*itsCost) {
+    ntiles = std::min (2*ntiles, maxTiles);
+  }
+  itsCacheSize = ntiles * itsTileShape.product() * itsValueSize;
+  return itsTileShape;
+}
+
+Table TileShapeAdvisor::retile (const Table& table, const String& newName,
+                                const String& columnName) const
+{
+  if (itsTileShape.empty()) {
+    throw AipsError ("TileShapeAdvisor::retile: advise has not been done");
+  }
+  return retile (table, newName, Vector<String>(1, columnName),
+                 itsTileShape, itsCacheSize);
+}
+
+Table TileShapeAdvisor::retile (const Table& table, const String& newName,
+                                const Vector<String>& columns,
+                                const IPosition& tileShape, uInt64 cacheSize)
+{
+  Record dminfo = table.dataManagerInfo();
+  DataManInfo::removeDminfoColumns (dminfo, columns);
+  // Make the data manager name unique.
+  String dmName = "Tiled" + columns[0];
+  for (uInt seqnr=0; ; ++seqnr) {
+    String name = dmName;
+    if (seqnr > 0) {
+      name += '_' + String::toString (seqnr);
+    }
+    Bool found = False;
+    for (uInt i=0; i<dminfo.nfields(); ++i) {
+      const Record& dm = dminfo.subRecord(i);
+      if (dm.isDefined ("NAME")  &&  dm.asString("NAME") == name) {
+        found = True;
+        break;
+      }
+    }
+    if (!found) {
+      dmName = name;
+      break;
+    }
+  }
+  Record dm;
+  dm.define ("TYPE", String("TiledShapeStMan"));
+  dm.define ("NAME", dmName);
+  dm.define ("COLUMNS", columns);
+  Record spec;
+  spec.define ("DEFAULTTILESHAPE", tileShape.asVector());
+  if (cacheSize > 0) {
+    spec.define ("MAXIMUMCACHESIZE", Int64(cacheSize));
+  }
+  dm.defineRecord ("SPEC", spec);
+  dminfo.defineRecord (dminfo.nfields(), dm);
+  Table newTable = TableCopy::makeEmptyTable (newName, dminfo, table,
+                                              Table::New,
+                                              Table::AipsrcEndian);
+  TableCopy::copyInfo (newTable, table);
+  TableCopy::copyRows (newTable, table);
+  TableCopy::copySubTables (newTable, table);
+  return newTable;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,246 @@
+//# TileShapeAdvisor.h: Advise a tile shape from the access pattern of a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TILESHAPEADVISOR_H
+#define TABLES_TILESHAPEADVISOR_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Advise a tile shape from the access pattern of a column
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTileShapeAdvisor.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TiledShapeStMan
+//   <li> TableTrace
+// </prerequisite>
+
+// <synopsis>
+// The best tile shape of a column stored with a TiledShapeStMan depends on
+// the way the column is accessed. A shape suitable for reading entire rows
+// can be very bad for reading a single channel of all rows.
+// TileShapeAdvisor finds the tile shape (and tile cache size) minimising the
+// predicted I/O for a given set of accesses of a column.
+// <br>The column is seen as a hypercube consisting of the cell axes and
+// the row axis. Each access is a (possibly strided) hyperslab in it.
+// The accesses can be defined in three ways:
+// <ul>
+//  <li> Explicitly using the function <src>addAccess</src>.
+//  <li> By declaring a typical access pattern for a MeasurementSet-like
+//       column where the rows are ordered in time and each time slot
+//       contains the same number of rows (e.g., baselines).
+//       <src>PerTime</src> reads all rows of a time slot at a time,
+//       <src>PerBaseline</src> reads the rows of a baseline for all times,
+//       and <src>PerChannel</src> reads a single element of the last cell
+//       axis (e.g., a channel) of all rows.
+//  <li> By reading a trace file written by TableTrace (see there how
+//       to switch on tracing using the <src>table.trace</src> aipsrc
+//       variables). The reads and writes of the given column are used.
+//       Optionally only the accesses of a given table are used.
+// </ul>
+// For each candidate tile shape the accesses are replayed against a
+// simulated tile cache using LRU replacement. Every tile read into the
+// cache or written back from it costs its size in bytes plus a fixed
+// seek cost (64 KB by default). The candidate tile lengths are powers of two
+// and the full axis length; only tiles with a size in the given range
+// (32 KB to 4 MB by default) are considered. The cache has the given
+// maximum size (64 MB by default), but always holds at least one tile.
+// <br>The advised cache size is the smallest number of tiles
+// (a power of two) whose predicted cost is within 5% of the cost using the
+// maximum cache size.
+// <br>The function <src>retile</src> copies a table, storing the given
+// columns in a new TiledShapeStMan with the advised tile shape and cache
+// size. Note that the cost model only describes a column whose cells
+// have the same shape, thus a single hypercube.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms");
+//   TileShapeAdvisor advisor(tab, "DATA");
+//   advisor.readTrace ("tabletrace.out", "DATA");
+//   advisor.advise();
+//   cout << advisor.tileShape() << ' ' << advisor.cacheSize() << endl;
+//   Table newTab = advisor.retile (tab, "my_retiled.ms", "DATA");
+// </srcblock>
+// </example>
+
+// <motivation>
+// MSTileLayout and other heuristics only use the data shape. Using
+// the actual access pattern gives much better results for applications
+// that do not read the data row by row.
+// </motivation>
+
+class TileShapeAdvisor
+{
+public:
+  // The declared access patterns.
+  enum AccessPattern {
+    // Read all rows of a time slot, time slot after time slot.
+    PerTime,
+    // Read the rows of a baseline for all times, baseline after baseline.
+    PerBaseline,
+    // Read an element of the last cell axis for all rows, one by one.
+    PerChannel
+  };
+
+  // Construct for a column with the given cell shape and number of rows.
+  // The value size is the size in bytes of a single array element.
+  TileShapeAdvisor (const IPosition& cellShape, rownr_t nrow,
+                    uInt valueSize);
+
+  // Construct for the given column in the table. If the column does not
+  // have a fixed shape, the shape of the first row is used.
+  TileShapeAdvisor (const Table& table, const String& columnName);
+
+  // Get the shape of the hypercube (cell axes and row axis).
+  const IPosition& cubeShape() const
+    { return itsCubeShape; }
+
+  // Add an access of a hyperslab of the hypercube (with the row axis as
+  // last axis). An empty stride means stride 1.
+  void addAccess (const IPosition& blc, const IPosition& trc,
+                  const IPosition& inc = IPosition(), Bool write = False);
+
+  // Add the accesses of a declared pattern. <src>rowsPerTime</src>
+  // is the number of rows in a time slot (e.g., the number of baselines).
+  void addPattern (AccessPattern pattern, uInt rowsPerTime);
+
+  // Add the accesses of the given column found in a TableTrace file.
+  // If a table name is given, only the accesses in that table are used.
+  // Writes are only used if <src>useWrites</src> is set.
+  // It returns the number of accesses found.
+  uInt readTrace (const String& traceFileName, const String& columnName,
+                  const String& tableName = String(), Bool useWrites = True);
+
+  // Get the number of accesses.
+  uInt naccess() const
+    { return itsAccesses.size(); }
+
+  // Remove all accesses.
+  void clearAccesses()
+    { itsAccesses.clear(); }
+
+  // Set the range of tile sizes (in bytes) to consider.
+  void setTileSizeRange (uInt64 minBytes, uInt64 maxBytes);
+
+  // Set the maximum cache size in bytes.
+  void setMaxCacheSize (uInt64 nbytes);
+
+  // Set the cost of a seek (expressed in bytes read).
+  void setSeekCost (uInt64 nbytes);
+
+  // Predict the I/O cost (in bytes) of the accesses for the given tile shape
+  // (which must contain the row axis) and cache size in bytes.
+  // A zero cache size means the maximum cache size.
+  Double predictCost (const IPosition& tileShape, uInt64 cacheSize = 0) const;
+
+  // Find the tile shape and cache size with the lowest predicted cost.
+  // It returns the tile shape. An exception is thrown if no accesses
+  // are defined.
+  IPosition advise();
+
+  // Get the results of the last <src>advise</src>.
+  // <group>
+  const IPosition& tileShape() const
+    { return itsTileShape; }
+  uInt64 cacheSize() const
+    { return itsCacheSize; }
+  Double cost() const
+    { return itsCost; }
+  // </group>
+
+  // Copy the table to a new table storing the column in a TiledShapeStMan
+  // using the advised tile shape and cache size.
+  Table retile (const Table& table, const String& newName,
+                const String& columnName) const;
+
+  // Copy the table to a new table storing the given columns in a
+  // TiledShapeStMan with the given default tile shape. If the cache size
+  // is not zero, it is used as the maximum cache size of the storage manager.
+  // The subtables are copied as well.
+  static Table retile (const Table& table, const String& newName,
+                       const Vector<String>& columns,
+                       const IPosition& tileShape, uInt64 cacheSize = 0);
+
+private:
+  // A hyperslab access.
+  struct Access {
+    IPosition blc;
+    IPosition trc;
+    IPosition inc;
+    Bool      write;
+  };
+
+  // Initialize the cube shape and the defaults.
+  void init (const IPosition& cellShape, rownr_t nrow, uInt valueSize);
+
+  // Add an access of the given rows using the cell slice.
+  void addRowAccess (rownr_t startRow, rownr_t endRow, rownr_t incrRow,
+                     const IPosition& blc, const IPosition& trc,
+                     const IPosition& inc, Bool write);
+
+  // Get the cost of the accesses for the tile shape using a cache
+  // holding the given number of tiles. The simulation stops as soon as
+  // the cost exceeds <src>maxCost</src> (if not negative).
+  Double simulate (const IPosition& tileShape, uInt64 ntiles,
+                   Double maxCost = -1) const;
+
+  // Get the number of tiles fitting in the cache.
+  uInt64 cacheTiles (const IPosition& tileShape, uInt64 cacheSize) const;
+
+  // Get the candidate tile shapes.
+  std::vector<IPosition> candidates() const;
+
+  IPosition           itsCubeShape;
+  uInt                itsValueSize;
+  uInt64              itsMinTileBytes;
+  uInt64              itsMaxTileBytes;
+  uInt64              itsMaxCacheSize;
+  uInt64              itsSeekCost;
+  std::vector<Access> itsAccesses;
+  IPosition           itsTileShape;
+  uInt64              itsCacheSize;
+  Double              itsCost;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
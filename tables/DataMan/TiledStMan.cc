@@ -494,6 +494,17 @@ void TiledStMan::showCacheStatistics (ostream& os) const
     }
 }
 
+Record TiledStMan::getCacheStatistics() const
+{
+    Record stats;
+    for (uInt i=0; i<cubeSet_p.nelements(); i++) {
+	if (cubeSet_p[i] != 0) {
+	    cubeSet_p[i]->addCacheStatistics (stats);
+	}
+    }
+    return stats;
+}
+
 TSMCube* TiledStMan::singleHypercube()
 {
     if (cubeSet_p.nelements() != 1  ||  cubeSet_p[0] == 0) {
@@ -262,6 +262,9 @@ public:
     // Show the statistics of all caches used.
     void showCacheStatistics (ostream& os) const;
 
+    // Get the statistics of all caches used (summed) as a record.
+    Record getCacheStatistics() const;
+
     // Get the length of the data for the given number of pixels.
     // This can be used to calculate the length of a tile.
     uInt64 getLengthOffset (uInt64 nrPixels, Block<uInt>& dataOffset,
@@ -0,0 +1,334 @@
+//# tColumnZoneMap.cc: Test program for class ColumnZoneMap
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/BaseColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class ColumnZoneMap and its use by the StandardStMan
+// and the table selection. It also tests finding the minimum and maximum
+// of a column using the metadata of the StandardStMan and IncrementalStMan.
+// </summary>
+
+typedef std::vector<std::pair<rownr_t,rownr_t>> Intervals;
+
+void testMap()
+{
+  ColumnZoneMap zm(4);
+  zm.addRows (10);
+  AlwaysAssertExit (zm.nrow() == 10  &&  zm.nzone() == 3);
+  AlwaysAssertExit (zm.lastRow(2) == 9);
+  // Nothing written, so no zone is valid.
+  AlwaysAssertExit (! zm.isValid());
+  for (rownr_t i=0; i<10; ++i) {
+    zm.put (i, Double(i));
+  }
+  AlwaysAssertExit (zm.isValid());
+  AlwaysAssertExit (zm.minimum(1) == 4  &&  zm.maximum(1) == 7);
+  // Select values 5-6, which are in zone 1 only.
+  Vector<Double> st(1, 5.);
+  Vector<Double> end(1, 6.);
+  Intervals res = zm.selectRows (st, end);
+  AlwaysAssertExit (res.size() == 1);
+  AlwaysAssertExit (res[0].first == 4  &&  res[0].second == 7);
+  // Two ranges selecting zones 0 and 2.
+  Vector<Double> st2(2);
+  Vector<Double> end2(2);
+  st2[0] = 0.5; end2[0] = 1;
+  st2[1] = 9;   end2[1] = 20;
+  res = zm.selectRows (st2, end2);
+  AlwaysAssertExit (res.size() == 2);
+  AlwaysAssertExit (res[0].second == 3  &&  res[1].first == 8);
+  // Adding rows makes the last zone invalid, thus always selected.
+  zm.addRows (3);
+  AlwaysAssertExit (!zm.isValid(2)  &&  !zm.isValid(3));
+  res = zm.selectRows (st, end);
+  AlwaysAssertExit (res.size() == 1);
+  AlwaysAssertExit (res[0].first == 4  &&  res[0].second == 12);
+  zm.put (10, 10.);
+  zm.put (11, 11.);
+  AlwaysAssertExit (zm.isValid(2)  &&  !zm.isValid(3));
+  zm.put (12, 12.);
+  AlwaysAssertExit (zm.isValid());
+  // Intersect intervals.
+  Intervals left, right;
+  left.push_back (std::make_pair (rownr_t(0), rownr_t(10)));
+  left.push_back (std::make_pair (rownr_t(20), rownr_t(30)));
+  right.push_back (std::make_pair (rownr_t(5), rownr_t(25)));
+  res = ColumnZoneMap::intersect (left, right);
+  AlwaysAssertExit (res.size() == 2);
+  AlwaysAssertExit (res[0].first == 5  &&  res[0].second == 10);
+  AlwaysAssertExit (res[1].first == 20  &&  res[1].second == 25);
+  // Write and read it back.
+  {
+    AipsIO aio ("tColumnZoneMap_tmp.map", ByteIO::New);
+    zm.put (aio);
+  }
+  {
+    ColumnZoneMap zm2;
+    AipsIO aio ("tColumnZoneMap_tmp.map");
+    zm2.get (aio, 13);
+    AlwaysAssertExit (zm2.zoneSize() == 4  &&  zm2.isValid());
+    AlwaysAssertExit (zm2.minimum(3) == 12  &&  zm2.maximum(3) == 12);
+  }
+  {
+    // A mismatching number of rows clears the map.
+    ColumnZoneMap zm2;
+    AipsIO aio ("tColumnZoneMap_tmp.map");
+    zm2.get (aio, 14);
+    AlwaysAssertExit (zm2.nrow() == 14  &&  !zm2.isValid(0));
+  }
+  // Removing a row invalidates the zones from that row on.
+  zm.removeRow (5);
+  AlwaysAssertExit (zm.nrow() == 12  &&  zm.nzone() == 3);
+  AlwaysAssertExit (zm.isValid(0)  &&  !zm.isValid(1)  &&  !zm.isValid(2));
+  // Rows written out of order leave a zone invalid until it is set.
+  ColumnZoneMap zm3(4);
+  zm3.addRows (4);
+  zm3.put (1, 1.);
+  zm3.put (0, 0.);
+  zm3.put (2, 2.);
+  zm3.put (3, 3.);
+  AlwaysAssertExit (! zm3.isValid(0));
+  zm3.setZone (0, 0., 3.);
+  AlwaysAssertExit (zm3.isValid(0));
+  // Adding rows to a partial zone makes it invalid until they are written.
+  ColumnZoneMap zm4(4);
+  zm4.addRows (2);
+  zm4.put (0, 0.);
+  zm4.put (1, 1.);
+  AlwaysAssertExit (zm4.isValid(0));
+  zm4.addRows (1);
+  AlwaysAssertExit (! zm4.isValid(0));
+  zm4.put (2, 2.);
+  AlwaysAssertExit (zm4.isValid(0));
+}
+
+void makeTable (rownr_t nrow, const String& name="tColumnZoneMap_tmp.data",
+                Bool useZoneMaps=True)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Int> ("SCAN"));
+  SetupNewTable newtab (name, td, Table::New);
+  StandardStMan ssm (512);
+  ssm.setUseZoneMaps (useZoneMaps);
+  newtab.bindAll (ssm);
+  Table tab (newtab, nrow);
+  ScalarColumn<Double> timeCol (tab, "TIME");
+  ScalarColumn<Int> scanCol (tab, "SCAN");
+  for (rownr_t i=0; i<nrow; ++i) {
+    timeCol.put (i, 1000. + i);
+    scanCol.put (i, i/100);
+  }
+}
+
+// Give access to the zone map of a column.
+class ZoneMapColumn : public TableColumn
+{
+public:
+  ZoneMapColumn (const Table& tab, const String& name)
+    : TableColumn (tab, name)
+  {}
+  const ColumnZoneMap* zoneMap() const
+    { return baseColPtr()->zoneMap(); }
+};
+
+// Check that the selection gives the expected rows and that the zone
+// map of the column limits the rows to be tested.
+void checkSelect (const Table& tab, const TableExprNode& expr,
+                  rownr_t firstRow, rownr_t lastRow,
+                  const String& colName, Double st, Double end)
+{
+  Table sel = tab(expr);
+  AlwaysAssertExit (sel.nrow() == lastRow - firstRow + 1);
+  Vector<rownr_t> rows = sel.rowNumbers();
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (rows[i] == firstRow + i);
+  }
+  const ColumnZoneMap* zm = ZoneMapColumn(tab, colName).zoneMap();
+  AlwaysAssertExit (zm != 0  &&  zm->isValid()  &&  zm->nrow() == tab.nrow());
+  Intervals zones = zm->selectRows (Vector<Double>(1, st),
+                                    Vector<Double>(1, end));
+  // The matching rows must be in a single interval, because adjacent
+  // intervals are combined.
+  rownr_t nzrow = 0;
+  Bool found = False;
+  for (const std::pair<rownr_t,rownr_t>& zone : zones) {
+    if (zone.first <= firstRow  &&  zone.second >= lastRow) {
+      found = True;
+    }
+    nzrow += zone.second - zone.first + 1;
+  }
+  AlwaysAssertExit (found);
+  AlwaysAssertExit (nzrow < tab.nrow());
+}
+
+void testTable()
+{
+  makeTable (10000);
+  {
+    Table tab ("tColumnZoneMap_tmp.data");
+    checkSelect (tab, tab.col("TIME") >= 5000. && tab.col("TIME") < 5100.,
+                 4000, 4099, "TIME", 5000., 5100.);
+    checkSelect (tab, tab.col("SCAN") == 37, 3700, 3799, "SCAN", 37, 37);
+    checkSelect (tab, 8000. < tab.col("TIME"), 7001, 9999,
+                 "TIME", 8000., 1e30);
+    // An OR of different columns cannot use the zone maps, but must
+    // give the correct result.
+    Table sel = tab(tab.col("TIME") < 1010. || tab.col("SCAN") < 0);
+    AlwaysAssertExit (sel.nrow() == 10);
+  }
+  {
+    // Update values and remove rows; the selection must stay correct.
+    Table tab ("tColumnZoneMap_tmp.data", Table::Update);
+    ScalarColumn<Double> timeCol (tab, "TIME");
+    timeCol.put (10, 5050.);
+    timeCol.put (10, 1010.);
+    tab.removeRow (0);
+    checkSelect (tab, tab.col("TIME") >= 5000. && tab.col("TIME") < 5100.,
+                 3999, 4098, "TIME", 5000., 5100.);
+    tab.addRow (1);
+    timeCol.put (9999, 20000.);
+    checkSelect (tab, tab.col("TIME") > 19999., 9999, 9999,
+                 "TIME", 19999., 1e30);
+  }
+  {
+    // The zone maps are read back from the file.
+    Table tab ("tColumnZoneMap_tmp.data");
+    checkSelect (tab, tab.col("SCAN") == 37, 3699, 3798, "SCAN", 37, 37);
+    checkSelect (tab, tab.col("TIME") > 19999., 9999, 9999,
+                 "TIME", 19999., 1e30);
+  }
+  {
+    // Emulate a change of the data by software not knowing about zone
+    // maps, by putting back the zone map file of before the change.
+    const String zoneFile ("tColumnZoneMap_tmp.data/table.f0z");
+    AlwaysAssertExit (File(zoneFile).exists());
+    RegularFile(zoneFile).copy ("tColumnZoneMap_tmp.zonefile");
+    {
+      Table tab ("tColumnZoneMap_tmp.data", Table::Update);
+      ScalarColumn<Double> (tab, "TIME").put (50, 30000.);
+    }
+    RegularFile("tColumnZoneMap_tmp.zonefile").copy (zoneFile);
+    // The change counter in the file mismatches, so it is not used.
+    Table tab ("tColumnZoneMap_tmp.data", Table::Update);
+    checkSelect (tab, tab.col("TIME") > 29999., 50, 50,
+                 "TIME", 29999., 1e30);
+    ScalarColumn<Double> (tab, "TIME").put (50, 1050.);
+  }
+  {
+    // Zone maps are not kept by default.
+    makeTable (100, "tColumnZoneMap_tmp.nozm", False);
+    Table tab ("tColumnZoneMap_tmp.nozm");
+    AlwaysAssertExit (! File("tColumnZoneMap_tmp.nozm/table.f0z").exists());
+    AlwaysAssertExit (ZoneMapColumn(tab, "TIME").zoneMap() == 0);
+    AlwaysAssertExit (tab(tab.col("TIME") > 1090.).nrow() == 9);
+  }
+}
+
+// Check the values in the rows found for the minimum and maximum.
+void checkMinMax (const Table& tab, const String& colName,
+                  Double expMin, Double expMax)
+{
+  TableColumn col(tab, colName);
+  rownr_t minRow, maxRow;
+  AlwaysAssertExit (col.findMinMax (minRow, maxRow));
+  AlwaysAssertExit (col.asdouble(minRow) == expMin);
+  AlwaysAssertExit (col.asdouble(maxRow) == expMax);
+}
+
+void testMinMax()
+{
+  {
+    // The zone map of the StandardStMan can be used.
+    Table tab ("tColumnZoneMap_tmp.data", Table::Update);
+    checkMinMax (tab, "TIME", 1001., 20000.);
+    checkMinMax (tab, "SCAN", 0, 99);
+    // Overwriting a value leaves the zone limits too wide, but the
+    // result must be exact.
+    ScalarColumn<Double> timeCol (tab, "TIME");
+    timeCol.put (5, -5.);
+    timeCol.put (5, 1006.);
+    timeCol.put (9000, 1e9);
+    timeCol.put (9000, 10000.);
+    checkMinMax (tab, "TIME", 1001., 20000.);
+    // A selection cannot use it.
+    Table sel = tab(tab.col("SCAN") > 10);
+    rownr_t minRow, maxRow;
+    AlwaysAssertExit (! TableColumn(sel, "TIME").findMinMax (minRow, maxRow));
+  }
+  {
+    // The IncrementalStMan steps through the intervals of equal values.
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+    td.addColumn (ScalarColumnDesc<Int> ("ANTENNA"));
+    td.addColumn (ScalarColumnDesc<String> ("NAME"));
+    SetupNewTable newtab ("tColumnZoneMap_tmp.ism", td, Table::New);
+    IncrementalStMan ism (512);
+    newtab.bindAll (ism);
+    Table tab (newtab, 1000);
+    ScalarColumn<Double> timeCol (tab, "TIME");
+    ScalarColumn<Int> antCol (tab, "ANTENNA");
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+      timeCol.put (i, 100. - i/10);
+      antCol.put (i, (i/10) % 7);
+    }
+    checkMinMax (tab, "TIME", 1., 100.);
+    checkMinMax (tab, "ANTENNA", 0, 6);
+    rownr_t minRow, maxRow;
+    AlwaysAssertExit (! TableColumn(tab, "NAME").findMinMax (minRow, maxRow));
+  }
+}
+
+int main()
+{
+  try {
+    testMap();
+    testTable();
+    testMinMax();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,234 @@
+//# tTileShapeAdvisor.cc: Test program for class TileShapeAdvisor
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TileShapeAdvisor.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/DataManInfo.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <fstream>
+
+using namespace casacore;
+using namespace std;
+
+// <summary>
+// Test program for class TileShapeAdvisor
+// </summary>
+
+// The column has 10 baselines and 40 times of 4 correlations, 64 channels.
+const IPosition cellShape(2, 4, 64);
+const uInt nbaseline = 10;
+const uInt nrow = 400;
+
+TileShapeAdvisor makeAdvisor()
+{
+  TileShapeAdvisor advisor(cellShape, nrow, sizeof(Complex));
+  advisor.setTileSizeRange (4096, 65536);
+  advisor.setMaxCacheSize (131072);
+  advisor.setSeekCost (4096);
+  return advisor;
+}
+
+void testPatterns()
+{
+  {
+    // Reading per time reads each tile once, so a single tile cache suffices.
+    TileShapeAdvisor advisor = makeAdvisor();
+    AlwaysAssertExit (advisor.cubeShape() == IPosition(3, 4, 64, nrow));
+    advisor.addPattern (TileShapeAdvisor::PerTime, nbaseline);
+    AlwaysAssertExit (advisor.naccess() == nrow/nbaseline);
+    IPosition tileShape = advisor.advise();
+    AlwaysAssertExit (advisor.cacheSize() ==
+                      uInt64(tileShape.product() * sizeof(Complex)));
+    AlwaysAssertExit (advisor.cost() <=
+                      advisor.predictCost (IPosition(3, 4, 64, 4)));
+  }
+  {
+    // Reading per channel needs tiles with few channels.
+    TileShapeAdvisor advisor = makeAdvisor();
+    advisor.addPattern (TileShapeAdvisor::PerChannel, nbaseline);
+    AlwaysAssertExit (advisor.naccess() == 64);
+    IPosition tileShape = advisor.advise();
+    AlwaysAssertExit (tileShape[1] < 64);
+    AlwaysAssertExit (advisor.cost() <
+                      advisor.predictCost (IPosition(3, 4, 64, 16)));
+    AlwaysAssertExit (advisor.cost() ==
+                      advisor.predictCost (tileShape, 0));
+    // A smaller cache can only be more expensive.
+    AlwaysAssertExit (advisor.predictCost (tileShape, 1) >= advisor.cost());
+  }
+  {
+    TileShapeAdvisor advisor = makeAdvisor();
+    advisor.addPattern (TileShapeAdvisor::PerBaseline, nbaseline);
+    AlwaysAssertExit (advisor.naccess() == nbaseline);
+    advisor.advise();
+    AlwaysAssertExit (advisor.cost() <=
+                      advisor.predictCost (IPosition(3, 4, 64, 16)));
+    AlwaysAssertExit (advisor.cost() <=
+                      advisor.predictCost (IPosition(3, 4, 8, 64)));
+  }
+}
+
+void testTrace()
+{
+  String tabName = Path("tTileShapeAdvisor_tmp.tab").absoluteName();
+  {
+    ofstream ofs("tTileShapeAdvisor_tmp.trace");
+    ofs << "# time oper tabid name row(s) shape blc/trc/inc" << endl;
+    ofs << "# Note: shapes are in Fortran order" << endl << endl;
+    ofs << "10:00:00.000000000 o t=0 " << tabName << ' ' << endl;
+    ofs << "10:00:00.100000000 r t=0 DATA 5 [4,64]" << endl;
+    ofs << "10:00:00.200000000 r t=0 DATA 0:9,20 [4,64,11]" << endl;
+    ofs << "10:00:00.300000000 r t=0 DATA * [1,64,400] [0,0][0,63][1,1]"
+        << endl;
+    ofs << "10:00:00.400000000 w t=0 DATA 3 [4,2] [0,3][3,4][1,1]" << endl;
+    ofs << "10:00:00.500000000 r t=0 FLAG 3 [4,64]" << endl;
+    ofs << "10:00:00.600000000 r t=1 DATA 3 [4,64]" << endl;
+    ofs << "10:00:00.700000000 r t=0 DATA 1000 [4,64]" << endl;
+    ofs << "10:00:00.800000000 c t=0 " << tabName << ' ' << endl;
+    ofs << "10:00:00.900000000 r t=0 DATA 3 [4,64]" << endl;
+  }
+  {
+    // All tables; the row beyond the end is ignored.
+    TileShapeAdvisor advisor = makeAdvisor();
+    AlwaysAssertExit (advisor.readTrace ("tTileShapeAdvisor_tmp.trace",
+                                         "DATA") == 7);
+    advisor.advise();
+  }
+  {
+    TileShapeAdvisor advisor = makeAdvisor();
+    AlwaysAssertExit (advisor.readTrace ("tTileShapeAdvisor_tmp.trace",
+                                         "DATA", tabName) == 5);
+    advisor.clearAccesses();
+    AlwaysAssertExit (advisor.readTrace ("tTileShapeAdvisor_tmp.trace",
+                                         "DATA", tabName, False) == 4);
+  }
+  {
+    // A trace of channel by channel reads gives the same advice as the
+    // declared pattern.
+    {
+      ofstream ofs("tTileShapeAdvisor_tmp.trace");
+      for (uInt i=0; i<64; ++i) {
+        ofs << "10:00:00.000000000 r t=0 DATA * [4,1,400] [0," << i
+            << "][3," << i << "][1,1]" << endl;
+      }
+    }
+    TileShapeAdvisor advisor1 = makeAdvisor();
+    AlwaysAssertExit (advisor1.readTrace ("tTileShapeAdvisor_tmp.trace",
+                                          "DATA") == 64);
+    TileShapeAdvisor advisor2 = makeAdvisor();
+    advisor2.addPattern (TileShapeAdvisor::PerChannel, nbaseline);
+    AlwaysAssertExit (advisor1.advise() == advisor2.advise());
+    AlwaysAssertExit (advisor1.cost() == advisor2.cost());
+  }
+}
+
+void testRetile()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA1"));
+  td.addColumn (ArrayColumnDesc<Complex>("DATA", cellShape,
+                                         ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTileShapeAdvisor_tmp.tab", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ArrayColumn<Complex> data(tab, "DATA");
+  Matrix<Complex> arr(cellShape);
+  indgen (arr);
+  for (uInt i=0; i<nrow; ++i) {
+    ant.put (i, i%nbaseline);
+    data.put (i, arr + Complex(i, 0));
+  }
+  TileShapeAdvisor advisor(tab, "DATA");
+  AlwaysAssertExit (advisor.cubeShape() == IPosition(3, 4, 64, nrow));
+  advisor.setTileSizeRange (4096, 65536);
+  advisor.addPattern (TileShapeAdvisor::PerChannel, nbaseline);
+  advisor.advise();
+  Table newTab = advisor.retile (tab, "tTileShapeAdvisor_tmp.retiled",
+                                 "DATA");
+  AlwaysAssertExit (newTab.nrow() == nrow);
+  ROTiledStManAccessor acc(newTab, "TiledDATA");
+  AlwaysAssertExit (acc.tileShape(0) == advisor.tileShape());
+  AlwaysAssertExit (acc.maximumCacheSize() == advisor.cacheSize());
+  ScalarColumn<Int> newAnt(newTab, "ANTENNA1");
+  ArrayColumn<Complex> newData(newTab, "DATA");
+  for (uInt i=0; i<nrow; ++i) {
+    AlwaysAssertExit (newAnt(i) == Int(i%nbaseline));
+    AlwaysAssertExit (allEQ (newData(i), data(i)));
+  }
+  // Retile using an explicit tile shape.
+  Table newTab2 = TileShapeAdvisor::retile (newTab,
+                                            "tTileShapeAdvisor_tmp.retiled2",
+                                            Vector<String>(1, "DATA"),
+                                            IPosition(3, 4, 8, 32));
+  ROTiledStManAccessor acc2(newTab2, "TiledDATA");
+  AlwaysAssertExit (acc2.tileShape(0) == IPosition(3, 4, 8, 32));
+  AlwaysAssertExit (allEQ (ArrayColumn<Complex>(newTab2, "DATA").getColumn(),
+                           data.getColumn()));
+}
+
+void testErrors()
+{
+  TileShapeAdvisor advisor = makeAdvisor();
+  Bool ok = False;
+  try {
+    advisor.advise();
+  } catch (const AipsError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+  ok = False;
+  try {
+    advisor.addAccess (IPosition(3, 0), IPosition(3, 4, 63, 0));
+  } catch (const AipsError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+}
+
+int main()
+{
+  try {
+    testPatterns();
+    testTrace();
+    testRetile();
+    testErrors();
+  } catch (const std::exception& x) {
+    cout << "Caught exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,297 @@
+//# ColumnStatistics.cc: Persistent statistics of a scalar table column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ColumnStatistics.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeSet.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <limits>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // Get the values of a block of rows in a numeric column as Double.
+  template<typename T>
+  static void getValuesAs (const TableColumn& col, rownr_t st, rownr_t n,
+                           Vector<Double>& values)
+  {
+    Vector<T> vals = ScalarColumn<T>(col).getColumnRange
+      (Slicer(IPosition(1, st), IPosition(1, n)));
+    values.resize (n);
+    convertArray (values, vals);
+  }
+
+  static void getValues (const TableColumn& col, rownr_t st, rownr_t n,
+                         Vector<Double>& values)
+  {
+    switch (col.columnDesc().dataType()) {
+    case TpUChar:
+      getValuesAs<uChar> (col, st, n, values);
+      break;
+    case TpShort:
+      getValuesAs<Short> (col, st, n, values);
+      break;
+    case TpUShort:
+      getValuesAs<uShort> (col, st, n, values);
+      break;
+    case TpInt:
+      getValuesAs<Int> (col, st, n, values);
+      break;
+    case TpUInt:
+      getValuesAs<uInt> (col, st, n, values);
+      break;
+    case TpInt64:
+      getValuesAs<Int64> (col, st, n, values);
+      break;
+    case TpFloat:
+      getValuesAs<Float> (col, st, n, values);
+      break;
+    default:
+      getValuesAs<Double> (col, st, n, values);
+      break;
+    }
+  }
+
+  ColumnStatistics::ColumnStatistics()
+    : itsNrow       (0),
+      itsNDistinct  (0),
+      itsNumeric    (False),
+      itsMin        (0),
+      itsMax        (0)
+  {}
+
+  ColumnStatistics::ColumnStatistics (const Table& table,
+                                      const String& columnName, uInt nbins)
+    : ColumnStatistics()
+  {
+    const ColumnDesc& cdesc = table.tableDesc().columnDesc (columnName);
+    if (! cdesc.isScalar()) {
+      return;
+    }
+    switch (cdesc.dataType()) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+      itsNumeric = True;
+      break;
+    case TpString:
+      break;
+    default:
+      return;
+    }
+    rownr_t nrow = table.nrow();
+    if (nrow == 0) {
+      return;
+    }
+    nbins = std::max (nbins, 1u);
+    TableExprNode col = table.col (columnName);
+    // Estimate the number of distinct values like GAPPROXCOUNTDISTINCT.
+    TableExprNodeSet set;
+    set.add (TableExprNodeSetElem(col));
+    TableExprNode aggr = TableExprNode::newFunctionNode
+      (TableExprFuncNode::gapproxcountdistinctFUNC, set, TableExprInfo(table));
+    std::shared_ptr<TableExprGroupFuncBase> func =
+      aggr.getRep()->makeGroupAggrFunc();
+    // Read the values in blocks.
+    const rownr_t blockSize = 32768;
+    TableColumn tabcol (table, columnName);
+    Vector<Double> values;
+    itsMin = std::numeric_limits<Double>::max();
+    itsMax = -std::numeric_limits<Double>::max();
+    for (rownr_t st=0; st<nrow; st+=blockSize) {
+      rownr_t n = std::min (blockSize, nrow-st);
+      for (rownr_t i=0; i<n; ++i) {
+        func->apply (TableExprId(st+i));
+      }
+      if (itsNumeric) {
+        getValues (tabcol, st, n, values);
+        for (Double v : values) {
+          if (v < itsMin) itsMin = v;
+          if (v > itsMax) itsMax = v;
+        }
+      }
+    }
+    func->finish();
+    itsNrow = nrow;
+    itsNDistinct = std::max (Int64(1), func->getInt());
+    if (! itsNumeric) {
+      return;
+    }
+    // Fill the histogram (NaNs are ignored).
+    itsHistogram.resize (nbins);
+    itsHistogram = 0;
+    if (itsMin > itsMax) {
+      itsMin = itsMax = 0;
+      return;
+    }
+    Double width = (itsMax - itsMin) / nbins;
+    for (rownr_t st=0; st<nrow; st+=blockSize) {
+      rownr_t n = std::min (blockSize, nrow-st);
+      getValues (tabcol, st, n, values);
+      for (Double v : values) {
+        if (! isNaN(v)) {
+          uInt bin = (width > 0  ?  uInt((v - itsMin) / width) : 0);
+          itsHistogram[std::min(bin, nbins-1)]++;
+        }
+      }
+    }
+  }
+
+  ColumnStatistics::ColumnStatistics (const RecordInterface& rec)
+    : ColumnStatistics()
+  {
+    itsNrow      = rec.asInt64 ("NROW");
+    itsNDistinct = rec.asDouble ("NDISTINCT");
+    itsNumeric   = rec.asBool ("NUMERIC");
+    if (itsNumeric) {
+      itsMin = rec.asDouble ("MIN");
+      itsMax = rec.asDouble ("MAX");
+      itsHistogram.reference (rec.asArrayInt64 ("HISTOGRAM"));
+    }
+  }
+
+  Record ColumnStatistics::toRecord() const
+  {
+    Record rec;
+    rec.define ("NROW", Int64(itsNrow));
+    rec.define ("NDISTINCT", itsNDistinct);
+    rec.define ("NUMERIC", itsNumeric);
+    if (itsNumeric) {
+      rec.define ("MIN", itsMin);
+      rec.define ("MAX", itsMax);
+      rec.define ("HISTOGRAM", itsHistogram);
+    }
+    return rec;
+  }
+
+  const String& ColumnStatistics::keywordName()
+  {
+    static const String name("_STATISTICS_");
+    return name;
+  }
+
+  void ColumnStatistics::update (Table& table,
+                                 const Vector<String>& columnNames,
+                                 uInt nbins)
+  {
+    Bool all = columnNames.empty();
+    Vector<String> names (all  ?  table.tableDesc().columnNames() :
+                          columnNames);
+    for (const String& name : names) {
+      ColumnStatistics stats (table, name, nbins);
+      TableColumn col (table, name);
+      if (stats.isValid()) {
+        col.rwKeywordSet().defineRecord (keywordName(), stats.toRecord());
+      } else if (!all  &&  table.nrow() > 0) {
+        throw TableError ("ColumnStatistics: column " + name +
+                          " is not a scalar numeric or string column");
+      }
+    }
+  }
+
+  ColumnStatistics ColumnStatistics::get (const Table& table,
+                                          const String& columnName)
+  {
+    const TableRecord& keys = TableColumn(table, columnName).keywordSet();
+    Int fieldnr = keys.fieldNumber (keywordName());
+    if (fieldnr < 0  ||  keys.dataType(fieldnr) != TpRecord) {
+      return ColumnStatistics();
+    }
+    return ColumnStatistics (keys.subRecord(fieldnr));
+  }
+
+  void ColumnStatistics::remove (Table& table, const String& columnName)
+  {
+    TableRecord& keys = TableColumn(table, columnName).rwKeywordSet();
+    if (keys.isDefined (keywordName())) {
+      keys.removeField (keywordName());
+    }
+  }
+
+  Double ColumnStatistics::fractionEqual() const
+  {
+    return (itsNDistinct > 0  ?  1. / itsNDistinct : 1.);
+  }
+
+  Double ColumnStatistics::fractionEqual (Double value) const
+  {
+    if (!itsNumeric  ||  itsHistogram.empty()) {
+      return fractionEqual();
+    }
+    if (value < itsMin  ||  value > itsMax) {
+      return 0;
+    }
+    Int64 total = sum(itsHistogram);
+    if (total == 0) {
+      return 0;
+    }
+    uInt nbins = itsHistogram.size();
+    Double width = (itsMax - itsMin) / nbins;
+    uInt bin = (width > 0  ?  uInt((value - itsMin) / width) : 0);
+    Double binFrac = Double(itsHistogram[std::min(bin, nbins-1)]) / total;
+    // Assume the distinct values are spread like the values.
+    return binFrac / std::max (1., itsNDistinct * binFrac);
+  }
+
+  Double ColumnStatistics::fractionInRange (Double start, Double end) const
+  {
+    if (!itsNumeric  ||  itsHistogram.empty()) {
+      return 1;
+    }
+    Int64 total = sum(itsHistogram);
+    if (total == 0  ||  end < start) {
+      return 0;
+    }
+    uInt nbins = itsHistogram.size();
+    Double width = (itsMax - itsMin) / nbins;
+    if (width <= 0) {
+      return (start <= itsMin  &&  end >= itsMin  ?  1. : 0.);
+    }
+    Double nr = 0;
+    for (uInt i=0; i<nbins; ++i) {
+      Double lo = itsMin + i*width;
+      Double hi = lo + width;
+      Double overlap = (std::min(end, hi) - std::max(start, lo)) / width;
+      if (overlap > 0) {
+        nr += std::min(overlap, 1.) * itsHistogram[i];
+      }
+    }
+    return nr / total;
+  }
+
+
+} //# NAMESPACE CASACORE - END
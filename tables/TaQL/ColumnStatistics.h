@@ -0,0 +1,172 @@
+//# ColumnStatistics.h: Persistent statistics of a scalar table column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_COLUMNSTATISTICS_H
+#define TABLES_COLUMNSTATISTICS_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // <summary>
+  // Persistent statistics of a scalar table column
+  // </summary>
+
+  // <use visibility=export>
+
+  // <reviewed reviewer="" date="" tests="tColumnStatistics">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> <linkto class=TableExprPlanner>TableExprPlanner</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // ColumnStatistics holds some statistics of the values in a scalar
+  // numeric or string column: the number of rows, an estimate of the number
+  // of distinct values (using the HyperLogLog algorithm as done by the TaQL
+  // function GAPPROXCOUNTDISTINCT), and for numeric columns the minimum,
+  // maximum and a histogram with equal bin widths.
+  // <br>The statistics are calculated and stored in the column keyword
+  // <src>_STATISTICS_</src> on demand by function <src>update</src>. They
+  // are not updated if the column changes, so <src>update</src> has to be
+  // called again after the column has changed significantly.
+  // <br>The statistics are used by the TaQL planner (class
+  // TableExprPlanner) to estimate the fraction of rows matching a
+  // condition. Because it only affects the evaluation order, outdated
+  // statistics do not give wrong query results.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   Table tab ("my.ms", Table::Update);
+  //   // Calculate the statistics of all scalar numeric and string columns.
+  //   ColumnStatistics::update (tab);
+  //   ColumnStatistics stats = ColumnStatistics::get (tab, "ANTENNA1");
+  //   cout << stats.ndistinct() << ' ' << stats.fractionEqual(3) << endl;
+  // </srcblock>
+  // </example>
+
+  // <motivation>
+  // The order of AND-ed conditions in a WHERE clause matters if some
+  // conditions are expensive to evaluate. Statistics make it possible to
+  // evaluate the cheap and selective conditions first.
+  // </motivation>
+
+  class ColumnStatistics
+  {
+  public:
+    // Create an invalid object (i.e., no statistics known).
+    ColumnStatistics();
+
+    // Calculate the statistics of the given column.
+    // The values are read twice; first to get minimum, maximum and number
+    // of distinct values, thereafter to fill the histogram.
+    // An invalid object is returned for other than scalar numeric or
+    // string columns.
+    ColumnStatistics (const Table& table, const String& columnName,
+                      uInt nbins=32);
+
+    // Create from a record as made by <src>toRecord</src>.
+    explicit ColumnStatistics (const RecordInterface&);
+
+    // Calculate and store the statistics of the given columns.
+    // If no columns are given, all scalar numeric and string columns are
+    // done.
+    static void update (Table& table,
+                        const Vector<String>& columnNames = Vector<String>(),
+                        uInt nbins=32);
+
+    // Get the statistics of a column as stored by <src>update</src>.
+    // An invalid object is returned if no statistics are stored.
+    static ColumnStatistics get (const Table& table, const String& columnName);
+
+    // Remove the statistics of a column.
+    static void remove (Table& table, const String& columnName);
+
+    // Convert to a record.
+    Record toRecord() const;
+
+    // Are statistics known?
+    Bool isValid() const
+      { return itsNrow > 0; }
+
+    // Are the statistics of a numeric column (with minimum, maximum and
+    // histogram)?
+    Bool isNumeric() const
+      { return itsNumeric; }
+
+    // Get the statistics.
+    // <group>
+    rownr_t nrow() const
+      { return itsNrow; }
+    Double ndistinct() const
+      { return itsNDistinct; }
+    Double minimum() const
+      { return itsMin; }
+    Double maximum() const
+      { return itsMax; }
+    const Vector<Int64>& histogram() const
+      { return itsHistogram; }
+    // </group>
+
+    // Estimate the fraction of rows having the given value (of a numeric
+    // column). It is 0 if outside the range, otherwise the fraction of its
+    // histogram bin divided by the estimated number of distinct values in
+    // the bin.
+    Double fractionEqual (Double value) const;
+
+    // Estimate the fraction of rows having a given value using the number
+    // of distinct values only.
+    Double fractionEqual() const;
+
+    // Estimate the fraction of rows with a value in the given interval
+    // (of a numeric column) assuming a uniform distribution in a
+    // histogram bin.
+    Double fractionInRange (Double start, Double end) const;
+
+    // Get the name of the column keyword holding the statistics.
+    static const String& keywordName();
+
+  private:
+    rownr_t       itsNrow;
+    Double        itsNDistinct;
+    Bool          itsNumeric;
+    Double        itsMin;
+    Double        itsMax;
+    Vector<Int64> itsHistogram;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
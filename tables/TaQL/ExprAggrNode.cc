@@ -158,6 +158,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                             "has to be a constant scalar");
       }
       return checkDT (dtypeOper, NTReal, NTDouble, nodes);
+    case gapproxcountdistinctFUNC:
+      checkNumOfArg (1, 1, nodes);
+      if (nodes[0]->valueType() != VTScalar) {
+        throw TableInvExpr ("Argument of function GAPPROXCOUNTDISTINCT "
+                            "has to be a scalar");
+      }
+      return checkDT (dtypeOper, NTAny, NTInt, nodes);
+    case gapproxmedianFUNC:
+    case gapproxfractileFUNC:
+      checkNumOfArg (ftype == gapproxmedianFUNC ? 1 : 2,
+                     ftype == gapproxmedianFUNC ? 1 : 2, nodes);
+      if (nodes[0]->valueType() != VTScalar) {
+        throw TableInvExpr ("1st argument of function GAPPROXMEDIAN or "
+                            "GAPPROXFRACTILE has to be a scalar");
+      }
+      if (nodes.size() > 1  &&  (nodes[1]->valueType() != VTScalar  ||
+                                 ! nodes[1]->isConstant())) {
+        throw TableInvExpr ("2nd argument of function GAPPROXFRACTILE "
+                            "has to be a constant scalar");
+      }
+      return checkDT (dtypeOper, NTReal, NTDouble, nodes);
     case ganysFUNC:
     case gallsFUNC:
       resVT = VTArray;
@@ -208,6 +229,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       return new TableExprGroupAggr(this);
     } else if (funcType() == growidFUNC) {
       return new TableExprGroupRowid(this);
+    } else if (funcType() == gapproxcountdistinctFUNC) {
+      return new TableExprGroupApproxCountDistinct(this);
     }
     if (operands()[0]->valueType() == VTScalar) {
       switch (operands()[0]->dataType()) {
@@ -272,6 +295,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         case gfractileFUNC:
           return new TableExprGroupFractileDouble
             (this, operands()[1]->getDouble(0));
+        case gapproxmedianFUNC:
+          return new TableExprGroupApproxFractileDouble(this, 0.5);
+        case gapproxfractileFUNC:
+          return new TableExprGroupApproxFractileDouble
+            (this, operands()[1]->getDouble(0));
         case ghistFUNC:
           return new TableExprGroupHistDouble
             (this, operands()[1]->getInt(0),
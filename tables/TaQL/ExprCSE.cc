@@ -0,0 +1,452 @@
+//# ExprCSE.cc: Elimination of common subexpressions in TaQL expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/TaQL/ExprCSE.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/tables/TaQL/ExprFuncNode.h>
+#include <casacore/tables/TaQL/ExprUnitNode.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+#include <iomanip>
+#include <typeinfo>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  TableExprNodeCache::TableExprNodeCache (const TENShPtr& node)
+    : TableExprNodeBinary (node->dataType(), *node, OtUndef),
+      row_p               (-1),
+      valBool_p           (False),
+      valInt_p            (0),
+      valDouble_p         (0)
+  {
+    lnode_p = node;
+  }
+
+  void TableExprNodeCache::show (ostream& os, uInt indent) const
+  {
+    for (uInt i=0; i<indent; i++) {
+      os << ' ';
+    }
+    os << "shared subexpression (cached per row)" << endl;
+    lnode_p->show (os, indent+2);
+  }
+
+  Bool TableExprNodeCache::isCached (const TableExprId& id)
+  {
+    // Only values given by row number can be cached.
+    if (! id.byRow()) {
+      return False;
+    }
+    if (id.rownr() == row_p) {
+      return True;
+    }
+    row_p = id.rownr();
+    return False;
+  }
+
+  Bool TableExprNodeCache::getBool (const TableExprId& id)
+  {
+    if (dtype_p != NTBool) {
+      return lnode_p->getBool (id);
+    }
+    if (! isCached(id)) {
+      valBool_p = lnode_p->getBool (id);
+    }
+    return valBool_p;
+  }
+
+  Int64 TableExprNodeCache::getInt (const TableExprId& id)
+  {
+    if (dtype_p != NTInt) {
+      return lnode_p->getInt (id);
+    }
+    if (! isCached(id)) {
+      valInt_p = lnode_p->getInt (id);
+    }
+    return valInt_p;
+  }
+
+  Double TableExprNodeCache::getDouble (const TableExprId& id)
+  {
+    if (dtype_p != NTDouble) {
+      return lnode_p->getDouble (id);
+    }
+    if (! isCached(id)) {
+      valDouble_p = lnode_p->getDouble (id);
+    }
+    return valDouble_p;
+  }
+
+  DComplex TableExprNodeCache::getDComplex (const TableExprId& id)
+  {
+    if (dtype_p != NTComplex) {
+      return lnode_p->getDComplex (id);
+    }
+    if (! isCached(id)) {
+      valDComplex_p = lnode_p->getDComplex (id);
+    }
+    return valDComplex_p;
+  }
+
+  String TableExprNodeCache::getString (const TableExprId& id)
+  {
+    if (dtype_p != NTString) {
+      return lnode_p->getString (id);
+    }
+    if (! isCached(id)) {
+      valString_p = lnode_p->getString (id);
+    }
+    return valString_p;
+  }
+
+  MVTime TableExprNodeCache::getDate (const TableExprId& id)
+  {
+    if (dtype_p != NTDate) {
+      return lnode_p->getDate (id);
+    }
+    if (! isCached(id)) {
+      valDate_p = lnode_p->getDate (id);
+    }
+    return valDate_p;
+  }
+
+  Bool TableExprNodeCache::isDefined (const TableExprId& id)
+  {
+    return lnode_p->isDefined (id);
+  }
+
+  void TableExprNodeCache::ranges (Block<TableExprRange>& blrange)
+  {
+    lnode_p->ranges (blrange);
+  }
+
+  Bool TableExprNodeCache::sampleRows
+  (rownr_t nrow, std::vector<std::pair<rownr_t,rownr_t>>& intervals) const
+  {
+    return lnode_p->sampleRows (nrow, intervals);
+  }
+
+  Array<Bool> TableExprNodeCache::getColumnBool (const Vector<rownr_t>& rownrs)
+  {
+    return lnode_p->getColumnBool (rownrs);
+  }
+
+  Array<Int64> TableExprNodeCache::getColumnInt64 (const Vector<rownr_t>& rownrs)
+  {
+    return lnode_p->getColumnInt64 (rownrs);
+  }
+
+  Array<Double> TableExprNodeCache::getColumnDouble (const Vector<rownr_t>& rownrs)
+  {
+    return lnode_p->getColumnDouble (rownrs);
+  }
+
+  Array<DComplex> TableExprNodeCache::getColumnDComplex
+  (const Vector<rownr_t>& rownrs)
+  {
+    return lnode_p->getColumnDComplex (rownrs);
+  }
+
+  Array<String> TableExprNodeCache::getColumnString (const Vector<rownr_t>& rownrs)
+  {
+    return lnode_p->getColumnString (rownrs);
+  }
+
+
+
+  uInt TableExprCSE::apply (const std::vector<TableExprNode*>& exprs)
+  {
+    // Make a copy of the roots, so a root can be replaced as well.
+    std::vector<TENShPtr> roots;
+    roots.reserve (exprs.size());
+    for (const TableExprNode* expr : exprs) {
+      roots.push_back (expr->getRep());
+    }
+    uInt nshared = itsCaches.size();
+    // First make the keys of all subexpressions, thereafter count them
+    // and finally replace the subexpressions occurring multiple times.
+    // The traversal order of the last two steps has to be the same.
+    for (const TENShPtr& root : roots) {
+      if (root) {
+        makeKey (root.get());
+      }
+    }
+    for (const TENShPtr& root : roots) {
+      if (root) {
+        countKeys (root.get());
+      }
+    }
+    for (TENShPtr& root : roots) {
+      if (root) {
+        share (root);
+      }
+    }
+    for (size_t i=0; i<roots.size(); ++i) {
+      if (roots[i] != exprs[i]->getRep()) {
+        *exprs[i] = TableExprNode(roots[i]);
+      }
+    }
+    itsKeys.clear();
+    itsCounts.clear();
+    itsShared.clear();
+    return itsCaches.size() - nshared;
+  }
+
+  TableExprNodeRep* TableExprCSE::skipCache (TableExprNodeRep* node)
+  {
+    // A node shared by a previous apply is transparent.
+    while (dynamic_cast<TableExprNodeCache*>(node)) {
+      std::vector<TENShPtr*> children;
+      node->getChildNodes (children);
+      node = children[0]->get();
+    }
+    return node;
+  }
+
+  const String& TableExprCSE::makeKey (TableExprNodeRep* node)
+  {
+    node = skipCache (node);
+    auto iter = itsKeys.find (node);
+    if (iter != itsKeys.end()) {
+      return iter->second;
+    }
+    String key = nodeKey (*node);
+    if (! key.empty()) {
+      // Make the keys of all children, so subexpressions in them can be
+      // shared, even if a child cannot be shared.
+      std::vector<TENShPtr*> children;
+      node->getChildNodes (children);
+      if (! children.empty()) {
+        Bool canShare = True;
+        String childKeys;
+        for (size_t i=0; i<children.size(); ++i) {
+          const String& childKey = makeKey (children[i]->get());
+          canShare = canShare  &&  !childKey.empty();
+          if (i > 0) {
+            childKeys += ',';
+          }
+          childKeys += childKey;
+        }
+        key = (canShare  ?  key + '(' + childKeys + ')' : String());
+      }
+    }
+    return itsKeys[node] = key;
+  }
+
+  Bool TableExprCSE::canShare (TableExprNodeRep* node, const String& key)
+  {
+    // Columns and constants are not shared, because it has no advantage.
+    return !key.empty()  &&  node->operType() != TableExprNodeRep::OtColumn
+      &&  !node->isConstant();
+  }
+
+  void TableExprCSE::countKeys (TableExprNodeRep* node)
+  {
+    node = skipCache (node);
+    const String& key = itsKeys[node];
+    if (canShare (node, key)) {
+      // The subexpressions of a later occurrence are not counted, because
+      // they are not evaluated anymore once the occurrence is shared.
+      if (++itsCounts[key] > 1) {
+        return;
+      }
+    } else if (key.empty()  &&  nodeKey(*node).empty()) {
+      return;
+    }
+    std::vector<TENShPtr*> children;
+    node->getChildNodes (children);
+    for (TENShPtr* child : children) {
+      countKeys (child->get());
+    }
+  }
+
+  void TableExprCSE::share (TENShPtr& slot)
+  {
+    TableExprNodeRep* node = skipCache (slot.get());
+    const String& key = itsKeys[node];
+    if (canShare (node, key)  &&  itsCounts[key] > 1) {
+      auto iter = itsShared.find (key);
+      if (iter != itsShared.end()) {
+        slot = iter->second;
+        return;
+      }
+      // The first occurrence is cached; subexpressions in it can be
+      // shared with other expressions.
+      std::shared_ptr<TableExprNodeCache> cache =
+        std::make_shared<TableExprNodeCache> (slot);
+      itsShared[key] = cache;
+      itsCaches.push_back (cache);
+      slot = cache;
+    } else if (key.empty()  &&  nodeKey(*node).empty()) {
+      return;
+    }
+    std::vector<TENShPtr*> children;
+    node->getChildNodes (children);
+    for (TENShPtr* child : children) {
+      share (*child);
+    }
+  }
+
+  String TableExprCSE::nodeKey (const TableExprNodeRep& node)
+  {
+    if (node.isAggregate()) {
+      return String();
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+    Bool isScalar = node.valueType() == TableExprNodeRep::VTScalar;
+    // A scalar constant is identified by its value.
+    if (node.isConstant()  &&  node.operType() == TableExprNodeRep::OtLiteral) {
+      if (!isScalar) {
+        return String();
+      }
+      TableExprNodeRep& rep = const_cast<TableExprNodeRep&>(node);
+      TableExprId id(0);
+      oss << 'K' << Int(node.dataType()) << ':';
+      switch (node.dataType()) {
+      case TableExprNodeRep::NTBool:
+        oss << rep.getBool(id);
+        break;
+      case TableExprNodeRep::NTInt:
+        oss << rep.getInt(id);
+        break;
+      case TableExprNodeRep::NTDouble:
+      case TableExprNodeRep::NTDate:
+        oss << rep.getDouble(id);
+        break;
+      case TableExprNodeRep::NTComplex:
+        oss << rep.getDComplex(id);
+        break;
+      case TableExprNodeRep::NTString:
+        {
+          // Prefix the length, so a string containing key characters
+          // (like a quote, comma or parenthesis) cannot give the same key
+          // as another expression.
+          String str = rep.getString(id);
+          oss << str.size() << '"' << str;
+        }
+        break;
+      default:
+        return String();
+      }
+      return oss.str();
+    }
+    // A column is identified by its table (alias) and name.
+    const TableExprNodeColumn* colNode =
+      dynamic_cast<const TableExprNodeColumn*>(&node);
+    if (colNode) {
+      oss << 'C' << colNode->getTableInfo().alias() << '.'
+          << colNode->getColumn().columnDesc().name();
+      return oss.str();
+    }
+    const TableExprNodeArrayColumn* arrColNode =
+      dynamic_cast<const TableExprNodeArrayColumn*>(&node);
+    if (arrColNode) {
+      oss << 'A' << arrColNode->getTableInfo().alias() << '.'
+          << arrColNode->getColumn().columnDesc().name();
+      return oss.str();
+    }
+    // Otherwise only scalar operators and functions can be shared.
+    if (!isScalar  ||  node.dataType() == TableExprNodeRep::NTRegex) {
+      return String();
+    }
+    const TableExprNodeUnit* unitNode =
+      dynamic_cast<const TableExprNodeUnit*>(&node);
+    if (unitNode) {
+      oss << 'U' << node.unit().getName() << ':' << node.getUnitFactor();
+      return oss.str();
+    }
+    // Only plain function nodes (no aggregates or array functions).
+    if (typeid(node) == typeid(TableExprFuncNode)) {
+      const TableExprFuncNode& funcNode =
+        static_cast<const TableExprFuncNode&>(node);
+      // Functions giving a different value per call cannot be shared.
+      switch (funcNode.funcType()) {
+      case TableExprFuncNode::randFUNC:
+      case TableExprFuncNode::rownrFUNC:
+      case TableExprFuncNode::rowidFUNC:
+      case TableExprFuncNode::sampleFUNC:
+        return String();
+      default:
+        break;
+      }
+      oss << 'F' << Int(funcNode.funcType()) << ':'
+          << Int(funcNode.argDataType()) << ':' << funcNode.getScale();
+      return oss.str();
+    }
+    switch (node.operType()) {
+    case TableExprNodeRep::OtPlus:
+    case TableExprNodeRep::OtMinus:
+    case TableExprNodeRep::OtTimes:
+    case TableExprNodeRep::OtDivide:
+    case TableExprNodeRep::OtModulo:
+    case TableExprNodeRep::OtBitAnd:
+    case TableExprNodeRep::OtBitOr:
+    case TableExprNodeRep::OtBitXor:
+    case TableExprNodeRep::OtBitNegate:
+    case TableExprNodeRep::OtEQ:
+    case TableExprNodeRep::OtGE:
+    case TableExprNodeRep::OtGT:
+    case TableExprNodeRep::OtNE:
+    case TableExprNodeRep::OtAND:
+    case TableExprNodeRep::OtOR:
+    case TableExprNodeRep::OtNOT:
+    case TableExprNodeRep::OtMIN:
+      // The class of the node tells the operator and data types.
+      if (dynamic_cast<const TableExprNodeBinary*>(&node)) {
+        oss << 'B' << typeid(node).name();
+        return oss.str();
+      }
+      break;
+    default:
+      break;
+    }
+    return String();
+  }
+
+  void TableExprCSE::clearCaches()
+  {
+    for (const std::shared_ptr<TableExprNodeCache>& cache : itsCaches) {
+      cache->clearCache();
+    }
+  }
+
+  void TableExprCSE::show (ostream& os) const
+  {
+    os << itsCaches.size() << " shared subexpressions" << endl;
+    for (const std::shared_ptr<TableExprNodeCache>& cache : itsCaches) {
+      cache->show (os, 2);
+    }
+  }
+
+
+} //# NAMESPACE CASACORE - END
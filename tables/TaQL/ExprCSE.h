@@ -0,0 +1,228 @@
+//# ExprCSE.h: Elimination of common subexpressions in TaQL expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_EXPRCSE_H
+#define TABLES_EXPRCSE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/casa/iosfwd.h>
+#include <map>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class TableExprNode;
+
+
+  // <summary>
+  // Node caching the value of a common subexpression for the last row
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tExprCSE">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableExprCSE
+  // </prerequisite>
+
+  // <synopsis>
+  // This node is inserted by class TableExprCSE above a subexpression
+  // that is used multiple times in the expressions of a query.
+  // It keeps the value of the scalar subexpression for the row evaluated
+  // last, so the subexpression is evaluated once per row, no matter how
+  // often the value is used in the expressions.
+  // <br>Only the get function of the node's data type is cached; other
+  // get functions (e.g. getDouble for an Int node) and the functions
+  // getting the values of multiple rows are passed to the subexpression.
+  // </synopsis>
+
+  class TableExprNodeCache : public TableExprNodeBinary
+  {
+  public:
+    // Construct for the given scalar subexpression.
+    explicit TableExprNodeCache (const TENShPtr& node);
+
+    ~TableExprNodeCache() override = default;
+
+    // Show the node and its subexpression.
+    void show (ostream&, uInt indent) const override;
+
+    // Clear the cached value. It has to be done if the meaning of the
+    // row numbers changes (e.g. if a selection is applied to the columns).
+    void clearCache()
+      { row_p = -1; }
+
+    // Get the (cached) value.
+    // <group>
+    Bool     getBool     (const TableExprId& id) override;
+    Int64    getInt      (const TableExprId& id) override;
+    Double   getDouble   (const TableExprId& id) override;
+    DComplex getDComplex (const TableExprId& id) override;
+    String   getString   (const TableExprId& id) override;
+    MVTime   getDate     (const TableExprId& id) override;
+    // </group>
+
+    // Pass the other functions to the subexpression.
+    // <group>
+    Bool isDefined (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
+    Bool sampleRows (rownr_t nrow,
+                     std::vector<std::pair<rownr_t,rownr_t>>& intervals)
+      const override;
+    Array<Bool>     getColumnBool (const Vector<rownr_t>& rownrs) override;
+    Array<Int64>    getColumnInt64 (const Vector<rownr_t>& rownrs) override;
+    Array<Double>   getColumnDouble (const Vector<rownr_t>& rownrs) override;
+    Array<DComplex> getColumnDComplex (const Vector<rownr_t>& rownrs) override;
+    Array<String>   getColumnString (const Vector<rownr_t>& rownrs) override;
+    // </group>
+
+  private:
+    // Tell if the value of the row is cached. If not, the row is set
+    // and False is returned, so the caller has to fill in the value.
+    Bool isCached (const TableExprId& id);
+
+    Int64    row_p;
+    Bool     valBool_p;
+    Int64    valInt_p;
+    Double   valDouble_p;
+    DComplex valDComplex_p;
+    String   valString_p;
+    MVTime   valDate_p;
+  };
+
+
+
+  // <summary>
+  // Elimination of common subexpressions in TaQL expressions
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tExprCSE">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableExprNodeRep
+  // </prerequisite>
+
+  // <synopsis>
+  // The same expression (e.g. <src>sqrt(sumsqr(UVW))</src>) can be used in
+  // several clauses of a query, say in the WHERE, ORDERBY and SELECT
+  // clause. Each occurrence is parsed into its own expression tree, thus
+  // evaluated separately for each row.
+  // <br>TableExprCSE finds the equal subtrees in a set of expressions
+  // (known as hash-consing). It makes a key for each subtree describing
+  // its operator or function and the keys of its operands. The second and
+  // later occurrences of a key are replaced by the first one, which is
+  // put under a TableExprNodeCache node, so its value is calculated only
+  // once per row. The parts of a shared subtree are not shared themselves,
+  // unless they also occur outside the subtree.
+  // <br>Only deterministic subtrees of which the structure is known are
+  // handled. These are scalar operators, scalar functions (not aggregate
+  // functions and UDFs, because they might keep a state) and their
+  // operands being scalar or array columns and scalar constants.
+  // Columns and constants themselves are not cached, because that has no
+  // advantage. Note that constant subexpressions have already been folded
+  // into a single constant when the expression was created.
+  // <br>As the cache only holds the value of the last row, all expressions
+  // have to be evaluated for the same set of row numbers. Function
+  // <src>clearCaches</src> has to be called if a selection is applied to
+  // the columns in the expressions.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   TableExprNode e1 = sqrt(sumsqr(tab.col("UVW"))) > 100;
+  //   TableExprNode e2 = sqrt(sumsqr(tab.col("UVW"))) / 1000;
+  //   std::vector<TableExprNode*> exprs {&e1, &e2};
+  //   TableExprCSE cse;
+  //   cse.apply (exprs);    // now e1 and e2 share sqrt(sumsqr(UVW))
+  // </srcblock>
+  // </example>
+
+  class TableExprCSE
+  {
+  public:
+    TableExprCSE() = default;
+
+    // Find the common subexpressions in the given expressions and share
+    // them. Only the outermost common subexpressions are shared, not the
+    // parts of them. An expression is replaced if it is entirely a common
+    // subexpression. All expressions to be evaluated for the same rows
+    // have to be given in a single call.
+    // It returns the number of shared subexpressions.
+    uInt apply (const std::vector<TableExprNode*>& exprs);
+
+    // Get the number of shared subexpressions.
+    uInt nshared() const
+      { return itsCaches.size(); }
+
+    // Clear the cached values in all shared subexpressions.
+    void clearCaches();
+
+    // Show the shared subexpressions.
+    void show (ostream& os) const;
+
+  private:
+    // Make the key of the node and its subexpressions.
+    // An empty key is returned if the node cannot be shared.
+    const String& makeKey (TableExprNodeRep* node);
+
+    // Count the occurrences of the keys.
+    void countKeys (TableExprNodeRep* node);
+
+    // Replace the node in the slot by the cached node if its key occurs
+    // multiple times.
+    void share (TENShPtr& slot);
+
+    // Skip the cache nodes made by a previous apply.
+    static TableExprNodeRep* skipCache (TableExprNodeRep* node);
+
+    // Tell if a node with the given key can be shared.
+    static Bool canShare (TableExprNodeRep* node, const String& key);
+
+    // Make the part of the key describing the node itself.
+    // An empty string is returned if the node cannot be shared.
+    static String nodeKey (const TableExprNodeRep& node);
+
+    //# The keys and counts are only used during apply.
+    std::map<const TableExprNodeRep*,String> itsKeys;
+    std::map<String,uInt> itsCounts;
+    std::map<String,std::shared_ptr<TableExprNodeCache>> itsShared;
+    std::vector<std::shared_ptr<TableExprNodeCache>> itsCaches;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,615 @@
+//# ExprCompiled.cc: Block-wise evaluation of a compiled scalar numeric expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ExprCompiled.h>
+#include <casacore/tables/TaQL/ExprCSE.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprFuncNode.h>
+#include <casacore/tables/TaQL/ExprUDFNode.h>
+#include <casacore/tables/TaQL/ExprUnitNode.h>
+#include <casacore/tables/TaQL/TableExprId.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/iostream.h>
+#include <cmath>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  //# The fused operations are templated loops over the register values.
+  namespace {
+
+    template<typename F>
+    inline void unaryOp (const Double* in, Double* out, uInt n, F func)
+    {
+      for (uInt i=0; i<n; ++i) {
+        out[i] = func(in[i]);
+      }
+    }
+
+    template<typename F>
+    inline void binaryOp (const Double* in1, const Double* in2, Double* out,
+                          uInt n, Int constArg, Double value, F func)
+    {
+      if (constArg == 1) {
+        for (uInt i=0; i<n; ++i) {
+          out[i] = func(value, in2[i]);
+        }
+      } else if (constArg == 2) {
+        for (uInt i=0; i<n; ++i) {
+          out[i] = func(in1[i], value);
+        }
+      } else {
+        for (uInt i=0; i<n; ++i) {
+          out[i] = func(in1[i], in2[i]);
+        }
+      }
+    }
+
+    template<typename T>
+    inline void copyToDouble (const Array<T>& arr, Double* out)
+    {
+      Bool deleteIt;
+      const T* data = arr.getStorage (deleteIt);
+      size_t n = arr.size();
+      for (size_t i=0; i<n; ++i) {
+        out[i] = data[i];
+      }
+      arr.freeStorage (data, deleteIt);
+    }
+
+  } //# end anonymous namespace
+
+
+  TableExprCompiled::TableExprCompiled (TableExprNodeRep* node)
+  {
+    compileNode (node, 0);
+  }
+
+  Bool TableExprCompiled::isScalarReal (const TableExprNodeRep& node)
+  {
+    return node.valueType() == TableExprNodeRep::VTScalar  &&
+      (node.dataType() == TableExprNodeRep::NTDouble  ||
+       node.dataType() == TableExprNodeRep::NTInt);
+  }
+
+  uInt TableExprCompiled::intBits (const TableExprNodeRep& node)
+  {
+    if (node.valueType() != TableExprNodeRep::VTScalar  ||
+        node.dataType() != TableExprNodeRep::NTInt) {
+      return 64;
+    }
+    if (node.isConstant()) {
+      Int64 value = const_cast<TableExprNodeRep&>(node).getInt
+        (TableExprId(0));
+      uInt64 absValue = (value < 0  ?  uInt64(0) - uInt64(value) : value);
+      uInt nbits = 0;
+      while (absValue > 0) {
+        ++nbits;
+        absValue >>= 1;
+      }
+      return nbits;
+    }
+    const TableExprNodeCache* cacheNode =
+      dynamic_cast<const TableExprNodeCache*>(&node);
+    if (cacheNode) {
+      return intBits (*cacheNode->getLeftChild());
+    }
+    if (dynamic_cast<const TableExprNodeColumn*>(&node)) {
+      DataType dtype;
+      if (node.getColumnDataType (dtype)) {
+        switch (dtype) {
+        case TpUChar:  return 8;
+        case TpShort:  return 15;
+        case TpUShort: return 16;
+        case TpInt:    return 31;
+        case TpUInt:   return 32;
+        default:       break;
+        }
+      }
+      return 64;
+    }
+    const TableExprNodeBinary* binNode =
+      dynamic_cast<const TableExprNodeBinary*>(&node);
+    if (binNode  &&  !dynamic_cast<const TableExprFuncNode*>(&node)) {
+      uInt nbits = 64;
+      switch (node.operType()) {
+      case TableExprNodeRep::OtPlus:
+      case TableExprNodeRep::OtMinus:
+        nbits = 1 + std::max (intBits (*binNode->getLeftChild()),
+                              intBits (*binNode->getRightChild()));
+        break;
+      case TableExprNodeRep::OtTimes:
+        nbits = (intBits (*binNode->getLeftChild()) +
+                 intBits (*binNode->getRightChild()));
+        break;
+      case TableExprNodeRep::OtMIN:
+        nbits = intBits (*binNode->getLeftChild());
+        break;
+      default:
+        break;
+      }
+      return std::min (nbits, 64u);
+    }
+    return 64;
+  }
+
+  Bool TableExprCompiled::canCompile (const TableExprNodeRep& node)
+  {
+    if (! isScalarReal(node)  ||  node.isConstant()) {
+      return False;
+    }
+    std::vector<TableExprNodeRep*> children;
+    Double value;
+    OpCode op = getOpCode (node, children, value);
+    return op != OpInterp  &&  op != OpColumn  &&  op != OpConst;
+  }
+
+  TableExprCompiled::OpCode TableExprCompiled::getOpCode
+  (const TableExprNodeRep& node, std::vector<TableExprNodeRep*>& children,
+   Double& value)
+  {
+    children.clear();
+    value = 0;
+    if (! isScalarReal(node)) {
+      return OpInterp;
+    }
+    if (node.isConstant()) {
+      return OpConst;
+    }
+    // A shared subexpression is compiled as the subexpression itself.
+    const TableExprNodeCache* cacheNode =
+      dynamic_cast<const TableExprNodeCache*>(&node);
+    if (cacheNode) {
+      OpCode op = getOpCode (*cacheNode->getLeftChild(), children, value);
+      return op == OpColumn  ?  OpInterp : op;
+    }
+    // A scalar column of a numeric type.
+    const TableExprNodeColumn* colNode =
+      dynamic_cast<const TableExprNodeColumn*>(&node);
+    if (colNode) {
+      DataType dtype;
+      if (colNode->getColumnDataType (dtype)) {
+        switch (dtype) {
+        case TpUChar:
+        case TpShort:
+        case TpUShort:
+        case TpInt:
+        case TpUInt:
+        case TpInt64:
+        case TpFloat:
+        case TpDouble:
+          return OpColumn;
+        default:
+          break;
+        }
+      }
+      return OpInterp;
+    }
+    // A UDF evaluating a block of rows at a time acts like a column.
+    const TableExprUDFNode* udfNode =
+      dynamic_cast<const TableExprUDFNode*>(&node);
+    if (udfNode  &&  udfNode->hasBatch()) {
+      return OpColumn;
+    }
+    // A unit conversion.
+    const TableExprNodeUnit* unitNode =
+      dynamic_cast<const TableExprNodeUnit*>(&node);
+    if (unitNode) {
+      children.push_back (unitNode->getLeftChild().get());
+      value = unitNode->getUnitFactor();
+      return isScalarReal(*children[0])  ?  OpScale : OpInterp;
+    }
+    // An arithmetic operator. The node and its operands must be Int or
+    // Double (thus not Date, String or Complex).
+    const TableExprNodeBinary* binNode =
+      dynamic_cast<const TableExprNodeBinary*>(&node);
+    const TableExprFuncNode* funcNode =
+      dynamic_cast<const TableExprFuncNode*>(&node);
+    OpCode op = OpInterp;
+    if (binNode  &&  !funcNode) {
+      Bool isDouble = node.dataType() == TableExprNodeRep::NTDouble;
+      switch (node.operType()) {
+      case TableExprNodeRep::OtPlus:
+        op = OpAdd;
+        break;
+      case TableExprNodeRep::OtMinus:
+        op = OpSub;
+        break;
+      case TableExprNodeRep::OtTimes:
+        op = OpMul;
+        break;
+      case TableExprNodeRep::OtDivide:
+        if (isDouble) op = OpDiv;
+        break;
+      case TableExprNodeRep::OtModulo:
+        if (isDouble) op = OpMod;
+        break;
+      case TableExprNodeRep::OtMIN:
+        op = OpNeg;
+        break;
+      default:
+        break;
+      }
+      // An Int result must fit in the mantissa of the Double registers.
+      if (op != OpInterp  &&  !isDouble  &&  intBits(node) > 53) {
+        op = OpInterp;
+      }
+      if (op != OpInterp) {
+        children.push_back (binNode->getLeftChild().get());
+        if (op != OpNeg) {
+          children.push_back (binNode->getRightChild().get());
+        }
+      }
+    } else if (funcNode  &&
+               node.dataType() == TableExprNodeRep::NTDouble) {
+      switch (funcNode->funcType()) {
+      case TableExprFuncNode::sinFUNC:   op = OpSin;   break;
+      case TableExprFuncNode::sinhFUNC:  op = OpSinh;  break;
+      case TableExprFuncNode::cosFUNC:   op = OpCos;   break;
+      case TableExprFuncNode::coshFUNC:  op = OpCosh;  break;
+      case TableExprFuncNode::tanFUNC:   op = OpTan;   break;
+      case TableExprFuncNode::tanhFUNC:  op = OpTanh;  break;
+      case TableExprFuncNode::asinFUNC:  op = OpAsin;  break;
+      case TableExprFuncNode::acosFUNC:  op = OpAcos;  break;
+      case TableExprFuncNode::atanFUNC:  op = OpAtan;  break;
+      case TableExprFuncNode::expFUNC:   op = OpExp;   break;
+      case TableExprFuncNode::logFUNC:   op = OpLog;   break;
+      case TableExprFuncNode::log10FUNC: op = OpLog10; break;
+      case TableExprFuncNode::squareFUNC: op = OpSqr;  break;
+      case TableExprFuncNode::cubeFUNC:  op = OpCube;  break;
+      case TableExprFuncNode::absFUNC:   op = OpAbs;   break;
+      case TableExprFuncNode::signFUNC:  op = OpSign;  break;
+      case TableExprFuncNode::roundFUNC: op = OpRound; break;
+      case TableExprFuncNode::floorFUNC: op = OpFloor; break;
+      case TableExprFuncNode::ceilFUNC:  op = OpCeil;  break;
+      case TableExprFuncNode::powFUNC:   op = OpPow;   break;
+      case TableExprFuncNode::atan2FUNC: op = OpAtan2; break;
+      case TableExprFuncNode::minFUNC:   op = OpMin;   break;
+      case TableExprFuncNode::maxFUNC:   op = OpMax;   break;
+      case TableExprFuncNode::fmodFUNC:  op = OpFmod;  break;
+      case TableExprFuncNode::sqrtFUNC:
+        op = OpSqrt;
+        value = funcNode->getScale();
+        break;
+      default:
+        break;
+      }
+      if (op != OpInterp) {
+        for (const TENShPtr& oper : funcNode->operands()) {
+          children.push_back (oper.get());
+        }
+      }
+    }
+    // All operands must be scalar Int or Double.
+    for (const TableExprNodeRep* child : children) {
+      if (! isScalarReal(*child)) {
+        children.clear();
+        return OpInterp;
+      }
+    }
+    return op;
+  }
+
+  void TableExprCompiled::compileNode (TableExprNodeRep* node, uInt reg)
+  {
+    if (itsRegisters.size() <= reg) {
+      itsRegisters.resize (reg+1, std::vector<Double>(blockSize));
+    }
+    std::vector<TableExprNodeRep*> children;
+    Instr instr;
+    instr.res      = reg;
+    instr.arg1     = reg;
+    instr.arg2     = reg+1;
+    instr.constArg = 0;
+    instr.value    = 0;
+    instr.node     = 0;
+    instr.dtype    = TpOther;
+    instr.op = getOpCode (*node, children, instr.value);
+    switch (instr.op) {
+    case OpConst:
+      instr.value = node->getDouble (TableExprId(0));
+      break;
+    case OpColumn:
+      instr.node = node;
+      if (! node->getColumnDataType (instr.dtype)) {
+        // A batch UDF.
+        instr.dtype = (node->dataType() == TableExprNodeRep::NTInt ?
+                       TpInt64 : TpDouble);
+      }
+      break;
+    case OpInterp:
+      instr.node = node;
+      break;
+    default:
+      if (children.size() == 1) {
+        compileNode (children[0], reg);
+      } else {
+        // A constant operand is kept in the instruction itself.
+        if (children[0]->isConstant()) {
+          instr.constArg = 1;
+          instr.value = children[0]->getDouble (TableExprId(0));
+          compileNode (children[1], reg);
+          instr.arg2 = reg;
+        } else if (children[1]->isConstant()) {
+          instr.constArg = 2;
+          instr.value = children[1]->getDouble (TableExprId(0));
+          compileNode (children[0], reg);
+        } else {
+          compileNode (children[0], reg);
+          compileNode (children[1], reg+1);
+        }
+      }
+    }
+    itsProgram.push_back (instr);
+  }
+
+  uInt TableExprCompiled::nInterpreted() const
+  {
+    uInt n = 0;
+    for (const Instr& instr : itsProgram) {
+      if (instr.op == OpInterp) ++n;
+    }
+    return n;
+  }
+
+  void TableExprCompiled::evaluate (const Vector<rownr_t>& rownrs,
+                                    Double* result)
+  {
+    rownr_t nrow = rownrs.size();
+    Vector<rownr_t> blockRows;
+    for (rownr_t st=0; st<nrow; st+=blockSize) {
+      uInt n = std::min (rownr_t(blockSize), nrow-st);
+      blockRows.reference (rownrs(Slice(st, n)));
+      evalBlock (blockRows, n);
+      const Double* res = itsRegisters[0].data();
+      std::copy (res, res+n, result+st);
+    }
+  }
+
+  Array<Double> TableExprCompiled::getColumnDouble
+  (const Vector<rownr_t>& rownrs)
+  {
+    Array<Double> arr (IPosition(1, rownrs.size()));
+    evaluate (rownrs, arr.data());
+    return arr;
+  }
+
+  void TableExprCompiled::readColumn (const Instr& instr,
+                                      const Vector<rownr_t>& rownrs,
+                                      Double* reg)
+  {
+    switch (instr.dtype) {
+    case TpUChar:
+      copyToDouble (instr.node->getColumnuChar(rownrs), reg);
+      break;
+    case TpShort:
+      copyToDouble (instr.node->getColumnShort(rownrs), reg);
+      break;
+    case TpUShort:
+      copyToDouble (instr.node->getColumnuShort(rownrs), reg);
+      break;
+    case TpInt:
+      copyToDouble (instr.node->getColumnInt(rownrs), reg);
+      break;
+    case TpUInt:
+      copyToDouble (instr.node->getColumnuInt(rownrs), reg);
+      break;
+    case TpInt64:
+      copyToDouble (instr.node->getColumnInt64(rownrs), reg);
+      break;
+    case TpFloat:
+      copyToDouble (instr.node->getColumnFloat(rownrs), reg);
+      break;
+    default:
+      copyToDouble (instr.node->getColumnDouble(rownrs), reg);
+      break;
+    }
+  }
+
+  void TableExprCompiled::evalBlock (const Vector<rownr_t>& rownrs, uInt n)
+  {
+    TableExprId id;
+    for (const Instr& instr : itsProgram) {
+      Double* out = itsRegisters[instr.res].data();
+      const Double* in1 = itsRegisters[instr.arg1].data();
+      const Double* in2 = (instr.arg2 < itsRegisters.size()  ?
+                           itsRegisters[instr.arg2].data() : 0);
+      Int ca = instr.constArg;
+      Double v = instr.value;
+      switch (instr.op) {
+      case OpConst:
+        std::fill (out, out+n, v);
+        break;
+      case OpColumn:
+        readColumn (instr, rownrs, out);
+        break;
+      case OpInterp:
+        for (uInt i=0; i<n; ++i) {
+          id.setRownr (rownrs[i]);
+          out[i] = instr.node->getDouble (id);
+        }
+        break;
+      case OpAdd:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return a+b;});
+        break;
+      case OpSub:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return a-b;});
+        break;
+      case OpMul:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return a*b;});
+        break;
+      case OpDiv:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return a/b;});
+        break;
+      case OpMod:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return floormod(a,b);});
+        break;
+      case OpPow:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return std::pow(a,b);});
+        break;
+      case OpAtan2:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return std::atan2(a,b);});
+        break;
+      case OpMin:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return std::min(a,b);});
+        break;
+      case OpMax:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return std::max(a,b);});
+        break;
+      case OpFmod:
+        binaryOp (in1, in2, out, n, ca, v,
+                  [](Double a, Double b) {return std::fmod(a,b);});
+        break;
+      case OpNeg:
+        unaryOp (in1, out, n, [](Double a) {return -a;});
+        break;
+      case OpScale:
+        unaryOp (in1, out, n, [v](Double a) {return v*a;});
+        break;
+      case OpSqrt:
+        unaryOp (in1, out, n, [v](Double a) {return std::sqrt(a)*v;});
+        break;
+      case OpSqr:
+        unaryOp (in1, out, n, [](Double a) {return a*a;});
+        break;
+      case OpCube:
+        unaryOp (in1, out, n, [](Double a) {return a*a*a;});
+        break;
+      case OpAbs:
+        unaryOp (in1, out, n, [](Double a) {return std::abs(a);});
+        break;
+      case OpSign:
+        unaryOp (in1, out, n,
+                 [](Double a) {return a>0 ? 1. : (a<0 ? -1. : 0.);});
+        break;
+      case OpRound:
+        unaryOp (in1, out, n, [](Double a)
+                 {return a<0 ? std::ceil(a-0.5) : std::floor(a+0.5);});
+        break;
+      case OpFloor:
+        unaryOp (in1, out, n, [](Double a) {return std::floor(a);});
+        break;
+      case OpCeil:
+        unaryOp (in1, out, n, [](Double a) {return std::ceil(a);});
+        break;
+      case OpSin:
+        unaryOp (in1, out, n, [](Double a) {return std::sin(a);});
+        break;
+      case OpSinh:
+        unaryOp (in1, out, n, [](Double a) {return std::sinh(a);});
+        break;
+      case OpCos:
+        unaryOp (in1, out, n, [](Double a) {return std::cos(a);});
+        break;
+      case OpCosh:
+        unaryOp (in1, out, n, [](Double a) {return std::cosh(a);});
+        break;
+      case OpTan:
+        unaryOp (in1, out, n, [](Double a) {return std::tan(a);});
+        break;
+      case OpTanh:
+        unaryOp (in1, out, n, [](Double a) {return std::tanh(a);});
+        break;
+      case OpAsin:
+        unaryOp (in1, out, n, [](Double a) {return std::asin(a);});
+        break;
+      case OpAcos:
+        unaryOp (in1, out, n, [](Double a) {return std::acos(a);});
+        break;
+      case OpAtan:
+        unaryOp (in1, out, n, [](Double a) {return std::atan(a);});
+        break;
+      case OpExp:
+        unaryOp (in1, out, n, [](Double a) {return std::exp(a);});
+        break;
+      case OpLog:
+        unaryOp (in1, out, n, [](Double a) {return std::log(a);});
+        break;
+      case OpLog10:
+        unaryOp (in1, out, n, [](Double a) {return std::log10(a);});
+        break;
+      }
+    }
+  }
+
+  const char* TableExprCompiled::opName (OpCode op)
+  {
+    static const char* names[] = {
+      "const", "column", "interp",
+      "add", "sub", "mul", "div", "mod", "pow", "atan2", "min", "max", "fmod",
+      "neg", "scale", "sqrt", "sqr", "cube", "abs", "sign", "round",
+      "floor", "ceil", "sin", "sinh", "cos", "cosh", "tan", "tanh",
+      "asin", "acos", "atan", "exp", "log", "log10"
+    };
+    return names[op];
+  }
+
+  void TableExprCompiled::show (ostream& os) const
+  {
+    for (const Instr& instr : itsProgram) {
+      os << "  r" << instr.res << " = " << opName(instr.op);
+      switch (instr.op) {
+      case OpConst:
+        os << ' ' << instr.value;
+        break;
+      case OpColumn:
+        os << ' ' << instr.dtype;
+        break;
+      case OpInterp:
+        break;
+      case OpAdd: case OpSub: case OpMul: case OpDiv: case OpMod:
+      case OpPow: case OpAtan2: case OpMin: case OpMax: case OpFmod:
+        if (instr.constArg == 1) {
+          os << ' ' << instr.value << " r" << instr.arg2;
+        } else if (instr.constArg == 2) {
+          os << " r" << instr.arg1 << ' ' << instr.value;
+        } else {
+          os << " r" << instr.arg1 << " r" << instr.arg2;
+        }
+        break;
+      default:
+        os << " r" << instr.arg1;
+        if (instr.op == OpScale  ||  (instr.op == OpSqrt && instr.value != 1)) {
+          os << ' ' << instr.value;
+        }
+        break;
+      }
+      os << endl;
+    }
+  }
+
+
+} //# NAMESPACE CASACORE - END
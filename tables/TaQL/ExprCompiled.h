@@ -0,0 +1,193 @@
+//# ExprCompiled.h: Block-wise evaluation of a compiled scalar numeric expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_EXPRCOMPILED_H
+#define TABLES_EXPRCOMPILED_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/iosfwd.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // <summary>
+  // Block-wise evaluation of a compiled scalar numeric expression
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tExprCompiled">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableExprNodeRep
+  // </prerequisite>
+
+  // <synopsis>
+  // Normally a TaQL expression is interpreted for each row by walking
+  // through the expression tree using virtual getDouble calls.
+  // For math-heavy scalar expressions (e.g. <src>sqrt(U*U+V*V)*FREQ/c</src>)
+  // that overhead dominates.
+  // <br>TableExprCompiled flattens a scalar Int or Double expression tree
+  // into a linear program of fused operations working on registers
+  // holding the values of a block of rows. The program is created once and
+  // reused for all blocks, so the tree is walked once per block instead of
+  // once per row. The operations are simple templated loops over the
+  // register values which the compiler can vectorize.
+  // <br>The following node types are compiled:
+  // <ul>
+  //  <li> Constant subexpressions (evaluated once at compile time).
+  //  <li> Scalar numeric columns; their values are read per block using
+  //       getColumnCells.
+  //  <li> Scalar numeric UDFs implementing the batch interface of
+  //       class UDFBase; they are evaluated per block like a column.
+  //  <li> The arithmetic operators + - * / % and unary minus on Int or
+  //       Double values.
+  //  <li> Unit conversions.
+  //  <li> Shared subexpressions (see class TableExprCSE); they are compiled
+  //       as the subexpression itself.
+  //  <li> The math functions sin, sinh, cos, cosh, tan, tanh, asin, acos,
+  //       atan, atan2, exp, log, log10, sqrt, pow, sqr, cube, min, max,
+  //       abs, sign, round, floor, ceil and fmod on Double values.
+  // </ul>
+  // Any other subtree (e.g. array reductions or other UDFs) is kept as a leaf that
+  // is evaluated per row by the interpreter, so each expression can be
+  // compiled, possibly only partly.
+  // <br>The registers hold Double values. An Int operation is only compiled
+  // if its result is exact, thus if the magnitude of its operands (derived
+  // from the column data types and constant values) guarantees that its
+  // result fits in the 53 bits mantissa of a Double. For example, the sum
+  // of two Int columns is compiled, but not if a column is Int64.
+  // <br>Register allocation is stack-like, thus the number of registers
+  // needed is the depth of the expression tree.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   TableExprNode expr = tab.col("U") * tab.col("V") + 1.;
+  //   TableExprCompiled prog (expr.getRep().get());
+  //   Array<Double> result = prog.getColumnDouble (tab.rowNumbers());
+  // </srcblock>
+  // </example>
+
+  class TableExprCompiled
+  {
+  public:
+    // Compile the given node which must be a scalar Int or Double expression.
+    // The node must be alive as long as this object is used.
+    explicit TableExprCompiled (TableExprNodeRep* node);
+
+    // Can the node be compiled? This is the case if it is a scalar Int or
+    // Double expression containing at least one compilable operator or
+    // function (compiling a single column or constant has no advantage).
+    static Bool canCompile (const TableExprNodeRep& node);
+
+    // Evaluate the expression for the given row numbers and store the results
+    // in the given buffer which must have length <src>rownrs.size()</src>.
+    // The rows are processed in blocks of <src>blockSize</src> rows.
+    void evaluate (const Vector<rownr_t>& rownrs, Double* result);
+
+    // Evaluate the expression for the given row numbers.
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs);
+
+    // Get the number of operations and interpreted leaves in the program.
+    // <group>
+    uInt nOperations() const
+      { return itsProgram.size(); }
+    uInt nInterpreted() const;
+    // </group>
+
+    // Show the program.
+    void show (ostream& os) const;
+
+    // The number of rows evaluated at a time.
+    static const uInt blockSize = 1024;
+
+  private:
+    enum OpCode {
+      //# Leaves
+      OpConst, OpColumn, OpInterp,
+      //# Binary operators and functions
+      OpAdd, OpSub, OpMul, OpDiv, OpMod, OpPow, OpAtan2, OpMin, OpMax, OpFmod,
+      //# Unary operators and functions
+      OpNeg, OpScale, OpSqrt, OpSqr, OpCube, OpAbs, OpSign, OpRound,
+      OpFloor, OpCeil, OpSin, OpSinh, OpCos, OpCosh, OpTan, OpTanh,
+      OpAsin, OpAcos, OpAtan, OpExp, OpLog, OpLog10
+    };
+
+    //# A single instruction. The result is stored in register res.
+    //# For a binary operation, a constant operand is kept in value
+    //# (flagged by constArg) instead of using a register.
+    struct Instr {
+      OpCode op;
+      uInt   res;
+      uInt   arg1;
+      uInt   arg2;
+      Int    constArg;        //# 0=none, 1=first, 2=second operand constant
+      Double value;           //# constant or scale factor
+      TableExprNodeRep* node; //# column or interpreted node
+      DataType dtype;         //# data type of a column
+    };
+
+    // Get the opcode of a node; OpInterp if not compilable.
+    static OpCode getOpCode (const TableExprNodeRep& node,
+                             std::vector<TableExprNodeRep*>& children,
+                             Double& value);
+
+    // Is the node a scalar Int or Double?
+    static Bool isScalarReal (const TableExprNodeRep& node);
+
+    // Get an upper limit of the number of bits needed for the absolute
+    // values of a scalar Int expression. It returns 64 if unknown.
+    static uInt intBits (const TableExprNodeRep& node);
+
+    // Generate the instructions for the node storing the result in the
+    // given register.
+    void compileNode (TableExprNodeRep* node, uInt reg);
+
+    // Evaluate a block of rows.
+    void evalBlock (const Vector<rownr_t>& rownrs, uInt n);
+
+    // Read the values of a column into a register.
+    void readColumn (const Instr& instr, const Vector<rownr_t>& rownrs,
+                     Double* reg);
+
+    // Get the name of an opcode.
+    static const char* opName (OpCode);
+
+    std::vector<Instr>              itsProgram;
+    std::vector<std::vector<Double>> itsRegisters;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
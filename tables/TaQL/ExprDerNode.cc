@@ -360,5 +360,62 @@ Double TableExprNodeRandom::getDouble (const TableExprId&)
     return random_p();
 }
 
+
+
+TableExprNodeSample::TableExprNodeSample (const TableExprInfo& tableInfo,
+                                          Double fraction, Int64 seed,
+                                          rownr_t nrowBlock)
+: TableExprNodeBinary (NTBool, VTScalar, OtRownr, Variable),
+  tableInfo_p         (tableInfo),
+  fraction_p          (fraction),
+  seed_p              (seed),
+  nrowBlock_p         (nrowBlock)
+{
+    if (fraction < 0  ||  fraction > 1) {
+        throw TableInvExpr ("Fraction in function SAMPLE must be in [0,1]");
+    }
+    if (nrowBlock_p == 0) {
+        throw TableInvExpr ("Block size in function SAMPLE must be positive");
+    }
+}
+TableExprInfo TableExprNodeSample::getTableInfo() const
+{
+    return tableInfo_p;
+}
+Bool TableExprNodeSample::isSampled (rownr_t block) const
+{
+    // Use the splitmix64 finalizer to hash block and seed, which gives
+    // uniformly distributed values also for consecutive block numbers.
+    uInt64 h = block + seed_p * 0x9e3779b97f4a7c15ULL + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    // Use the upper 53 bits as a fraction in [0,1).
+    return Double(h >> 11) * (1. / 9007199254740992.) < fraction_p;
+}
+Bool TableExprNodeSample::getBool (const TableExprId& id)
+{
+    AlwaysAssert (id.byRow(), AipsError);
+    return isSampled (id.rownr() / nrowBlock_p);
+}
+Bool TableExprNodeSample::sampleRows
+(rownr_t nrow, std::vector<std::pair<rownr_t,rownr_t>>& intervals) const
+{
+    intervals.clear();
+    rownr_t nblock = (nrow + nrowBlock_p - 1) / nrowBlock_p;
+    for (rownr_t block=0; block<nblock; ++block) {
+        if (isSampled (block)) {
+            rownr_t first = block * nrowBlock_p;
+            rownr_t last  = std::min (first + nrowBlock_p, nrow) - 1;
+            if (!intervals.empty()  &&  intervals.back().second+1 == first) {
+                intervals.back().second = last;
+            } else {
+                intervals.push_back (std::make_pair (first, last));
+            }
+        }
+    }
+    return True;
+}
+
 } //# NAMESPACE CASACORE - END
 
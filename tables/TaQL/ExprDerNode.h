@@ -451,6 +451,54 @@ private:
 
 
 
+// <summary>
+// Sampling of blocks of rows in table select expression tree
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tExprNode">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+// </prerequisite>
+
+// <synopsis>
+// This class represents the sample(fraction, seed, nrowblock) function in a
+// table select expression tree. The rows are divided in blocks of
+// <src>nrowblock</src> rows. The function is true for the rows in a block
+// if a hash of the block number and the seed is less than the fraction.
+// Thus the same seed always gives the same sample, while on average the
+// given fraction of the rows is selected.
+// <br>Because entire blocks are selected, the table selection only needs
+// to read the data in the selected blocks (see function
+// <src>sampleRows</src>). It is best if the block size is about the number
+// of rows in a data bucket.
+// </synopsis> 
+
+class TableExprNodeSample : public TableExprNodeBinary
+{
+public:
+    TableExprNodeSample (const TableExprInfo&, Double fraction,
+                         Int64 seed, rownr_t nrowBlock);
+    ~TableExprNodeSample() override = default;
+    TableExprInfo getTableInfo() const override;
+    Bool getBool (const TableExprId& id) override;
+    Bool sampleRows (rownr_t nrow,
+                     std::vector<std::pair<rownr_t,rownr_t>>&) const override;
+    // Tell if the given block is in the sample.
+    Bool isSampled (rownr_t block) const;
+private:
+    TableExprInfo tableInfo_p;
+    Double        fraction_p;
+    uInt64        seed_p;
+    rownr_t       nrowBlock_p;
+};
+
+
+
 } //# NAMESPACE CASACORE - END
 
 #endif
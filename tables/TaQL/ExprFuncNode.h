@@ -294,14 +294,16 @@ public:
         replmaskedFUNC,   //# 177
         replunmaskedFUNC, //# 178
         arrflatFUNC,      //# 179
+            // special function selecting a sample of blocks of rows
+        sampleFUNC,       //# 180
         //# AGGREGATE functions must be the last ones.
-        FirstAggrFunc,    //# 180
+        FirstAggrFunc,    //# 181
         countallFUNC = FirstAggrFunc,
         gcountFUNC,
         gfirstFUNC,
         glastFUNC,
         //# Grouping doing aggregation on the fly; reducing to a scalar per group
-        gminFUNC,         //# 184
+        gminFUNC,         //# 185
         gmaxFUNC,
         gsumFUNC,
         gproductFUNC,
@@ -316,8 +318,11 @@ public:
         gallFUNC,
         gntrueFUNC,
         gnfalseFUNC,
+        gapproxcountdistinctFUNC,
+        gapproxmedianFUNC,
+        gapproxfractileFUNC,
         //# Grouping doing aggregation on the fly; reducing to an array per group
-        FirstAggrArrayFunc,//# 199
+        FirstAggrArrayFunc,//# 203
         gminsFUNC = FirstAggrArrayFunc,
         gmaxsFUNC,
         gsumsFUNC,
@@ -333,15 +338,15 @@ public:
         gallsFUNC,
         gntruesFUNC,
         gnfalsesFUNC,
-        LastAggrArrayFunc, //# 214
+        LastAggrArrayFunc, //# 218
         ghistFUNC = LastAggrArrayFunc,
         //# Grouping requiring aggregation of rows when getting result
-        gaggrFUNC,         //# 215
+        gaggrFUNC,         //# 219
         growidFUNC,
         gmedianFUNC,
         gfractileFUNC,
         gexpridFUNC,       //# special function (can be inserted by TableParse)
-        NRFUNC             //# 220  should be last
+        NRFUNC             //# 224  should be last
         };
 
     // Constructor
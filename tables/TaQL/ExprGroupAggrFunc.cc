@@ -32,6 +32,10 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/GenSort.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include <limits>
 
 
@@ -327,6 +331,175 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return 0;
   }
 
+  //# Mix the bits of a 64-bit value (splitmix64 finalizer), so similar
+  //# values give uncorrelated hashes.
+  inline uInt64 approxMixHash (uInt64 h)
+  {
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+  }
+  inline uInt64 approxDoubleHash (Double v)
+  {
+    // Make sure that -0 and 0 are the same.
+    if (v == 0) v = 0;
+    uInt64 h;
+    memcpy (&h, &v, sizeof(h));
+    return h;
+  }
+
+  TableExprGroupApproxCountDistinct::TableExprGroupApproxCountDistinct
+  (TableExprNodeRep* node)
+    : TableExprGroupFuncInt (node),
+      itsRegisters (4096, 0)
+  {}
+  TableExprGroupApproxCountDistinct::~TableExprGroupApproxCountDistinct()
+  {}
+  void TableExprGroupApproxCountDistinct::addHash (uInt64 hash)
+  {
+    hash = approxMixHash (hash + 0x9e3779b97f4a7c15ULL);
+    // The upper 12 bits give the register; the rank is the position of
+    // the first 1-bit in the remaining 52 bits.
+    uInt64 reg = hash >> 52;
+    uInt64 w = hash << 12;
+    uChar rank = 1;
+    while (rank <= 52  &&  (w & 0x8000000000000000ULL) == 0) {
+      w <<= 1;
+      rank++;
+    }
+    if (rank > itsRegisters[reg]) {
+      itsRegisters[reg] = rank;
+    }
+  }
+  void TableExprGroupApproxCountDistinct::apply (const TableExprId& id)
+  {
+    switch (itsOperand->dataType()) {
+    case TableExprNodeRep::NTBool:
+      addHash (itsOperand->getBool(id) ? 1 : 0);
+      break;
+    case TableExprNodeRep::NTInt:
+      addHash (itsOperand->getInt(id));
+      break;
+    case TableExprNodeRep::NTDouble:
+      addHash (approxDoubleHash (itsOperand->getDouble(id)));
+      break;
+    case TableExprNodeRep::NTComplex:
+      {
+        DComplex v = itsOperand->getDComplex(id);
+        addHash (approxMixHash (approxDoubleHash (v.real())) ^
+                 approxDoubleHash (v.imag()));
+      }
+      break;
+    case TableExprNodeRep::NTDate:
+      addHash (approxDoubleHash (itsOperand->getDate(id).day()));
+      break;
+    case TableExprNodeRep::NTString:
+      addHash (std::hash<std::string>() (itsOperand->getString(id)));
+      break;
+    default:
+      throw TableInvExpr ("Unhandled data type in GAPPROXCOUNTDISTINCT");
+    }
+  }
+  void TableExprGroupApproxCountDistinct::finish()
+  {
+    Double m = itsRegisters.size();
+    Double sum = 0;
+    uInt nzero = 0;
+    for (uChar r : itsRegisters) {
+      sum += std::ldexp (1., -Int(r));
+      if (r == 0) nzero++;
+    }
+    Double est = 0.7213 / (1 + 1.079/m) * m * m / sum;
+    // Use linear counting for small numbers.
+    if (est <= 2.5*m  &&  nzero > 0) {
+      est = m * std::log (m / nzero);
+    }
+    itsValue = Int64(est + 0.5);
+  }
+
+  TableExprGroupApproxFractileDouble::TableExprGroupApproxFractileDouble
+  (TableExprNodeRep* node, Double fraction)
+    : TableExprGroupFuncDouble (node),
+      itsFrac    (fraction),
+      itsSize    (0),
+      itsLevels  (1),
+      itsOffset  (1, 0)
+  {
+    itsMaxSize = capacity(0);
+  }
+  TableExprGroupApproxFractileDouble::~TableExprGroupApproxFractileDouble()
+  {}
+  size_t TableExprGroupApproxFractileDouble::capacity (size_t level) const
+  {
+    // The top level has the largest capacity.
+    Double cap = 256 * std::pow (2./3., Double(itsLevels.size() - 1 - level));
+    return std::max (size_t(8), size_t(std::ceil(cap)));
+  }
+  void TableExprGroupApproxFractileDouble::compress()
+  {
+    for (size_t level=0; level<itsLevels.size(); ++level) {
+      if (itsLevels[level].size() >= capacity(level)) {
+        if (level+1 == itsLevels.size()) {
+          itsLevels.resize (level+2);
+          itsOffset.push_back (0);
+        }
+        // Sort the level and move every other value to the next level.
+        // Alternate the start, so the errors tend to cancel.
+        std::vector<Double>& buf = itsLevels[level];
+        std::sort (buf.begin(), buf.end());
+        size_t st = itsOffset[level];
+        itsOffset[level] = 1 - itsOffset[level];
+        for (size_t i=st; i<buf.size(); i+=2) {
+          itsLevels[level+1].push_back (buf[i]);
+        }
+        buf.clear();
+        break;
+      }
+    }
+    itsSize = 0;
+    itsMaxSize = 0;
+    for (size_t level=0; level<itsLevels.size(); ++level) {
+      itsSize += itsLevels[level].size();
+      itsMaxSize += capacity(level);
+    }
+  }
+  void TableExprGroupApproxFractileDouble::apply (const TableExprId& id)
+  {
+    itsLevels[0].push_back (itsOperand->getDouble(id));
+    itsSize++;
+    while (itsSize >= itsMaxSize) {
+      compress();
+    }
+  }
+  void TableExprGroupApproxFractileDouble::finish()
+  {
+    // Sort the values with their weights and find the value at the
+    // weighted rank (determined as in TableExprGroupFractileDouble).
+    std::vector<std::pair<Double,uInt64>> values;
+    values.reserve (itsSize);
+    uInt64 total = 0;
+    for (size_t level=0; level<itsLevels.size(); ++level) {
+      uInt64 weight = uInt64(1) << level;
+      for (Double v : itsLevels[level]) {
+        values.push_back (std::make_pair (v, weight));
+        total += weight;
+      }
+    }
+    itsValue = 0;
+    if (! values.empty()) {
+      std::sort (values.begin(), values.end());
+      uInt64 rank = static_cast<uInt64>((total - 1.)*itsFrac + 0.001);
+      uInt64 cum = 0;
+      for (const std::pair<Double,uInt64>& v : values) {
+        cum += v.second;
+        itsValue = v.first;
+        if (cum > rank) {
+          break;
+        }
+      }
+    }
+  }
+
 
   TableExprGroupSumDComplex::TableExprGroupSumDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node)
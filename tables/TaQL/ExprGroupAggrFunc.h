@@ -73,6 +73,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupCount (TableExprNodeRep* node);
     virtual ~TableExprGroupCount();
     virtual void apply (const TableExprId& id);
+    // Set the result directly (if known from metadata).
+    void setResult (Int64 cnt)
+      { itsValue = cnt; }
   private:
     TableExprNodeArrayColumn* itsColumn;
   };
@@ -424,6 +427,75 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double itsFrac;
   };
 
+  // <summary>
+  // Aggregate class estimating the number of distinct values in a group
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tExprGroup">
+  // </reviewed>
+  // <synopsis>
+  // Aggregate class estimating the number of distinct values in a group
+  // using the HyperLogLog algorithm (Flajolet et al., 2007).
+  // The values are hashed into 4096 registers, so the memory used is
+  // fixed, while the standard error of the estimate is about 1.6%.
+  // Small numbers (up to a few thousand) are estimated by linear counting,
+  // which is nearly exact.
+  // <br>It can be used for any scalar data type.
+  // </synopsis>
+  class TableExprGroupApproxCountDistinct: public TableExprGroupFuncInt
+  {
+  public:
+    explicit TableExprGroupApproxCountDistinct (TableExprNodeRep* node);
+    virtual ~TableExprGroupApproxCountDistinct();
+    virtual void apply (const TableExprId& id);
+    virtual void finish();
+  private:
+    // Add a hash value to the registers.
+    void addHash (uInt64 hash);
+
+    std::vector<uChar> itsRegisters;
+  };
+
+  // <summary>
+  // Aggregate class estimating the fractile of values in a group
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tExprGroup">
+  // </reviewed>
+  // <synopsis>
+  // Aggregate class estimating the fractile of values in a group using
+  // a KLL sketch (Karnin, Lang and Liberty, 2016).
+  // Unlike TableExprGroupFractileDouble, it aggregates on the fly and
+  // does not need to keep all values of a group. The values are kept in
+  // levels of buffers, where a value at level h represents 2^h values.
+  // When a level is full, it is sorted and every other value is moved to
+  // the next level. The capacity of the levels decreases geometrically
+  // from the top level (which has a capacity of 256), so the memory used
+  // grows only logarithmically with the number of values.
+  // The error of the rank of the result is about 1% of the number of values.
+  // If the group contains less than 256 values, the result is exact.
+  // </synopsis>
+  class TableExprGroupApproxFractileDouble: public TableExprGroupFuncDouble
+  {
+  public:
+    explicit TableExprGroupApproxFractileDouble (TableExprNodeRep* node,
+                                                 Double fractile);
+    virtual ~TableExprGroupApproxFractileDouble();
+    virtual void apply (const TableExprId& id);
+    virtual void finish();
+  private:
+    // Get the capacity of a level.
+    size_t capacity (size_t level) const;
+    // Compact the lowest level exceeding its capacity.
+    void compress();
+
+    Double itsFrac;
+    size_t itsSize;                            //# nr of values in levels
+    size_t itsMaxSize;                         //# sum of level capacities
+    std::vector<std::vector<Double>> itsLevels;
+    std::vector<uChar> itsOffset;              //# compaction offset per level
+  };
+
 
   // <summary>
   // Aggregate class determining the sum of complex values in a group
@@ -29,6 +29,7 @@
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
 #include <casacore/casa/Quanta/MVTime.h>
 #include <float.h>                     // for DBL_MAX
 #include <limits.h>                     // for DBL_MAX
@@ -81,10 +82,35 @@ Bool TableExprNodeEQString::getBool (const TableExprId& id)
 TableExprNodeEQRegex::TableExprNodeEQRegex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
 {}
+void TableExprNodeEQRegex::optimize()
+{
+    // Analyze a constant regex only once.
+    if (rnode_p->isConstant()) {
+        regex_p = std::make_shared<TaqlRegex> (rnode_p->getRegex(0));
+    }
+}
 Bool TableExprNodeEQRegex::getBool (const TableExprId& id)
 {
+    if (regex_p) {
+        return regex_p->match (lnode_p->getString(id));
+    }
     return rnode_p->getRegex(id).match (lnode_p->getString(id));
 }
+Array<Bool> TableExprNodeEQRegex::getColumnBool (const Vector<rownr_t>& rownrs)
+{
+    if (! regex_p) {
+        return TableExprNodeBinary::getColumnBool (rownrs);
+    }
+    Array<String> strs (lnode_p->getColumnString (rownrs));
+    Array<Bool> arr (strs.shape());
+    Bool deleteStr, deleteArr;
+    const String* strPtr = strs.getStorage (deleteStr);
+    Bool* arrPtr = arr.getStorage (deleteArr);
+    regex_p->match (strPtr, strs.size(), arrPtr, False);
+    strs.freeStorage (strPtr, deleteStr);
+    arr.putStorage (arrPtr, deleteArr);
+    return arr;
+}
 
 TableExprNodeEQDate::TableExprNodeEQDate (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -138,10 +164,35 @@ Bool TableExprNodeNEString::getBool (const TableExprId& id)
 TableExprNodeNERegex::TableExprNodeNERegex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
 {}
+void TableExprNodeNERegex::optimize()
+{
+    // Analyze a constant regex only once.
+    if (rnode_p->isConstant()) {
+        regex_p = std::make_shared<TaqlRegex> (rnode_p->getRegex(0));
+    }
+}
 Bool TableExprNodeNERegex::getBool (const TableExprId& id)
 {
+    if (regex_p) {
+        return ! regex_p->match (lnode_p->getString(id));
+    }
     return ! rnode_p->getRegex(id).match (lnode_p->getString(id));
 }
+Array<Bool> TableExprNodeNERegex::getColumnBool (const Vector<rownr_t>& rownrs)
+{
+    if (! regex_p) {
+        return TableExprNodeBinary::getColumnBool (rownrs);
+    }
+    Array<String> strs (lnode_p->getColumnString (rownrs));
+    Array<Bool> arr (strs.shape());
+    Bool deleteStr, deleteArr;
+    const String* strPtr = strs.getStorage (deleteStr);
+    Bool* arrPtr = arr.getStorage (deleteArr);
+    regex_p->match (strPtr, strs.size(), arrPtr, True);
+    strs.freeStorage (strPtr, deleteStr);
+    arr.putStorage (arrPtr, deleteArr);
+    return arr;
+}
 
 TableExprNodeNEDate::TableExprNodeNEDate (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -459,6 +510,52 @@ void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 }
 
 
+//# The integer comparisons can create a range in the same way as the
+//# Double ones, because converting an integer to Double preserves the order.
+//# A > comparison is stored as a >= range, which is a superset.
+static void intCompareRange (Block<TableExprRange>& blrange,
+                             const TENShPtr& lnode, const TENShPtr& rnode,
+                             Bool isEqual)
+{
+    Double st = 0;
+    Double end = 0;
+    TENShPtr tsncol = 0;
+    if (lnode->operType()  == TableExprNodeRep::OtColumn
+    &&  lnode->valueType() == TableExprNodeRep::VTScalar
+    &&  rnode->operType()  == TableExprNodeRep::OtLiteral) {
+        tsncol = lnode;
+        st = rnode->getDouble (0);
+        end = (isEqual  ?  st : DBL_MAX);
+    }else{
+        if (rnode->operType()  == TableExprNodeRep::OtColumn
+        &&  rnode->valueType() == TableExprNodeRep::VTScalar
+        &&  lnode->operType()  == TableExprNodeRep::OtLiteral) {
+            tsncol = rnode;
+            end = lnode->getDouble (0);
+            st = (isEqual  ?  end : -DBL_MAX);
+        }
+    }
+    TableExprNodeRep::createRange (blrange,
+                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
+                                   st, end);
+}
+
+void TableExprNodeEQInt::ranges (Block<TableExprRange>& blrange)
+{
+    intCompareRange (blrange, lnode_p, rnode_p, True);
+}
+
+void TableExprNodeGEInt::ranges (Block<TableExprRange>& blrange)
+{
+    intCompareRange (blrange, lnode_p, rnode_p, False);
+}
+
+void TableExprNodeGTInt::ranges (Block<TableExprRange>& blrange)
+{
+    intCompareRange (blrange, lnode_p, rnode_p, False);
+}
+
+
 //# Or two blocks of ranges.
 void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
 {
@@ -526,5 +623,20 @@ void TableExprNodeAND::ranges (Block<TableExprRange>& blrange)
     }
 }
 
+//# And the sampled row intervals.
+Bool TableExprNodeAND::sampleRows
+(rownr_t nrow, std::vector<std::pair<rownr_t,rownr_t>>& intervals) const
+{
+    std::vector<std::pair<rownr_t,rownr_t>> other;
+    Bool left  = lnode_p->sampleRows (nrow, intervals);
+    Bool right = rnode_p->sampleRows (nrow, other);
+    if (left  &&  right) {
+        intervals = ColumnZoneMap::intersect (intervals, other);
+    } else if (right) {
+        intervals.swap (other);
+    }
+    return left || right;
+}
+
 } //# NAMESPACE CASACORE - END
 
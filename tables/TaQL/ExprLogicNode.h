@@ -102,6 +102,7 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -215,6 +216,8 @@ public:
 // This is defined for all data types.
 // Only the Bool get function is defined, because the result of a
 // compare is always a Bool.
+// A constant regex is analyzed only once (in function optimize) instead
+// of for each row. Function getColumnBool matches it on all strings at once.
 // </synopsis> 
 
 class TableExprNodeEQRegex : public TableExprNodeBinary
@@ -222,7 +225,11 @@ class TableExprNodeEQRegex : public TableExprNodeBinary
 public:
     TableExprNodeEQRegex (const TableExprNodeRep&);
     ~TableExprNodeEQRegex() = default;
+    void optimize() override;
     Bool getBool (const TableExprId& id) override;
+    Array<Bool> getColumnBool (const Vector<rownr_t>& rownrs) override;
+private:
+    std::shared_ptr<TaqlRegex> regex_p;
 };
 
 
@@ -426,6 +433,8 @@ public:
 // This is defined for all data types.
 // Only the Bool get function is defined, because the result of a
 // compare is always a Bool.
+// A constant regex is analyzed only once (in function optimize) instead
+// of for each row. Function getColumnBool matches it on all strings at once.
 // </synopsis> 
 
 class TableExprNodeNERegex : public TableExprNodeBinary
@@ -433,7 +442,11 @@ class TableExprNodeNERegex : public TableExprNodeBinary
 public:
     TableExprNodeNERegex (const TableExprNodeRep&);
     ~TableExprNodeNERegex() = default;
+    void optimize() override;
     Bool getBool (const TableExprId& id) override;
+    Array<Bool> getColumnBool (const Vector<rownr_t>& rownrs) override;
+private:
+    std::shared_ptr<TaqlRegex> regex_p;
 };
 
 
@@ -495,6 +508,7 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -647,6 +661,7 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -994,6 +1009,8 @@ public:
     ~TableExprNodeAND() = default;
     Bool getBool (const TableExprId& id) override;
     void ranges (Block<TableExprRange>&) override;
+    Bool sampleRows (rownr_t nrow,
+                     std::vector<std::pair<rownr_t,rownr_t>>&) const override;
 };
 
 
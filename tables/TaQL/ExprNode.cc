@@ -1338,6 +1338,22 @@ TableExprNode TableExprNode::newFunctionNode
         TableExprNodeMulti::checkNumOfArg (0, 0, par);
         return newRandomNode (tabInfo);
     }
+    if (ftype == TableExprFuncNode::sampleFUNC) {
+        TableExprNodeMulti::checkNumOfArg (1, 3, par);
+        for (uInt i=0; i<npar; i++) {
+            if (! par[i]->isConstant()  ||
+                par[i]->valueType() != TableExprNodeRep::VTScalar  ||
+                (par[i]->dataType() != TableExprNodeRep::NTInt  &&
+                 (i > 0  ||  par[i]->dataType() != TableExprNodeRep::NTDouble))) {
+                throw TableInvExpr ("Arguments of function SAMPLE must be "
+                                    "constant numeric scalars (seed and "
+                                    "block size integer)");
+            }
+        }
+        return newSampleNode (tabInfo, par[0]->getDouble(0),
+                              npar > 1 ? par[1]->getInt(0) : 0,
+                              npar > 2 ? par[2]->getInt(0) : 1024);
+    }
     // Check all the operands and get the resulting data type and value type
     // of the function.
     // It also fills the expected data and value type of the operands.
@@ -1507,6 +1523,14 @@ TableExprNode TableExprNode::newRandomNode (const TableExprInfo& tableInfo)
     return TENShPtr(new TableExprNodeRandom (tableInfo));
 }
 
+TableExprNode TableExprNode::newSampleNode (const TableExprInfo& tableInfo,
+                                            Double fraction, Int64 seed,
+                                            rownr_t nrowBlock)
+{
+    return TENShPtr(new TableExprNodeSample (tableInfo, fraction, seed,
+                                             nrowBlock));
+}
+
 DataType TableExprNode::dataType() const
 {
     if (node_p->valueType() == TableExprNodeRep::VTScalar
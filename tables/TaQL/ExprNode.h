@@ -524,6 +524,11 @@ public:
     // Create rand() function node.
     static TableExprNode newRandomNode (const TableExprInfo&);
 
+    // Create sample() function node selecting on average the given fraction
+    // of the blocks of <src>nrowBlock</src> rows.
+    static TableExprNode newSampleNode (const TableExprInfo&, Double fraction,
+                                        Int64 seed=0, rownr_t nrowBlock=1024);
+
     // Create ArrayElement node for the given array with the given index.
     // The origin is 0 for C++ and 1 for TaQL.
     static TableExprNode newArrayPartNode (const TableExprNode& arrayNode,
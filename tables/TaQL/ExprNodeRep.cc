@@ -30,16 +30,127 @@
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprCompiled.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/tables/TaQL/MArray.h>
 #include <casacore/tables/TaQL/MArrayLogical.h>
 #include <casacore/casa/iostream.h>
+#include <cctype>
+#include <cstring>
 
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+TaqlRegex::TaqlRegex (const Regex& regex)
+  : itsRegex (regex),
+    itsGlob  (False)
+{
+  analyze();
+}
+
+void TaqlRegex::analyze()
+{
+  // Split the regex into the literal parts separated by .*
+  // It is a glob if nothing else is found.
+  // The literal prefix is the first part up to the first special character.
+  const String& rx = itsRegex.regexp();
+  if (rx.empty()) {
+    return;
+  }
+  itsParts.assign (1, String());
+  itsGlob = True;
+  Bool prefixDone = False;
+  Bool hasAlternative = False;
+  for (size_t i=0; i<rx.size(); ++i) {
+    Char c = rx[i];
+    Bool literal = False;
+    if (c == '\\') {
+      // An escaped non-alphanumeric character is a literal.
+      if (i+1 < rx.size()  &&  !isalnum(rx[i+1])) {
+        c = rx[++i];
+        literal = True;
+      }
+    } else if (strchr ("^$.*+?()[]{}|", c) == 0) {
+      literal = True;
+    }
+    Bool quantified = (i+1 < rx.size()  &&  strchr ("*+?{", rx[i+1]) != 0);
+    if (literal  &&  !quantified) {
+      itsParts.back().push_back (c);
+      if (!prefixDone) {
+        itsPrefix.push_back (c);
+      }
+    } else if (!literal  &&  c == '.'  &&  i+1 < rx.size()  &&
+               rx[i+1] == '*'  &&
+               (i+2 == rx.size()  ||  strchr ("*+?{", rx[i+2]) == 0)) {
+      itsParts.push_back (String());
+      prefixDone = True;
+      ++i;
+    } else {
+      if (c == '|'  &&  !literal) {
+        hasAlternative = True;
+      }
+      itsGlob = False;
+      prefixDone = True;
+    }
+  }
+  // A prefix cannot be used if alternatives are given.
+  if (hasAlternative) {
+    itsPrefix = String();
+  }
+  if (!itsGlob) {
+    itsParts.clear();
+  }
+}
+
+Bool TaqlRegex::matchGlob (const String& str) const
+{
+  const String& first = itsParts.front();
+  if (itsParts.size() == 1) {
+    return str == first;
+  }
+  const String& last = itsParts.back();
+  if (str.size() < first.size() + last.size()  ||
+      str.compare (0, first.size(), first) != 0  ||
+      str.compare (str.size() - last.size(), last.size(), last) != 0) {
+    return False;
+  }
+  // Find the middle parts in order; the first occurrence is the best one.
+  size_t pos = first.size();
+  size_t end = str.size() - last.size();
+  for (size_t i=1; i<itsParts.size()-1; ++i) {
+    const String& part = itsParts[i];
+    if (! part.empty()) {
+      pos = str.find (part, pos);
+      if (pos == String::npos  ||  pos + part.size() > end) {
+        return False;
+      }
+      pos += part.size();
+    }
+  }
+  return True;
+}
+
+void TaqlRegex::match (const String* strs, size_t nstr, Bool* result,
+                       Bool negate) const
+{
+  if (itsRegex.regexp().empty()) {
+    for (size_t i=0; i<nstr; ++i) {
+      result[i] = (itsDist.match(strs[i]) != negate);
+    }
+  } else if (itsGlob) {
+    for (size_t i=0; i<nstr; ++i) {
+      result[i] = (matchGlob(strs[i]) != negate);
+    }
+  } else {
+    for (size_t i=0; i<nstr; ++i) {
+      result[i] = (matchRegex(strs[i]) != negate);
+    }
+  }
+}
+
+
 TableExprInfo::TableExprInfo (const Table& table, const String& alias,
                               Bool isJoinTable)
   : itsTable       (table),
@@ -62,7 +173,8 @@ TableExprNodeRep::TableExprNodeRep (NodeDataType dtype, ValueType vtype,
   optype_p      (optype),
   argtype_p     (NoArr),
   exprtype_p    (exprtype),
-  ndim_p        (0)
+  ndim_p        (0),
+  compileTried_p(False)
 {}
 
 TableExprNodeRep::TableExprNodeRep (NodeDataType dtype, ValueType vtype,
@@ -75,7 +187,21 @@ TableExprNodeRep::TableExprNodeRep (NodeDataType dtype, ValueType vtype,
   argtype_p     (argtype),
   exprtype_p    (exprtype),
   ndim_p        (ndim),
-  shape_p       (shape)
+  shape_p       (shape),
+  compileTried_p(False)
+{}
+
+TableExprNodeRep::TableExprNodeRep (const TableExprNodeRep& that)
+: dtype_p       (that.dtype_p),
+  vtype_p       (that.vtype_p),
+  optype_p      (that.optype_p),
+  argtype_p     (that.argtype_p),
+  exprtype_p    (that.exprtype_p),
+  ndim_p        (that.ndim_p),
+  shape_p       (that.shape_p),
+  unit_p        (that.unit_p),
+  attributes_p  (that.attributes_p),
+  compileTried_p(False)
 {}
   
 TableExprInfo TableExprNodeRep::getTableInfo() const
@@ -112,6 +238,9 @@ void TableExprNodeRep::applySelection (const Vector<rownr_t>&)
   nodes.push_back (this);
 }
 
+void TableExprNodeRep::getChildNodes (std::vector<TENShPtr*>&)
+{}
+
 void TableExprNodeRep::setUnit (const Unit& unit)
 {
     unit_p = unit;
@@ -160,6 +289,12 @@ void TableExprNodeRep::ranges (Block<TableExprRange>& blrange)
     blrange.resize (0, True);
 }
 
+Bool TableExprNodeRep::sampleRows
+(rownr_t, std::vector<std::pair<rownr_t,rownr_t>>&) const
+{
+    return False;
+}
+
 // Create a range.
 void TableExprNodeRep::createRange (Block<TableExprRange>& blrange)
 {
@@ -446,6 +581,19 @@ Array<Float>    TableExprNodeRep::getColumnFloat
 Array<Double>   TableExprNodeRep::getColumnDouble
 (const Vector<rownr_t>& rownrs)
 {
+    // Use the block-wise compiled evaluation for an arithmetic expression
+    // if worthwhile. The program is compiled once and kept in the node.
+    if (rownrs.size() > 1) {
+      if (! compileTried_p) {
+        compileTried_p = True;
+        if (TableExprCompiled::canCompile (*this)) {
+          compiled_p.reset (new TableExprCompiled (this));
+        }
+      }
+      if (compiled_p) {
+        return compiled_p->getColumnDouble (rownrs);
+      }
+    }
     TableExprId id;
     rownr_t nrrow = rownrs.size();
     Array<Double> arr (IPosition(1,nrrow));
@@ -651,6 +799,16 @@ void TableExprNodeBinary::flattenTree (std::vector<TableExprNodeRep*>& nodes)
   }
 }
 
+void TableExprNodeBinary::getChildNodes (std::vector<TENShPtr*>& nodes)
+{
+  if (lnode_p) {
+    nodes.push_back (&lnode_p);
+  }
+  if (rnode_p) {
+    nodes.push_back (&rnode_p);
+  }
+}
+
 // Check the datatypes and get the common one.
 // For use with operands.
 TableExprNodeRep::NodeDataType TableExprNodeBinary::getDT
@@ -974,6 +1132,15 @@ void TableExprNodeMulti::flattenTree (std::vector<TableExprNodeRep*>& nodes)
   }
 }
 
+void TableExprNodeMulti::getChildNodes (std::vector<TENShPtr*>& nodes)
+{
+  for (uInt j=0; j<operands_p.size(); j++) {
+    if (operands_p[j] != 0) {
+      nodes.push_back (&operands_p[j]);
+    }
+  }
+}
+
 std::shared_ptr<TableExprGroupFuncBase> TableExprNodeRep::makeGroupAggrFunc()
 {
   throw AipsError ("TableExprNodeRep::makeGroupAggrFunc should not be called");
@@ -48,6 +48,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TableExprNode;
 class TableExprNodeColumn;
 class TableExprGroupFuncBase;
+class TableExprCompiled;
 template<class T> class Block;
 
 //# Define a shared pointer to the Rep class.
@@ -74,34 +75,68 @@ typedef std::shared_ptr<TableExprNodeRep> TENShPtr;
 // A StringDistance (Levensthein distance) in TaQL is given in the same way
 // as a Regex. This class is needed to have a single object in the parse tree
 // objects containing them (in class TableExprNodeConstRegex).
+// <br>Matching a regex can be expensive, so the regex is analyzed once
+// when the object is constructed. A regex consisting of literal characters
+// and <src>.*</src> only (as created for simple patterns like
+// <src>'abc*'</src> or SQL patterns like <src>'%abc%'</src>) is matched
+// using plain string operations. For other regexes the literal prefix is
+// used to reject a string quickly before the regex itself is matched.
 // </synopsis> 
 
 class TaqlRegex
 {
 public:
     // Construct from a regex.
-  explicit TaqlRegex (const Regex& regex)
-    : itsRegex(regex)
-  {}
+  explicit TaqlRegex (const Regex& regex);
 
   // Construct from a StringDistance.
   explicit TaqlRegex (const StringDistance& dist)
-    : itsDist(dist)
+    : itsDist (dist),
+      itsGlob (False)
   {}
 
   // Does the regex or maximum string distance match?
   Bool match (const String& str) const
     { return itsRegex.regexp().empty()  ?
-        itsDist.match(str) : str.matches(itsRegex);
+        itsDist.match(str) : (itsGlob ? matchGlob(str) : matchRegex(str));
     }
 
+  // Match all strings in the array and store the result in <src>result</src>.
+  // If <src>negate=True</src>, the negated match result is stored.
+  void match (const String* strs, size_t nstr, Bool* result,
+              Bool negate=False) const;
+
   // Return the regular expression.
   const Regex& regex() const
     { return itsRegex; }
 
+  // Can the regex be matched using plain string operations?
+  Bool isGlob() const
+    { return itsGlob; }
+
+  // Get the literal prefix of the regex.
+  const String& prefix() const
+    { return itsPrefix; }
+
 private:
-  Regex          itsRegex;
-  StringDistance itsDist;
+  // Analyze the regex to find the literal parts.
+  void analyze();
+
+  // Match a regex consisting of literal parts separated by <src>.*</src>.
+  Bool matchGlob (const String& str) const;
+
+  // Match the regex after checking the literal prefix.
+  Bool matchRegex (const String& str) const
+    { return (itsPrefix.empty()  ||
+              str.compare (0, itsPrefix.size(), itsPrefix) == 0)  &&
+        str.matches(itsRegex);
+    }
+
+  Regex               itsRegex;
+  StringDistance      itsDist;
+  Bool                itsGlob;
+  String              itsPrefix;
+  std::vector<String> itsParts;
 };
 
 
@@ -261,7 +296,8 @@ public:
     TableExprNodeRep (NodeDataType, ValueType, OperType, ExprType);
 
     // Copy constructor.
-    TableExprNodeRep (const TableExprNodeRep&) = default;
+    // The compiled program (see getColumnDouble) is not copied.
+    TableExprNodeRep (const TableExprNodeRep&);
 
     // Assign to a TableExprNodeRep cannot be done.
     TableExprNodeRep& operator= (const TableExprNodeRep&) = delete;
@@ -294,6 +330,11 @@ public:
 
     // Flatten the node tree by adding the node and its children to the vector.
     virtual void flattenTree (std::vector<TableExprNodeRep*>&);
+
+    // Add pointers to the (non-null) child nodes to the vector, so a child
+    // can be replaced by an equivalent node (e.g. a shared subexpression).
+    // The default implementation does nothing.
+    virtual void getChildNodes (std::vector<TENShPtr*>&);
   
     // Create the correct immediate aggregate function object.
     // The default implementation throws an exception, because it should
@@ -435,6 +476,15 @@ public:
     // using && or ||.
     virtual void ranges (Block<TableExprRange>&);
 
+    // Get the row intervals (first and last row) a boolean expression
+    // can be true for in a table with the given number of rows, because
+    // it samples the rows using the SAMPLE function (possibly combined
+    // with other conditions using &&).
+    // It returns False if the expression does not limit the rows in this way.
+    // The intervals are ascending and disjoint.
+    virtual Bool sampleRows (rownr_t nrow,
+                             std::vector<std::pair<rownr_t,rownr_t>>&) const;
+
     // Get the data type of the derived TableExprNode object.
     // This is the data type of the resulting value. E.g. a compare
     // of 2 numeric values results in a Bool, thus the data type
@@ -522,6 +572,8 @@ protected:
     IPosition         shape_p;       //# Fixed shape of node values
     Unit              unit_p;        //# Unit of the values
     Record            attributes_p;  //# Possible attributes (for UDFs)
+    Bool              compileTried_p;//# Tried to compile the expression?
+    std::shared_ptr<TableExprCompiled> compiled_p; //# Compiled expression
 
     // Get the shape for the given row.
     virtual const IPosition& getShape (const TableExprId& id);
@@ -593,6 +645,9 @@ public:
 
     // Flatten the node tree by adding the node and its children to the vector.
     void flattenTree (std::vector<TableExprNodeRep*>&) override;
+
+    // Add pointers to the child nodes to the vector.
+    void getChildNodes (std::vector<TENShPtr*>&) override;
   
     // Check the data types and get the common one.
     static NodeDataType getDT (NodeDataType leftDtype,
@@ -692,6 +747,9 @@ public:
 
     // Flatten the node tree by adding the node and its children to the vector.
     void flattenTree (std::vector<TableExprNodeRep*>&) override;
+
+    // Add pointers to the child nodes to the vector.
+    void getChildNodes (std::vector<TENShPtr*>&) override;
   
     // Check number of arguments
     // low <= number_of_args <= high
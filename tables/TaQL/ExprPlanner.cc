@@ -0,0 +1,301 @@
+//# ExprPlanner.cc: Cost-based ordering of the conjuncts of a TaQL WHERE expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ExprPlanner.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprLogicNode.h>
+#include <casacore/tables/TaQL/ExprFuncNode.h>
+#include <casacore/tables/TaQL/ExprFuncNodeArray.h>
+#include <casacore/tables/TaQL/ExprUDFNode.h>
+#include <casacore/tables/TaQL/ExprUDFNodeArray.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  Bool TableExprPlanner::orderConjuncts (TableExprNode& expr, Bool doTracing)
+  {
+    std::vector<TENShPtr> conjuncts;
+    getConjuncts (expr.getRep(), conjuncts);
+    if (conjuncts.size() < 2) {
+      return False;
+    }
+    // Determine the rank of each conjunct that can be moved.
+    // The others keep their order after the movable ones.
+    std::vector<std::pair<Double,uInt>> ranks;
+    std::vector<std::pair<Double,uInt>> fixed;
+    ranks.reserve (conjuncts.size());
+    for (uInt i=0; i<conjuncts.size(); ++i) {
+      if (! canMove (conjuncts[i].get())) {
+        fixed.emplace_back (0., i);
+        if (doTracing) {
+          cerr << "  conjunct " << i << ": not moved" << endl;
+        }
+        continue;
+      }
+      Double sel = selectivity (conjuncts[i].get());
+      Double cst = cost (conjuncts[i].get());
+      ranks.emplace_back (cst / std::max (1. - sel, 1e-3), i);
+      if (doTracing) {
+        cerr << "  conjunct " << i << ": selectivity=" << sel
+             << " cost=" << cst << endl;
+      }
+    }
+    std::stable_sort (ranks.begin(), ranks.end(),
+                      [](const std::pair<Double,uInt>& r1,
+                         const std::pair<Double,uInt>& r2)
+                      { return r1.first < r2.first; });
+    ranks.insert (ranks.end(), fixed.begin(), fixed.end());
+    Bool changed = False;
+    for (uInt i=0; i<ranks.size(); ++i) {
+      if (ranks[i].second != i) {
+        changed = True;
+        break;
+      }
+    }
+    if (changed) {
+      TableExprNode result (conjuncts[ranks[0].second]);
+      for (uInt i=1; i<ranks.size(); ++i) {
+        result = result && TableExprNode(conjuncts[ranks[i].second]);
+      }
+      expr = result;
+      if (doTracing) {
+        cerr << "WHERE conjuncts reordered as";
+        for (const auto& r : ranks) {
+          cerr << ' ' << r.second;
+        }
+        cerr << endl;
+      }
+    }
+    return changed;
+  }
+
+  void TableExprPlanner::getConjuncts (const TENShPtr& node,
+                                       std::vector<TENShPtr>& conjuncts)
+  {
+    const TableExprNodeAND* andNode =
+      dynamic_cast<const TableExprNodeAND*>(node.get());
+    if (andNode) {
+      getConjuncts (andNode->getLeftChild(), conjuncts);
+      getConjuncts (andNode->getRightChild(), conjuncts);
+    } else {
+      conjuncts.push_back (node);
+    }
+  }
+
+  Bool TableExprPlanner::canMove (TableExprNodeRep* node)
+  {
+    if (node->valueType() != TableExprNodeRep::VTScalar) {
+      return False;
+    }
+    if (node->isConstant()) {
+      return True;
+    }
+    TableExprNodeBinary* bnode = dynamic_cast<TableExprNodeBinary*>(node);
+    if (!bnode  ||  !bnode->getLeftChild()) {
+      return False;
+    }
+    TableExprNodeRep* left  = bnode->getLeftChild().get();
+    TableExprNodeRep* right = bnode->getRightChild().get();
+    switch (node->operType()) {
+    case TableExprNodeRep::OtAND:
+    case TableExprNodeRep::OtOR:
+      return right  &&  canMove(left)  &&  canMove(right);
+    case TableExprNodeRep::OtNOT:
+      return canMove (left);
+    case TableExprNodeRep::OtEQ:
+    case TableExprNodeRep::OtNE:
+    case TableExprNodeRep::OtGT:
+    case TableExprNodeRep::OtGE:
+      if (!right) {
+        return False;
+      }
+      if (! dynamic_cast<TableExprNodeColumn*>(left)) {
+        std::swap (left, right);
+      }
+      return dynamic_cast<TableExprNodeColumn*>(left)  &&
+        right->isConstant()  &&
+        right->valueType() == TableExprNodeRep::VTScalar;
+    default:
+      break;
+    }
+    return False;
+  }
+
+  Double TableExprPlanner::selectivity (TableExprNodeRep* node)
+  {
+    if (node->isConstant()  &&  node->valueType() == TableExprNodeRep::VTScalar
+        &&  node->dataType() == TableExprNodeRep::NTBool) {
+      return (node->getBool(TableExprId(0))  ?  1. : 0.);
+    }
+    TableExprNodeBinary* bnode = dynamic_cast<TableExprNodeBinary*>(node);
+    if (bnode  &&  node->valueType() == TableExprNodeRep::VTScalar) {
+      switch (node->operType()) {
+      case TableExprNodeRep::OtAND:
+        return selectivity (bnode->getLeftChild().get()) *
+               selectivity (bnode->getRightChild().get());
+      case TableExprNodeRep::OtOR:
+        {
+          Double s1 = selectivity (bnode->getLeftChild().get());
+          Double s2 = selectivity (bnode->getRightChild().get());
+          return s1 + s2 - s1*s2;
+        }
+      case TableExprNodeRep::OtNOT:
+        return 1. - selectivity (bnode->getLeftChild().get());
+      default:
+        break;
+      }
+    }
+    Double sel = compareSelectivity (node);
+    if (sel >= 0) {
+      return sel;
+    }
+    switch (node->operType()) {
+    case TableExprNodeRep::OtEQ:
+      return 0.1;
+    case TableExprNodeRep::OtNE:
+      return 0.9;
+    case TableExprNodeRep::OtGT:
+    case TableExprNodeRep::OtGE:
+      return 0.33;
+    case TableExprNodeRep::OtIN:
+      return 0.2;
+    default:
+      break;
+    }
+    return 0.5;
+  }
+
+  Double TableExprPlanner::compareSelectivity (TableExprNodeRep* node)
+  {
+    TableExprNodeRep::OperType oper = node->operType();
+    if (oper != TableExprNodeRep::OtEQ  &&  oper != TableExprNodeRep::OtNE  &&
+        oper != TableExprNodeRep::OtGT  &&  oper != TableExprNodeRep::OtGE) {
+      return -1;
+    }
+    TableExprNodeBinary* bnode = dynamic_cast<TableExprNodeBinary*>(node);
+    if (!bnode  ||  node->valueType() != TableExprNodeRep::VTScalar
+        ||  !bnode->getLeftChild()  ||  !bnode->getRightChild()) {
+      return -1;
+    }
+    // Find out which side is the column; the other side must be a constant.
+    TableExprNodeRep* colNode = bnode->getLeftChild().get();
+    TableExprNodeRep* constNode = bnode->getRightChild().get();
+    Bool colLeft = True;
+    if (! dynamic_cast<TableExprNodeColumn*>(colNode)) {
+      std::swap (colNode, constNode);
+      colLeft = False;
+    }
+    if (! dynamic_cast<TableExprNodeColumn*>(colNode)  ||
+        ! constNode->isConstant()  ||
+        constNode->valueType() != TableExprNodeRep::VTScalar) {
+      return -1;
+    }
+    const ColumnStatistics& stats = getStatistics (colNode);
+    if (! stats.isValid()) {
+      return -1;
+    }
+    Bool numeric = (constNode->dataType() == TableExprNodeRep::NTInt  ||
+                    constNode->dataType() == TableExprNodeRep::NTDouble);
+    Double value = 0;
+    if (numeric  &&  stats.isNumeric()) {
+      value = constNode->getDouble (TableExprId(0));
+    } else if (oper != TableExprNodeRep::OtEQ  &&
+               oper != TableExprNodeRep::OtNE) {
+      return -1;
+    }
+    Double feq = (stats.isNumeric()  ?
+                  stats.fractionEqual(value) : stats.fractionEqual());
+    switch (oper) {
+    case TableExprNodeRep::OtEQ:
+      return feq;
+    case TableExprNodeRep::OtNE:
+      return 1. - feq;
+    default:
+      break;
+    }
+    // A less-than is expressed as a greater-than with swapped operands.
+    Double frac = (colLeft  ?
+                   stats.fractionInRange (value, stats.maximum()) :
+                   stats.fractionInRange (stats.minimum(), value));
+    // The range includes the value itself.
+    if (oper == TableExprNodeRep::OtGT) {
+      frac -= feq;
+    }
+    return std::min (1., std::max (0., frac));
+  }
+
+  const ColumnStatistics& TableExprPlanner::getStatistics
+  (TableExprNodeRep* colNode)
+  {
+    auto iter = itsStats.find (colNode);
+    if (iter == itsStats.end()) {
+      const TableExprNodeColumn* col =
+        static_cast<const TableExprNodeColumn*>(colNode);
+      ColumnStatistics stats;
+      const Table& table = col->getTableInfo().table();
+      if (! table.isNull()) {
+        stats = ColumnStatistics::get
+          (table, col->getColumn().columnDesc().name());
+      }
+      iter = itsStats.insert (std::make_pair(colNode, stats)).first;
+    }
+    return iter->second;
+  }
+
+  Double TableExprPlanner::cost (TableExprNodeRep* node)
+  {
+    if (node->isConstant()) {
+      return 0;
+    }
+    Double cst = 1;
+    if (dynamic_cast<TableExprUDFNode*>(node)  ||
+        dynamic_cast<TableExprUDFNodeArray*>(node)) {
+      cst = 100;
+    } else if (dynamic_cast<TableExprNodeEQRegex*>(node)  ||
+               dynamic_cast<TableExprNodeNERegex*>(node)) {
+      cst = 5;
+    } else if (dynamic_cast<TableExprFuncNode*>(node)  ||
+               dynamic_cast<TableExprFuncNodeArray*>(node)) {
+      cst = 2;
+    } else if (node->operType() == TableExprNodeRep::OtColumn  &&
+               node->valueType() == TableExprNodeRep::VTArray) {
+      cst = 10;
+    }
+    std::vector<TENShPtr*> children;
+    node->getChildNodes (children);
+    for (TENShPtr* child : children) {
+      if (*child) {
+        cst += cost (child->get());
+      }
+    }
+    return cst;
+  }
+
+
+} //# NAMESPACE CASACORE - END
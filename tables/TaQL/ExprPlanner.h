@@ -0,0 +1,138 @@
+//# ExprPlanner.h: Cost-based ordering of the conjuncts of a TaQL WHERE expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_EXPRPLANNER_H
+#define TABLES_EXPRPLANNER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/TaQL/ColumnStatistics.h>
+#include <map>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class TableExprNode;
+
+
+  // <summary>
+  // Cost-based ordering of the conjuncts of a TaQL WHERE expression
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tColumnStatistics">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableExprNodeRep
+  //  <li> ColumnStatistics
+  // </prerequisite>
+
+  // <synopsis>
+  // The AND operator in TaQL does not evaluate its right operand if the
+  // left operand is false. Thus the order in which the user typed the
+  // conjuncts of a WHERE expression determines how often each of them is
+  // evaluated. Putting an expensive conjunct (e.g. a MSCAL function
+  // calculating the hour angle) first means it is evaluated for every row,
+  // even if a cheap conjunct would have rejected most rows.
+  // <br>TableExprPlanner reorders the conjuncts such that the ones with the
+  // lowest cost per rejected row are evaluated first. The rank of a
+  // conjunct is its cost divided by the fraction of rows it rejects.
+  // <ul>
+  //  <li> The cost is a rough estimate of the evaluation time per row.
+  //       A user defined function is deemed much more expensive than a
+  //       builtin function, which is more expensive than an operator.
+  //  <li> The selectivity (the fraction of rows passing) of comparisons
+  //       of a scalar column with a constant is estimated from the
+  //       column statistics saved by class ColumnStatistics. If not
+  //       available, a fixed guess depending on the operator is used.
+  // </ul>
+  // Because the AND operator does not evaluate its right operand if the
+  // left one is false, a conjunct can act as a guard for the next ones
+  // (e.g. <src>isdefined(DATA) && sum(DATA)>0</src>). Therefore only
+  // conjuncts that cannot throw an exception are reordered. These are the
+  // comparisons of a scalar column with a constant (possibly combined
+  // with OR and NOT). They are ordered in ascending rank and put in front
+  // of the other conjuncts, which keep the order given by the user.
+  // <br>Conjuncts with the same rank keep their order. Because the
+  // statistics are only used to order the conjuncts, outdated statistics
+  // cannot change the result of a query.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   TableExprNode expr = (udf(tab.col("TIME")) > 0) && (tab.col("ANTENNA1") == 3);
+  //   TableExprPlanner planner;
+  //   planner.orderConjuncts (expr);    // ANTENNA1==3 is evaluated first
+  // </srcblock>
+  // </example>
+
+  class TableExprPlanner
+  {
+  public:
+    TableExprPlanner() = default;
+
+    // Reorder the conjuncts of the given expression that cannot throw
+    // in ascending rank and put them in front of the other conjuncts.
+    // It returns True if the order has been changed.
+    // If tracing is on, the selectivity and cost of the conjuncts is shown.
+    Bool orderConjuncts (TableExprNode& expr, Bool doTracing=False);
+
+    // Estimate the fraction of rows for which a boolean expression is true.
+    Double selectivity (TableExprNodeRep* node);
+
+    // Estimate the cost of evaluating an expression for a row.
+    static Double cost (TableExprNodeRep* node);
+
+  private:
+    // Add the conjuncts of an AND-chain to the vector.
+    static void getConjuncts (const TENShPtr& node,
+                              std::vector<TENShPtr>& conjuncts);
+
+    // Can the conjunct be moved? This is only the case if it cannot throw
+    // an exception, thus for (ORs and NOTs of) comparisons of a scalar
+    // column with a scalar constant.
+    static Bool canMove (TableExprNodeRep* node);
+
+    // Estimate the selectivity of a comparison of a column with a
+    // scalar constant. It returns a negative value if no statistics
+    // are available.
+    Double compareSelectivity (TableExprNodeRep* node);
+
+    // Get the statistics of a column (which are cached).
+    const ColumnStatistics& getStatistics (TableExprNodeRep* colNode);
+
+    std::map<const TableExprNodeRep*,ColumnStatistics> itsStats;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -27,6 +27,7 @@
 #include <casacore/tables/TaQL/ExprUDFNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
   
@@ -67,6 +68,42 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   std::shared_ptr<TableExprGroupFuncBase> TableExprUDFNode::makeGroupAggrFunc()
     { return std::make_shared<TableExprGroupNull>(this); }
 
+  Array<Bool> TableExprUDFNode::getColumnBool (const Vector<rownr_t>& rownrs)
+  {
+    if (! hasBatch()) {
+      return TableExprNodeMulti::getColumnBool (rownrs);
+    }
+    Array<Bool> arr (IPosition(1, rownrs.size()));
+    itsUDF->getBoolBatch (rownrs, arr.data());
+    return arr;
+  }
+
+  Array<Int64> TableExprUDFNode::getColumnInt64 (const Vector<rownr_t>& rownrs)
+  {
+    if (! hasBatch()) {
+      return TableExprNodeMulti::getColumnInt64 (rownrs);
+    }
+    Array<Int64> arr (IPosition(1, rownrs.size()));
+    itsUDF->getIntBatch (rownrs, arr.data());
+    return arr;
+  }
+
+  Array<Double> TableExprUDFNode::getColumnDouble (const Vector<rownr_t>& rownrs)
+  {
+    if (! hasBatch()) {
+      return TableExprNodeMulti::getColumnDouble (rownrs);
+    }
+    Array<Double> arr (IPosition(1, rownrs.size()));
+    if (dataType() == NTInt) {
+      Vector<Int64> ivals (rownrs.size());
+      itsUDF->getIntBatch (rownrs, ivals.data());
+      convertArray (arr, ivals);
+    } else {
+      itsUDF->getDoubleBatch (rownrs, arr.data());
+    }
+    return arr;
+  }
+
   Bool      TableExprUDFNode::getBool     (const TableExprId& id)
     { return itsUDF->getBool (id); }
   Int64     TableExprUDFNode::getInt      (const TableExprId& id)
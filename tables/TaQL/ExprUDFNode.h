@@ -114,6 +114,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     MVTime    getDate     (const TableExprId& id) override;
     // </group>
 
+    // Tell if the UDF can be evaluated for a block of rows at a time.
+    // Aggregate UDFs are always evaluated per group.
+    Bool hasBatch() const
+      { return itsUDF->hasBatch()  &&  !itsUDF->isAggregate(); }
+
+    // Get the function results for the given rows.
+    // The batch functions of the UDF are used if available.
+    // <group>
+    Array<Bool>   getColumnBool   (const Vector<rownr_t>& rownrs) override;
+    Array<Int64>  getColumnInt64  (const Vector<rownr_t>& rownrs) override;
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs) override;
+    // </group>
+
   private:
     TableExprInfo            itsTableInfo;
     std::shared_ptr<UDFBase> itsUDF;
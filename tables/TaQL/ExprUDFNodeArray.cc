@@ -72,6 +72,20 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return itsUDF->getArrayInt (id); }
   MArray<Double>   TableExprUDFNodeArray::getArrayDouble  (const TableExprId& id)
     { return itsUDF->getArrayDouble (id); }
+
+  void TableExprUDFNodeArray::getArrayDoubleBatch
+  (const Vector<rownr_t>& rownrs, MArray<Double>* result)
+  {
+    if (dataType() == NTDouble  &&  hasBatch()) {
+      itsUDF->getArrayDoubleBatch (rownrs, result);
+    } else {
+      TableExprId id;
+      for (rownr_t i=0; i<rownrs.size(); ++i) {
+        id.setRownr (rownrs[i]);
+        result[i].reference (getArrayDouble (id));
+      }
+    }
+  }
   MArray<DComplex> TableExprUDFNodeArray::getArrayDComplex(const TableExprId& id)
     { return itsUDF->getArrayDComplex (id); }
   MArray<String>   TableExprUDFNodeArray::getArrayString  (const TableExprId& id)
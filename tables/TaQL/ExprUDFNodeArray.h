@@ -107,6 +107,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     MArray<MVTime>   getArrayDate     (const TableExprId& id) override;
     // </group>
 
+    // Tell if the UDF can be evaluated for a block of rows at a time.
+    // Aggregate UDFs are always evaluated per group.
+    Bool hasBatch() const
+      { return itsUDF->hasBatch()  &&  !itsUDF->isAggregate(); }
+
+    // Get the function results for the given rows using the batch
+    // function of the UDF (if available).
+    void getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                              MArray<Double>* result);
+
   private:
     TableExprInfo            itsTableInfo;
     std::shared_ptr<UDFBase> itsUDF;
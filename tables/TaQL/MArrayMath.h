@@ -36,6 +36,8 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Containers/Block.h>
+#include <exception>
+#include <vector>
 
 namespace casacore {
 
@@ -191,6 +193,13 @@ namespace casacore {
     partialArrayMath (res, a, collapseAxes, funcObj);
     return res;
   }
+
+  // The reduction is done in parallel (if OpenMP is used) for the parts
+  // of the array. To be thread-safe, the array is not sliced. Instead the
+  // unmasked values of a part are gathered in a contiguous buffer per
+  // thread using precalculated offsets. The functor is called with
+  // the gathered values as a 1-dim array without mask. This also makes it
+  // possible for the compiler to vectorize reductions like sum and max.
   template<typename T, typename RES>
   void partialArrayMath (MArray<RES>& res,
                          const MArray<T>& a,
@@ -198,47 +207,102 @@ namespace casacore {
                          const MArrayFunctorBase<T,RES>& funcObj)
   {
     AlwaysAssert (a.hasMask(), AipsError);
-    // This can also be done as boxedArrayMath with a removeDegenerate thereafter.
-    //
-    // It should be possible to parallelize this loop.
-    // Determine nr of iteration steps and iterate over that as an int.
-    // Do not use Array slicing, because that is not thread-safe.
-    // Instead create ArraySTLIterator directly from Array and blc,trc,
-    // so funcObj should accept iterators instead of Array.
-    // However, ArraySTLIterator needs the sliced array, not original.
-    // Maybe keep ref of itsSteps in iterator instead of array.
-    // Hmm, tricky for median and fractile.
-    // Better to make Array copy ctor thread-safe (thus use boost shared_ptr).
-    ReadOnlyArrayIterator<T>    aiter(a.array(), collapseAxes);
-    ReadOnlyArrayIterator<Bool> miter(a.mask(),  collapseAxes);
-    IPosition shape(a.array().shape().removeAxes (collapseAxes));
-    /*
-    Int64 nr = 1;
+    // Make sure the data are contiguous, so offsets can be used.
+    Array<T> arr (a.array());
+    if (! arr.contiguousStorage()) {
+      arr.reference (a.array().copy());
+    }
+    Array<Bool> marr (a.mask());
+    if (! marr.contiguousStorage()) {
+      marr.reference (a.mask().copy());
+    }
+    const IPosition& shape = arr.shape();
+    uInt ndim = shape.size();
+    // Determine the offsets of the elements in a part, where the first
+    // axis varies fastest (as in ArrayIterator).
+    // Also determine the shape and strides of the non-collapsed axes.
+    std::vector<Bool> isCollapsed (ndim, False);
     for (uInt i=0; i<collapseAxes.size(); ++i) {
-      nr *= a.array().shape()[collapseAxes[i]];
+      isCollapsed[collapseAxes[i]] = True;
     }
-    ///#pragma omp parallel
-    for (Int64 i=0; i<nr; ++i) {
-      IPosition pos = findPos(i);
-      IPosition endPos = pos + cursorShape - 1;
-      *data[pos] = funcObj(MArray<T>(a.array()(pos,endPos), a.mask()(pos,endpos)));
+    std::vector<size_t> partOffsets (1, 0);
+    std::vector<size_t> resStrides;
+    IPosition resShape;
+    size_t stride = 1;
+    for (uInt ax=0; ax<ndim; ++ax) {
+      if (isCollapsed[ax]) {
+        size_t nold = partOffsets.size();
+        partOffsets.resize (nold * shape[ax]);
+        for (Int64 v=1; v<shape[ax]; ++v) {
+          for (size_t j=0; j<nold; ++j) {
+            partOffsets[v*nold + j] = partOffsets[j] + v*stride;
+          }
+        }
+      } else {
+        resShape.append (IPosition(1, shape[ax]));
+        resStrides.push_back (stride);
+      }
+      stride *= shape[ax];
+    }
+    // Collapsing all axes results in a single value (as in ArrayPartMath).
+    if (resShape.empty()) {
+      resShape = IPosition(1, 1);
+      resStrides.push_back (0);
     }
-    */
-    ///IPosition shape(a.array().shape().removeAxes (collapseAxes));
-    res.resize (shape, False);
-    Array<Bool> resMask(shape);
+    res.resize (resShape, False);
+    Array<Bool> resMask(resShape);
     RES* data = res.array().data();
     Bool* mask = resMask.data();
-    while (!aiter.pastEnd()) {
-      if (allTrue(miter.array())) {
-        *mask++ = True;
-        *data++ = RES();
-      } else {
-        *mask++ = False;
-        *data++ = funcObj(MArray<T> (aiter.array(), miter.array()));
+    const T* adata = arr.data();
+    const Bool* mdata = marr.data();
+    Int64 nparts = resShape.product();
+    size_t npartElem = partOffsets.size();
+    uInt nresdim = resShape.size();
+    std::exception_ptr excp;
+#ifdef _OPENMP
+#pragma omp parallel if (nparts > 1  &&  nparts*npartElem > 65536)
+#endif
+    {
+      // Each thread uses its own buffer.
+      Block<T> buf (npartElem);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (Int64 i=0; i<nparts; ++i) {
+        // Determine the offset of the first element of the part.
+        size_t start = 0;
+        Int64 inx = i;
+        for (uInt j=0; j<nresdim; ++j) {
+          start += (inx % resShape[j]) * resStrides[j];
+          inx /= resShape[j];
+        }
+        // Gather the unmasked values (mask True means masked off).
+        size_t n = 0;
+        for (size_t j=0; j<npartElem; ++j) {
+          size_t off = start + partOffsets[j];
+          if (! mdata[off]) {
+            buf[n++] = adata[off];
+          }
+        }
+        if (n == 0) {
+          mask[i] = True;
+          data[i] = RES();
+        } else {
+          mask[i] = False;
+          try {
+            Array<T> vals (IPosition(1, n), buf.storage(), SHARE);
+            data[i] = funcObj (MArray<T>(vals));
+          } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical (partialArrayMath)
+#endif
+            excp = std::current_exception();
+          }
+        }
       }
-      aiter.next();
-      miter.next();
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
     }
     res.setMask (resMask);
   }
@@ -440,9 +440,11 @@ TableExprNode RecordGram::handleField (const String& name)
 TableExprNode RecordGram::handleFunc (const String& name,
                                       const TableExprNodeSet& arguments)
 {
-  // The ROWNR function can only be used with tables.
+  // The ROWNR and SAMPLE functions can only be used with tables.
   if (theirTabPtr == 0) {
-    Vector<Int> ignoreFuncs (1, TableExprFuncNode::rownrFUNC);
+    Vector<Int> ignoreFuncs (2);
+    ignoreFuncs[0] = TableExprFuncNode::rownrFUNC;
+    ignoreFuncs[1] = TableExprFuncNode::sampleFUNC;
     return TableParseFunc::makeFuncNode (0, name, arguments,
                                           ignoreFuncs, TableExprInfo(),
                                           theirTaQLStyle);
@@ -0,0 +1,127 @@
+//# TaQLCursor.cc: Iterate in blocks of rows through the result of a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLCursor.h>
+#include <casacore/tables/TaQL/TaQLNode.h>
+#include <casacore/tables/TaQL/TaQLNodeHandler.h>
+#include <casacore/tables/TaQL/TableParseQuery.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/OS/Timer.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  TaQLCursor::TaQLCursor (const String& command, rownr_t blockSize)
+    : itsCommand   (command),
+      itsNrow      (0),
+      itsBlockSize (blockSize),
+      itsStart     (0),
+      itsNext      (0)
+  {
+    execute (std::vector<const Table*>());
+  }
+
+  TaQLCursor::TaQLCursor (const String& command,
+                          const std::vector<const Table*>& tempTables,
+                          rownr_t blockSize)
+    : itsCommand   (command),
+      itsNrow      (0),
+      itsBlockSize (blockSize),
+      itsStart     (0),
+      itsNext      (0)
+  {
+    execute (tempTables);
+  }
+
+  TaQLCursor::~TaQLCursor()
+  {}
+
+  void TaQLCursor::execute (const std::vector<const Table*>& tempTables)
+  {
+    if (itsBlockSize == 0) {
+      itsBlockSize = 1024;
+    }
+    // Parse and execute the command like tableCommand does, but ask
+    // to defer the projection of an outer SELECT.
+    Timer timer;
+    TaQLNode tree = TaQLNode::parse (itsCommand);
+    try {
+      TaQLNodeHandler treeHandler;
+      treeHandler.setCursorMode();
+      TaQLNodeResult res = treeHandler.handleTree (tree, tempTables);
+      const TaQLNodeHRValue& hrval = TaQLNodeHandler::getHR(res);
+      if (tree.style().doTiming()) {
+        timer.show (" Total time   ");
+      }
+      if (! hrval.getExpr().isNull()) {
+        throw TableInvExpr ("TaQLCursor cannot be used for a CALC command");
+      }
+      itsType  = hrval.getString();
+      itsNames.reference (hrval.getNames());
+      itsQuery = hrval.getQuery();
+      if (itsQuery) {
+        itsNrow = itsQuery->cursorNrow();
+      } else {
+        itsResult = hrval.getTable();
+        itsNrow   = itsResult.nrow();
+      }
+    } catch (std::exception& x) {
+      throw TableParseError ("'" + itsCommand + "'\n  " + x.what());
+    }
+  }
+
+  Bool TaQLCursor::next()
+  {
+    if (itsNext >= itsNrow) {
+      itsBlock = Table();
+      return False;
+    }
+    itsStart = itsNext;
+    rownr_t n = std::min (itsBlockSize, itsNrow - itsStart);
+    itsNext += n;
+    if (itsQuery) {
+      try {
+        itsBlock = itsQuery->projectBlock (itsStart, n);
+      } catch (std::exception& x) {
+        throw TableParseError ("'" + itsCommand + "'\n  " + x.what());
+      }
+    } else {
+      Vector<rownr_t> rownrs(n);
+      indgen (rownrs, itsStart);
+      itsBlock = itsResult(rownrs);
+    }
+    return True;
+  }
+
+  void TaQLCursor::reset()
+  {
+    itsStart = 0;
+    itsNext  = 0;
+    itsBlock = Table();
+  }
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,172 @@
+//# TaQLCursor.h: Iterate in blocks of rows through the result of a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TAQLCURSOR_H
+#define TABLES_TAQLCURSOR_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <memory>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  //# Forward Declarations
+  class TableParseQuery;
+
+
+  // <summary>
+  // Iterate in blocks of rows through the result of a TaQL query
+  // </summary>
+
+  // <use visibility=export>
+
+  // <reviewed reviewer="" date="" tests="tTaQLCursor">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> <linkto file="TableParse.h#tableCommand">tableCommand</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // A TaQLCursor executes a TaQL command and gives its result in blocks
+  // of (by default 1024) rows. Each block is a table containing the
+  // selected columns of the result rows in the block.
+  // <br>For a SELECT command with expressions in the column list, the
+  // selection, grouping and sorting are done as usual, but the expressions
+  // are not evaluated for all result rows at once. Instead, they are
+  // evaluated for the rows of a block only when the block is asked for.
+  // In this way the first rows are available immediately and the memory
+  // used is bounded by the block size instead of the size of the entire
+  // result.
+  // <br>The evaluation cannot be deferred if DISTINCT or GIVING is used,
+  // or if an expression in the column list is used in ORDERBY or HAVING.
+  // In such a case (and for other commands) the command is executed as
+  // with <src>tableCommand</src> and the blocks reference the rows in
+  // its result table.
+  // <br>Note that the tables used in the query must not be changed while
+  // iterating, because the expressions are evaluated when a block is made.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   TaQLCursor cursor ("select TIME, sqrt(sumsqr(UVW[:2])) as UVDIST"
+  //                      " from my.ms where ANTENNA1 != ANTENNA2");
+  //   while (cursor.next()) {
+  //     ScalarColumn<Double> uvdist (cursor.block(), "UVDIST");
+  //     Vector<Double> values = uvdist.getColumn();
+  //     ...
+  //   }
+  // </srcblock>
+  // </example>
+
+  // <motivation>
+  // Materializing the result of a query on a large MeasurementSet can
+  // require a lot of memory, while the consumer only needs a part of it
+  // at a time.
+  // </motivation>
+
+  class TaQLCursor
+  {
+  public:
+    // Execute the command (which can refer to the given temporary tables
+    // as $1, $2, etc.).
+    // An exception is thrown if the command is invalid or if it is a
+    // CALC command (which does not result in a table).
+    // <group>
+    explicit TaQLCursor (const String& command, rownr_t blockSize=1024);
+    TaQLCursor (const String& command,
+                const std::vector<const Table*>& tempTables,
+                rownr_t blockSize=1024);
+    // </group>
+
+    ~TaQLCursor();
+
+    // Get the type of the command (e.g., select).
+    const String& commandType() const
+      { return itsType; }
+
+    // Get the number of rows in the result.
+    rownr_t nrow() const
+      { return itsNrow; }
+
+    // Get the names of the selected columns.
+    // It is empty if no columns were given in the command.
+    const Vector<String>& columnNames() const
+      { return itsNames; }
+
+    // Tell if the expressions in the column list are evaluated per block.
+    Bool isLazy() const
+      { return itsQuery != nullptr; }
+
+    // Get the (maximum) number of rows in a block.
+    rownr_t blockSize() const
+      { return itsBlockSize; }
+
+    // Make the next block. It returns False if there are no more rows.
+    Bool next();
+
+    // Get the current block of rows.
+    const Table& block() const
+      { return itsBlock; }
+
+    // Get the index of the first row of the current block in the result.
+    rownr_t blockStart() const
+      { return itsStart; }
+
+    // Restart the iteration at the first row.
+    void reset();
+
+  private:
+    // Copying is not possible.
+    // <group>
+    TaQLCursor (const TaQLCursor&);
+    TaQLCursor& operator= (const TaQLCursor&);
+    // </group>
+
+    // Execute the command.
+    void execute (const std::vector<const Table*>& tempTables);
+
+    String         itsCommand;
+    String         itsType;
+    std::shared_ptr<TableParseQuery> itsQuery;   //# query for lazy projection
+    Table          itsResult;                    //# result if not lazy
+    Vector<String> itsNames;
+    rownr_t        itsNrow;
+    rownr_t        itsBlockSize;
+    rownr_t        itsStart;
+    rownr_t        itsNext;
+    Table          itsBlock;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -597,12 +597,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TaQLNodeResult res(hrval);
     if (! node.getNoExecute()) {
       if (outer) {
+        if (itsCursor) {
+          curSel->setCursor();
+        }
         curSel->execute (node.style().doTiming(), False, False, 0,
-                         node.style().doTracing(), itsTempTables, itsStack);
+                         node.style().doTracing(), itsTempTables, itsStack,
+                         node.style().doProfiling());
         hrval->setTable (curSel->getTable());
         Block<String> block = curSel->getColumnNames();
         hrval->setNames (Vector<String>(block.begin(), block.end()));
         hrval->setString ("select");
+        if (curSel->isCursor()) {
+          // The projection is deferred, so the result takes over the query.
+          hrval->setQuery (std::shared_ptr<TableParseQuery>(curSel));
+          itsStack.pop_back();
+          return res;
+        }
       } else {
         if (node.getFromExecute()) {
           hrval->setTable (curSel->doFromQuery(node.style().doTiming()));
@@ -35,6 +35,7 @@
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Containers/ValueHolder.h>
+#include <memory>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -93,6 +94,10 @@ class TaQLNodeHRValue;
 class TaQLNodeHandler : public TaQLNodeVisitor
 {
 public:
+  TaQLNodeHandler()
+    : itsCursor (False)
+  {}
+
   virtual ~TaQLNodeHandler();
 
   // Handle and process the raw parse tree.
@@ -100,6 +105,13 @@ public:
   TaQLNodeResult handleTree (const TaQLNode& tree,
                              const std::vector<const Table*>&);
 
+  // Tell that the outer SELECT command has to be executed in cursor mode.
+  // If possible, the projection is not done, but the query object is
+  // returned in the result, so a TaQLCursor can do the projection
+  // in blocks of rows.
+  void setCursorMode()
+    { itsCursor = True; }
+
   // Define the functions to visit each node type.
   // <group>
   virtual TaQLNodeResult visitConstNode    (const TaQLConstNodeRep& node);
@@ -207,6 +219,8 @@ private:
   std::vector<TableParseQuery*> itsStack;
   //# The temporary tables referred to by $i in the TaQL string.
   std::vector<const Table*> itsTempTables;
+  //# Execute the outer SELECT in cursor mode?
+  Bool itsCursor;
 };
 
 
@@ -276,6 +290,8 @@ public:
     { return *itsSet; }
   const Vector<String>& getNames() const
     { return itsNames; }
+  const std::shared_ptr<TableParseQuery>& getQuery() const
+    { return itsQuery; }
   // </group>
 
   // Set the values.
@@ -305,6 +321,8 @@ public:
     { itsSet = set; }
   void setNames (const Vector<String>& names)
     { itsNames = names; }
+  void setQuery (const std::shared_ptr<TableParseQuery>& query)
+    { itsQuery = query; }
   // </group>
 
 private:
@@ -320,6 +338,7 @@ private:
   TableExprNodeSetElem* itsElem;      //# is counted in itsExpr
   TableExprNodeSet*     itsSet;       //# is counted in itsExpr
   Vector<String>        itsNames;
+  std::shared_ptr<TableParseQuery> itsQuery;  //# query of a cursor
 };
 
 
@@ -0,0 +1,179 @@
+//# TaQLProfile.cc: Collect per-step execution statistics of a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLProfile.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/OS/Memory.h>
+#include <casacore/casa/iostream.h>
+#include <iomanip>
+#include <sstream>
+#include <set>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  TaQLProfile::TaQLProfile (const Table& table)
+    : itsMemStart (0),
+      itsMemPeak  (0)
+  {
+    // Find the unique data managers used by the columns.
+    // Columns for which no data manager can be found (e.g. in a
+    // concatenated table) are ignored.
+    if (! table.isNull()) {
+      std::set<uInt> seqnrs;
+      Vector<String> colNames (table.tableDesc().columnNames());
+      for (const String& name : colNames) {
+        try {
+          RODataManAccessor acc (table, name, True);
+          if (seqnrs.insert (acc.dataManagerSeqNr()).second) {
+            itsDataMans.push_back (acc);
+          }
+        } catch (const std::exception&) {
+        }
+      }
+    }
+  }
+
+  std::vector<Record> TaQLProfile::getStatistics() const
+  {
+    std::vector<Record> stats;
+    stats.reserve (itsDataMans.size());
+    for (const RODataManAccessor& acc : itsDataMans) {
+      stats.push_back (acc.getCacheStatistics());
+    }
+    return stats;
+  }
+
+  void TaQLProfile::start()
+  {
+    itsStartStats = getStatistics();
+    itsMemStart   = Memory::allocatedMemoryInBytes();
+    itsMemPeak    = std::max (itsMemPeak, itsMemStart);
+    itsTimer.mark();
+  }
+
+  void TaQLProfile::stop (const String& stepName,
+                          rownr_t nrowIn, rownr_t nrowOut)
+  {
+    Step step;
+    step.realTime    = itsTimer.real();
+    step.cpuTime     = itsTimer.all();
+    step.name        = stepName;
+    step.nrowIn      = nrowIn;
+    step.nrowOut     = nrowOut;
+    step.memory      = Memory::allocatedMemoryInBytes();
+    step.memoryDelta = step.memory - itsMemStart;
+    itsMemPeak = std::max (itsMemPeak, step.memory);
+    // Get the increase of the IO counters for each data manager.
+    std::vector<Record> stats = getStatistics();
+    for (uInt i=0; i<stats.size(); ++i) {
+      Record diff;
+      diff.define ("name", itsDataMans[i].dataManagerName());
+      diff.define ("type", itsDataMans[i].dataManagerType());
+      for (uInt j=0; j<stats[i].nfields(); ++j) {
+        Int64 val = stats[i].asInt64(j);
+        Int fld = itsStartStats[i].fieldNumber (stats[i].name(j));
+        if (fld >= 0) {
+          val -= itsStartStats[i].asInt64(fld);
+        }
+        diff.define (stats[i].name(j), val);
+      }
+      step.ioStats.push_back (diff);
+    }
+    itsSteps.push_back (step);
+  }
+
+  Record TaQLProfile::toRecord() const
+  {
+    Record rec;
+    for (uInt i=0; i<itsSteps.size(); ++i) {
+      const Step& step = itsSteps[i];
+      Record srec;
+      srec.define ("name", step.name);
+      srec.define ("nrowin", Int64(step.nrowIn));
+      srec.define ("nrowout", Int64(step.nrowOut));
+      srec.define ("realtime", step.realTime);
+      srec.define ("cputime", step.cpuTime);
+      srec.define ("memory", step.memory);
+      srec.define ("memorydelta", step.memoryDelta);
+      Record iorec;
+      for (uInt j=0; j<step.ioStats.size(); ++j) {
+        // Data manager names should be unique, but be defensive.
+        String key = step.ioStats[j].asString("name");
+        if (key.empty()  ||  iorec.isDefined(key)) {
+          key = "dm" + String::toString(j);
+        }
+        iorec.defineRecord (key, step.ioStats[j]);
+      }
+      srec.defineRecord ("io", iorec);
+      rec.defineRecord ("step" + String::toString(i), srec);
+    }
+    rec.define ("memorypeak", itsMemPeak);
+    return rec;
+  }
+
+  void TaQLProfile::show (ostream& ostr) const
+  {
+    // Format in a local stream, so the precision of the caller's stream
+    // is not changed.
+    std::ostringstream os;
+    os << "Executed plan (last step first):" << endl;
+    // Show the steps in reverse order, so the input of a step is
+    // shown (indented) underneath it.
+    String indent("  ");
+    for (Int i=Int(itsSteps.size())-1; i>=0; --i) {
+      const Step& step = itsSteps[i];
+      os << indent << "-> " << step.name
+         << "  rows: " << step.nrowIn << " -> " << step.nrowOut
+         << "  real: " << std::setprecision(3) << step.realTime
+         << " s  cpu: " << step.cpuTime << " s"
+         << "  mem: " << step.memory / (1024*1024) << " MB ("
+         << (step.memoryDelta >= 0 ? "+" : "")
+         << step.memoryDelta / 1024 << " KB)" << endl;
+      for (const Record& io : step.ioStats) {
+        Int64 naccess = io.isDefined("naccess") ? io.asInt64("naccess") : 0;
+        if (naccess > 0) {
+          Int64 nread  = io.asInt64("nread");
+          os << indent << "     " << io.asString("type") << ' '
+             << io.asString("name")
+             << ": accesses=" << naccess
+             << " reads=" << nread
+             << " writes=" << io.asInt64("nwrite")
+             << " bytes=" << io.asInt64("nbytesread")
+             << " hit-rate=" << std::setprecision(4)
+             << 100. * (naccess - nread) / naccess << '%' << endl;
+        }
+      }
+      indent += "   ";
+    }
+    os << "  memory peak (sampled): " << itsMemPeak / (1024*1024)
+       << " MB" << endl;
+    ostr << os.str();
+  }
+
+
+} //# NAMESPACE CASACORE - END
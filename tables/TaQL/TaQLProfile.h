@@ -0,0 +1,151 @@
+//# TaQLProfile.h: Collect per-step execution statistics of a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TAQLPROFILE_H
+#define TABLES_TAQLPROFILE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/DataManAccessor.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/iosfwd.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  //# Forward Declarations
+  class Table;
+
+
+  // <summary>
+  // Collect per-step execution statistics of a TaQL query
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tTaQLProfile">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableParseQuery
+  //  <li> DataManager::getCacheStatistics
+  // </prerequisite>
+
+  // <synopsis>
+  // TaQLProfile is used by TableParseQuery::execute if the TaQL style
+  // PROFILE is given (e.g. <src>using style profile select ...</src>).
+  // The execution of a query is a pipeline of steps (WHERE, GROUPBY,
+  // HAVING, ORDERBY, LIMIT, projection, etc.). For each step executed
+  // the following is recorded:
+  // <ul>
+  //  <li> The number of rows going into and coming out of the step.
+  //  <li> The elapsed real and cpu time.
+  //  <li> Per data manager of the query's main table the number of
+  //       cache accesses, bucket/tile reads and writes, and bytes read.
+  //       From it the cache hit rate is derived.
+  //  <li> The allocated memory after the step and its change.
+  //       The peak of these memory samples is kept as well.
+  // </ul>
+  // Function <src>show</src> prints the executed plan as a tree (similar
+  // to SQL's EXPLAIN ANALYZE) with the last step at the top and each
+  // step's input underneath it. In this way it can be seen if a slow query
+  // is dominated by I/O (many reads and bytes), by expression evaluation
+  // (high cpu time without reads), or by sorting.
+  // <br>Function <src>toRecord</src> gives the same information as a Record,
+  // so it can be used programmatically (e.g. from Python).
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  //   TaQLProfile profile(table);
+  //   profile.start();
+  //   Table sel = table(expr);
+  //   profile.stop ("Where", table.nrow(), sel.nrow());
+  //   profile.show (cout);
+  // </srcblock>
+  // </example>
+
+  class TaQLProfile
+  {
+  public:
+    // Construct the object for the given table.
+    // The cache statistics of the data managers used by its columns
+    // are collected for each step.
+    explicit TaQLProfile (const Table& table);
+
+    // Start measuring a step.
+    void start();
+
+    // Stop measuring the step started by <src>start</src> and add its
+    // statistics using the given step name and number of rows.
+    void stop (const String& stepName, rownr_t nrowIn, rownr_t nrowOut);
+
+    // Get the number of steps recorded.
+    uInt nstep() const
+      { return itsSteps.size(); }
+
+    // Get the peak of the sampled allocated memory (in bytes).
+    Int64 memoryPeak() const
+      { return itsMemPeak; }
+
+    // Get the profile as a record containing a subrecord per step.
+    Record toRecord() const;
+
+    // Show the executed plan tree with the statistics per step.
+    void show (ostream& os) const;
+
+  private:
+    // Get the current cache statistics of all data managers.
+    std::vector<Record> getStatistics() const;
+
+    //# The statistics of a single step.
+    struct Step {
+      String  name;
+      rownr_t nrowIn;
+      rownr_t nrowOut;
+      Double  realTime;
+      Double  cpuTime;
+      Int64   memory;
+      Int64   memoryDelta;
+      //# Increase of the counters per data manager.
+      std::vector<Record> ioStats;
+    };
+
+    std::vector<RODataManAccessor> itsDataMans;
+    std::vector<Record>            itsStartStats;
+    std::vector<Step>              itsSteps;
+    Timer                          itsTimer;
+    Int64                          itsMemStart;
+    Int64                          itsMemPeak;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -739,13 +739,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "  angdist     angdistx    normangle   cones       anycone     findcone",
     "    see also 'show func meas' and 'show func mscal'",
     "misc functions:",
-    "  msid        rownr       rowid",
+    "  msid        rownr       rowid       sample",
     "aggregate functions:",
     "  gmin        gmax        gsum        gproduct    gsumsqr        gmean",
     "  gvariance   gsamplevariance         gstddev     gsamplestddev  grms",
     "  gany        gall        gntrue      gnfalse",
     "    plural forms of above aggregate functions (e.g., gmins)",
     "  gmedian     gfractile   ghist       gstack",
+    "  gapproxcountdistinct    gapproxmedian           gapproxfractile",
     "  countall    gcount      gfirst      glast "
   };
 
@@ -954,6 +955,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "  int ROWNR()   aka ROWNUMBER    return row number in current table",
     "  int ROWID()                    return row number in input table",
     "      MSID(column)               use column if existing, otherwise ROWID()",
+    "  bool SAMPLE(fraction, seed, nrowblock)   aka TABLESAMPLE",
+    "         true for a deterministic sample of the given fraction of blocks",
+    "         of rows (default seed 0, default 1024 rows per block);",
+    "         in WHERE only the rows in the sampled blocks are read",
   };
 
   const char* aggrFuncHelp[] = {
@@ -981,6 +986,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "  double  GRMS      (real)      root-mean-square",
     "  double  GMEDIAN   (real)      median (the middle element)",
     "  double  GFRACTILE (real, fraction)   element at given fraction",
+    "  int     GAPPROXCOUNTDISTINCT (anytype)  estimated number of distinct values",
+    "                                aka APPROX_COUNT_DISTINCT (HyperLogLog)",
+    "  double  GAPPROXMEDIAN   (real) estimated median          aka APPROX_MEDIAN",
+    "  double  GAPPROXFRACTILE (real, fraction)  estimated fraction element",
+    "                                aka APPROX_FRACTILE (KLL sketch)",
     "",
     "The following functions result in an array and operate element by element",
     "  GANYS       GALLS       GNTRUES     GNFALSES",
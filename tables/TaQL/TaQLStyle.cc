@@ -35,7 +35,8 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsDoProfiling (False)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -73,6 +74,10 @@ void TaQLStyle::set (const String& value)
     itsDoTracing = True;
   } else if (val == "NOTRACE") {
     itsDoTracing = False;
+  } else if (val == "PROFILE") {
+    itsDoProfiling = True;
+  } else if (val == "NOPROFILE") {
+    itsDoProfiling = False;
   } else {
     throw TableError(value + " is an invalid TaQL STYLE value");
   }
@@ -83,6 +88,7 @@ void TaQLStyle::reset()
   set ("GLISH");
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsDoProfiling = False;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
@@ -51,8 +51,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // style in a TaQL command.
 // The default style is Glish.
 //
-// The class is also used to tell the TaQL execution engine if timings
-// or tracing of the various parts of the TaQL command need to be done.
+// The class is also used to tell the TaQL execution engine if timings,
+// tracing or profiling of the various parts of the TaQL command need
+// to be done.
 //
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
@@ -113,12 +114,22 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set if profiling needs to be done.
+  void setProfiling (Bool doProfiling)
+    { itsDoProfiling = doProfiling; }
+
+  // Should profiling be done (i.e., show the executed plan with the
+  // statistics per step)?
+  Bool doProfiling() const
+    { return itsDoProfiling; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  Bool itsDoProfiling;
   std::map<String,String> itsUDFLibNameMap;
 };
 
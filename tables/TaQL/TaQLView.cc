@@ -0,0 +1,277 @@
+//# TaQLView.cc: Materialized TaQL query result kept up-to-date with its source
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLView.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/TaQLNode.h>
+#include <casacore/tables/TaQL/TaQLNodeDer.h>
+#include <casacore/tables/TaQL/TableParseFunc.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  namespace {
+    // Find the name of a function in the expression whose result does not
+    // depend on a single row (an aggregate or row number function).
+    // Subqueries are not looked into, because they are evaluated once.
+    String findRowsFunc (const TaQLNode& node)
+    {
+      if (! node.isValid()) {
+        return String();
+      }
+      const TaQLNodeRep* rep = node.getRep();
+      if (const TaQLFuncNodeRep* func =
+          dynamic_cast<const TaQLFuncNodeRep*>(rep)) {
+        uInt nargs = (func->itsArgs.isValid()  ?
+                      func->itsArgs.getMultiRep()->itsNodes.size() : 0);
+        TableExprFuncNode::FunctionType ftype =
+          TableParseFunc::findFunc (func->itsName, nargs, Vector<Int>());
+        if ((ftype >= TableExprFuncNode::FirstAggrFunc  &&
+             ftype < TableExprFuncNode::NRFUNC)  ||
+            ftype == TableExprFuncNode::rownrFUNC  ||
+            ftype == TableExprFuncNode::rowidFUNC) {
+          return func->itsName;
+        }
+        return findRowsFunc (func->itsArgs);
+      }
+      std::vector<TaQLNode> children;
+      if (const TaQLMultiNodeRep* multi =
+          dynamic_cast<const TaQLMultiNodeRep*>(rep)) {
+        children = multi->itsNodes;
+      } else if (const TaQLColumnsNodeRep* cols =
+                 dynamic_cast<const TaQLColumnsNodeRep*>(rep)) {
+        children.push_back (cols->itsNodes);
+      } else if (const TaQLColNodeRep* col =
+                 dynamic_cast<const TaQLColNodeRep*>(rep)) {
+        children.push_back (col->itsExpr);
+      } else if (const TaQLUnaryNodeRep* unary =
+                 dynamic_cast<const TaQLUnaryNodeRep*>(rep)) {
+        children.push_back (unary->itsChild);
+      } else if (const TaQLBinaryNodeRep* binary =
+                 dynamic_cast<const TaQLBinaryNodeRep*>(rep)) {
+        children.push_back (binary->itsLeft);
+        children.push_back (binary->itsRight);
+      } else if (const TaQLRangeNodeRep* range =
+                 dynamic_cast<const TaQLRangeNodeRep*>(rep)) {
+        children.push_back (range->itsStart);
+        children.push_back (range->itsEnd);
+      } else if (const TaQLIndexNodeRep* index =
+                 dynamic_cast<const TaQLIndexNodeRep*>(rep)) {
+        children.push_back (index->itsStart);
+        children.push_back (index->itsEnd);
+        children.push_back (index->itsIncr);
+      } else if (const TaQLUnitNodeRep* unit =
+                 dynamic_cast<const TaQLUnitNodeRep*>(rep)) {
+        children.push_back (unit->itsChild);
+      }
+      for (const TaQLNode& child : children) {
+        String name = findRowsFunc (child);
+        if (! name.empty()) {
+          return name;
+        }
+      }
+      return String();
+    }
+  }
+
+  Table TaQLView::create (const String& viewName, const String& query,
+                          const String& sourceName, Bool incremental)
+  {
+    if (incremental) {
+      checkIncremental (query);
+    }
+    Table source (sourceName);
+    // Lock the source, so the data and counters are consistent.
+    source.lock (FileLocker::Read);
+    Table view;
+    try {
+      view = make (viewName, query, source, incremental);
+    } catch (...) {
+      source.unlock();
+      throw;
+    }
+    source.unlock();
+    return view;
+  }
+
+  Table TaQLView::open (const String& viewName, Bool doRefresh)
+  {
+    if (doRefresh) {
+      refresh (viewName);
+    }
+    Table view (viewName);
+    if (! isView (view)) {
+      throw TableError ("Table " + viewName + " is not a TaQL view");
+    }
+    return view;
+  }
+
+  TaQLView::RefreshType TaQLView::refresh (const String& viewName)
+  {
+    Table view (viewName, Table::Update);
+    if (! isView (view)) {
+      throw TableError ("Table " + viewName + " is not a TaQL view");
+    }
+    const TableRecord& info = view.keywordSet().subRecord ("TAQLVIEW");
+    String query = info.asString ("QUERY");
+    Bool incremental = info.asBool ("INCREMENTAL");
+    rownr_t nrowOld = info.asInt64 ("NROW");
+    uInt modifyCounter = info.asuInt ("MODIFY_COUNTER");
+    uInt tableChangeCounter = info.asuInt ("TABLE_CHANGE_COUNTER");
+    Table source (info.asString ("SOURCE"));
+    source.lock (FileLocker::Read);
+    RefreshType type = NoRefresh;
+    try {
+      if (source.getModifyCounter() != modifyCounter  ||
+          source.nrow() != nrowOld) {
+        if (incremental  &&  source.nrow() > nrowOld  &&
+            source.getTableChangeCounter() == tableChangeCounter) {
+          // Only execute the query for the new rows and append the result.
+          Vector<rownr_t> rownrs (source.nrow() - nrowOld);
+          indgen (rownrs, nrowOld);
+          Table result = tableCommand (query, source(rownrs)).table();
+          TableCopy::copyRows (view, result, view.nrow(), 0, result.nrow(),
+                               False);
+          writeInfo (view, query, source, incremental);
+          view.flush();
+          type = Appended;
+        } else {
+          // The view is replaced, so it has to be closed first.
+          view = Table();
+          make (viewName, query, source, incremental);
+          type = Recomputed;
+        }
+      }
+    } catch (...) {
+      source.unlock();
+      throw;
+    }
+    source.unlock();
+    return type;
+  }
+
+  void TaQLView::recompute (const String& viewName)
+  {
+    String query, sourceName;
+    Bool incremental;
+    {
+      Table view (viewName);
+      if (! isView (view)) {
+        throw TableError ("Table " + viewName + " is not a TaQL view");
+      }
+      const TableRecord& info = view.keywordSet().subRecord ("TAQLVIEW");
+      query = info.asString ("QUERY");
+      sourceName = info.asString ("SOURCE");
+      incremental = info.asBool ("INCREMENTAL");
+    }
+    create (viewName, query, sourceName, incremental);
+  }
+
+  Bool TaQLView::isView (const Table& table)
+  {
+    return table.keywordSet().isDefined ("TAQLVIEW");
+  }
+
+  void TaQLView::checkIncremental (const String& query)
+  {
+    TaQLNode node = TaQLNode::parse (query);
+    const TaQLSelectNodeRep* sel =
+      dynamic_cast<const TaQLSelectNodeRep*>(node.getRep());
+    if (sel == 0) {
+      throw TableInvExpr ("An incremental TaQL view requires a SELECT query");
+    }
+    String clause;
+    if (sel->itsGroupby.isValid()) {
+      clause = "GROUPBY";
+    } else if (sel->itsHaving.isValid()) {
+      clause = "HAVING";
+    } else if (sel->itsSort.isValid()) {
+      clause = "ORDERBY";
+    } else if (sel->itsLimitOff.isValid()) {
+      clause = "LIMIT/OFFSET";
+    } else if (sel->itsJoins.isValid()  &&
+               sel->itsJoins.getMultiRep()->itsNodes.size() > 0) {
+      clause = "JOIN";
+    } else if (sel->itsTables.isValid()  &&
+               sel->itsTables.getMultiRep()->itsNodes.size() > 1) {
+      clause = "multiple tables in FROM";
+    } else if (sel->itsColumns.isValid()  &&
+               dynamic_cast<const TaQLColumnsNodeRep*>
+                 (sel->itsColumns.getRep())->itsDistinct) {
+      clause = "DISTINCT";
+    } else {
+      // Without GROUPBY an aggregate function makes a single result row.
+      String funcName = findRowsFunc (sel->itsColumns);
+      if (funcName.empty()) {
+        funcName = findRowsFunc (sel->itsWhere);
+      }
+      if (! funcName.empty()) {
+        clause = "function " + funcName;
+      }
+    }
+    if (! clause.empty()) {
+      throw TableInvExpr ("An incremental TaQL view cannot be made for "
+                          "a query using " + clause);
+    }
+  }
+
+  Table TaQLView::make (const String& viewName, const String& query,
+                        const Table& source, Bool incremental)
+  {
+    Table result = tableCommand (query, source).table();
+    // Make a plain table without rows with the same columns as the result.
+    Table view = TableCopy::makeEmptyTable (viewName, Record(), result,
+                                            Table::New, Table::AipsrcEndian,
+                                            True, True);
+    // Do not keep the table keywords (and thus subtables) of the source.
+    TableRecord& keys = view.rwKeywordSet();
+    while (keys.nfields() > 0) {
+      keys.removeField (0);
+    }
+    TableCopy::copyRows (view, result, False);
+    writeInfo (view, query, source, incremental);
+    view.flush();
+    return view;
+  }
+
+  void TaQLView::writeInfo (Table& view, const String& query,
+                            const Table& source, Bool incremental)
+  {
+    TableRecord info;
+    info.define ("QUERY", query);
+    info.define ("SOURCE", source.tableName());
+    info.define ("INCREMENTAL", incremental);
+    info.define ("NROW", Int64(source.nrow()));
+    info.define ("MODIFY_COUNTER", source.getModifyCounter());
+    info.define ("TABLE_CHANGE_COUNTER", source.getTableChangeCounter());
+    view.rwKeywordSet().defineRecord ("TAQLVIEW", info);
+  }
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,152 @@
+//# TaQLView.h: Materialized TaQL query result kept up-to-date with its source
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TAQLVIEW_H
+#define TABLES_TAQLVIEW_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/BasicSL/String.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // <summary>
+  // Materialized TaQL query result kept up-to-date with its source table
+  // </summary>
+
+  // <use visibility=export>
+
+  // <reviewed reviewer="" date="" tests="tTaQLView">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> <linkto file="TableParse.h#tableCommand">tableCommand</linkto>
+  //  <li> <linkto class=TableSyncData>TableSyncData</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // A TaQLView is a persistent table holding the result of a TaQL query
+  // on a source table (a selection with possibly computed columns).
+  // Besides the result, the view table records the query, the name of the
+  // source table, and the number of rows and change counters of the source
+  // table (as kept in its lock file, see class TableSyncData) at the time
+  // the view was made. The source table has to be given as
+  // <src>$1</src> in the query.
+  // <br>When the view is refreshed (which is done by default when it is
+  // opened), the recorded counters are compared with the current ones:
+  // <ul>
+  //  <li> If unchanged, the stored result is used as is.
+  //  <li> If the view is incremental, the table description and keywords
+  //       of the source have not changed, and rows have been added,
+  //       the query is executed for the new rows only and the result rows
+  //       are appended to the view.
+  //  <li> Otherwise the query is executed again for the entire source.
+  // </ul>
+  // An incremental view is meant for a source that is only appended to,
+  // like a MeasurementSet being filled. It can only be used if each row
+  // in the query result depends on a single source row, thus the query
+  // cannot contain GROUPBY (thus an aggregation per scan or so cannot be
+  // incremental), HAVING, ORDERBY, LIMIT/OFFSET, DISTINCT, JOIN, multiple
+  // tables, aggregate functions, or the row number functions rownumber
+  // and rowid. All of them are checked when the view is created.
+  // User defined functions cannot be checked.
+  // Note that the change counters cannot tell if existing rows have been
+  // changed or removed while also rows have been added. In such a case
+  // the view has to be recomputed explicitly using <src>recompute</src>.
+  // <br>The view information is kept in the table keyword TAQLVIEW.
+  // </synopsis>
+
+  // <example>
+  // Keep the per-row uv-distance of the cross-correlations of a growing
+  // MeasurementSet.
+  // <srcblock>
+  //   TaQLView::create ("uvdist.view",
+  //                     "select TIME, ANTENNA1, ANTENNA2, sqrt(sumsqr(UVW[:2]))"
+  //                     " as UVDIST from $1 where ANTENNA1 != ANTENNA2",
+  //                     "my.ms", True);
+  //   // Later on (e.g. every few minutes) only the new rows are processed.
+  //   Table view = TaQLView::open ("uvdist.view");
+  // </srcblock>
+  // </example>
+
+  // <motivation>
+  // Monitoring tools repeatedly run the same queries on growing tables.
+  // Recomputing the entire result each time is wasteful.
+  // </motivation>
+
+  class TaQLView
+  {
+  public:
+    // Define what a refresh has done.
+    enum RefreshType {
+      // The view was up-to-date.
+      NoRefresh,
+      // The query was executed for the new source rows.
+      Appended,
+      // The query was executed for the entire source.
+      Recomputed
+    };
+
+    // Create the view table with the given name by executing the query on
+    // the given source table. An existing table with that name is
+    // overwritten. The query has to refer to the source as <src>$1</src>.
+    // <br>An exception is thrown if <src>incremental=True</src> and
+    // the query cannot be maintained incrementally.
+    static Table create (const String& viewName, const String& query,
+                         const String& sourceName, Bool incremental=False);
+
+    // Open the view table, by default after having refreshed it.
+    static Table open (const String& viewName, Bool refresh=True);
+
+    // Refresh the view and tell what has been done.
+    static RefreshType refresh (const String& viewName);
+
+    // Execute the query again for the entire source.
+    static void recompute (const String& viewName);
+
+    // Tell if a table is a view.
+    static Bool isView (const Table& table);
+
+  private:
+    // Check if the query can be maintained incrementally.
+    static void checkIncremental (const String& query);
+
+    // Execute the query on the source (which is locked by the caller) and
+    // create the view table from the result.
+    static Table make (const String& viewName, const String& query,
+                       const Table& source, Bool incremental);
+
+    // Write the view info with the counters of the source.
+    static void writeInfo (Table& view, const String& query,
+                           const Table& source, Bool incremental);
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -74,6 +74,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         return new TaQLJoinRowid (tabInfo, tpq->joins()[tabPair.joinIndex()]);
       } else if (ftype == TableExprFuncNode::rownrFUNC) {
         throw TableInvExpr("Function rownr cannot be used on a join table");
+      } else if (ftype == TableExprFuncNode::sampleFUNC) {
+        throw TableInvExpr("Function sample cannot be used on a join table");
       }
     }
     try {
@@ -629,6 +631,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       ftype = TableExprFuncNode::replunmaskedFUNC;
     } else if (funcName == "flatten"  ||  funcName == "arrayflatten") {
       ftype = TableExprFuncNode::arrflatFUNC;
+    } else if (funcName == "sample"  ||  funcName == "tablesample") {
+      ftype = TableExprFuncNode::sampleFUNC;
     } else if (funcName == "countall") {
       ftype = TableExprFuncNode::countallFUNC;
     } else if (funcName == "gcount") {
@@ -695,6 +699,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       ftype = TableExprFuncNode::gntruesFUNC;
     } else if (funcName == "gnfalse") {
       ftype = TableExprFuncNode::gnfalseFUNC;
+    } else if (funcName == "gapproxcountdistinct"  ||
+               funcName == "approx_count_distinct") {
+      ftype = TableExprFuncNode::gapproxcountdistinctFUNC;
+    } else if (funcName == "gapproxmedian"  ||  funcName == "approx_median") {
+      ftype = TableExprFuncNode::gapproxmedianFUNC;
+    } else if (funcName == "gapproxfractile"  ||
+               funcName == "approx_fractile") {
+      ftype = TableExprFuncNode::gapproxfractileFUNC;
     } else if (funcName == "gnfalses") {
       ftype = TableExprFuncNode::gnfalsesFUNC;
     } else if (funcName == "ghist"  ||  funcName == "ghistogram") {
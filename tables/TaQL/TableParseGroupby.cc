@@ -29,6 +29,8 @@
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/Tables/TableError.h>
 
 using namespace std;
@@ -145,6 +147,75 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return aggregate (rownrs);
   }
 
+  std::shared_ptr<TableExprGroupResult> TableParseGroupby::execMetaAggr
+  (Vector<rownr_t>& rownrs, const Table& table) const
+  {
+    if ((itsGroupAggrUsed & GROUPBY) != 0  ||  itsAggrNodes.empty()  ||
+        table.isNull()  ||  table.nrow() == 0) {
+      return std::shared_ptr<TableExprGroupResult>();
+    }
+    // Find the rows of the minimum and maximum if needed.
+    // Give up if any aggregate function cannot be derived.
+    std::vector<rownr_t> resRows(itsAggrNodes.size(), 0);
+    for (uInt i=0; i<itsAggrNodes.size(); ++i) {
+      TableExprAggrNode* node = dynamic_cast<TableExprAggrNode*>(itsAggrNodes[i]);
+      if (!node  ||  node->valueType() != TableExprNodeRep::VTScalar) {
+        return std::shared_ptr<TableExprGroupResult>();
+      }
+      switch (node->funcType()) {
+      case TableExprFuncNode::countallFUNC:
+        break;
+      case TableExprFuncNode::gcountFUNC:
+        if (node->operands()[0]->valueType() != TableExprNodeRep::VTScalar) {
+          return std::shared_ptr<TableExprGroupResult>();
+        }
+        break;
+      case TableExprFuncNode::gminFUNC:
+      case TableExprFuncNode::gmaxFUNC:
+        {
+          const TableExprNodeColumn* colNode =
+            dynamic_cast<const TableExprNodeColumn*>(node->operands()[0].get());
+          // The column has to contain the same rows as the table.
+          if (!colNode  ||
+              !colNode->getTableInfo().table().isSameRoot (table)  ||
+              colNode->getTableInfo().table().nrow() != table.nrow()) {
+            return std::shared_ptr<TableExprGroupResult>();
+          }
+          rownr_t minRow, maxRow;
+          if (! colNode->getColumn().findMinMax (minRow, maxRow)) {
+            return std::shared_ptr<TableExprGroupResult>();
+          }
+          resRows[i] = (node->funcType() == TableExprFuncNode::gminFUNC  ?
+                        minRow : maxRow);
+        }
+        break;
+      default:
+        return std::shared_ptr<TableExprGroupResult>();
+      }
+    }
+    // Make a set of the aggregate function objects and fill in the results.
+    // Only the row containing the minimum or maximum is evaluated.
+    std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets
+      (1, std::make_shared<TableExprGroupFuncSet>(itsAggrNodes));
+    const std::vector<std::shared_ptr<TableExprGroupFuncBase>>& funcs =
+      funcSets[0]->getFuncs();
+    for (uInt i=0; i<itsAggrNodes.size(); ++i) {
+      if (TableExprGroupCountAll* countAll =
+          dynamic_cast<TableExprGroupCountAll*>(funcs[i].get())) {
+        countAll->setResult (table.nrow());
+      } else if (TableExprGroupCount* count =
+                 dynamic_cast<TableExprGroupCount*>(funcs[i].get())) {
+        count->setResult (table.nrow());
+      } else {
+        funcs[i]->apply (TableExprId(resRows[i]));
+      }
+      funcs[i]->finish();
+    }
+    // The resulting table has only 1 group; use the last row with it.
+    rownrs.reference (Vector<rownr_t>(1, table.nrow() - 1));
+    return std::make_shared<TableExprGroupResult>(funcSets);
+  }
+
   Bool TableParseGroupby::execHaving
   (Vector<rownr_t>& rownrs, const std::shared_ptr<TableExprGroupResult>& groups)
   {
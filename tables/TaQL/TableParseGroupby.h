@@ -103,6 +103,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // first row of each group.
     std::shared_ptr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs) const;
 
+    // Try to derive the results of the aggregate functions for all rows
+    // of the given table from the metadata of the table and its storage
+    // managers without stepping through the rows.
+    // It is possible if no GROUPBY is given and only the aggregate
+    // functions count(*), gcount of a scalar, and gmin and gmax of a
+    // scalar numeric column of the table are used. The latter two require
+    // a storage manager being able to find the rows containing the minimum
+    // and maximum (see DataManagerColumn::findMinMax).
+    // If possible, rownrs is set to the last row (as count(*) does) and
+    // the results are returned. Otherwise a null pointer is returned.
+    std::shared_ptr<TableExprGroupResult> execMetaAggr (Vector<rownr_t>& rownrs,
+                                                        const Table& table) const;
+
     // Execute the HAVING clause (if present).
     // Return False in no HAVING.
     Bool execHaving (Vector<rownr_t>& rownrs,
@@ -84,8 +84,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       { return columnNames_p; }
 
     // Get the projected column expressions.
+    // The non-const version makes it possible to optimize them.
+    // <group>
     const Block<TableExprNode>& getColumnExpr() const
       { return columnExpr_p; }
+    Block<TableExprNode>& getColumnExpr()
+      { return columnExpr_p; }
+    // </group>
 
     // Are expressions used in the column projection?
     Bool hasExpressions() const
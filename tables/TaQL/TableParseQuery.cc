@@ -28,8 +28,11 @@
 #include <casacore/tables/TaQL/TableParseUtil.h>
 #include <casacore/tables/TaQL/TaQLNode.h>
 #include <casacore/tables/TaQL/TaQLStyle.h>
+#include <casacore/tables/TaQL/TaQLProfile.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/TaQL/ExprDerNodeArray.h>
+#include <casacore/tables/TaQL/ExprCompiled.h>
+#include <casacore/tables/TaQL/ExprPlanner.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
 #include <casacore/tables/TaQL/ExprRange.h>
@@ -57,8 +60,12 @@
 #include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/ostream.h>
 #include <algorithm>
+#include <memory>
+#include <unordered_set>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -80,7 +87,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       stride_p        (1),
       insSel_p        (0),
       noDupl_p        (False),
-      order_p         (Sort::Ascending)
+      order_p         (Sort::Ascending),
+      cursor_p        (False)
   {}
 
   TableParseQuery::~TableParseQuery()
@@ -605,6 +613,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // If needed, make the expression's unit the same as the column unit.
       key.adaptUnit (TableExprNodeColumn::getColumnUnit (cols[i]));
     }
+    // If all expressions are compiled arithmetic expressions, update
+    // block-wise which is much faster than evaluating row by row.
+    Bool updateBlock = !groups;
+    for (uInt i=0; i<nrkey  &&  updateBlock; i++) {
+      updateBlock = update_p[i]->canUpdateBlock (cols[i]);
+    }
+    if (updateBlock) {
+      Vector<rownr_t> blockRows;
+      for (rownr_t st=0; st<rownrs.size(); st+=TableExprCompiled::blockSize) {
+        rownr_t n = std::min (rownr_t(TableExprCompiled::blockSize),
+                              rownrs.size() - st);
+        blockRows.reference (rownrs(Slice(st, n)));
+        for (uInt i=0; i<nrkey; i++) {
+          update_p[i]->updateBlock (cols[i], st, blockRows);
+        }
+      }
+      if (showTimings) {
+        timer.show ("  Update      ");
+      }
+      return;
+    }
     // Loop through all rows in the table and update each row.
     TableExprIdAggr rowid(groups);
     for (rownr_t row=0; row<rownrs.size(); ++row) {
@@ -795,6 +824,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
          iter!=applySelNodes_p.end(); ++iter) {
       iter->applySelection (rownrs_p);
     }
+    // The row numbers change, so the values cached for the shared
+    // subexpressions are invalid.
+    cse_p.clearCaches();
     // Create the subset.
     Table tab(table(rownrs_p));
     // From now on use row numbers 0..n.
@@ -802,6 +834,43 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return tab;
   }
 
+  void TableParseQuery::eliminateCSE (Bool doTracing)
+  {
+    std::vector<TableExprNode*> exprs;
+    if (! node_p.isNull()) {
+      exprs.push_back (&node_p);
+    }
+    Block<TableExprNode>& colExprs = tableProject_p.getColumnExpr();
+    for (uInt i=0; i<colExprs.size(); ++i) {
+      if (! colExprs[i].isNull()) {
+        exprs.push_back (&colExprs[i]);
+      }
+    }
+    std::vector<TableExprNode> sortNodes;
+    sortNodes.reserve (sort_p.size());
+    for (const TableParseSortKey& key : sort_p) {
+      sortNodes.push_back (key.node());
+    }
+    for (TableExprNode& node : sortNodes) {
+      exprs.push_back (&node);
+    }
+    if (cse_p.apply (exprs) > 0) {
+      for (uInt i=0; i<sort_p.size(); ++i) {
+        if (sortNodes[i].getRep() != sort_p[i].node().getRep()) {
+          if (sort_p[i].orderGiven()) {
+            sort_p[i] = TableParseSortKey (sortNodes[i], sort_p[i].order());
+          } else {
+            sort_p[i] = TableParseSortKey (sortNodes[i]);
+          }
+        }
+      }
+      if (doTracing) {
+        cerr << "Common subexpression elimination found ";
+        cse_p.show (cerr);
+      }
+    }
+  }
+
   Bool TableParseQuery::doHaving (Bool showTimings,
                                   const std::shared_ptr<TableExprGroupResult>& groups)
   {
@@ -823,6 +892,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       return;
     }
     Timer timer;
+    // If only the first rows are needed (ORDERBY with LIMIT), only those
+    // rows are partially sorted.
+    if (endrow_p > 0  &&  limit_p >= 0  &&  !distinct_p  &&  !noDupl_p  &&
+        rownr_t(endrow_p) < rownrs_p.size()) {
+      doTopSort (endrow_p);
+      if (showTimings) {
+        timer.show ("  Orderby     ");
+      }
+      return;
+    }
     // Create and fill a Sort object for all keys.
     // The data are kept in vector Arrays and are automatically deleted at the end.
     std::vector<std::shared_ptr<ArrayBase>> arrays;
@@ -847,6 +926,33 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     rownrs_p.reference (newRownrs);
   }
 
+  void TableParseQuery::doTopSort (rownr_t nrsel)
+  {
+    // The rows are processed in chunks to avoid that the sort keys of
+    // all rows are held in memory. The best rows found so far are merged
+    // with the next chunk. They are put first to keep equal keys in order.
+    rownr_t chunkSize = std::max (4*nrsel, rownr_t(1024*1024));
+    rownr_t nrrow = rownrs_p.size();
+    Vector<rownr_t> topRownrs;
+    for (rownr_t st=0; st<nrrow; st+=chunkSize) {
+      rownr_t nr = std::min (chunkSize, nrrow - st);
+      Vector<rownr_t> rownrs (topRownrs.size() + nr);
+      rownrs(Slice(0, topRownrs.size())) = topRownrs;
+      rownrs(Slice(topRownrs.size(), nr)) = rownrs_p(Slice(st, nr));
+      std::vector<std::shared_ptr<ArrayBase>> arrays;
+      Sort sort;
+      for (auto& sortKey : sort_p) {
+        arrays.push_back (sortKey.addSortValues (sort, order_p, rownrs));
+      }
+      Vector<rownr_t> index;
+      sort.partialSort (index, rownrs.size(), nrsel);
+      topRownrs.resize (index.size());
+      for (rownr_t i=0; i<index.size(); ++i) {
+        topRownrs[i] = rownrs[index[i]];
+      }
+    }
+    rownrs_p.reference (topRownrs);
+  }
 
   void TableParseQuery::doLimOff (Bool showTimings)
   {
@@ -935,6 +1041,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return projectExprTable_p;
   }
 
+  Table TableParseQuery::projectBlock (rownr_t start, rownr_t nrow)
+  {
+    AlwaysAssert (cursor_p  &&  start + nrow <= rownrs_p.size(), AipsError);
+    SetupNewTable newtab ("", projectExprTable_p.actualTableDesc(),
+                          Table::New);
+    Table block (newtab, Table::Memory, nrow);
+    if (nrow > 0) {
+      Vector<rownr_t> rownrs (rownrs_p(Slice(start, nrow)));
+      doUpdate (False, Table(), block, rownrs, cursorGroups_p);
+    }
+    return block;
+  }
+
   Table TableParseQuery::doFinish (Bool showTimings, Table& table,
                                    const std::vector<const Table*>& tempTables,
                                    const std::vector<TableParseQuery*>& stack)
@@ -980,11 +1099,183 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return result;
   }
 
+  //# Append the binary values of a scalar column to the keys of the rows.
+  //# Floating point values are normalized, so -0 equals 0 and all NaNs
+  //# are equal (as in the comparison used by Sort).
+  template<typename T>
+  inline T distinctNormalize (T value)
+    { return value; }
+  inline Float distinctNormalize (Float value)
+    { return (value == 0  ?  0 : (isNaN(value) ? floatNaN() : value)); }
+  inline Double distinctNormalize (Double value)
+    { return (value == 0  ?  0 : (isNaN(value) ? doubleNaN() : value)); }
+  inline Complex distinctNormalize (const Complex& value)
+    { return Complex (distinctNormalize(value.real()),
+                      distinctNormalize(value.imag())); }
+  inline DComplex distinctNormalize (const DComplex& value)
+    { return DComplex (distinctNormalize(value.real()),
+                       distinctNormalize(value.imag())); }
+
+  template<typename T>
+  void distinctAddKeys (const Table& table, const String& name,
+                        rownr_t startRow, std::vector<std::string>& keys)
+  {
+    Vector<T> values = ScalarColumn<T>(table, name).getColumnRange
+      (Slicer(IPosition(1, startRow), IPosition(1, keys.size())));
+    for (size_t i=0; i<keys.size(); ++i) {
+      T value = distinctNormalize (values[i]);
+      keys[i].append (reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+  }
+
+  template<>
+  void distinctAddKeys<String> (const Table& table, const String& name,
+                                rownr_t startRow,
+                                std::vector<std::string>& keys)
+  {
+    Vector<String> values = ScalarColumn<String>(table, name).getColumnRange
+      (Slicer(IPosition(1, startRow), IPosition(1, keys.size())));
+    for (size_t i=0; i<keys.size(); ++i) {
+      uInt64 len = values[i].size();
+      keys[i].append (reinterpret_cast<const char*>(&len), sizeof(len));
+      keys[i].append (values[i]);
+    }
+  }
+
+  Bool TableParseQuery::doHashDistinct (const Table& table,
+                                        Vector<rownr_t>& rownrs) const
+  {
+    // Only scalar columns of the standard types can be used.
+    const Block<String>& names = tableProject_p.getColumnNames();
+    std::vector<DataType> types;
+    for (const String& name : names) {
+      const ColumnDesc& cdesc = table.tableDesc()[name];
+      if (! cdesc.isScalar()) {
+        return False;
+      }
+      switch (cdesc.dataType()) {
+      case TpBool: case TpUChar: case TpShort: case TpUShort: case TpInt:
+      case TpUInt: case TpInt64: case TpFloat: case TpDouble: case TpComplex:
+      case TpDComplex: case TpString:
+        types.push_back (cdesc.dataType());
+        break;
+      default:
+        return False;
+      }
+    }
+    // The rows are processed in chunks. The key of a row is the
+    // concatenation of the binary values of its columns.
+    // The rows are partitioned on the hash value of their keys. Each
+    // partition has its own hash set, so the partitions can be processed
+    // in parallel. The rows in a partition are processed in order, so the
+    // first occurrence of each key is kept.
+    // Note that a hash set holds a copy of each distinct key, thus if all
+    // rows are distinct, the keys of all rows are held in memory. The same
+    // is true for the unique sort used otherwise, so the keys are not
+    // spilled to disk.
+    uInt nthr = std::max (1u, OMP::maxThreads());
+    std::vector<std::unordered_set<std::string>> keySets (nthr);
+    std::hash<std::string> hasher;
+    rownr_t nrow = table.nrow();
+    rownr_t chunkSize = 65536;
+    std::vector<rownr_t> result;
+    for (rownr_t st=0; st<nrow; st+=chunkSize) {
+      rownr_t nr = std::min (chunkSize, nrow-st);
+      std::vector<std::string> keys (nr);
+      for (uInt i=0; i<names.size(); ++i) {
+        switch (types[i]) {
+        case TpBool:
+          distinctAddKeys<Bool> (table, names[i], st, keys);
+          break;
+        case TpUChar:
+          distinctAddKeys<uChar> (table, names[i], st, keys);
+          break;
+        case TpShort:
+          distinctAddKeys<Short> (table, names[i], st, keys);
+          break;
+        case TpUShort:
+          distinctAddKeys<uShort> (table, names[i], st, keys);
+          break;
+        case TpInt:
+          distinctAddKeys<Int> (table, names[i], st, keys);
+          break;
+        case TpUInt:
+          distinctAddKeys<uInt> (table, names[i], st, keys);
+          break;
+        case TpInt64:
+          distinctAddKeys<Int64> (table, names[i], st, keys);
+          break;
+        case TpFloat:
+          distinctAddKeys<Float> (table, names[i], st, keys);
+          break;
+        case TpDouble:
+          distinctAddKeys<Double> (table, names[i], st, keys);
+          break;
+        case TpComplex:
+          distinctAddKeys<Complex> (table, names[i], st, keys);
+          break;
+        case TpDComplex:
+          distinctAddKeys<DComplex> (table, names[i], st, keys);
+          break;
+        default:
+          distinctAddKeys<String> (table, names[i], st, keys);
+          break;
+        }
+      }
+      // Determine the partition of each row.
+      std::vector<uInt> part (nr);
+#ifdef _OPENMP
+#pragma omp parallel for if (nthr > 1  &&  nr > 10000)
+#endif
+      for (Int64 i=0; i<Int64(nr); ++i) {
+        part[i] = hasher(keys[i]) % nthr;
+      }
+      std::vector<std::vector<rownr_t>> partRows (nthr);
+      for (rownr_t i=0; i<nr; ++i) {
+        partRows[part[i]].push_back (i);
+      }
+      std::vector<char> isFirst (nr, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (nthr > 1  &&  nr > 10000)
+#endif
+      for (Int p=0; p<Int(nthr); ++p) {
+        for (rownr_t i : partRows[p]) {
+          if (keySets[p].insert (std::move(keys[i])).second) {
+            isFirst[i] = 1;
+          }
+        }
+      }
+      for (rownr_t i=0; i<nr; ++i) {
+        if (isFirst[i]) {
+          result.push_back (st+i);
+        }
+      }
+    }
+    rownrs.resize (result.size());
+    std::copy (result.begin(), result.end(), rownrs.begin());
+    return True;
+  }
+
   Table TableParseQuery::doDistinct (Bool showTimings, const Table& table)
   {
     Timer timer;
     Table result;
-    // Sort the table uniquely on all columns.
+    // Try to find the first row of each distinct key using hashing,
+    // which keeps the original order.
+    Vector<rownr_t> rownrs;
+    if (doHashDistinct (table, rownrs)) {
+      if (rownrs.size() == table.nrow()) {
+        result = table;
+      } else {
+        result = table(rownrs);
+        rownrs_p.reference (rownrs);
+      }
+      if (showTimings) {
+        timer.show ("  Distinct    ");
+      }
+      return result;
+    }
+    // Otherwise sort the table uniquely on all columns.
     Table tabs = table.sort (tableProject_p.getColumnNames(), Sort::Ascending,
                              Sort::QuickSort|Sort::NoDuplicates);
     if (tabs.nrow() == table.nrow()) {
@@ -1143,7 +1434,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                                  Bool mustSelect, rownr_t maxRow,
                                  Bool doTracing,
                                  const std::vector<const Table*>& tempTables,
-                                 const std::vector<TableParseQuery*>& stack)
+                                 const std::vector<TableParseQuery*>& stack,
+                                 Bool doProfiling)
   {
     //# A selection query consists of:
     //#  - SELECT to do projection
@@ -1199,6 +1491,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Make sure WHERE expression does not use aggregate functions.
     // It has been checked before, but use defensive programming.
     TableParseGroupby::checkAggrFuncs (node_p);
+    //# Evaluate the cheap and selective conjuncts of WHERE first
+    //# (only the ones that cannot throw are moved).
+    if (! node_p.isNull()) {
+      TableExprPlanner planner;
+      planner.orderConjuncts (node_p, doTracing);
+    }
+    //# Evaluate the expressions used in multiple clauses only once per row.
+    if (commandType_p == PSELECT) {
+      eliminateCSE (doTracing);
+    }
     //# Get nodes representing aggregate functions.
     //# Test if aggregate, groupby, or having is used.
     groupby_p.findGroupAggr (tableProject_p.getColumnExpr(),
@@ -1222,6 +1524,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
     //# The first table in the list is the source table.
     Table table = tableList_p.firstTable();
+    //# Collect statistics of each step if profiling is done.
+    std::unique_ptr<TaQLProfile> profile;
+    if (doProfiling) {
+      profile.reset (new TaQLProfile (table));
+    }
     //# Set endrow_p if positive limit and positive or no offset.
     if (offset_p >= 0  &&  limit_p > 0) {
       endrow_p = offset_p + limit_p * stride_p;
@@ -1248,7 +1555,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       //#//                 << rang[i].end() << endl;
       //#//        }
       Timer timer;
+      if (profile) profile->start();
       resultTable = table(node_p, nrmax);
+      if (profile) profile->stop ("Where", table.nrow(), resultTable.nrow());
       if (showTimings) {
         timer.show ("  Where       ");
       }
@@ -1256,12 +1565,32 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         cerr << "WHERE resulted in " << resultTable.nrow() << " rows" << endl;
       }
     }
+    // Without WHERE the aggregates might be derived from the metadata of
+    // the table, so the rows do not need to be read.
+    std::shared_ptr<TableExprGroupResult> groupResult;
+    if (node_p.isNull()  &&  groupby_p.isUsed()) {
+      if (profile) profile->start();
+      groupResult = groupby_p.execMetaAggr (rownrs_p, table);
+      if (groupResult) {
+        if (profile) profile->stop ("Groupby (metadata)", table.nrow(),
+                                    rownrs_p.size());
+        if (doTracing) {
+          cerr << "Aggregates derived from table metadata" << endl;
+        }
+      }
+    }
     // Get the row numbers of the result of the possible first step.
-    rownrs_p.reference (resultTable.rowNumbers(table));
+    if (! groupResult) {
+      rownrs_p.reference (resultTable.rowNumbers(table));
+    }
     // Execute possible groupby/aggregate.
-    std::shared_ptr<TableExprGroupResult> groupResult;
     if (groupby_p.isUsed() != 0) {
-      groupResult = doGroupby (showTimings);
+      if (! groupResult) {
+        rownr_t nrowIn = rownrs_p.size();
+        if (profile) profile->start();
+        groupResult = doGroupby (showTimings);
+        if (profile) profile->stop ("Groupby", nrowIn, rownrs_p.size());
+      }
       // Aggregate results and normal table rows need to have the same rownrs,
       // so set the selected rows in the table column objects.
       resultTable = adjustApplySelNodes(table);
@@ -1275,7 +1604,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Do the projection of SELECT columns used in HAVING or ORDERBY.
     // Thereafter the column nodes need to use rownrs 0..n.
     if (tableProject_p.nColumnsPreCalc() > 0) {
+      if (profile) profile->start();
       doProjectExpr (True, groupResult);
+      if (profile) profile->stop ("Pre-projection", rownrs_p.size(),
+                                  rownrs_p.size());
       resultTable = adjustApplySelNodes(table);
       table = resultTable;
       if (doTracing) {
@@ -1286,14 +1618,20 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
     }
     // Do the possible HAVING step.
+    rownr_t nrowIn = rownrs_p.size();
+    if (profile) profile->start();
     if (doHaving (showTimings, groupResult)) {
+      if (profile) profile->stop ("Having", nrowIn, rownrs_p.size());
       if (doTracing) {
         cerr << "HAVING resulted in " << rownrs_p.size() << " rows" << endl;
       }
     }
     //# Then do the sort.
     if (sort_p.size() > 0) {
+      nrowIn = rownrs_p.size();
+      if (profile) profile->start();
       doSort (showTimings);
+      if (profile) profile->stop ("Orderby", nrowIn, rownrs_p.size());
       if (doTracing) {
         cerr << "ORDERBY resulted in " << rownrs_p.size() << " rows" << endl;
       }
@@ -1302,7 +1640,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // because duplicate rows will be removed.
     if (!distinct_p  &&  (offset_p != 0  ||  limit_p != 0  ||
                           endrow_p != 0  || stride_p != 1)) {
+      nrowIn = rownrs_p.size();
+      if (profile) profile->start();
       doLimOff (showTimings);
+      if (profile) profile->stop ("Limit/Offset", nrowIn, rownrs_p.size());
       if (doTracing) {
         cerr << "LIMIT/OFFSET resulted in " << rownrs_p.size() << " rows" << endl;
       }
@@ -1329,22 +1670,52 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
     }
     //# Then do the update, delete, insert, or projection and so.
+    nrowIn = rownrs_p.size();
+    if (profile) profile->start();
     if (commandType_p == PUPDATE) {
       doUpdate (showTimings, table, resultTable, rownrs_p);
       table.flush();
+      if (profile) profile->stop ("Update", nrowIn, nrowIn);
     } else if (commandType_p == PINSERT) {
       Table tabNewRows = doInsert (showTimings, table);
       table.flush();
       resultTable = tabNewRows;
+      if (profile) profile->stop ("Insert", nrowIn, resultTable.nrow());
     } else if (commandType_p == PDELETE) {
       doDelete (showTimings, table);
       table.flush();
+      if (profile) profile->stop ("Delete", nrowIn, nrowIn);
     } else if (commandType_p == PCOUNT) {
       resultTable = doCount (showTimings, table);
+      if (profile) profile->stop ("Count", nrowIn, resultTable.nrow());
     } else {
+      //# A lazy projection is only possible for plain expressions.
+      cursor_p = cursor_p  &&  commandType_p == PSELECT
+        &&  tableProject_p.hasExpressions()
+        &&  tableProject_p.nColumnsPreCalc() == 0
+        &&  !distinct_p  &&  resultType_p == 0  &&  resultName_p.empty();
+      if (cursor_p) {
+        // Keep the group results and make the update objects for
+        // projectBlock.
+        cursorGroups_p = groupResult;
+        update_p.clear();
+        tableProject_p.makeUpdate (False, *this);
+        table_p = projectExprTable_p;
+        if (doTracing) {
+          cerr << "Projection of " << rownrs_p.size()
+               << " rows is done lazily" << endl;
+        }
+        if (profile) {
+          profile->show (cout);
+        }
+        return;
+      }
       //# Then do the projection.
       if (tableProject_p.getColumnNames().size() > 0) {
         resultTable = doProject (showTimings, table, groupResult);
+        if (profile) profile->stop (distinct_p ? "Projection+Distinct" :
+                                    "Projection",
+                                    nrowIn, resultTable.nrow());
         if (doTracing) {
           cerr << "Final projection done of "
                << tableProject_p.getColumnNames().size() -
@@ -1356,7 +1727,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // If select distinct is given, limit/offset must be done at the end.
       if (distinct_p  &&  (offset_p != 0  ||  limit_p != 0  ||
                            endrow_p != 0  || stride_p != 1)) {
+        nrowIn = resultTable.nrow();
+        if (profile) profile->start();
         resultTable = doLimOff (showTimings, resultTable);
+        if (profile) profile->stop ("Limit/Offset", nrowIn,
+                                    resultTable.nrow());
         if (doTracing) {
           cerr << "LIMIT/OFFSET resulted in " << resultTable.nrow()
                << " rows" << endl;
@@ -1364,7 +1739,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
       //# Finally rename or copy using the given name (and flush it).
       if (resultType_p != 0  ||  ! resultName_p.empty()) {
+        if (profile) profile->start();
         resultTable = doFinish (showTimings, resultTable, tempTables, stack);
+        if (profile) profile->stop ("Giving", resultTable.nrow(),
+                                    resultTable.nrow());
         if (doTracing) {
           cerr << "Finished the GIVING command" << endl;
         }
@@ -1372,6 +1750,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
     //# Keep the table for later.
     table_p = resultTable;
+    if (profile) {
+      profile->show (cout);
+    }
   }
 
   String TableParseQuery::getTableStructure (const Vector<String>& parts,
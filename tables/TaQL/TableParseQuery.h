@@ -36,6 +36,7 @@
 #include <casacore/tables/TaQL/TableParseGroupby.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprCSE.h>
 #include <casacore/tables/TaQL/ExprGroup.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
 #include <casacore/casa/BasicSL/String.h>
@@ -135,10 +136,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Optionally the maximum nr of rows to be selected can be given.
     // It will be used as the default value for the LIMIT clause.
     // 0 = no maximum.
+    // If doProfiling is set, the executed plan is shown with the row counts,
+    // times, IO and memory statistics per step (see class TaQLProfile).
     void execute (Bool showTimings, Bool setInGiving,
                   Bool mustSelect, rownr_t maxRow, Bool doTracing=False,
                   const std::vector<const Table*>& tempTables = std::vector<const Table*>(),
-                  const std::vector<TableParseQuery*>& stack = std::vector<TableParseQuery*>());
+                  const std::vector<TableParseQuery*>& stack = std::vector<TableParseQuery*>(),
+                  Bool doProfiling=False);
 
     // Execute a query in a FROM clause resulting in a Table.
     Table doFromQuery (Bool showTimings);
@@ -310,6 +314,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     const Table& getTable() const
       { return table_p; }
 
+    // Ask to evaluate the projection of a SELECT lazily (see class TaQLCursor).
+    // It is only done if possible, thus if expressions are projected
+    // without DISTINCT or GIVING and if none of them is used in ORDERBY
+    // or HAVING. Otherwise the query is executed as usual.
+    void setCursor()
+      { cursor_p = True; }
+
+    // Tell if execute has left the projection to be done lazily.
+    Bool isCursor() const
+      { return cursor_p; }
+
+    // Get the number of rows in the result of a lazy projection.
+    rownr_t cursorNrow() const
+      { return rownrs_p.size(); }
+
+    // Evaluate the projection of the result rows <src>start</src> till
+    // <src>start+nrow</src> and return them in a new memory table.
+    // It can only be used if execute has left the projection to be done
+    // lazily.
+    Table projectBlock (rownr_t start, rownr_t nrow);
+
     // Show the structure of fromTables_p[0] using the options given in parts[2:].
     String getTableStructure (const Vector<String>& parts, const TaQLStyle& style);
 
@@ -366,6 +391,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // It returns the Table containing the subset of rows in the input Table.
     Table adjustApplySelNodes (const Table&);
 
+    // Share the common subexpressions in the WHERE, ORDERBY and SELECT
+    // expressions, so they are evaluated once per row.
+    void eliminateCSE (Bool doTracing);
+
     // Do the groupby/aggregate step and return its result.
     std::shared_ptr<TableExprGroupResult> doGroupby (bool showTimings);
 
@@ -377,6 +406,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Do the sort step.
     void doSort (Bool showTimings);
 
+    // Do the sort step if only the first <src>nrsel</src> rows are needed.
+    // A partial sort is done in chunks of rows, so the sort keys of at most
+    // a chunk of rows have to be held.
+    void doTopSort (rownr_t nrsel);
+
     // Do the limit/offset step.
     void  doLimOff (Bool showTimings);
     Table doLimOff (Bool showTimings, const Table& table);
@@ -384,6 +418,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Do the 'select distinct' step.
     Table doDistinct (Bool showTimings, const Table& table);
 
+    // Find the first row of each distinct combination of the projected
+    // columns using hash sets, which keeps the original row order and is
+    // done in parallel if possible.
+    // It returns False if a column is not a scalar of a standard type.
+    Bool doHashDistinct (const Table& table, Vector<rownr_t>& rownrs) const;
+
     // Finish the table (rename, copy, and/or flush).
     Table doFinish (Bool showTimings, Table& table,
                     const std::vector<const Table*>& tempTables,
@@ -447,8 +487,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     //# It can consist of column nodes and the rowid function node.
     //# Some nodes (in aggregate functions) can later be disabled for adjustment.
     std::vector<TableExprNode> applySelNodes_p;
+    //# The common subexpressions shared in the expressions.
+    TableExprCSE cse_p;
     //# The resulting table.
     Table table_p;
+    //# Lazy projection (see setCursor).
+    Bool cursor_p;
+    std::shared_ptr<TableExprGroupResult> cursorGroups_p;
     //# The table resulting from a projection with expressions.
     Table projectExprTable_p;
     //# The resulting row numbers.
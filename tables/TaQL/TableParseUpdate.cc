@@ -29,7 +29,11 @@
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeArray.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
+#include <casacore/tables/TaQL/ExprCompiled.h>
+#include <casacore/tables/TaQL/ExprUDFNode.h>
+#include <casacore/tables/TaQL/ExprUDFNodeArray.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/TableError.h>
 
 
@@ -577,4 +581,69 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableParseUpdate::canUpdateBlock (const TableColumn& col)
+  {
+    compiled_p.reset();
+    if (indexPtr_p != 0  ||  !mask_p.isNull()  ||  !columnNameMask_p.empty()
+        ||  col.columnDesc().dataType() != TpDouble
+        ||  node_p.getNodeRep()->dataType() != TableExprNodeRep::NTDouble) {
+      return False;
+    }
+    const TableExprNodeRep* node = node_p.getNodeRep();
+    if (! col.columnDesc().isScalar()) {
+      // An array UDF can be used if it can evaluate a block of rows.
+      const TableExprUDFNodeArray* udfNode =
+        dynamic_cast<const TableExprUDFNodeArray*>(node);
+      return udfNode  &&  udfNode->hasBatch();
+    }
+    // A scalar UDF can be used if it can evaluate a block of rows.
+    const TableExprUDFNode* udfNode =
+      dynamic_cast<const TableExprUDFNode*>(node);
+    if (udfNode  &&  udfNode->hasBatch()) {
+      return True;
+    }
+    // Only a fully compiled expression can be used, because an interpreted
+    // part (e.g. a subquery) might use values of other rows.
+    if (TableExprCompiled::canCompile (*node)) {
+      std::shared_ptr<TableExprCompiled> prog
+        (new TableExprCompiled (node_p.getRep().get()));
+      if (prog->nInterpreted() == 0) {
+        compiled_p = prog;
+      }
+    }
+    return compiled_p != 0;
+  }
+
+  void TableParseUpdate::updateBlock (TableColumn& col, rownr_t startRow,
+                                      const Vector<rownr_t>& rownrs)
+  {
+    if (! col.columnDesc().isScalar()) {
+      // Put the arrays of a batch UDF.
+      TableExprUDFNodeArray* udfNode =
+        dynamic_cast<TableExprUDFNodeArray*>(node_p.getRep().get());
+      AlwaysAssert (udfNode != 0, AipsError);
+      std::vector<MArray<Double>> values (rownrs.size());
+      udfNode->getArrayDoubleBatch (rownrs, values.data());
+      ArrayColumn<Double> acol (col);
+      for (rownr_t i=0; i<rownrs.size(); ++i) {
+        if (! values[i].isNull()) {
+          acol.put (startRow + i, values[i].array());
+        }
+      }
+      return;
+    }
+    Vector<Double> values;
+    if (compiled_p) {
+      values.resize (rownrs.size());
+      compiled_p->evaluate (rownrs, values.data());
+    } else {
+      // A batch UDF.
+      values.reference (node_p.getRep()->getColumnDouble (rownrs));
+    }
+    ScalarColumn<Double> scol (col);
+    scol.putColumnRange (Slicer (IPosition(1, startRow),
+                                 IPosition(1, rownrs.size())),
+                         values);
+  }
+
 } //# NAMESPACE CASACORE - END
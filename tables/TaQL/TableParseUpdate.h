@@ -30,6 +30,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <memory>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -40,6 +41,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   class TaQLStyle;
   class TableExprId;
   class TableColumn;
+  class TableExprCompiled;
   template<class T> class ArrayColumn;
 
 
@@ -98,7 +100,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
     // Set the node expression (used by TableParseQuery::doInsert).
     void setNode (const TableExprNode& node)
-      { node_p = node; }
+      { node_p = node; compiled_p.reset(); }
     
     // Set the column name.
     void setColumnName (const String& name)
@@ -132,6 +134,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void updateColumn (TableColumn& col, ArrayColumn<Bool>& maskCol,
                        rownr_t row, const TableExprId& rowid);
 
+    // Test if the column can be updated for a block of rows at a time.
+    // That is the case if a Double column is updated without subscripts or
+    // masks and if the expression is a scalar arithmetic expression
+    // that can be fully compiled (see class TableExprCompiled) or a UDF
+    // supporting batch evaluation (see class UDFBase).
+    // If possible, the compiled expression is kept for updateBlock.
+    Bool canUpdateBlock (const TableColumn& col);
+
+    // Update the values in the given rows of the column with the values
+    // of the expression evaluated for the given row numbers.
+    // The rows to update are <src>startRow</src> till
+    // <src>startRow+rownrs.size()</src>.
+    // canUpdateBlock must have returned True.
+    void updateBlock (TableColumn& col, rownr_t startRow,
+                      const Vector<rownr_t>& rownrs);
+
   private:
     // Update the values in the columns (helpers of updateColumn).
     // It converts the data type of the expression to that opf the column.
@@ -178,6 +196,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TableExprNode       indexNode_p;
     TableExprNode       mask_p;
     TableExprNode       node_p;
+    std::shared_ptr<TableExprCompiled> compiled_p;
   };
 
 
@@ -26,6 +26,7 @@
 //# Includes
 #include <casacore/tables/TaQL/UDFBase.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/OS/DynLib.h>
 
 namespace casacore {
@@ -42,6 +43,7 @@ namespace casacore {
       itsNDim           (-2),
       itsIsConstant     (False),
       itsIsAggregate    (False),
+      itsHasBatch       (False),
       itsApplySelection (True)
   {}
 
@@ -115,6 +117,11 @@ namespace casacore {
     itsIsAggregate = isAggregate;
   }
 
+  void UDFBase::setBatch (Bool hasBatch)
+  {
+    itsHasBatch = hasBatch;
+  }
+
   Bool      UDFBase::getBool     (const TableExprId&)
     { throw TableInvExpr ("UDFBase::getBool not implemented"); }
   Int64     UDFBase::getInt      (const TableExprId&)
@@ -142,6 +149,40 @@ namespace casacore {
   MArray<MVTime>  UDFBase:: getArrayDate     (const TableExprId&)
     { throw TableInvExpr ("UDFBase::getArrayDate not implemented"); }
 
+  void UDFBase::getBoolBatch (const Vector<rownr_t>& rownrs, Bool* result)
+  {
+    TableExprId id;
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      id.setRownr (rownrs[i]);
+      result[i] = getBool (id);
+    }
+  }
+  void UDFBase::getIntBatch (const Vector<rownr_t>& rownrs, Int64* result)
+  {
+    TableExprId id;
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      id.setRownr (rownrs[i]);
+      result[i] = getInt (id);
+    }
+  }
+  void UDFBase::getDoubleBatch (const Vector<rownr_t>& rownrs, Double* result)
+  {
+    TableExprId id;
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      id.setRownr (rownrs[i]);
+      result[i] = getDouble (id);
+    }
+  }
+  void UDFBase::getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                     MArray<Double>* result)
+  {
+    TableExprId id;
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      id.setRownr (rownrs[i]);
+      result[i].reference (getArrayDouble (id));
+    }
+  }
+
   void UDFBase::recreateColumnObjects (const Vector<rownr_t>&)
   {}
 
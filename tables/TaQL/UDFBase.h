@@ -128,6 +128,16 @@ namespace casacore {
   //      </srcblock>
   //  </td>
   // </tr>
+  // <tr>
+  //  <td><src>getXXXBatch</src></td>
+  //  <td>these optional virtual functions evaluate the function for
+  //      a vector of row numbers at once. If implemented, the setup
+  //      function has to call <src>setBatch(True)</src> to tell TaQL
+  //      to use them. TaQL does so when evaluating a column of values
+  //      (e.g. in a projection or update). It can be much faster if the
+  //      UDF has an expensive setup per call.
+  //  </td>
+  // </tr>
   // </table>
   //
   // A UDF has to be made known to TaQL by adding it to the UDF registry with
@@ -261,6 +271,22 @@ namespace casacore {
     virtual MArray<MVTime>   getArrayDate     (const TableExprId& id);
     // </group>
 
+    // Evaluate the function for the given rows at once and store the results
+    // in the given buffer, which has length <src>rownrs.size()</src>.
+    // TaQL only uses these functions if the UDF's setup function has
+    // called <src>setBatch(True)</src>. The UDF can then amortize its
+    // per-call overhead (e.g. setting up a measures frame and conversion)
+    // over many rows.
+    // Their default implementations call the row-wise get function per row.
+    // <group>
+    virtual void getBoolBatch   (const Vector<rownr_t>& rownrs, Bool* result);
+    virtual void getIntBatch    (const Vector<rownr_t>& rownrs, Int64* result);
+    virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Double* result);
+    virtual void getArrayDoubleBatch (const Vector<rownr_t>& rownrs,
+                                      MArray<Double>* result);
+    // </group>
+
     // Get the unit.
     const String& getUnit() const
       { return itsUnit; }
@@ -314,6 +340,12 @@ namespace casacore {
     // Define if the UDF is an aggregate function (usually used in GROUPBY).
     void setAggregate (Bool isAggregate);
 
+    // Define if the UDF implements the batch get functions, so TaQL can
+    // evaluate it for a block of rows at a time.
+    // If this function is not called by the setup function of the derived
+    // class, the UDF is evaluated row by row.
+    void setBatch (Bool hasBatch);
+
     // Let a derived class recreate its column objects in case a selection
     // has to be applied.
     // The default implementation does nothing.
@@ -350,6 +382,10 @@ namespace casacore {
     Bool isAggregate() const
       { return itsIsAggregate; }
 
+    // Tell if the UDF implements the batch get functions.
+    Bool hasBatch() const
+      { return itsHasBatch; }
+
     // Do not apply the selection.
     void disableApplySelection()
       { itsApplySelection = False; }
@@ -373,6 +409,7 @@ namespace casacore {
     Record                         itsAttributes;
     Bool                           itsIsConstant;
     Bool                           itsIsAggregate;
+    Bool                           itsHasBatch;
     Bool                           itsApplySelection;
     //# The registry is used for two purposes:
     //# 1. It is a map of known function names (lib.func) to funcptr.
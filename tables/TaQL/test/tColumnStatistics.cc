@@ -0,0 +1,166 @@
+//# tColumnStatistics.cc: Test program for class ColumnStatistics and TableExprPlanner
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ColumnStatistics.h>
+#include <casacore/tables/TaQL/ExprPlanner.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeSet.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for classes ColumnStatistics and TableExprPlanner.
+// It checks the statistics and that the conjuncts of a WHERE expression
+// are ordered by rank without changing the result, also if conjuncts
+// act as a guard for the next ones.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ai"));
+  td.addColumn (ScalarColumnDesc<Double> ("u"));
+  td.addColumn (ScalarColumnDesc<String> ("s"));
+  td.addColumn (ArrayColumnDesc<Float> ("arr"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> aicol (tab, "ai");
+  ScalarColumn<Double> ucol (tab, "u");
+  ScalarColumn<String> scol (tab, "s");
+  ArrayColumn<Float> arrcol (tab, "arr");
+  for (uInt i=0; i<nrow; ++i) {
+    aicol.put (i, Int(i%10));
+    ucol.put (i, Double(i));
+    scol.put (i, "s" + String::toString(i%4));
+    // Only the odd rows have a third element.
+    Vector<Float> vec(i%2 == 0 ? 1 : 5, Float(i));
+    arrcol.put (i, vec);
+  }
+}
+
+void testStatistics (const String& name, uInt nrow)
+{
+  {
+    Table tab (name, Table::Update);
+    ColumnStatistics::update (tab);
+    // An array column cannot have statistics.
+    Bool caught = False;
+    try {
+      ColumnStatistics::update (tab, Vector<String>(1, "arr"));
+    } catch (const TableError&) {
+      caught = True;
+    }
+    AlwaysAssertExit (caught);
+  }
+  // Check the persistent statistics.
+  Table tab (name);
+  ColumnStatistics ai = ColumnStatistics::get (tab, "ai");
+  AlwaysAssertExit (ai.isValid()  &&  ai.isNumeric());
+  AlwaysAssertExit (ai.nrow() == nrow);
+  AlwaysAssertExit (ai.ndistinct() >= 9  &&  ai.ndistinct() <= 11);
+  AlwaysAssertExit (ai.minimum() == 0  &&  ai.maximum() == 9);
+  AlwaysAssertExit (uInt(sum(ai.histogram())) == nrow);
+  AlwaysAssertExit (near (ai.fractionEqual(3.), 0.1, 0.1));
+  AlwaysAssertExit (ai.fractionEqual(10.) == 0);
+  ColumnStatistics u = ColumnStatistics::get (tab, "u");
+  AlwaysAssertExit (u.minimum() == 0  &&  u.maximum() == nrow-1);
+  AlwaysAssertExit (near (u.fractionInRange (0, (nrow-1)/2.), 0.5, 0.05));
+  AlwaysAssertExit (u.fractionInRange (nrow, 2*nrow) == 0);
+  ColumnStatistics s = ColumnStatistics::get (tab, "s");
+  AlwaysAssertExit (s.isValid()  &&  !s.isNumeric());
+  AlwaysAssertExit (near (s.fractionEqual(), 0.25, 0.05));
+  AlwaysAssertExit (! ColumnStatistics::get(tab, "arr").isValid());
+  {
+    Table rwtab (name, Table::Update);
+    ColumnStatistics::remove (rwtab, "s");
+    AlwaysAssertExit (! ColumnStatistics::get(rwtab, "s").isValid());
+  }
+}
+
+void testPlanner (const String& name, uInt nrow)
+{
+  Table tab (name);
+  TableExprNode ai = tab.col("ai");
+  TableExprNode u  = tab.col("u");
+  // An expensive conjunct given first.
+  TableExprNode expr = (sin(u) + cos(u) > 0) && (ai == 3) && (u < 10);
+  Vector<Bool> before(nrow);
+  for (uInt i=0; i<nrow; ++i) {
+    before[i] = expr.getBool (i);
+  }
+  TableExprPlanner planner;
+  Double sel = planner.selectivity (expr.getRep().get());
+  AlwaysAssertExit (sel > 0  &&  sel < 0.01);
+  AlwaysAssertExit (planner.orderConjuncts (expr));
+  // Now u<10 is the most selective and ai==3 is next.
+  AlwaysAssertExit (! planner.orderConjuncts (expr));
+  for (uInt i=0; i<nrow; ++i) {
+    AlwaysAssertExit (expr.getBool(i) == before[i]);
+  }
+  // A single conjunct is not changed.
+  TableExprNode single = ai == 3;
+  AlwaysAssertExit (! planner.orderConjuncts (single));
+  // Guarding conjuncts keep their order; only ai==3 is moved to the front.
+  // Only the odd rows have a third element, so arr[3] would throw for
+  // the even rows.
+  TableExprNode arr = tab.col("arr");
+  TableExprNode elem3 = arr(TableExprNodeSet(IPosition(1,2)));
+  TableExprNode guard = (nelements(arr) > 2) && (elem3 > 0) && (ai == 3);
+  AlwaysAssertExit (planner.orderConjuncts (guard));
+  AlwaysAssertExit (! planner.orderConjuncts (guard));
+  AlwaysAssertExit (tab(guard).nrow() == nrow/10);
+  // No conjunct can be moved.
+  TableExprNode guard2 = (ndim(arr) == 1) && (nelements(arr) > 2) &&
+                         (elem3 > 0);
+  AlwaysAssertExit (! planner.orderConjuncts (guard2));
+  AlwaysAssertExit (tab(guard2).nrow() == nrow/2);
+}
+
+int main()
+{
+  try {
+    uInt nrow = 1000;
+    makeTable ("tColumnStatistics_tmp.tab", nrow);
+    testStatistics ("tColumnStatistics_tmp.tab", nrow);
+    testPlanner ("tColumnStatistics_tmp.tab", nrow);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,187 @@
+//# tExprCSE.cc: Test program for class TableExprCSE
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ExprCSE.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TableExprCSE.
+// It checks that the common subexpressions are found and that sharing
+// them does not change the results.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ai"));
+  td.addColumn (ScalarColumnDesc<Double> ("u"));
+  td.addColumn (ScalarColumnDesc<Double> ("v"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> aicol (tab, "ai");
+  ScalarColumn<Double> ucol (tab, "u");
+  ScalarColumn<Double> vcol (tab, "v");
+  for (uInt i=0; i<nrow; ++i) {
+    aicol.put (i, Int(i%10));
+    ucol.put (i, 10. * sin(i*0.1));
+    vcol.put (i, -20. * cos(i*0.2));
+  }
+}
+
+// Get the values of the expressions for all rows.
+Vector<Double> getValues (const TableExprNode& expr, uInt nrow)
+{
+  Vector<Double> vals(nrow);
+  for (uInt i=0; i<nrow; ++i) {
+    vals[i] = expr.getDouble (i);
+  }
+  return vals;
+}
+
+Vector<Bool> getBools (const TableExprNode& expr, uInt nrow)
+{
+  Vector<Bool> vals(nrow);
+  for (uInt i=0; i<nrow; ++i) {
+    vals[i] = expr.getBool (i);
+  }
+  return vals;
+}
+
+void testShared (const Table& tab)
+{
+  uInt nrow = tab.nrow();
+  TableExprNode u = tab.col("u");
+  TableExprNode v = tab.col("v");
+  TableExprNode e1 = sqrt(u*u + v*v) > 10;
+  TableExprNode e2 = sqrt(u*u + v*v) / 1000;
+  TableExprNode e3 = u*u + 1;
+  TableExprNode e4 = tab.col("ai") + 1;
+  Vector<Bool>   exp1 = getBools (e1, nrow);
+  Vector<Double> exp2 = getValues (e2, nrow);
+  Vector<Double> exp3 = getValues (e3, nrow);
+  Vector<Double> exp4 = getValues (e4, nrow);
+  const TableExprNodeRep* rep4 = e4.getNodeRep();
+  TableExprCSE cse;
+  std::vector<TableExprNode*> exprs {&e1, &e2, &e3, &e4};
+  // sqrt(u*u+v*v) and u*u (also used outside the sqrt) are shared;
+  // the parts of the sqrt are not shared.
+  AlwaysAssertExit (cse.apply (exprs) == 2);
+  AlwaysAssertExit (cse.nshared() == 2);
+  AlwaysAssertExit (e4.getNodeRep() == rep4);
+  cse.show (cout);
+  // The results must be the same, also in reversed row order.
+  for (int iter=0; iter<2; ++iter) {
+    AlwaysAssertExit (allEQ (getBools (e1, nrow), exp1));
+    AlwaysAssertExit (allEQ (getValues (e2, nrow), exp2));
+    AlwaysAssertExit (allEQ (getValues (e3, nrow), exp3));
+    AlwaysAssertExit (allEQ (getValues (e4, nrow), exp4));
+    for (uInt i=nrow; i>0; --i) {
+      AlwaysAssertExit (e1.getBool(i-1) == exp1[i-1]);
+      AlwaysAssertExit (e2.getDouble(i-1) == exp2[i-1]);
+    }
+    cse.clearCaches();
+  }
+  // A selection using the shared expression gives the same rows.
+  Table sel = tab(e1);
+  uInt nsel = 0;
+  for (uInt i=0; i<nrow; ++i) {
+    if (exp1[i]) ++nsel;
+  }
+  AlwaysAssertExit (sel.nrow() == nsel);
+}
+
+void testWholeExpr (const Table& tab)
+{
+  uInt nrow = tab.nrow();
+  TableExprNode u = tab.col("u");
+  // An entire expression is shared.
+  TableExprNode e1 = abs(u) * 2;
+  TableExprNode e2 = abs(u) * 2;
+  TableExprNode e3 = abs(u) * 3;
+  Vector<Double> exp1 = getValues (e1, nrow);
+  Vector<Double> exp3 = getValues (e3, nrow);
+  TableExprCSE cse;
+  std::vector<TableExprNode*> exprs {&e1, &e2, &e3};
+  AlwaysAssertExit (cse.apply (exprs) == 2);
+  AlwaysAssertExit (e1.getNodeRep() == e2.getNodeRep());
+  AlwaysAssertExit (allEQ (getValues (e1, nrow), exp1));
+  AlwaysAssertExit (allEQ (getValues (e2, nrow), exp1));
+  AlwaysAssertExit (allEQ (getValues (e3, nrow), exp3));
+}
+
+void testNotShared (const Table& tab)
+{
+  TableExprNode u = tab.col("u");
+  TableExprNode v = tab.col("v");
+  // Different operands, columns, constants and random numbers
+  // are not shared.
+  TableExprNode e1 = u + v;
+  TableExprNode e2 = v + u;
+  TableExprNode e3 = u + 1.5;
+  TableExprNode e4 = u + 2.5;
+  TableExprNode e5 = TableExprNode::newRandomNode(TableExprInfo(tab)) + 1;
+  TableExprNode e6 = TableExprNode::newRandomNode(TableExprInfo(tab)) + 1;
+  TableExprCSE cse;
+  std::vector<TableExprNode*> exprs {&e1, &e2, &e3, &e4, &e5, &e6};
+  AlwaysAssertExit (cse.apply (exprs) == 0);
+  // String constants containing the separators used in the keys
+  // must not result in the same key.
+  TableExprNode s1 = iif (u > 0, String("a\",K4:\"b"), String("c"));
+  TableExprNode s2 = iif (u > 0, String("a"), String("b\",K4:\"c"));
+  TableExprCSE cse2;
+  std::vector<TableExprNode*> exprs2 {&s1, &s2};
+  // Only the condition is shared.
+  AlwaysAssertExit (cse2.apply (exprs2) == 1);
+  AlwaysAssertExit (s1.getNodeRep() != s2.getNodeRep());
+  AlwaysAssertExit (s1.getString(1) != s2.getString(1));
+}
+
+int main()
+{
+  try {
+    makeTable ("tExprCSE_tmp.tab", 100);
+    Table tab ("tExprCSE_tmp.tab");
+    testShared (tab);
+    testWholeExpr (tab);
+    testNotShared (tab);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
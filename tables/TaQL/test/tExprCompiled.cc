@@ -0,0 +1,235 @@
+//# tExprCompiled.cc: Test program for class TableExprCompiled
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/ExprCompiled.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/iostream.h>
+#include <cstdlib>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TableExprCompiled.
+// It checks that the compiled evaluation gives the same results as the
+// row-wise interpreted evaluation.
+// If a number of rows is given as argument, it also times both evaluations
+// for a typical uv-distance expression.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ai"));
+  td.addColumn (ScalarColumnDesc<Int64> ("al"));
+  td.addColumn (ScalarColumnDesc<Float> ("af"));
+  td.addColumn (ScalarColumnDesc<Double> ("u"));
+  td.addColumn (ScalarColumnDesc<Double> ("v"));
+  td.addColumn (ScalarColumnDesc<Double> ("freq"));
+  td.addColumn (ScalarColumnDesc<Double> ("res"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> aicol (tab, "ai");
+  ScalarColumn<Int64> alcol (tab, "al");
+  ScalarColumn<Float> afcol (tab, "af");
+  ScalarColumn<Double> ucol (tab, "u");
+  ScalarColumn<Double> vcol (tab, "v");
+  ScalarColumn<Double> fcol (tab, "freq");
+  for (uInt i=0; i<nrow; ++i) {
+    aicol.put (i, Int(i%100) - 50);
+    alcol.put (i, (Int64(1) << 60) + i);
+    afcol.put (i, i/7.);
+    ucol.put (i, 10. * sin(i*0.01));
+    vcol.put (i, -20. * cos(i*0.02));
+    fcol.put (i, 1e8 + i*1e3);
+  }
+}
+
+// Compare the compiled result with the interpreted result.
+void check (const TableExprNode& expr, const Vector<rownr_t>& rownrs,
+            Bool fullyCompiled=True)
+{
+  AlwaysAssertExit (TableExprCompiled::canCompile (*expr.getNodeRep()));
+  TableExprCompiled prog (expr.getRep().get());
+  AlwaysAssertExit ((prog.nInterpreted() == 0) == fullyCompiled);
+  Array<Double> res = prog.getColumnDouble (rownrs);
+  AlwaysAssertExit (res.size() == rownrs.size());
+  TableExprId id;
+  Double val;
+  uInt i = 0;
+  for (Array<Double>::const_iterator iter=res.begin();
+       iter!=res.end(); ++iter, ++i) {
+    id.setRownr (rownrs[i]);
+    expr.get (id, val);
+    if (! near (*iter, val, 1e-13)) {
+      prog.show (cout);
+      cout << "Mismatch in row " << rownrs[i] << ": " << *iter
+           << " <> " << val << endl;
+      AlwaysAssertExit (False);
+    }
+  }
+}
+
+void testExpr (const Table& tab)
+{
+  Vector<rownr_t> rownrs (tab.rowNumbers());
+  // Use some non-contiguous rows as well.
+  Vector<rownr_t> oddRows (rownrs.size() / 2);
+  for (uInt i=0; i<oddRows.size(); ++i) {
+    oddRows[i] = 2*i + 1;
+  }
+  TableExprNode ai (tab.col("ai"));
+  TableExprNode af (tab.col("af"));
+  TableExprNode u (tab.col("u"));
+  TableExprNode v (tab.col("v"));
+  TableExprNode freq (tab.col("freq"));
+  // Columns and constants alone are not worth compiling.
+  AlwaysAssertExit (! TableExprCompiled::canCompile (*u.getNodeRep()));
+  TableExprNode cnst (TableExprNode(2.) + 3.);
+  AlwaysAssertExit (! TableExprCompiled::canCompile (*cnst.getNodeRep()));
+  // Strings cannot be compiled.
+  TableExprNode str (TableExprNode("a") + "b");
+  AlwaysAssertExit (! TableExprCompiled::canCompile (*str.getNodeRep()));
+  // The typical uv-distance in wavelengths.
+  check (sqrt(u*u + v*v) * freq / 299792458., rownrs);
+  check (sqrt(u*u + v*v) * freq / 299792458., oddRows);
+  // Integer arithmetic.
+  check (ai*3 - ai + 7, rownrs);
+  check (-ai + ai*1000, oddRows);
+  // Integer arithmetic which might not fit in a Double is not compiled.
+  TableExprNode al (tab.col("al"));
+  AlwaysAssertExit (! TableExprCompiled::canCompile (*(al+1).getNodeRep()));
+  AlwaysAssertExit (! TableExprCompiled::canCompile
+                    (*(-ai + ai*ai).getNodeRep()));
+  check ((al+1) * 2., rownrs, False);
+  // The program is compiled once and kept in the node.
+  TableExprNode expr (u*v + ai);
+  for (uInt i=0; i<2; ++i) {
+    Array<Double> res = expr.getRep()->getColumnDouble (oddRows);
+    Array<Double> exp (res.shape());
+    TableExprId id;
+    for (uInt j=0; j<oddRows.size(); ++j) {
+      id.setRownr (oddRows[j]);
+      exp.data()[j] = expr.getDouble (id);
+    }
+    AlwaysAssertExit (allNear (res, exp, 1e-13));
+  }
+  // Mixed types including a Float column.
+  check (af*ai - 2.5, rownrs);
+  check (2. / (af+1), rownrs);
+  check (freq % 7., rownrs);
+  check (-u % 3., rownrs);
+  // Functions.
+  check (sin(u) + cos(v) + tan(u/100), rownrs);
+  check (sinh(u/10) + cosh(v/10) + tanh(u), rownrs);
+  check (asin(u/10) + acos(v/20) + atan(u), rownrs);
+  check (atan2(u, v) + pow(abs(u), 1.5) + square(v) + cube(u), rownrs);
+  check (exp(u/10) + log(abs(v)+1) + log10(freq), rownrs);
+  check (min(u, v) + max(u, 3.) + sign(v), rownrs);
+  check (round(u) + floor(v) + ceil(u*v) + fmod(freq, 13.), rownrs);
+  // A unit conversion.
+  check (u.useUnit("m").useUnit("km") * 2., rownrs);
+  // An uncompilable subexpression is evaluated by the interpreter.
+  check (iif(u > v, u, v) * 2., rownrs, False);
+  check ((u*2 + iif(ai > 0, u, 1.)) / freq, oddRows, False);
+}
+
+void testUpdate (const String& name)
+{
+  // Update all rows and a selection. Both use block-wise evaluation.
+  tableCommand ("update " + name + " set res = sqrt(u*u+v*v)*freq/c()");
+  tableCommand ("update " + name + " set res = u*2 - v where ai > 0");
+  Table tab (name);
+  ScalarColumn<Double> ucol (tab, "u");
+  ScalarColumn<Double> vcol (tab, "v");
+  ScalarColumn<Double> fcol (tab, "freq");
+  ScalarColumn<Double> rcol (tab, "res");
+  ScalarColumn<Int> aicol (tab, "ai");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (aicol(i) > 0) {
+      AlwaysAssertExit (near (rcol(i), ucol(i)*2 - vcol(i), 1e-13));
+    } else {
+      AlwaysAssertExit (near (rcol(i), sqrt(ucol(i)*ucol(i) + vcol(i)*vcol(i)) *
+                              fcol(i) / 299792458., 1e-13));
+    }
+  }
+}
+
+void timeExpr (const Table& tab)
+{
+  Vector<rownr_t> rownrs (tab.rowNumbers());
+  TableExprNode u (tab.col("u"));
+  TableExprNode v (tab.col("v"));
+  TableExprNode freq (tab.col("freq"));
+  TableExprNode expr (sqrt(u*u + v*v) * freq / 299792458.);
+  Timer timer;
+  TableExprId id;
+  Double sum1 = 0;
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    id.setRownr (rownrs[i]);
+    sum1 += expr.getDouble (id);
+  }
+  timer.show ("interpreted");
+  timer.mark();
+  TableExprCompiled prog (expr.getRep().get());
+  Double sum2 = sum (prog.getColumnDouble (rownrs));
+  timer.show ("compiled   ");
+  AlwaysAssertExit (near (sum1, sum2, 1e-10));
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt nrow = 5000;
+    Bool doTime = argc > 1;
+    if (doTime) {
+      nrow = std::atoi (argv[1]);
+    }
+    makeTable ("tExprCompiled_tmp.data", nrow);
+    Table tab ("tExprCompiled_tmp.data");
+    if (doTime) {
+      timeExpr (tab);
+    } else {
+      testExpr (tab);
+      tab = Table();
+      testUpdate ("tExprCompiled_tmp.data");
+    }
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -283,6 +283,75 @@ void doDouble()
              recs, fractile(vecd, 0.65), "fractileDouble");
 }
 
+// Check the result of an approximate aggregate function.
+void checkApprox (const TableExprNode& expr,
+                  const vector<Record>& recs,
+                  Double expVal, Double tolerance, const String& str)
+{
+  cout << "Test approx " << str << endl;
+  TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
+    (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
+  std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
+  AlwaysAssertExit (! func->isLazy());
+  for (uInt i=0; i<recs.size(); ++i) {
+    TableExprId id(recs[i]);
+    func->apply (id);
+  }
+  func->finish();
+  Double val = func->getDouble();
+  if (abs(val - expVal) > tolerance) {
+    foundError = True;
+    cout << str << ": found value " << val << "; expected "
+         << expVal << " +- " << tolerance << endl;
+  }
+}
+
+void doApprox()
+{
+  // Values with 1000 distinct integers in a scrambled order.
+  uInt nval = 100000;
+  Vector<Double> vecd(nval);
+  vector<Record> recs(nval);
+  vector<Record> recsStr(nval);
+  for (uInt i=0; i<nval; ++i) {
+    Int v = (i * 7919) % 1000;
+    vecd[i] = (uInt64(i) * 104729) % nval;
+    recs[i].define ("fldi", v);
+    recs[i].define ("fldd", vecd[i]);
+    recsStr[i].define ("flds", "s" + String::toString(v%500));
+  }
+  TableExprNode expri = makeRecordExpr (recs[0], "fldi");
+  TableExprNode exprd = makeRecordExpr (recs[0], "fldd");
+  TableExprNode exprs = makeRecordExpr (recsStr[0], "flds");
+  // Small numbers of distinct values are nearly exact.
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxcountdistinctFUNC, expri),
+               recs, 1000, 10, "countdistinctInt");
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxcountdistinctFUNC, exprs),
+               recsStr, 500, 5, "countdistinctString");
+  // All values are distinct; the standard error is 1.6%.
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxcountdistinctFUNC, exprd),
+               recs, nval, 0.05*nval, "countdistinctDouble");
+  // The rank error of the fractiles is about 1%.
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxmedianFUNC, exprd),
+               recs, median(vecd), 0.02*nval, "medianDouble");
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxfractileFUNC, exprd, 0.1),
+               recs, fractile(vecd, 0.1), 0.02*nval, "fractileDouble");
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxfractileFUNC, expri, 0.9),
+               recs, 900, 20, "fractileInt");
+  // For a few values the fractile is exact.
+  vector<Record> recsSmall (recs.begin(), recs.begin() + 100);
+  Vector<Double> vecSmall (vecd(Slice(0, 100)));
+  checkApprox (TableExprNode::newFunctionNode
+               (TableExprFuncNode::gapproxfractileFUNC, exprd, 0.3),
+               recsSmall, fractile(vecSmall, 0.3), 0, "fractileSmall");
+}
+
 void doDComplex()
 {
   // Define a Vector with values.
@@ -474,6 +543,7 @@ int main()
     doBool();
     doInt();
     doDouble();
+    doApprox();
     doDComplex();
     cout << "test Array aggregation ..." << endl;
     doBoolArr();
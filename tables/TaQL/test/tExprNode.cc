@@ -27,6 +27,10 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -1118,11 +1122,137 @@ void doShow()
   expr2.show (cout);
 }
 
+void doSample()
+{
+  // Make a table with 10000 rows.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ROW"));
+  SetupNewTable newtab ("tExprNode_tmp.data", td, Table::New);
+  Table tab (newtab, 10000);
+  ScalarColumn<Int> rowCol (tab, "ROW");
+  for (uInt i=0; i<10000; ++i) {
+    rowCol.put (i, i);
+  }
+  // Sample about 25% in blocks of 100 rows.
+  TableExprNode samp = TableExprNode::newSampleNode (TableExprInfo(tab),
+                                                     0.25, 7, 100);
+  Table sel = tab(samp);
+  cout << "sample selected " << sel.nrow() << " rows" << endl;
+  AlwaysAssertExit (sel.nrow() > 1000  &&  sel.nrow() < 4000);
+  AlwaysAssertExit (sel.nrow() % 100 == 0);
+  // The selection must match the expression value and be reproducible.
+  Vector<rownr_t> rows = sel.rowNumbers();
+  Vector<Bool> inSel(10000, False);
+  for (rownr_t row : rows) {
+    inSel[row] = True;
+  }
+  for (uInt i=0; i<10000; ++i) {
+    AlwaysAssertExit (samp.getBool(i) == inSel[i]);
+    AlwaysAssertExit (inSel[i] == inSel[i - i%100]);
+  }
+  AlwaysAssertExit (allEQ (tab(samp).rowNumbers(), rows));
+  // Another seed gives another sample.
+  TableExprNode samp2 = TableExprNode::newSampleNode (TableExprInfo(tab),
+                                                      0.25, 8, 100);
+  AlwaysAssertExit (anyNE (inSel, samp2.getColumnBool(tab.rowNumbers())));
+  // Combine with another condition.
+  Table sel2 = tab(tab.col("ROW") >= 5000  &&  samp);
+  for (rownr_t row : sel2.rowNumbers()) {
+    AlwaysAssertExit (row >= 5000  &&  inSel[row]);
+  }
+  rownr_t nr = 0;
+  for (rownr_t row : rows) {
+    if (row >= 5000) nr++;
+  }
+  AlwaysAssertExit (sel2.nrow() == nr);
+  checkFailure ("sample fraction", TableExprNode::newSampleNode
+                (TableExprInfo(tab), 1.5));
+}
+
+void checkRegex (const String& rx, Bool isGlob, const String& prefix)
+{
+  // The fast match must give the same result as the regex itself.
+  const char* strs[] = {"", "a", "abc", "abcd", "xabc", "abcabc", "a.c",
+                        "a*c", "3C273", "3C84", "abxcd", "ab", "bc", "ac",
+                        "axc", "abbc", "a|b", "CasA", "casa", "a+b"};
+  TaqlRegex trx ((Regex(rx)));
+  Regex regex(rx);
+  AlwaysAssertExit (trx.isGlob() == isGlob);
+  AlwaysAssertExit (trx.prefix() == prefix);
+  for (const char* str : strs) {
+    AlwaysAssertExit (trx.match(str) == String(str).matches(regex));
+  }
+  Vector<String> vec(sizeof(strs) / sizeof(char*));
+  for (size_t i=0; i<vec.size(); ++i) {
+    vec[i] = strs[i];
+  }
+  Vector<Bool> res(vec.size());
+  trx.match (vec.data(), vec.size(), res.data(), True);
+  for (size_t i=0; i<vec.size(); ++i) {
+    AlwaysAssertExit (res[i] != vec[i].matches(regex));
+  }
+}
+
+void doRegex()
+{
+  // Check which regexes can be matched with plain string operations.
+  checkRegex ("abc", True, "abc");
+  checkRegex (Regex::fromPattern("abc*"), True, "abc");
+  checkRegex (Regex::fromPattern("*abc"), True, "");
+  checkRegex (Regex::fromPattern("a*c"), True, "a");
+  checkRegex (Regex::fromSQLPattern("%b%"), True, "");
+  checkRegex (Regex::fromSQLPattern("a%b%c"), True, "a");
+  checkRegex (Regex::fromSQLPattern("a.c%"), True, "a.c");
+  checkRegex (Regex::fromPattern("a*c*"), True, "a");
+  checkRegex (Regex::fromPattern("a\\*c"), True, "a*c");
+  checkRegex (Regex::fromPattern("3C*"), True, "3C");
+  checkRegex ("a\\|b", True, "a|b");
+  checkRegex ("a\\+b", True, "a+b");
+  // Regexes needing a full match; they might use a prefix.
+  checkRegex (Regex::fromPattern("a?c"), False, "a");
+  checkRegex (Regex::fromSQLPattern("a_c%"), False, "a");
+  checkRegex ("abc*", False, "ab");
+  checkRegex ("ab+c", False, "a");
+  checkRegex ("ab{1,2}c", False, "a");
+  checkRegex ("a\\.*", False, "a");
+  checkRegex ("a\\w*", False, "a");
+  checkRegex ("abc|xabc", False, "");
+  // An alternative anywhere disables the prefix.
+  checkRegex ("a(b|x)c", False, "");
+  checkRegex ("[aA].*", False, "");
+  checkRegex ("3C[0-9]+", False, "3C");
+  checkRegex (Regex::makeCaseInsensitive("casa"), False, "");
+  checkRegex (".*", True, "");
+  // Select from a table using the batch evaluation of the match.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab ("tExprNode_tmp.data", td, Table::New);
+  Table tab (newtab, 5000);
+  ScalarColumn<String> nameCol (tab, "NAME");
+  for (uInt i=0; i<5000; ++i) {
+    nameCol.put (i, "3C" + String::toString(i));
+  }
+  Table sel = tab(tab.col("NAME") == pattern("3C1*"));
+  AlwaysAssertExit (sel.nrow() == 1111);
+  sel = tab(tab.col("NAME") != sqlpattern("%9"));
+  AlwaysAssertExit (sel.nrow() == 4500);
+  sel = tab(tab.col("NAME") == TableExprNode(Regex("3C4[0-9]")));
+  AlwaysAssertExit (sel.nrow() == 10);
+  // A limit evaluates row by row.
+  sel = tab(tab.col("NAME") == pattern("3C1*"), 5);
+  AlwaysAssertExit (sel.nrow() == 5  &&  sel.rowNumbers()[4] == 13);
+  Vector<Bool> res ((tab.col("NAME") ==
+                     pattern("*0")).getColumnBool(tab.rowNumbers()));
+  AlwaysAssertExit (ntrue(res) == 500  &&  res[10]  &&  !res[11]);
+}
+
 int main()
 {
   try {
     doIt();
     doShow();
+    doSample();
+    doRegex();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
@@ -34,6 +34,7 @@
 #include <casacore/tables/TaQL/UDFBase.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/casa/Utilities/Assert.h>
 
 using namespace casacore;
@@ -82,10 +83,37 @@ public:
   }
 };
 
+class TestUDFBatch: public UDFBase
+{
+public:
+  TestUDFBatch() {}
+  static UDFBase* makeObject (const String&) { return new TestUDFBatch(); }
+  virtual void setup (const Table&, const TaQLStyle&)
+  {
+    AlwaysAssert (operands().size() == 1, AipsError);
+    setDataType (TableExprNodeRep::NTDouble);
+    setNDim (0);       // scalar
+    setBatch (True);   // batch functions are implemented
+  }
+  Double getDouble (const TableExprId& id)
+    { return 2. * operands()[0]->getInt(id); }
+  void getDoubleBatch (const Vector<rownr_t>& rownrs, Double* result)
+  {
+    theirNBatch++;
+    Array<Int> vals (operands()[0]->getColumnInt (rownrs));
+    for (uInt i=0; i<rownrs.size(); ++i) {
+      result[i] = 2. * vals.data()[i];
+    }
+  }
+  static uInt theirNBatch;
+};
+uInt TestUDFBatch::theirNBatch = 0;
+
 void makeTable()
 {
   TableDesc td;
   td.addColumn (ScalarColumnDesc<Int>("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Double>("DVAL"));
   SetupNewTable newtab("tExprNodeUDF_tmp.tab", td, Table::New);
   Table tab(newtab);
   ScalarColumn<Int> ant1(tab, "ANTENNA1");
@@ -100,6 +128,7 @@ int main()
   try {
     UDFBase::registerUDF ("Test.UDF", TestUDF::makeObject);
     UDFBase::registerUDF ("Test.UDFAggr", TestUDFAggr::makeObject);
+    UDFBase::registerUDF ("Test.UDFBatch", TestUDFBatch::makeObject);
     makeTable();
     Table tab("tExprNodeUDF_tmp.tab");
     TableExprInfo tabInfo(tab);
@@ -143,6 +172,30 @@ int main()
       Vector<Int> colval (ScalarColumn<Int>(tab, "ANTENNA1").getColumn());
       AlwaysAssertExit (val == sum(colval*colval*colval));
     }
+    {
+      // Test a user defined function evaluating blocks of rows.
+      TableExprNode node1(tab.col("ANTENNA1"));
+      TableExprNodeSet set;
+      set.add (TableExprNodeSetElem(node1));
+      TableExprNode node2(TableExprNode::newUDFNode ("Test.UDFBatch", set,
+                                                     tabInfo));
+      // Used in an expression, it is evaluated per block.
+      TableExprNode expr (node2*3. + 1.);
+      Array<Double> vals = expr.getColumnDouble (tab.rowNumbers());
+      AlwaysAssertExit (TestUDFBatch::theirNBatch == 1);
+      for (uInt i=0; i<tab.nrow(); ++i) {
+        AlwaysAssertExit (vals.data()[i] == 6.*(i%3) + 1);
+      }
+      // A projection or update uses the batch function.
+      tab = Table();
+      tableCommand ("update tExprNodeUDF_tmp.tab set DVAL=Test.UDFBatch(ANTENNA1)");
+      AlwaysAssertExit (TestUDFBatch::theirNBatch == 2);
+      tab = Table("tExprNodeUDF_tmp.tab");
+      ScalarColumn<Double> dval(tab, "DVAL");
+      for (uInt i=0; i<tab.nrow(); ++i) {
+        AlwaysAssertExit (dval(i) == 2.*(i%3));
+      }
+    }
   } catch (std::exception& x) {
     cout << "Unexpected exception " << x.what() << endl;
     return 1;
@@ -384,6 +384,28 @@ void doTestPartial()
   aresd = 1.; aresd(1,1) = 71.4213; aresd(2,3) = 0.;
   mad = partialRmss(MArray<double>(arrd,mask), IPosition(1,0));
   AlwaysAssertExit (allNear(mad.array(), aresd, 1e-5) && allEQ(mad.mask(), mres));
+  // Use a large non-contiguous array, so it is done in parallel.
+  // Masking every 3rd element must give the same result as an unmasked
+  // array with those elements set to zero.
+  Cube<Int> big(40,50,60);
+  Cube<Bool> bigMask(big.shape());
+  Cube<Int> bigZero(big.shape());
+  for (uInt i=0; i<big.size(); ++i) {
+    big.data()[i] = i%17;
+    bigMask.data()[i] = (i%3 == 0);
+    bigZero.data()[i] = (i%3 == 0  ?  0 : i%17);
+  }
+  Slicer slicer(IPosition(3,1,0,2), IPosition(3,38,50,55));
+  MArray<Int> bigma(big(slicer), bigMask(slicer));
+  for (uInt i=0; i<3; ++i) {
+    IPosition axes(2, i, (i+1)%3);
+    MArray<Int> sums (partialSums (bigma, axes));
+    AlwaysAssertExit (allEQ(sums.array(), partialSums(bigZero(slicer), axes)));
+    AlwaysAssertExit (allEQ(sums.mask(), False));
+    MArray<Int> maxs (partialMaxs (bigma, IPosition(1,i)));
+    AlwaysAssertExit (allEQ(maxs.array(), partialMaxs(bigZero(slicer),
+                                                      IPosition(1,i))));
+  }
 }
 
 void doTestBoxed()
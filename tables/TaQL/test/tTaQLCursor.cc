@@ -0,0 +1,128 @@
+//# tTaQLCursor.cc: Test program for class TaQLCursor
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLCursor.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TaQLCursor.
+// It checks that the blocks contain the same values as the result of
+// tableCommand.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("SCAN"));
+  td.addColumn (ScalarColumnDesc<Double> ("VALUE"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> scanCol (tab, "SCAN");
+  ScalarColumn<Double> valCol (tab, "VALUE");
+  for (uInt i=0; i<nrow; ++i) {
+    scanCol.put (i, i/10);
+    valCol.put (i, i%7);
+  }
+}
+
+// Iterate through the result of the command and compare the values of
+// the given column with the result of tableCommand.
+void check (const String& command, const String& colName,
+            rownr_t blockSize, Bool lazy)
+{
+  Table result = tableCommand(command).table();
+  Vector<Double> expected = ScalarColumn<Double>(result, colName).getColumn();
+  TaQLCursor cursor (command, blockSize);
+  AlwaysAssertExit (cursor.isLazy() == lazy);
+  AlwaysAssertExit (cursor.commandType() == "select");
+  AlwaysAssertExit (cursor.nrow() == result.nrow());
+  // Do it twice to check reset.
+  for (int i=0; i<2; ++i) {
+    rownr_t nrow = 0;
+    while (cursor.next()) {
+      const Table& block = cursor.block();
+      AlwaysAssertExit (cursor.blockStart() == nrow);
+      AlwaysAssertExit (block.nrow() > 0  &&  block.nrow() <= blockSize);
+      Vector<Double> values = ScalarColumn<Double>(block, colName).getColumn();
+      AlwaysAssertExit (allEQ (values,
+                               expected(Slice(nrow, block.nrow()))));
+      nrow += block.nrow();
+    }
+    AlwaysAssertExit (nrow == result.nrow());
+    AlwaysAssertExit (cursor.block().isNull());
+    cursor.reset();
+  }
+}
+
+void testCursor (const String& name)
+{
+  // Expressions are evaluated lazily, also after sorting and grouping.
+  check ("select SCAN, VALUE*2 as V2 from " + name + " where VALUE > 2",
+         "V2", 100, True);
+  check ("select VALUE+SCAN as V from " + name + " orderby VALUE desc, SCAN"
+         " limit 555", "V", 64, True);
+  check ("select gsum(VALUE) as V from " + name + " groupby SCAN",
+         "V", 7, True);
+  check ("select sqrt(VALUE) as V from " + name + " where SCAN > 1000",
+         "V", 10, True);
+  // DISTINCT and sorting on a projected column cannot be done lazily.
+  check ("select distinct VALUE*3 as V from " + name, "V", 3, False);
+  check ("select VALUE*3 as V from " + name + " orderby V", "V", 100, False);
+  // Plain columns are not evaluated, so they reference the selected rows.
+  check ("select VALUE from " + name + " where SCAN%3 == 0", "VALUE",
+         50, False);
+  // A CALC command does not give a table.
+  Bool failed = False;
+  try {
+    TaQLCursor cursor ("calc 1+2");
+  } catch (const TableParseError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    makeTable ("tTaQLCursor_tmp.data", 2345);
+    testCursor ("tTaQLCursor_tmp.data");
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
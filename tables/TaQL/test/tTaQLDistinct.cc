@@ -0,0 +1,133 @@
+//# tTaQLDistinct.cc: Test program for TaQL SELECT DISTINCT
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <cstdlib>
+#include <set>
+#include <tuple>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for TaQL SELECT DISTINCT, which uses hashing for scalar
+// columns. The result must contain the first row of each distinct key in
+// the original row order. The table has more rows than the chunk size
+// and the threshold for doing it in parallel.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ab"));
+  td.addColumn (ScalarColumnDesc<Double> ("ad"));
+  td.addColumn (ScalarColumnDesc<String> ("an"));
+  td.addColumn (ArrayColumnDesc<Int> ("arr", IPosition(1,2),
+                                      ColumnDesc::FixedShape));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> abcol (tab, "ab");
+  ScalarColumn<Double> adcol (tab, "ad");
+  ScalarColumn<String> ancol (tab, "an");
+  ArrayColumn<Int> arrcol (tab, "arr");
+  Vector<Int> arr(2);
+  for (uInt i=0; i<nrow; ++i) {
+    abcol.put (i, std::rand() % 50);
+    adcol.put (i, (std::rand() % 4) / 2.);
+    ancol.put (i, "s" + String::toString(std::rand() % 30));
+    arr = std::rand() % 3;
+    arrcol.put (i, arr);
+  }
+}
+
+// Get the rows expected for distinct ab, ad, an.
+Vector<rownr_t> expected (const Table& tab, Bool useAd, Bool useAn)
+{
+  Vector<Int> ab = ScalarColumn<Int>(tab, "ab").getColumn();
+  Vector<Double> ad = ScalarColumn<Double>(tab, "ad").getColumn();
+  Vector<String> an = ScalarColumn<String>(tab, "an").getColumn();
+  std::set<std::tuple<Int,Double,String>> keys;
+  std::vector<rownr_t> rows;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (keys.insert (std::make_tuple (ab[i], useAd ? ad[i] : 0.,
+                                      useAn ? an[i] : String())).second) {
+      rows.push_back (i);
+    }
+  }
+  return Vector<rownr_t>(rows);
+}
+
+void check (const String& query, const Vector<rownr_t>& expRows)
+{
+  Table result = tableCommand (query).table();
+  Vector<rownr_t> rows = result.rowNumbers();
+  AlwaysAssertExit (rows.size() == expRows.size());
+  AlwaysAssertExit (allEQ (rows, expRows));
+}
+
+int main()
+{
+  try {
+    makeTable ("tTaQLDistinct_tmp.data", 150000);
+    Table tab ("tTaQLDistinct_tmp.data");
+    // Multiple key columns of different types.
+    Vector<rownr_t> rows3 = expected (tab, True, True);
+    AlwaysAssertExit (rows3.size() > 5000);
+    check ("select distinct ab, ad, an from tTaQLDistinct_tmp.data", rows3);
+    check ("select distinct an, ab, ad from tTaQLDistinct_tmp.data", rows3);
+    check ("select distinct ab, an from tTaQLDistinct_tmp.data",
+           expected (tab, False, True));
+    check ("select distinct ab from tTaQLDistinct_tmp.data",
+           expected (tab, False, False));
+    // A selection done before.
+    Table sel = tableCommand ("select distinct ab, ad, an from "
+                              "tTaQLDistinct_tmp.data where ab < 10").table();
+    Table exp = tab(tab.col("ab") < 10);
+    Vector<rownr_t> expRows = expected (exp, True, True);
+    Vector<rownr_t> selRows = exp.rowNumbers();
+    for (rownr_t& row : expRows) {
+      row = selRows[row];
+    }
+    AlwaysAssertExit (allEQ (sel.rowNumbers(), expRows));
+    // A computed column.
+    Table expr = tableCommand ("select distinct ab, arr[1] from "
+                               "tTaQLDistinct_tmp.data").table();
+    AlwaysAssertExit (expr.nrow() == 150);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,157 @@
+//# tTaQLMetaAggr.cc: Test program for TaQL aggregates derived from metadata
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for a TaQL query using only gmin, gmax and gcount without
+// WHERE and GROUPBY. Such a query is answered from the metadata of the
+// storage managers (the zone maps of the StandardStMan, the intervals of
+// the IncrementalStMan). The result must be the same as when all rows are
+// scanned, which is forced by a WHERE clause, also after rows are
+// rewritten or deleted.
+// </summary>
+
+// TIME and SCAN are stored in a StandardStMan with zone maps,
+// ISCAN in an IncrementalStMan.
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Int> ("SCAN"));
+  td.addColumn (ScalarColumnDesc<Int> ("ISCAN"));
+  SetupNewTable newtab (name, td, Table::New);
+  StandardStMan ssm ("SSM", 256);
+  ssm.setUseZoneMaps (True);
+  newtab.bindAll (ssm);
+  IncrementalStMan ism ("ISM", 256);
+  newtab.bindColumn ("ISCAN", ism);
+  Table tab (newtab, nrow);
+  ScalarColumn<Double> timeCol (tab, "TIME");
+  ScalarColumn<Int> scanCol (tab, "SCAN");
+  ScalarColumn<Int> iscanCol (tab, "ISCAN");
+  for (uInt i=0; i<nrow; ++i) {
+    timeCol.put (i, 1000. + (i*37)%nrow);
+    scanCol.put (i, i/50);
+    iscanCol.put (i, 3 - Int(i/100));
+  }
+}
+
+// Get the aggregated values of a query.
+Vector<Double> aggregate (const String& name, const String& where)
+{
+  Table res = tableCommand ("select gmin(TIME) as TMIN, gmax(TIME) as TMAX,"
+                            " gmin(SCAN) as SMIN, gmax(SCAN) as SMAX,"
+                            " gmin(ISCAN) as IMIN, gmax(ISCAN) as IMAX,"
+                            " gcount(*) as NALL, gcount(TIME) as NTIME"
+                            " from " + name + where).table();
+  AlwaysAssertExit (res.nrow() == 1);
+  Vector<String> names = res.tableDesc().columnNames();
+  AlwaysAssertExit (names.size() == 8);
+  Vector<Double> vals(names.size());
+  for (uInt i=0; i<names.size(); ++i) {
+    vals[i] = TableColumn(res, names[i]).asdouble (0);
+  }
+  return vals;
+}
+
+// Check the query without WHERE (using the metadata) against the query
+// with a WHERE selecting all rows (scanning the rows).
+void check (const String& name, Double tmin, Double tmax)
+{
+  Table tab (name);
+  // The metadata must be usable.
+  rownr_t minRow, maxRow;
+  AlwaysAssertExit (TableColumn(tab, "TIME").findMinMax (minRow, maxRow));
+  AlwaysAssertExit (TableColumn(tab, "SCAN").findMinMax (minRow, maxRow));
+  AlwaysAssertExit (TableColumn(tab, "ISCAN").findMinMax (minRow, maxRow));
+  Vector<Double> meta = aggregate (name, "");
+  Vector<Double> scan = aggregate (name, " where rownumber() >= 0");
+  AlwaysAssertExit (allEQ (meta, scan));
+  AlwaysAssertExit (meta[0] == tmin  &&  meta[1] == tmax);
+  AlwaysAssertExit (meta[6] == tab.nrow()  &&  meta[7] == tab.nrow());
+}
+
+int main()
+{
+  try {
+    const String name ("tTaQLMetaAggr_tmp.data");
+    makeTable (name, 1000);
+    check (name, 1000., 1999.);
+    {
+      // Rewrite the rows with the minimum and maximum, so the zone limits
+      // are too wide. Also put new extremes in another zone.
+      Table tab (name, Table::Update);
+      ScalarColumn<Double> timeCol (tab, "TIME");
+      ScalarColumn<Int> scanCol (tab, "SCAN");
+      ScalarColumn<Int> iscanCol (tab, "ISCAN");
+      for (uInt i=0; i<tab.nrow(); ++i) {
+        if (timeCol(i) == 1000.  ||  timeCol(i) == 1999.) {
+          timeCol.put (i, 1500.);
+        }
+      }
+      timeCol.put (777, 999.5);
+      scanCol.put (0, 100);
+      scanCol.put (999, -1);
+      iscanCol.put (500, 20);
+    }
+    check (name, 999.5, 1998.);
+    {
+      // Delete the rows with the extremes and a block of rows.
+      Table tab (name, Table::Update);
+      Vector<rownr_t> rows(52);
+      rows[0] = 0;
+      rows[1] = 777;
+      for (uInt i=2; i<rows.size(); ++i) {
+        rows[i] = 898 + i;
+      }
+      tab.removeRow (rows);
+      AlwaysAssertExit (tab.nrow() == 948);
+    }
+    Table tab (name);
+    ScalarColumn<Double> timeCol (tab, "TIME");
+    Vector<Double> times = timeCol.getColumn();
+    check (name, min(times), max(times));
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,118 @@
+//# tTaQLProfile.cc: Test program for class TaQLProfile
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLProfile.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <sstream>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TaQLProfile.
+// The timings and memory usage vary, so only the row counts and
+// presence of the IO statistics are checked.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ab"));
+  td.addColumn (ScalarColumnDesc<Double> ("ad"));
+  SetupNewTable newtab (name, td, Table::New);
+  StandardStMan ssm ("SSM", 256);
+  newtab.bindAll (ssm);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> abcol (tab, "ab");
+  ScalarColumn<Double> adcol (tab, "ad");
+  for (uInt i=0; i<nrow; ++i) {
+    abcol.put (i, i);
+    adcol.put (i, i/2.);
+  }
+}
+
+void testProfile (const String& name)
+{
+  Table tab (name);
+  TaQLProfile profile (tab);
+  profile.start();
+  Table sel = tab(tab.col("ab") < 30);
+  profile.stop ("Where", tab.nrow(), sel.nrow());
+  profile.start();
+  Table srt = sel.sort ("ad", Sort::Descending);
+  profile.stop ("Orderby", sel.nrow(), srt.nrow());
+  AlwaysAssertExit (profile.nstep() == 2);
+  Record rec = profile.toRecord();
+  const Record& step0 = rec.subRecord ("step0");
+  AlwaysAssertExit (step0.asString("name") == "Where");
+  AlwaysAssertExit (step0.asInt64("nrowin") == 100);
+  AlwaysAssertExit (step0.asInt64("nrowout") == 30);
+  const Record& step1 = rec.subRecord ("step1");
+  AlwaysAssertExit (step1.asString("name") == "Orderby");
+  AlwaysAssertExit (step1.asInt64("nrowout") == 30);
+  // Both columns are in the same StandardStMan.
+  const Record& io = step0.subRecord ("io");
+  AlwaysAssertExit (io.nfields() == 1);
+  AlwaysAssertExit (io.subRecord("SSM").asString("type") == "StandardStMan");
+  AlwaysAssertExit (io.subRecord("SSM").asInt64("naccess") > 0);
+  AlwaysAssertExit (rec.asInt64("memorypeak") >= 0);
+  // Showing the profile must not change the precision of the stream.
+  std::ostringstream os;
+  os.precision (9);
+  profile.show (os);
+  AlwaysAssertExit (os.precision() == 9);
+}
+
+void testQuery (const String& name)
+{
+  // Profiling must not change the query result.
+  Table res = tableCommand ("using style profile select ab from " + name +
+                            " where ab>=10 orderby ad desc limit 5").table();
+  AlwaysAssertExit (res.nrow() == 5);
+  ScalarColumn<Int> abcol (res, "ab");
+  AlwaysAssertExit (abcol(0) == 99);
+  AlwaysAssertExit (abcol(4) == 95);
+}
+
+int main()
+{
+  try {
+    makeTable ("tTaQLProfile_tmp.data", 100);
+    testProfile ("tTaQLProfile_tmp.data");
+    testQuery ("tTaQLProfile_tmp.data");
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,95 @@
+//# tTaQLTopSort.cc: Test program for TaQL ORDERBY with LIMIT
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <cstdlib>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for TaQL ORDERBY with LIMIT, which uses a partial sort.
+// The result must be the same as the first part of the full sort.
+// The table has more rows than the chunk size used for the partial sort.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ab"));
+  td.addColumn (ScalarColumnDesc<Double> ("ad"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab, nrow);
+  ScalarColumn<Int> abcol (tab, "ab");
+  ScalarColumn<Double> adcol (tab, "ad");
+  for (uInt i=0; i<nrow; ++i) {
+    abcol.put (i, std::rand() % 1000);
+    adcol.put (i, (std::rand() % 100) / 10.);
+  }
+}
+
+// Compare the result of the query with limit and offset to the
+// corresponding part of the full result.
+void check (const String& query, Int64 limit, Int64 offset)
+{
+  Table full = tableCommand (query).table();
+  Table part = tableCommand (query + " limit " + String::toString(limit) +
+                             " offset " + String::toString(offset)).table();
+  Vector<rownr_t> fullRows = full.rowNumbers();
+  Vector<rownr_t> partRows = part.rowNumbers();
+  Int64 nr = std::max (Int64(0),
+                       std::min (limit, Int64(fullRows.size()) - offset));
+  AlwaysAssertExit (Int64(partRows.size()) == nr);
+  if (nr > 0) {
+    AlwaysAssertExit (allEQ (partRows, fullRows(Slice(offset, nr))));
+  }
+}
+
+int main()
+{
+  try {
+    makeTable ("tTaQLTopSort_tmp.data", 1500000);
+    String query ("select from tTaQLTopSort_tmp.data orderby ab, ad desc");
+    check (query, 10, 0);
+    check (query, 100, 25);
+    check (query, 1, 1499999);
+    check (query, 10, 1500000);
+    check ("select from tTaQLTopSort_tmp.data where ad > 5 orderby desc ab",
+           1000, 10);
+    check ("select from tTaQLTopSort_tmp.data orderby ad", 5, 3);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
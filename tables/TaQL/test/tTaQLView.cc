@@ -0,0 +1,165 @@
+//# tTaQLView.cc: Test program for class TaQLView
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLView.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TaQLView.
+// </summary>
+
+void makeTable (const String& name, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("SCAN"));
+  td.addColumn (ScalarColumnDesc<Double> ("VALUE"));
+  SetupNewTable newtab (name, td, Table::New);
+  Table tab (newtab);
+  tab.addRow (nrow);
+  ScalarColumn<Int> scanCol (tab, "SCAN");
+  ScalarColumn<Double> valCol (tab, "VALUE");
+  for (uInt i=0; i<nrow; ++i) {
+    scanCol.put (i, i/10);
+    valCol.put (i, i%7);
+  }
+}
+
+void addRows (const String& name, uInt nrow)
+{
+  Table tab (name, Table::Update);
+  rownr_t nrowOld = tab.nrow();
+  tab.addRow (nrow);
+  ScalarColumn<Int> scanCol (tab, "SCAN");
+  ScalarColumn<Double> valCol (tab, "VALUE");
+  for (rownr_t i=nrowOld; i<tab.nrow(); ++i) {
+    scanCol.put (i, i/10);
+    valCol.put (i, i%7);
+  }
+}
+
+// Check that the view contains the same as a full query.
+void checkView (const String& viewName, const String& query,
+                const String& column)
+{
+  Table view (viewName);
+  Table source (view.keywordSet().subRecord("TAQLVIEW").asString("SOURCE"));
+  Table result = tableCommand (query, source).table();
+  AlwaysAssertExit (view.nrow() == result.nrow());
+  AlwaysAssertExit (allEQ (ScalarColumn<Double>(view, column).getColumn(),
+                           ScalarColumn<Double>(result, column).getColumn()));
+}
+
+int main()
+{
+  try {
+    String src ("tTaQLView_tmp.data");
+    makeTable (src, 100);
+    String query1 ("select SCAN, 2*VALUE as V2 from $1 where VALUE > 2");
+    String query2 ("select SCAN, gsum(VALUE) as VSUM from $1 groupby SCAN");
+    Table view1 = TaQLView::create ("tTaQLView_tmp.view1", query1, src, True);
+    Table view2 = TaQLView::create ("tTaQLView_tmp.view2", query2, src);
+    AlwaysAssertExit (TaQLView::isView (view1)  &&  TaQLView::isView (view2));
+    AlwaysAssertExit (view2.nrow() == 10);
+    view1 = Table();
+    view2 = Table();
+    checkView ("tTaQLView_tmp.view1", query1, "V2");
+    checkView ("tTaQLView_tmp.view2", query2, "VSUM");
+    // Nothing changed.
+    AlwaysAssertExit (TaQLView::refresh ("tTaQLView_tmp.view1") ==
+                      TaQLView::NoRefresh);
+    AlwaysAssertExit (TaQLView::refresh ("tTaQLView_tmp.view2") ==
+                      TaQLView::NoRefresh);
+    // Add rows; the incremental view is appended to.
+    addRows (src, 55);
+    AlwaysAssertExit (TaQLView::refresh ("tTaQLView_tmp.view1") ==
+                      TaQLView::Appended);
+    AlwaysAssertExit (TaQLView::refresh ("tTaQLView_tmp.view2") ==
+                      TaQLView::Recomputed);
+    checkView ("tTaQLView_tmp.view1", query1, "V2");
+    checkView ("tTaQLView_tmp.view2", query2, "VSUM");
+    AlwaysAssertExit (TaQLView::open("tTaQLView_tmp.view2").nrow() == 16);
+    // Changing a keyword of the source forces a recompute.
+    {
+      Table tab (src, Table::Update);
+      tab.rwKeywordSet().define ("KEY", 1);
+    }
+    addRows (src, 5);
+    AlwaysAssertExit (TaQLView::refresh ("tTaQLView_tmp.view1") ==
+                      TaQLView::Recomputed);
+    checkView ("tTaQLView_tmp.view1", query1, "V2");
+    // Explicit recompute.
+    TaQLView::recompute ("tTaQLView_tmp.view1");
+    checkView ("tTaQLView_tmp.view1", query1, "V2");
+    // A groupby query cannot be incremental, nor can queries using
+    // aggregate or row number functions.
+    const char* nonIncrQueries[] = {
+      "select SCAN, gsum(VALUE) as VSUM from $1 groupby SCAN",
+      "select gsum(VALUE) as VSUM from $1",
+      "select SCAN, 2*gmax(VALUE+1) as VMAX from $1",
+      "select gcount(*) as N from $1",
+      "select SCAN from $1 where VALUE > gmean(VALUE)",
+      "select SCAN, rownumber() as NR from $1",
+      "select SCAN from $1 where rowid() < 10"};
+    Bool failed;
+    for (const char* query : nonIncrQueries) {
+      failed = False;
+      try {
+        TaQLView::create ("tTaQLView_tmp.view3", query, src, True);
+      } catch (const TableInvExpr&) {
+        failed = True;
+      }
+      AlwaysAssertExit (failed);
+    }
+    // Per-row functions are fine.
+    TaQLView::create ("tTaQLView_tmp.view4",
+                      "select SCAN, sqrt(abs(VALUE)) as V from $1"
+                      " where VALUE in [1:5]", src, True);
+    // A normal table is not a view.
+    failed = False;
+    try {
+      TaQLView::open (src);
+    } catch (const TableError&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -93,6 +93,16 @@ Bool BaseColumn::canChangeShape() const
     return False;                      // can not be changed
 }
 
+const ColumnZoneMap* BaseColumn::zoneMap() const
+{
+    return 0;
+}
+
+Bool BaseColumn::findMinMax (rownr_t&, rownr_t&) const
+{
+    return False;
+}
+
 void BaseColumn::get (rownr_t, void*) const
 {
   throw (TableInvOper ("get() not implemented for column " +
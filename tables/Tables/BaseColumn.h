@@ -41,6 +41,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class ArrayBase;
 class BaseColumnDesc;
 class ColumnCache;
+class ColumnZoneMap;
 class TableRecord;
 class RefRows;
 class IPosition;
@@ -149,6 +150,15 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Get the zone map of a scalar numeric column from the data manager.
+    // By default it returns a null pointer, thus no zone map.
+    virtual const ColumnZoneMap* zoneMap() const;
+
+    // Find the rows containing the minimum and maximum value of a scalar
+    // numeric column from the metadata of the data manager.
+    // By default it returns False, thus not possible.
+    virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr) const;
+
     // Initialize the rows from startRow till endRow (inclusive)
     // with the default value defined in the column description.
     virtual void initialize (rownr_t startRownr, rownr_t endRownr) = 0;
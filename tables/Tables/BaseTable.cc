@@ -36,6 +36,10 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprCompiled.h>
+#include <casacore/tables/TaQL/ExprRange.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/DataMan/ColumnZoneMap.h>
 #include <casacore/tables/Tables/BaseTabIter.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
@@ -360,6 +364,21 @@ void BaseTable::writeEnd (AipsIO& ios)
 void BaseTable::setTableChanged()
 {}
 
+uInt BaseTable::getTableChangeCounter() const
+{
+    return 0;
+}
+
+uInt BaseTable::getDataChangeCounter() const
+{
+    return 0;
+}
+
+uInt BaseTable::getDataManChangeCounter (uInt) const
+{
+    return 0;
+}
+
 
 void BaseTable::markForDelete (Bool callback, const String& oldName)
 {
@@ -805,28 +824,88 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
     std::shared_ptr<RefTable> resultTable = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(resultTable), AipsError);
     Bool val;
-    rownr_t nrrow = nrow();
     TableExprId id;
-    for (rownr_t i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    // Only evaluate the rows that can match according to the zone maps.
+    std::vector<std::pair<rownr_t,rownr_t>> intervals = selectZones (node);
+    if (maxRow == 0  &&  offset == 0) {
+      // All rows have to be evaluated, so do it per block of rows to
+      // benefit from nodes evaluating a column at once (e.g. regex match).
+      Vector<rownr_t> rownrs;
+      for (const std::pair<rownr_t,rownr_t>& interval : intervals) {
+        for (rownr_t st=interval.first; st<=interval.second;
+             st+=TableExprCompiled::blockSize) {
+          rownr_t n = std::min (rownr_t(TableExprCompiled::blockSize),
+                                interval.second - st + 1);
+          rownrs.resize (n);
+          indgen (rownrs, st);
+          Array<Bool> vals (node.getRep()->getColumnBool (rownrs));
+          const Bool* valPtr = vals.data();
+          for (rownr_t i=0; i<n; ++i) {
+            if (valPtr[i]) {
+              resultTable->addRownr (st+i);
+            }
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
       }
+      adjustRownrs (resultTable->nrow(), resultTable->rowStorage(), False);
+      return resultTable;
+    }
+    for (const std::pair<rownr_t,rownr_t>& interval : intervals) {
+      for (rownr_t i=interval.first; i<=interval.second; i++) {
+        id.setRownr (i);
+        node.get (id, val);
+        if (val) {
+          if (offset == 0) {
+            resultTable->addRownr (i);                  // add row
+            // Stop if max #rows reached (note that maxRow==0 means no limit).
+            if (resultTable->nrow() == maxRow) {
+              break;
+            }
+          } else {
+            // Skip first offset matching rows.
+            offset--;
+          }
+        }
+      }
+      if (maxRow > 0  &&  resultTable->nrow() == maxRow) {
+        break;
+      }
     }
     adjustRownrs (resultTable->nrow(), resultTable->rowStorage(), False);
     return resultTable;
 }
 
+std::vector<std::pair<rownr_t,rownr_t>> BaseTable::selectZones
+(const TableExprNode& node)
+{
+    std::vector<std::pair<rownr_t,rownr_t>> intervals;
+    if (nrow() > 0) {
+      intervals.push_back (std::make_pair (rownr_t(0), nrow()-1));
+    }
+    // Get the value ranges of the columns in the expression.
+    // Use the zone map of such a column (if in this table) to find the
+    // rows that can contain values in the ranges.
+    Block<TableExprRange> ranges;
+    node.getRep()->ranges (ranges);
+    for (const TableExprRange& range : ranges) {
+      const TableColumn& col = range.getColumn();
+      if (col.table().baseTablePtr() == this) {
+        const ColumnZoneMap* zoneMap =
+          getColumn(col.columnDesc().name())->zoneMap();
+        if (zoneMap  &&  zoneMap->nrow() == nrow()) {
+          intervals = ColumnZoneMap::intersect
+            (intervals, zoneMap->selectRows (range.start(), range.end()));
+        }
+      }
+    }
+    // Only the sampled rows are needed if the SAMPLE function is used.
+    std::vector<std::pair<rownr_t,rownr_t>> sampled;
+    if (node.getRep()->sampleRows (nrow(), sampled)) {
+      intervals = ColumnZoneMap::intersect (intervals, sampled);
+    }
+    return intervals;
+}
+
 std::shared_ptr<BaseTable> BaseTable::select (const Vector<rownr_t>& rownrs)
 {
     AlwaysAssert (!isNull(), AipsError);
@@ -37,6 +37,7 @@
 #include <casacore/casa/IO/FileLocker.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
 #include <memory>
+#include <vector>
 
 #ifdef HAVE_MPI
 #include <mpi.h>
@@ -168,6 +169,18 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const = 0;
 
+    // Get the counter telling how often the table description or keywords
+    // have changed. By default it returns 0.
+    virtual uInt getTableChangeCounter() const;
+
+    // Get the counter telling how often the data in the data managers
+    // have changed. By default it returns 0.
+    virtual uInt getDataChangeCounter() const;
+
+    // Get the change counter of the data manager with the given sequence
+    // number. By default it returns 0.
+    virtual uInt getDataManChangeCounter (uInt seqnr) const;
+
     // Set the table to being changed. By default it does nothing.
     virtual void setTableChanged();
 
@@ -357,6 +370,15 @@ public:
     std::shared_ptr<BaseTable> select (const TableExprNode&,
                                        rownr_t maxRow, rownr_t offset);
 
+    // Get the intervals of rows (first and last row) that can match the
+    // given selection expression. The value ranges of the columns in the
+    // expression are used with the zone maps of those columns (if
+    // maintained by their storage managers) to skip zones that cannot
+    // contain matching rows. Furthermore, if the expression uses the SAMPLE
+    // function, only the rows in the sampled blocks are returned.
+    // If neither can be used, all rows are returned as a single interval.
+    std::vector<std::pair<rownr_t,rownr_t>> selectZones (const TableExprNode&);
+
     // Select maxRow rows and skip first offset rows. maxRow=0 means all.
     std::shared_ptr<BaseTable> select (rownr_t maxRow, rownr_t offset);
 
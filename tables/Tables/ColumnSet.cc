@@ -920,6 +920,16 @@ DataManager* ColumnSet::getDataManager (uInt seqnr) const
     return 0;
 }
 
+Int ColumnSet::dataManagerIndex (uInt seqnr) const
+{
+    for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+	if (seqnr == BLOCKDATAMANVAL(i)->sequenceNr()) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
 
 Bool ColumnSet::userLock (FileLocker::LockType type, Bool wait)
 {
@@ -253,6 +253,11 @@ public:
     // correct datamanagers when they are read back.
     DataManager* getDataManager (uInt seqnr) const;
 
+    // Get the index of the data manager with the given sequence number.
+    // It is the index in the change flags (see dataManChanged).
+    // -1 is returned if not found.
+    Int dataManagerIndex (uInt seqnr) const;
+
     // Check if no double data manager names have been given.
     void checkDataManagerNames (const String& tableName) const;
 
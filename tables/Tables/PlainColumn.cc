@@ -96,6 +96,12 @@ Bool PlainColumn::isStored() const
 ColumnCache& PlainColumn::columnCache()
     { return dataColPtr_p->columnCache(); }
 
+const ColumnZoneMap* PlainColumn::zoneMap() const
+    { return dataColPtr_p->zoneMap(); }
+
+Bool PlainColumn::findMinMax (rownr_t& minRownr, rownr_t& maxRownr) const
+    { return dataColPtr_p->findMinMax (minRownr, maxRownr); }
+
 void PlainColumn::setMaximumCacheSize (uInt nbytes)
     { dataManPtr_p->setMaximumCacheSize (nbytes); }
 
@@ -126,6 +126,13 @@ public:
     // Get a pointer to the underlying column cache.
     virtual ColumnCache& columnCache();
 
+    // Get the zone map of the column from the data manager.
+    virtual const ColumnZoneMap* zoneMap() const;
+
+    // Find the rows containing the minimum and maximum value using the
+    // data manager.
+    virtual Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr) const;
+
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
@@ -502,6 +502,22 @@ uInt PlainTable::getModifyCounter() const
     return lockSync_p.getModifyCounter();
 }
 
+uInt PlainTable::getTableChangeCounter() const
+{
+    return lockSync_p.getTableChangeCounter();
+}
+
+uInt PlainTable::getDataChangeCounter() const
+{
+    return lockSync_p.getDataChangeCounter();
+}
+
+uInt PlainTable::getDataManChangeCounter (uInt seqnr) const
+{
+    Int inx = colSetPtr_p->dataManagerIndex (seqnr);
+    return (inx < 0  ?  0 : lockSync_p.getDataManChangeCounter (inx));
+}
+
 
 void PlainTable::flush (Bool fsync, Bool recursive)
 {
@@ -186,6 +186,15 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
+    // Get the table change counter.
+    virtual uInt getTableChangeCounter() const;
+
+    // Get the data change counter.
+    virtual uInt getDataChangeCounter() const;
+
+    // Get the change counter of a data manager.
+    virtual uInt getDataManChangeCounter (uInt seqnr) const;
+
     // Set the table to being changed.
     virtual void setTableChanged();
 
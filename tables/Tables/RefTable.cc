@@ -236,6 +236,16 @@ uInt RefTable::getModifyCounter() const
     return baseTabPtr_p->getModifyCounter();
 }
 
+uInt RefTable::getTableChangeCounter() const
+{
+    return baseTabPtr_p->getTableChangeCounter();
+}
+
+uInt RefTable::getDataChangeCounter() const
+{
+    return baseTabPtr_p->getDataChangeCounter();
+}
+
 
 //# Adjust the input rownrs to the actual rownrs in the root table.
 Bool RefTable::adjustRownrs (rownr_t nr, Vector<rownr_t>& rowStorage,
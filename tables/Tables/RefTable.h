@@ -204,6 +204,12 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
+    // Get the table change counter of the parent table.
+    virtual uInt getTableChangeCounter() const;
+
+    // Get the data change counter of the parent table.
+    virtual uInt getDataChangeCounter() const;
+
     // Test if the parent table is opened as writable.
     virtual Bool isWritable() const;
 
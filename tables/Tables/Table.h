@@ -454,6 +454,22 @@ public:
     // (or is being changed) since the last time this function was called.
     Bool hasDataChanged();
 
+    // Get the change counters of the table as kept in the lock file
+    // (see class TableSyncData). The modify counter is incremented each
+    // time the table is flushed after a change. The table change counter
+    // is only incremented if the table description or keywords changed.
+    // The data change counter is only incremented if the data in the
+    // columns (or the number of rows) changed. It is the sum of the change
+    // counters of the data managers, which can also be obtained for a
+    // data manager given by its sequence number.
+    // The counters are up-to-date while the table is locked.
+    // <group>
+    uInt getModifyCounter() const;
+    uInt getTableChangeCounter() const;
+    uInt getDataChangeCounter() const;
+    uInt getDataManChangeCounter (uInt seqnr) const;
+    // </group>
+
     // Flush the table, i.e. write out the buffers. If <src>sync=True</src>,
     // it is ensured that all data are physically written to disk.
     // Nothing will be done if the table is not writable.
@@ -1177,6 +1193,14 @@ inline rownr_t Table::nrow() const
     { return baseTabPtr_p->nrow(); }
 inline BaseTable* Table::baseTablePtr() const
     { return baseTabPtr_p; }
+inline uInt Table::getModifyCounter() const
+    { return baseTabPtr_p->getModifyCounter(); }
+inline uInt Table::getTableChangeCounter() const
+    { return baseTabPtr_p->getTableChangeCounter(); }
+inline uInt Table::getDataChangeCounter() const
+    { return baseTabPtr_p->getDataChangeCounter(); }
+inline uInt Table::getDataManChangeCounter (uInt seqnr) const
+    { return baseTabPtr_p->getDataManChangeCounter (seqnr); }
 inline const TableDesc& Table::tableDesc() const
     { return baseTabPtr_p->tableDesc(); }
 inline const TableRecord& Table::keywordSet() const
@@ -195,6 +195,14 @@ public:
     rownr_t nrow() const
 	{ return baseColPtr_p->nrow(); }
 
+    // Find the rows containing the minimum and maximum value of a scalar
+    // numeric column using the metadata of its storage manager (e.g. the
+    // zone map of the StandardStMan or the value intervals of the
+    // IncrementalStMan), thus without reading all values.
+    // False is returned if not possible.
+    Bool findMinMax (rownr_t& minRownr, rownr_t& maxRownr) const
+	{ return baseColPtr_p->findMinMax (minRownr, maxRownr); }
+
     // Can the shape of an already existing non-FixedShape array be changed?
     // This depends on the storage manager. Most storage managers
     // can handle it, but TiledDataStMan and TiledColumnStMan can not.
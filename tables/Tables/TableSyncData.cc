@@ -47,6 +47,21 @@ TableSyncData::~TableSyncData()
     itsAipsIO.close();
 }
 
+uInt TableSyncData::getDataChangeCounter() const
+{
+    uInt counter = 0;
+    for (uInt i=0; i<itsDataManChangeCounter.nelements(); i++) {
+        counter += itsDataManChangeCounter[i];
+    }
+    return counter;
+}
+
+uInt TableSyncData::getDataManChangeCounter (uInt i) const
+{
+    return (i < itsDataManChangeCounter.nelements()  ?
+            itsDataManChangeCounter[i] : 0);
+}
+
 void TableSyncData::write (rownr_t nrrow, uInt nrcolumn, Bool tableChanged,
 			   const Block<Bool>& dataManChanged)
 {
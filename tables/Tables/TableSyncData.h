@@ -112,6 +112,19 @@ public:
     // Get the modify counter.
     uInt getModifyCounter() const;
 
+    // Get the table change counter, which is only incremented if the
+    // table description or keywords have changed.
+    uInt getTableChangeCounter() const;
+
+    // Get the data change counter, which is the sum of the change counters
+    // of the data managers. It is not incremented if only the table
+    // description or keywords have changed.
+    uInt getDataChangeCounter() const;
+
+    // Get the change counter of the i-th data manager.
+    // It returns 0 if unknown.
+    uInt getDataManChangeCounter (uInt i) const;
+
 
 private:
     //# Member variables.
@@ -134,6 +147,10 @@ inline uInt TableSyncData::getModifyCounter() const
 {
     return itsModifyCounter;
 }
+inline uInt TableSyncData::getTableChangeCounter() const
+{
+    return itsTableChangeCounter;
+}
 
 
 
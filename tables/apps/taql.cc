@@ -24,6 +24,7 @@
 //#                        Charlottesville, VA 22903-2475 USA
 
 #include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/TaQLCursor.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableProxy.h>
 #include <casacore/tables/Tables/TableRecord.h>
@@ -446,8 +447,10 @@ template<> void showArray (const Array<MVTime>& arr, ostream& os)
 
 // Show the required columns of the table.
 // First test if they exist and contain scalars or arrays.
+// The units are only shown if <src>showUnits=True</src>.
 void showTable (const Table& tab, const Vector<String>& colnam,
-                Bool printMeasure, const String& separator, ostream& os)
+                Bool printMeasure, const String& separator, ostream& os,
+                Bool showUnits=True)
 {
   uInt nrcol = 0;
   PtrBlock<TableColumn*> tableColumns(colnam.nelements());
@@ -502,7 +505,7 @@ void showTable (const Table& tab, const Vector<String>& colnam,
     return;
   }
   // Show possible units.
-  if (hasUnits) {
+  if (hasUnits  &&  showUnits) {
     os << "Unit: ";
     for (uInt j=0; j<nrcol; j++) {
       if (j > 0) {
@@ -697,6 +700,58 @@ void showParseError (const TableParseError& x)
 }
 
 
+// Execute a SELECT command whose result is only shown.
+// A TaQLCursor is used, so the rows are shown while the expressions in the
+// column list are evaluated. When printing automatically, only the first
+// maxNRows are evaluated.
+void taqlCursor (const Options& options, const String& command,
+                 const vector<const Table*>& tempTables,
+                 Bool printSelect, Bool printCommand,
+                 Bool printNRows, Bool printHeader)
+{
+  ostream& os = *(options.stream);
+  rownr_t maxNRows = options.maxNRows;
+  TaQLCursor cursor (command, tempTables,
+                     printSelect ? 1024 : std::min(maxNRows, rownr_t(1024)));
+  if (printCommand) {
+    os << command << endl;
+    os << "    has been executed" << endl;
+  }
+  if (printNRows) {
+    os << "    " << cursor.commandType() << " result of " << cursor.nrow()
+       << " rows" << endl;
+  }
+  const Vector<String>& colNames = cursor.columnNames();
+  if (colNames.empty()) {
+    return;
+  }
+  if (printHeader) {
+    // Show the selected column names.
+    os << colNames.nelements() << " selected columns: ";
+    for (uInt i=0; i<colNames.nelements(); i++) {
+      os << " " << colNames(i);
+    }
+    os << endl;
+  }
+  // Show the contents of the columns block by block.
+  rownr_t nshown = 0;
+  while ((printSelect || nshown < maxNRows)  &&  cursor.next()) {
+    Table tabc (cursor.block());
+    if (!printSelect  &&  nshown + tabc.nrow() > maxNRows) {
+      Vector<rownr_t> rownrs(maxNRows - nshown);
+      indgen (rownrs);
+      tabc = tabc(rownrs);
+    }
+    showTable (tabc, colNames, options.printMeasure, options.separator, os,
+               nshown == 0);
+    nshown += tabc.nrow();
+  }
+  if (nshown < cursor.nrow()) {
+    os << "  Note: only the first " << maxNRows << " rows are shown (out of "
+       << cursor.nrow() << ')' << endl;
+  }
+}
+
 // Execute a TaQL command.
 Table taqlCommand (const Options& options, const String& varName,
                    const String& command,
@@ -706,6 +761,7 @@ Table taqlCommand (const Options& options, const String& varName,
   // Only show results for SELECT, COUNT and CALC.
   Bool addComm = False;
   Bool showHelp = False;
+  Bool isSelect = False;
   Bool printSelect  = options.printSelect;
   Bool printAuto    = options.printAuto;
   Bool printMeasure = options.printMeasure;
@@ -723,6 +779,7 @@ Table taqlCommand (const Options& options, const String& varName,
     String s = command.substr(spos, epos-spos);
     s.downcase();
     showHelp = (s=="show" || s=="help");
+    isSelect = (s=="select");
     addComm = !(s=="with" || s=="select" || s=="update" || s=="insert" ||
                 s=="calc" || s=="delete" || s=="count"  || 
                 s=="create" || s=="createtable" ||
@@ -744,6 +801,13 @@ Table taqlCommand (const Options& options, const String& varName,
     style = "glish";
   }
   strc = "using style " + style + ' ' + strc;
+  // A SELECT result that is only shown does not need to be kept.
+  if (varName.empty()  &&  (isSelect || addComm)  &&
+      (printSelect || (printAuto && maxNRows>0))) {
+    taqlCursor (options, strc, tempTables, printSelect, printCommand,
+                printNRows, printHeader);
+    return Table();
+  }
   Vector<String> colNames;
   String cmd;
   TaQLResult result = tableCommand (strc, tempTables, colNames, cmd);